@@ -9,6 +9,7 @@
 #include <mutex>
 #include <w_task.h>
 #include <w_thread.h>
+#include <w_frame_arena.h>
 #include <w_timer.h>
 #include <glm/gtx/quaternion.hpp>
 
@@ -450,7 +451,10 @@ HRESULT scene::_build_draw_command_buffer(_In_ const std::shared_ptr<w_graphics_
                 0.0f,
                 VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
             {
-                std::vector<VkCommandBuffer> _sec_cmd_buffers;
+                w_frame_vector<VkCommandBuffer> _sec_cmd_buffers;
+                _sec_cmd_buffers.reserve(this->_render_thread_pool.size());
+                //signaled once all secondary command buffers of this frame buffer were recorded
+                w_job_counter _recording_counter;
                 //add job for each thread
                 size_t _start_index = 0;
                 for (auto& _thread_context : this->_render_thread_pool)
@@ -480,15 +484,12 @@ HRESULT scene::_build_draw_command_buffer(_In_ const std::shared_ptr<w_graphics_
                             });
                         }
                         vkEndCommandBuffer(_thread_cmd);
-                    });
+                    }, &_recording_counter);
                     _start_index += _thread_context->batch_size;
                 }
 
-                //wait for all threads
-                for (auto& _thread : this->_render_thread_pool)
-                {
-                    _thread->thread.wait();
-                }
+                //wait only for recording jobs of this frame buffer
+                _recording_counter.wait();
 
                 //Execute secondary commands buffer to primary command
                 if (_sec_cmd_buffers.size())
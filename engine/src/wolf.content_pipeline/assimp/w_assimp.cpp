@@ -8,6 +8,8 @@
 #include <assimp/cimport.h>
 
 #include <amd/amd_tootle.h>
+#include <w_thread_pool.h>
+#include <chrono>
 
 #ifdef __WIN32
 
@@ -25,6 +27,115 @@ using namespace wolf;
 using namespace wolf::system;
 using namespace wolf::content_pipeline;
 
+// Flags for loading the mesh
+static const int s_assimp_flags =
+		aiProcess_ValidateDataStructure			// perform a full validation of the loader's output
+		| aiProcess_Triangulate					// triangulate polygons with more than 3 edges
+		| aiProcess_ImproveCacheLocality		// improve the cache locality of the output vertices
+		| aiProcess_RemoveRedundantMaterials	// remove redundant materials
+		| aiProcess_FindDegenerates				// remove degenerated polygons from the import
+		| aiProcess_FindInvalidData				// detect invalid model data, such as invalid normal vectors
+		| aiProcess_OptimizeMeshes				// join small meshes, if possible
+		| aiProcess_GenSmoothNormals			// generate smooth normals if needed
+		| aiProcess_CalcTangentSpace			// calculate tangant and bitangent when normal presented
+		| aiProcess_FindInstances				// duplicate meshes 
+		| aiProcess_SplitLargeMeshes			// split large, unrenderable meshes into submeshes
+		| aiProcess_MakeLeftHanded;				// make left hand coordinate system
+
+//problems of a mesh which will be reported once after conversion
+struct w_assimp_mesh_report
+{
+	bool		has_no_vertices = false;
+	bool		has_no_normals = false;
+	bool		has_no_uvs = false;
+	size_t		skipped_faces = 0;
+};
+
+static double s_get_seconds(_In_ const std::chrono::steady_clock::time_point& pStart)
+{
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - pStart).count();
+}
+
+//convert one assimp mesh, it runs on workers of pool, so it must not touch shared state or logger
+static w_cpipeline_mesh* s_convert_mesh(
+	_In_ const aiMesh* pMesh,
+	_In_ const std::vector<std::string>& pTexturePaths,
+	_Inout_ w_assimp_mesh_report& pReport)
+{
+	static_assert(sizeof(aiVector3D) == 3 * sizeof(float), "positions of assimp must be packed");
+
+	auto _w_mesh = new w_cpipeline_mesh();
+	_w_mesh->name = pMesh->mName.C_Str();
+
+	if (pMesh->mMaterialIndex < pTexturePaths.size())
+	{
+		_w_mesh->textures_path = pTexturePaths[pMesh->mMaterialIndex];
+	}
+
+	//TODO: we need to support skinned model in next version
+	if (!pMesh->mVertices || !pMesh->mNumVertices)
+	{
+		pReport.has_no_vertices = true;
+		return _w_mesh;
+	}
+
+	const size_t _number_of_vertices = pMesh->mNumVertices;
+	auto _normals = pMesh->mNormals;
+	auto _uvs = pMesh->mTextureCoords[0];
+	pReport.has_no_normals = _normals == nullptr;
+	pReport.has_no_uvs = _uvs == nullptr;
+
+	//resize value initializes vertices, so unused attributes are zero
+	auto& _vertices = _w_mesh->vertices.get_vector();
+	_vertices.resize(_number_of_vertices);
+	for (size_t i = 0; i < _number_of_vertices; ++i)
+	{
+		auto& _w_vertex = _vertices[i];
+
+		auto& _pos = pMesh->mVertices[i];
+		_w_vertex.position[0] = _pos.x;
+		_w_vertex.position[1] = _pos.y;
+		_w_vertex.position[2] = _pos.z;
+
+		if (_normals)
+		{
+			_w_vertex.normal[0] = _normals[i].x;
+			_w_vertex.normal[1] = _normals[i].y;
+			_w_vertex.normal[2] = _normals[i].z;
+		}
+		if (_uvs)
+		{
+			_w_vertex.uv[0] = _uvs[i].x;
+			_w_vertex.uv[1] = _uvs[i].y;
+		}
+	}
+
+	_w_mesh->bounding_box = w_bounding_box::create_from_points(&pMesh->mVertices[0].x, _number_of_vertices);
+
+	//generate indices, points and lines which were not triangulated are skipped
+	size_t _number_of_triangles = 0;
+	for (size_t f = 0; f < pMesh->mNumFaces; ++f)
+	{
+		if (pMesh->mFaces[f].mNumIndices == 3) _number_of_triangles++;
+	}
+	pReport.skipped_faces = pMesh->mNumFaces - _number_of_triangles;
+
+	auto& _indices = _w_mesh->indices.get_vector();
+	_indices.resize(_number_of_triangles * 3);
+	size_t _index = 0;
+	for (size_t f = 0; f < pMesh->mNumFaces; ++f)
+	{
+		auto& _face = pMesh->mFaces[f];
+		if (_face.mNumIndices != 3) continue;
+
+		_indices[_index++] = _face.mIndices[0];
+		_indices[_index++] = _face.mIndices[1];
+		_indices[_index++] = _face.mIndices[2];
+	}
+
+	return _w_mesh;
+}
+
 static void _iterate_node(
 	_In_ const aiNode* pRootNode,
 	_In_ const aiNode* pNode,
@@ -110,7 +221,7 @@ static W_RESULT _generate_simpolygon_lod(
 	auto _mesh_name = pMesh->name;
 	auto _current_dir = wolf::system::io::get_current_directory();
 	auto _obj_path = _current_dir + pMesh->name + ".obj";
-	content_pipeline::wavefront::obj::write(pMesh->vertices, pMesh->indices, _obj_path);
+	content_pipeline::wavefront::obj::write(pMesh->vertices.get_vector(), pMesh->indices.get_vector(), _obj_path);
 	
 	//Create a original simplygon scene from exported obj
 	auto _original_scene = simplygon::iSimplygonSDK->CreateScene();
@@ -201,8 +312,8 @@ static W_RESULT _generate_simpolygon_lod(
 	W_RESULT __hr = W_PASSED;
 
 	if (wavefront::obj::read(
-		pMesh->lod_1_vertices,
-		pMesh->lod_1_indices,
+		pMesh->lod_1_vertices.get_vector(),
+		pMesh->lod_1_indices.get_vector(),
 		_obj_lod_path))
 	{
 		__hr = W_FAILED;
@@ -254,36 +365,24 @@ w_cpipeline_scene* w_assimp::load(_In_z_ const std::wstring& pAssetPath,
 #ifdef __WIN32
                                   ,_In_ const bool& pGenerateLODUsingSimplygon
 #endif
+                                  ,_In_opt_ w_thread_pool* pThreadPool
+                                  ,_Out_opt_ w_assimp_stats* pStats
 )
 {
 	Assimp::Importer _assimp_importer;
 
-	// Flags for loading the mesh
-	static const int _assimp_flags =
-		aiProcess_ValidateDataStructure			// perform a full validation of the loader's output
-		| aiProcess_Triangulate					// triangulate polygons with more than 3 edges
-		| aiProcess_ImproveCacheLocality		// improve the cache locality of the output vertices
-		| aiProcess_RemoveRedundantMaterials	// remove redundant materials
-		| aiProcess_FindDegenerates				// remove degenerated polygons from the import
-		| aiProcess_FindInvalidData				// detect invalid model data, such as invalid normal vectors
-		| aiProcess_OptimizeMeshes				// join small meshes, if possible
-		| aiProcess_GenSmoothNormals			// generate smooth normals if needed
-		| aiProcess_CalcTangentSpace			// calculate tangant and bitangent when normal presented
-		| aiProcess_FindInstances				// duplicate meshes 
-		| aiProcess_SplitLargeMeshes			// split large, unrenderable meshes into submeshes
-		| aiProcess_MakeLeftHanded				// make left hand coordinate system
-    ;
-    
+	auto _load_start = std::chrono::steady_clock::now();
+	double _read_seconds = 0, _convert_seconds = 0;
+	size_t _vertices_count = 0, _indices_count = 0;
+
 	//first read 3d model file
 	auto _path = wolf::system::convert::wstring_to_string(pAssetPath);
-	auto _scene = _assimp_importer.ReadFile(_path.c_str(), _assimp_flags);
+	auto _scene = _assimp_importer.ReadFile(_path.c_str(), s_assimp_flags);
+	_read_seconds = s_get_seconds(_load_start);
 	if (_scene)
 	{
-        if (!_scene->mRootNode || !_scene->mRootNode->mNumChildren)
-        {
-            delete _scene;
-            return nullptr;
-        }
+        //the scene is owned by importer
+        if (!_scene->mRootNode || !_scene->mRootNode->mNumChildren) return nullptr;
         
 		//convert scene model
 		auto _scene_name = wolf::system::io::get_file_name(_path);
@@ -344,133 +443,65 @@ w_cpipeline_scene* w_assimp::load(_In_z_ const std::wstring& pAssetPath,
 //
 //        }
         
-        //load model meshes
-        std::vector<w_cpipeline_mesh*> _model_meshes;
-        
-		//std::vector<float> _vertices_positions;//we will use it for amd tootle
-		if (_scene->HasMeshes())
+        //load model meshes, each mesh is converted by one task into its own slot, so the result does not depend on scheduling
+		auto _convert_start = std::chrono::steady_clock::now();
+
+		const size_t _number_of_meshes = _scene->HasMeshes() ? _scene->mNumMeshes : 0;
+		std::vector<w_cpipeline_mesh*> _converted_meshes(_number_of_meshes, nullptr);
+		std::vector<w_assimp_mesh_report> _reports(_number_of_meshes);
+
+		auto _convert = [&](const size_t& pBegin, const size_t& pEnd)
 		{
-			for (size_t i = 0; i < _scene->mNumMeshes; ++i)
+			for (auto i = pBegin; i < pEnd; ++i)
 			{
-				//clear vertex positions
-				//_vertices_positions.clear();
-
-				//get each assimp meshe
 				auto _a_mesh = _scene->mMeshes[i];
 				if (_a_mesh)
 				{
-					glm::vec3 _min_vertex;
-					glm::vec3 _max_vertex;
-
-					//copy assimp mesh information to wolf mesh information
-					auto _w_mesh = new w_cpipeline_mesh();
-					for (size_t j = 0; j < _a_mesh->mNumVertices; ++j)
-					{
-						//create wolf vertex structure
-						w_vertex_struct _w_vertex;
-
-						//TODO: we need to support skinned model in next version
-
-						//modify vertices for right handed coordinate system
-						//if (_coordinate_system == w_coordinate_system::RIGHT_HANDED)
-						//{
-						//	if (_coordinate_system_up_vector.z == 1)
-						//	{
-						//		std::swap(_a_mesh->mVertices[j].z, _a_mesh->mVertices[j].y);
-						//		_a_mesh->mVertices[j].y *= -1;
-						//	}
-						//}
-
-						//does not have any vertex
-						if (!_a_mesh->mVertices)
-						{
-							logger.error("{} does have any vertex information", _scene_name);
-							break;
-						}
-
-						auto _pos = _a_mesh->mVertices[j];
-						_w_vertex.position[0] = _pos.x;
-						_w_vertex.position[1] = _pos.y;
-						_w_vertex.position[2] = _pos.z;
-
-						if (_a_mesh->mNormals)
-						{
-							//get normal
-							auto _normal = _a_mesh->mNormals[j];
-							_w_vertex.normal[0] = _normal.x;
-							_w_vertex.normal[1] = _normal.y;
-							_w_vertex.normal[2] = _normal.z;
-						}
-						else
-						{
-							logger.warning("{} does have any vertex information", _scene_name);
-						}
-
-						//copy mesh
-						if (_a_mesh->mTextureCoords && _a_mesh->mTextureCoords[0])
-						{
-							//get uv
-							auto _uv = _a_mesh->mTextureCoords[0][j];
-							_w_vertex.uv[0] = _uv.x;
-							_w_vertex.uv[1] = _uv.y;
-						}
-						else
-						{
-							logger.warning("{} does have any vertex information", _scene_name);
-						}
-
-						//add to vertices
-						_w_mesh->vertices.push_back(_w_vertex);
-
-						//if (pOptimizeMeshUsingAMDTootle)
-						//{
-						//	//store vertex positions
-						//	_vertices_positions.push_back(_w_vertex.position[0]);
-						//	_vertices_positions.push_back(_w_vertex.position[1]);
-						//	_vertices_positions.push_back(_w_vertex.position[2]);
-						//}
-
-						//check for minimum and maximum vertices for bounding boxes
-						_min_vertex.x = std::min(_w_vertex.position[0], _min_vertex.x);
-						_min_vertex.y = std::min(_w_vertex.position[1], _min_vertex.y);
-						_min_vertex.z = std::min(_w_vertex.position[2], _min_vertex.z);
-
-						_max_vertex.x = std::max(_w_vertex.position[0], _max_vertex.x);
-						_max_vertex.y = std::max(_w_vertex.position[1], _max_vertex.y);
-						_max_vertex.z = std::max(_w_vertex.position[2], _max_vertex.z);
-
-						if (_a_mesh->mMaterialIndex >= 0 &&
-							_a_mesh->mMaterialIndex < _texture_paths.size())
-						{
-							_w_mesh->textures_path = _texture_paths[_a_mesh->mMaterialIndex];
-						}
-					}
-
-					// generate indices
-					for (size_t f = 0; f < _a_mesh->mNumFaces; ++f)
-					{
-						for (size_t k = 0; k < 3; ++k)
-						{
-							_w_mesh->indices.push_back(_a_mesh->mFaces[f].mIndices[k]);
-						}
-					}
-
-					//copy min and max to bounding box
-					std::memcpy(&_w_mesh->bounding_box.min[0], &_min_vertex[0], 3 * sizeof(float));
-					std::memcpy(&_w_mesh->bounding_box.max[0], &_max_vertex[0], 3 * sizeof(float));
+					_converted_meshes[i] = s_convert_mesh(_a_mesh, _texture_paths, _reports[i]);
+				}
+			}
+		};
+		if (pThreadPool && pThreadPool->get_pool_size() && _number_of_meshes > 1)
+		{
+			pThreadPool->parallel_for(0, _number_of_meshes, _convert, 1);
+		}
+		else
+		{
+			_convert(0, _number_of_meshes);
+		}
 
-					//apply amd tootle to it
-					//if (pOptimizeMeshUsingAMDTootle)
-					//{
-						//amd::tootle::apply(_w_mesh->vertices, _vertices_positions, _w_mesh->indices);
-					//}
+		//report problems once per mesh and in order of meshes
+		std::vector<w_cpipeline_mesh*> _model_meshes;
+		_model_meshes.reserve(_number_of_meshes);
+		for (size_t i = 0; i < _number_of_meshes; ++i)
+		{
+			auto _w_mesh = _converted_meshes[i];
+			if (!_w_mesh) continue;
 
-					//add this mesh to others
-					_w_mesh->name = _a_mesh->mName.C_Str();
-					_model_meshes.push_back(_w_mesh);
-				}
+			auto& _report = _reports[i];
+			if (_report.has_no_vertices)
+			{
+				logger.error("mesh {} of {} does not have any vertex information", _w_mesh->name, _scene_name);
+			}
+			if (_report.has_no_normals || _report.has_no_uvs)
+			{
+				logger.warning("{} vertices of mesh {} of {} do not have{}{}",
+					_w_mesh->vertices.size(),
+					_w_mesh->name,
+					_scene_name,
+					_report.has_no_normals ? " normal" : "",
+					_report.has_no_uvs ? " uv" : "");
 			}
+			if (_report.skipped_faces)
+			{
+				logger.warning("{} faces of mesh {} of {} are not triangle and were skipped", _report.skipped_faces, _w_mesh->name, _scene_name);
+			}
+
+			_vertices_count += _w_mesh->vertices.size();
+			_indices_count += _w_mesh->indices.size();
+			_model_meshes.push_back(_w_mesh);
 		}
+		_convert_seconds = s_get_seconds(_convert_start);
 
         //finally iterate over all nodes to find models and instances, LODs and CHs
 		std::vector<w_cpipeline_model*> _LODs;
@@ -614,6 +645,16 @@ w_cpipeline_scene* w_assimp::load(_In_z_ const std::wstring& pAssetPath,
 		//_CHs.clear();
 		_models.clear();
 
+		if (pStats)
+		{
+			pStats->read_file = _read_seconds;
+			pStats->convert_meshes = _convert_seconds;
+			pStats->build_scene = s_get_seconds(_load_start) - _read_seconds - _convert_seconds;
+			pStats->meshes = _model_meshes.size();
+			pStats->vertices = _vertices_count;
+			pStats->indices = _indices_count;
+		}
+
 		//if (_bounds.size())
 		//{
 		//	//sort boundaries
@@ -633,3 +674,11 @@ w_cpipeline_scene* w_assimp::load(_In_z_ const std::wstring& pAssetPath,
 	return nullptr;
 }
 
+#pragma region Getters
+
+uint32_t w_assimp::get_import_flags()
+{
+	return static_cast<uint32_t>(s_assimp_flags);
+}
+
+#pragma endregion
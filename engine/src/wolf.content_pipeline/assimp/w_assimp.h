@@ -13,17 +13,52 @@
 #include "w_cpipeline_export.h"
 #include <w_cpipeline_scene.h>
 
+//increase it whenever output of w_assimp::load changes, build caches of imported assets are invalidated by it
+#define W_ASSIMP_IMPORT_VERSION 2
+
+namespace wolf
+{
+	namespace system
+	{
+		class w_thread_pool;
+	}
+}
+
 namespace assimp
 {
+	//time of each stage of load in seconds and size of imported geometry
+	struct w_assimp_stats
+	{
+		double		read_file = 0;
+		double		convert_meshes = 0;
+		double		build_scene = 0;
+		size_t		meshes = 0;
+		size_t		vertices = 0;
+		size_t		indices = 0;
+	};
+
 	struct w_assimp
 	{
 	public:
+		/*
+			import an asset with assimp and convert it to wolf scene
+			@param pThreadPool, meshes are converted in parallel on this pool, nullptr means the calling thread. The result is same in both cases
+			@param pStats, if it is not nullptr it will be filled with time of each stage
+			@return the scene, it must be released by caller
+		*/
 		WCP_EXP static wolf::content_pipeline::w_cpipeline_scene* load(_In_z_ const std::wstring& pAssetPath,
                                                                        _In_ const bool& pOptimizeMeshUsingAMDTootle
 #ifdef __WIN32
                                                                        ,_In_ const bool& pGenerateLODUsingSimplygon
 #endif
+                                                                       ,_In_opt_ wolf::system::w_thread_pool* pThreadPool = nullptr
+                                                                       ,_Out_opt_ w_assimp_stats* pStats = nullptr
                                                                        );
+
+#pragma region Getters
+		//returns post process flags of assimp which are used by load
+		WCP_EXP static uint32_t get_import_flags();
+#pragma endregion
 	};
 }
 
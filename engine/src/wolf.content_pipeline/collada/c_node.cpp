@@ -46,11 +46,9 @@ c_node* c_node::find_instanced_geomaetry_node(std::string pGeometryName)
 ULONG c_node::release()
 {
 	if (is_released) return 1;
-	
-	for (size_t i = 0; i < this->child_nodes.size(); ++i)
-	{
-		SAFE_RELEASE(this->child_nodes.at(i));
-	}
+	is_released = true;
+
+	//child nodes are allocated from the node pool of c_parser, so the parser frees them
 	this->child_nodes.clear();
 
 	return 0;
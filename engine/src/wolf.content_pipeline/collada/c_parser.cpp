@@ -588,7 +588,7 @@ void c_parser::_read_visual_scene_nodes(_In_ rapidxml::xml_node<>* pXNode, _Inou
         if (_name == "node")
         {
             //create node
-            auto _node = new c_node();
+            auto _node = this->_node_pool.allocate_new();
 
             //get collada attributes
             _get_collada_obj_attribute(_child, _node);
@@ -663,7 +663,7 @@ void c_parser::_get_node_data(_In_ rapidxml::xml_node<>* pXNode, _Inout_ c_node*
         else if (_name == "node")
         {
             //create node
-            auto _node = new c_node();
+            auto _node = this->_node_pool.allocate_new();
 
             //get collada attributes
             _get_collada_obj_attribute(_child, _node);
@@ -1846,9 +1846,22 @@ void c_parser::_clear_all_resources()
 	}
 	if (sNodes.size() > 0)
 	{
-		std::for_each(sNodes.begin(), sNodes.end(), [](c_node* pNode)
+		std::for_each(sNodes.begin(), sNodes.end(), [this](c_node* pNode)
 		{
-			pNode->release();
+			_release_node(pNode);
 		});
+		sNodes.clear();
 	}
 }
+
+void c_parser::_release_node(_In_ c_node* pNode)
+{
+	if (!pNode) return;
+
+	for (auto _child : pNode->child_nodes)
+	{
+		_release_node(_child);
+	}
+	pNode->release();
+	this->_node_pool.deallocate_delete(pNode);
+}
@@ -17,6 +17,7 @@
 #include "c_bone.h"
 #include "c_extra.h"
 #include "c_animation.h"
+#include <w_pool_allocator.h>
 
 namespace wolf
 {
@@ -27,7 +28,10 @@ namespace wolf
 			class c_parser
 			{
 			public:
-                c_parser() : sZ_Up(true) {}
+                c_parser() : sZ_Up(true), _node_pool("c_parser::c_node",
+                    W_POOL_ALLOCATOR_OBJECTS_PER_SEGMENT,
+                    W_POOL_ALLOCATOR_DEBUG_MODE,
+                    wolf::system::W_MEMORY_CATEGORY_CONTENT_PIPELINE) {}
 				virtual ~c_parser() {};
 
 				WCP_EXP W_RESULT parse_collada_from_file(
@@ -87,6 +91,7 @@ namespace wolf
                     _In_ const bool& pInvertNormals,
                     _In_ const bool& pFind_LODs_ConvexHulls_Boundaries);
 				void			                            _clear_all_resources();
+				void			                            _release_node(_In_ c_node* pNode);
 				
                 //static variables which are necessary for parsing collada file 
                 std::vector<c_bone*>			            sBones;
@@ -101,6 +106,8 @@ namespace wolf
                 c_xsi_extra					                sXSI_Extra;
                 rapidxml::xml_node<>*		                SGeometryLibraryNode;
                 bool                                        sZ_Up;
+                //nodes are allocated from this pool and freed by _clear_all_resources
+                wolf::system::w_pool_allocator<c_node>      _node_pool;
 			};
 		}
 	}
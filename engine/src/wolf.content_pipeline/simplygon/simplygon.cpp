@@ -329,7 +329,7 @@ exit_func:
 //	_In_ std::vector<uint32_t>& pIndicesData,
 //	_Inout_ CountedPointer<IScene>& pScene)
 //{
-//	const std::string _trace_info = "simplygon::create_obj_scene_from_data";
+//	const char* _trace_info = "simplygon::create_obj_scene_from_data";
 //
 //	using namespace wolf::content_pipeline;
 //
@@ -451,7 +451,7 @@ exit_func:
 //	_Inout_ std::vector<uint32_t>& pIndicesData,
 //	_In_ CountedPointer<IScene>& pScene)
 //{
-//	const std::string _trace_info = "simplygon::retrieve_data_from_obj_scene";
+//	const char* _trace_info = "simplygon::retrieve_data_from_obj_scene";
 //
 //	bool _error = false;
 //
@@ -13,12 +13,17 @@
 #include "w_cpipeline_export.h"
 #include <string>
 #include <w_io.h>
+#include <w_file_view.h>
+#include "w_cpipeline_wscene.h"
+#include "w_cpipeline_build_cache.h"
 //#include "collada/c_parser.h"
 //#include "w_cpipeline_scene.h"
 #include <msgpack.hpp>
 #include "simplygon/simplygon.h"
 #include <assimp/w_assimp.h>
 #include <w_compress.hpp>
+#include <w_compress_blocks.h>
+#include <w_memory_tracker.h>
 
 namespace wolf
 {
@@ -40,8 +45,12 @@ namespace wolf
 #ifdef __WIN32
                            , _In_ const bool& pGenerateLODUsingSimplygon = true
 #endif
+                           , _In_opt_ wolf::system::w_thread_pool* pThreadPool = nullptr
             )
 			{
+				//account memory pools which are allocated while loading to content pipeline
+				wolf::system::w_memory_tag_scope _memory_tag(wolf::system::W_MEMORY_CATEGORY_CONTENT_PIPELINE);
+
 #if defined(__WIN32) || defined(__UWP)
 				auto _file_exists = wolf::system::io::get_is_fileW(pAssetPath.c_str());
 #else
@@ -69,7 +78,7 @@ namespace wolf
 						auto _hr = load_wolf_scenes_from_file(_scenes, pAssetPath);
 						if (_hr == W_PASSED && _scenes.size())
 						{
-							//make a deep copy from first element
+							//make a copy from first element, geometry of .wscene v2 is shared with the mapping of file
 							auto _scene = new w_cpipeline_scene(_scenes[0]);
 							_scenes.clear();
 							return _scene;
@@ -78,21 +87,65 @@ namespace wolf
 					}
 					else
 					{
-						return assimp::w_assimp::load(
+						//reuse the imported scene of build cache if source and import flags were not changed
+						uint64_t _key = 0;
+						auto _build_cache = get_build_cache();
+						if (_build_cache)
+						{
+							uint64_t _import_flags = assimp::w_assimp::get_import_flags();
+							if (pOptimizeMeshUsingAMDTootle) _import_flags |= 1ull << 32;
+#ifdef __WIN32
+							if (pGenerateLODUsingSimplygon) _import_flags |= 1ull << 33;
+#endif
+							if (_build_cache->get_key(wolf::system::convert::wstring_to_string(pAssetPath), _import_flags, _key) == W_FAILED)
+							{
+								_build_cache = nullptr;
+							}
+						}
+						if (_build_cache)
+						{
+							std::vector<w_cpipeline_scene> _scenes;
+							if (_build_cache->load(_key, _scenes, pThreadPool) == W_PASSED && _scenes.size())
+							{
+								auto _scene = new w_cpipeline_scene(_scenes[0]);
+								_scenes.clear();
+								return _scene;
+							}
+						}
+
+						auto _scene = assimp::w_assimp::load(
 							pAssetPath,
 							pOptimizeMeshUsingAMDTootle
 #ifdef __WIN32
 							, pGenerateLODUsingSimplygon
 #endif
+							, pThreadPool
 						);
+						if (_scene && _build_cache)
+						{
+							std::vector<w_cpipeline_scene> _scenes = { *_scene };
+							if (_build_cache->store(_key, _scenes, pThreadPool) == W_FAILED)
+							{
+								logger.warning(L"could not store {} in build cache", pAssetPath);
+							}
+							_scenes.clear();
+						}
+						return _scene;
 					}
 				}
 				logger.error(L"Type not supported for {}", pAssetPath);
 				return nullptr;
 			}
 
+			/*
+				pack scenes and compress them
+				@param pThreadPool, if it is not nullptr scenes will be compressed as block container on pool
+				@param pBlocksConfig, configuration of block container, e.g. use hc_level for offline builds
+			*/
 			static W_RESULT save_wolf_scenes_to_memory(_In_ std::vector<w_cpipeline_scene>& pScenePacks, 
-				_Inout_ w_compress_result& pWolfScenePacked)
+				_Inout_ w_compress_result& pWolfScenePacked,
+				_In_opt_ wolf::system::w_thread_pool* pThreadPool = nullptr,
+				_In_ const wolf::system::w_compress_blocks_config& pBlocksConfig = wolf::system::w_compress_blocks_config())
 			{
 				using namespace wolf::system;
 
@@ -102,7 +155,9 @@ namespace wolf
 				
 				std::string _str = _sbuffer.str();
 				pWolfScenePacked.size_in = _str.size();
-				auto _hr = w_compress::compress_buffer(_str.c_str(), &pWolfScenePacked);
+				auto _hr = pThreadPool ?
+					w_compress_blocks::compress(_str.c_str(), &pWolfScenePacked, pBlocksConfig, pThreadPool) :
+					w_compress::compress_buffer(_str.c_str(), &pWolfScenePacked);
 				if (_hr != W_PASSED)
 				{
 					logger.error("error happened while compressing scenes");
@@ -121,7 +176,9 @@ namespace wolf
 				return _hr;
 			}
 
-			static W_RESULT save_wolf_scenes_to_file(_In_ std::vector<w_cpipeline_scene>& pScenePacks, _In_z_ std::wstring pWolfSceneFilePath)
+			static W_RESULT save_wolf_scenes_to_file(_In_ std::vector<w_cpipeline_scene>& pScenePacks, _In_z_ std::wstring pWolfSceneFilePath,
+				_In_opt_ wolf::system::w_thread_pool* pThreadPool = nullptr,
+				_In_ const wolf::system::w_compress_blocks_config& pBlocksConfig = wolf::system::w_compress_blocks_config())
 			{
 #if defined(__WIN32) || defined(__UWP)
 				auto _path = pWolfSceneFilePath;
@@ -129,8 +186,8 @@ namespace wolf
 				auto _path = wolf::system::convert::wstring_to_string(pWolfSceneFilePath);
 #endif
 
-				w_compress_result _wolf_scene_packed;
-				if (save_wolf_scenes_to_memory(pScenePacks, _wolf_scene_packed) == W_PASSED)
+				w_compress_result _wolf_scene_packed = {};
+				if (save_wolf_scenes_to_memory(pScenePacks, _wolf_scene_packed, pThreadPool, pBlocksConfig) == W_PASSED)
 				{
 					if (_wolf_scene_packed.data && _wolf_scene_packed.size_out)
 					{
@@ -166,17 +223,52 @@ namespace wolf
 				return W_FAILED;
 			}
 
-			static W_RESULT load_wolf_scenes_from_memory(_In_z_ std::string pWolfScenePacked, _Inout_ std::vector<w_cpipeline_scene>& pScenePacks)
+			/*
+				save scenes as .wscene v2, which will be mapped and used in place by load_wolf_scenes_from_file
+				@param pConfig, configuration of chunks, compressed chunks are smaller but will be decompressed on load
+				@param pThreadPool, if it is not nullptr chunks will be compressed on pool
+			*/
+			static W_RESULT save_wolf_scenes_to_file(_In_ std::vector<w_cpipeline_scene>& pScenePacks, _In_z_ std::wstring pWolfSceneFilePath,
+				_In_ const w_cpipeline_wscene_config& pConfig,
+				_In_opt_ wolf::system::w_thread_pool* pThreadPool = nullptr)
+			{
+				auto _path = wolf::system::convert::wstring_to_string(pWolfSceneFilePath);
+				auto _hr = w_cpipeline_wscene::save_to_file(pScenePacks, _path, pConfig, pThreadPool);
+				if (_hr == W_FAILED)
+				{
+					logger.error("Error on saving wolf scene file on following path: {}", _path);
+				}
+				return _hr;
+			}
+
+			//load scenes which were saved by save_wolf_scenes_to_memory or .wscene v2, compressed blocks and chunks are decompressed on pThreadPool
+			static W_RESULT load_wolf_scenes_from_memory(_In_ const char* pWolfScenePacked, _In_ const size_t& pSize,
+				_Inout_ std::vector<w_cpipeline_scene>& pScenePacks, _In_opt_ wolf::system::w_thread_pool* pThreadPool = nullptr)
 			{
 				using namespace wolf::system;
 
+				if (!pWolfScenePacked || !pSize) return W_FAILED;
+
+				if (w_cpipeline_wscene::get_is_wscene(reinterpret_cast<const uint8_t*>(pWolfScenePacked), pSize))
+				{
+					//without owner geometry is copied from buffer, so it will not be modified
+					return w_cpipeline_wscene::load_from_memory(
+						reinterpret_cast<uint8_t*>(const_cast<char*>(pWolfScenePacked)),
+						pSize,
+						nullptr,
+						pScenePacks,
+						pThreadPool);
+				}
+
 				//decompress it, then unpack it
-				w_compress_result _decompress_result;
-				_decompress_result.size_in = pWolfScenePacked.size(); //1 for '\0'
-				auto _hr = w_compress::decompress_buffer(pWolfScenePacked.c_str(), &_decompress_result);
+				w_compress_result _decompress_result = {};
+				_decompress_result.size_in = pSize;
+				auto _hr = w_compress_blocks::get_is_block_container(pWolfScenePacked, pSize) ?
+					w_compress_blocks::decompress(pWolfScenePacked, &_decompress_result, pThreadPool) :
+					w_compress::decompress_buffer(pWolfScenePacked, &_decompress_result);
 				if (_hr == W_RESULT::W_PASSED)
 				{
-					auto _msg = msgpack::unpack(_decompress_result.data, _decompress_result.size_out + 1);
+					auto _msg = msgpack::unpack(_decompress_result.data, _decompress_result.size_out);
 					_msg.get().convert(pScenePacks);
 				}
 				else
@@ -191,33 +283,43 @@ namespace wolf
 				return _hr;
 			}
 
-			static W_RESULT load_wolf_scenes_from_file(_In_ std::vector<w_cpipeline_scene>& pScenePacks, _In_z_ std::wstring pWolfSceneFilePath)
+			static W_RESULT load_wolf_scenes_from_memory(_In_z_ const std::string& pWolfScenePacked, _Inout_ std::vector<w_cpipeline_scene>& pScenePacks,
+				_In_opt_ wolf::system::w_thread_pool* pThreadPool = nullptr)
+			{
+				return load_wolf_scenes_from_memory(pWolfScenePacked.data(), pWolfScenePacked.size(), pScenePacks, pThreadPool);
+			}
+
+			/*
+				the file is mapped and never copied into an intermediate buffer.
+				Meshes of .wscene v2 are views into the mapping, which is mapped as copy on write and released with the last mesh
+			*/
+			static W_RESULT load_wolf_scenes_from_file(_In_ std::vector<w_cpipeline_scene>& pScenePacks, _In_z_ std::wstring pWolfSceneFilePath,
+				_In_opt_ wolf::system::w_thread_pool* pThreadPool = nullptr)
 
 			{
+				using namespace wolf::system;
+
 #if defined(__WIN32) || defined(__UWP)
 				auto _path = pWolfSceneFilePath;
 #else
 				auto _path = wolf::system::convert::wstring_to_string(pWolfSceneFilePath);
 #endif
-				std::ifstream _file(_path, std::ios::in | std::ios::binary);
-				if (!_file || _file.bad())
+				auto _file = std::make_shared<w_file_view>();
+				if (_file->open(_path.c_str(), W_FILE_VIEW_SEQUENTIAL, true) == W_FAILED)
 				{
 #if defined(__WIN32) || defined(__UWP)
 					logger.error(L"Error on opening wolf scene file from following path: {}", _path);
 #else
 					logger.error("Error on opening wolf scene file from following path: {}", _path);
 #endif
-					_file.close();
 					return W_FAILED;
 				}
-				std::string _str((std::istreambuf_iterator<char>(_file)),
-					std::istreambuf_iterator<char>());
-
-				auto _hr = load_wolf_scenes_from_memory(_str, pScenePacks);
-
-				_file.close();
 
-				return _hr;
+				if (w_cpipeline_wscene::get_is_wscene(_file->get_data(), _file->get_size()))
+				{
+					return w_cpipeline_wscene::load_from_memory(_file->get_writable_data(), _file->get_size(), _file, pScenePacks, pThreadPool);
+				}
+				return load_wolf_scenes_from_memory(reinterpret_cast<const char*>(_file->get_data()), _file->get_size(), pScenePacks, pThreadPool);
 			}
 
 			static void release()
@@ -225,7 +327,30 @@ namespace wolf
 #ifdef __WIN32
 				simplygon::release();
 #endif
+				set_build_cache(nullptr);
             }
+
+#pragma region Getters
+			static w_cpipeline_build_cache* get_build_cache()
+			{
+				return _build_cache();
+			}
+#pragma endregion
+
+#pragma region Setters
+			//imported assets are stored in and loaded from this cache, nullptr disables it. The cache must be alive while loading
+			static void set_build_cache(_In_opt_ w_cpipeline_build_cache* pBuildCache)
+			{
+				_build_cache() = pBuildCache;
+			}
+#pragma endregion
+
+		private:
+			static w_cpipeline_build_cache*& _build_cache()
+			{
+				static w_cpipeline_build_cache* _cache = nullptr;
+				return _cache;
+			}
 		};
 	}
 }
@@ -0,0 +1,505 @@
+#include "w_cpipeline_pch.h"
+#include "w_cpipeline_build_cache.h"
+#include "assimp/w_assimp.h"
+#include <w_file_view.h>
+#include <w_io.h>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+#include <sys/stat.h>
+
+#if defined(__WIN32) || defined(__UWP)
+#include <sys/utime.h>
+#else
+#include <utime.h>
+#endif
+
+//include xxhash as static functions, so it is not exported twice
+#define XXH_PRIVATE_API
+#include <lz4/xxhash.h>
+
+using namespace wolf::system;
+
+namespace wolf
+{
+	namespace content_pipeline
+	{
+        static const char* W_BUILD_CACHE_EXTENSION = ".wscene";
+        static const char* W_BUILD_CACHE_TEMP_EXTENSION = ".tmp";
+        //16 hex digits of key
+        static const size_t W_BUILD_CACHE_KEY_LENGTH = 16;
+
+        struct w_build_cache_file
+        {
+            std::string     path;
+            uint64_t        size;
+            int64_t         last_write_time;
+        };
+
+        static bool s_get_file_stat(_In_z_ const std::string& pPath, _Out_ uint64_t& pSize, _Out_ int64_t& pLastWriteTime)
+        {
+#if defined(__WIN32) || defined(__UWP)
+            struct _stat64 _stat;
+            if (_stat64(pPath.c_str(), &_stat) != 0) return false;
+#else
+            struct stat _stat;
+            if (stat(pPath.c_str(), &_stat) != 0) return false;
+#endif
+            pSize = static_cast<uint64_t>(_stat.st_size);
+            pLastWriteTime = static_cast<int64_t>(_stat.st_mtime);
+            return true;
+        }
+
+        //path of cached file of key inside cache directory
+        static std::string s_get_file_path(_In_z_ const std::string& pPath, _In_ const uint64_t& pKey)
+        {
+            char _key[W_BUILD_CACHE_KEY_LENGTH + 1];
+            std::snprintf(_key, sizeof(_key), "%016llx", static_cast<unsigned long long>(pKey));
+            return pPath + "/" + _key + W_BUILD_CACHE_EXTENSION;
+        }
+
+        //mark file as recently used
+        static void s_touch_file(_In_z_ const std::string& pPath)
+        {
+#if defined(__WIN32) || defined(__UWP)
+            _utime(pPath.c_str(), nullptr);
+#else
+            utime(pPath.c_str(), nullptr);
+#endif
+        }
+
+        static bool s_has_suffix(_In_z_ const std::string& pValue, _In_z_ const char* pSuffix)
+        {
+            auto _length = std::strlen(pSuffix);
+            return pValue.size() >= _length && pValue.compare(pValue.size() - _length, _length, pSuffix) == 0;
+        }
+
+        //returns true if name is <16 hex digits>.wscene
+        static bool s_get_is_cache_file_name(_In_z_ const std::string& pName)
+        {
+            if (pName.size() != W_BUILD_CACHE_KEY_LENGTH + std::strlen(W_BUILD_CACHE_EXTENSION) ||
+                !s_has_suffix(pName, W_BUILD_CACHE_EXTENSION)) return false;
+
+            for (size_t i = 0; i < W_BUILD_CACHE_KEY_LENGTH; ++i)
+            {
+                if (!std::isxdigit(static_cast<unsigned char>(pName[i]))) return false;
+            }
+            return true;
+        }
+
+        //find names of material libraries of a wavefront .obj
+        static void s_get_obj_dependencies(_In_ const uint8_t* pData, _In_ const size_t& pSize, _Inout_ std::vector<std::string>& pDependencies)
+        {
+            static const char _mtllib[] = "mtllib";
+            const auto _mtllib_length = sizeof(_mtllib) - 1;
+
+            auto _text = reinterpret_cast<const char*>(pData);
+            size_t _pos = 0;
+            while (_pos < pSize)
+            {
+                auto _line_end = static_cast<const char*>(std::memchr(_text + _pos, '\n', pSize - _pos));
+                size_t _end = _line_end ? static_cast<size_t>(_line_end - _text) : pSize;
+
+                while (_pos < _end && (_text[_pos] == ' ' || _text[_pos] == '\t')) _pos++;
+                if (_end - _pos > _mtllib_length &&
+                    std::memcmp(_text + _pos, _mtllib, _mtllib_length) == 0 &&
+                    (_text[_pos + _mtllib_length] == ' ' || _text[_pos + _mtllib_length] == '\t'))
+                {
+                    //the rest of line is a list of file names
+                    _pos += _mtllib_length;
+                    while (_pos < _end)
+                    {
+                        while (_pos < _end && std::isspace(static_cast<unsigned char>(_text[_pos]))) _pos++;
+                        auto _begin = _pos;
+                        while (_pos < _end && !std::isspace(static_cast<unsigned char>(_text[_pos]))) _pos++;
+                        if (_pos > _begin)
+                        {
+                            pDependencies.push_back(std::string(_text + _begin, _pos - _begin));
+                        }
+                    }
+                }
+                _pos = _end + 1;
+            }
+        }
+
+        class w_cpipeline_build_cache_pimp
+        {
+        public:
+            w_cpipeline_build_cache_pimp() :
+                _name("w_cpipeline_build_cache"),
+                _temp_counter(0)
+            {
+            }
+
+            ~w_cpipeline_build_cache_pimp()
+            {
+                release();
+            }
+
+            W_RESULT initialize(_In_ const w_cpipeline_build_cache_config& pConfig)
+            {
+                const char* _trace_info = "w_cpipeline_build_cache::initialize";
+
+                if (pConfig.path.empty())
+                {
+                    W_V(W_FAILED, w_log_type::W_ERROR, "path of {} is empty. trace info: {}", this->_name, _trace_info);
+                    return W_FAILED;
+                }
+
+                auto _path = pConfig.path;
+                while (_path.size() > 1 && (_path.back() == '/' || _path.back() == '\\'))
+                {
+                    _path.pop_back();
+                }
+
+                {
+                    std::lock_guard<std::mutex> _lock(this->_mutex);
+
+                    this->_config = pConfig;
+                    this->_config.path = _path;
+                    this->_stats = w_cpipeline_build_cache_stats();
+                }
+
+                if (io::get_is_directory(_path.c_str()) == W_FAILED &&
+                    io::create_directory(_path.c_str()) == W_FAILED)
+                {
+                    W_V(W_FAILED, w_log_type::W_ERROR, "could not create directory {}. trace info: {}", _path, _trace_info);
+                    return W_FAILED;
+                }
+
+                return evict();
+            }
+
+            W_RESULT get_key(_In_z_ const std::string& pSourcePath, _In_ const uint64_t& pImportFlags, _Out_ uint64_t& pKey)
+            {
+                const char* _trace_info = "w_cpipeline_build_cache::get_key";
+
+                pKey = 0;
+                auto _start = std::chrono::steady_clock::now();
+
+                w_file_view _source;
+                if (_source.open(pSourcePath.c_str()) == W_FAILED)
+                {
+                    W_V(W_FAILED, w_log_type::W_ERROR, "could not open source {}. trace info: {}", pSourcePath, _trace_info);
+                    return W_FAILED;
+                }
+
+                const auto _wscene_config = _get_config().wscene;
+
+                XXH64_state_t _state;
+                XXH64_reset(&_state, 0);
+
+                //output depends on version of importer, layout of vertices, vertex format of cached file and name of source which becomes name of scene
+                const uint64_t _version[] =
+                {
+                    W_ASSIMP_IMPORT_VERSION,
+                    sizeof(w_vertex_struct),
+                    sizeof(w_vertex_struct_packed),
+                    static_cast<uint64_t>(_wscene_config.pack_vertices) |
+                        (static_cast<uint64_t>(_wscene_config.keep_vertices) << 1) |
+                        (static_cast<uint64_t>(_wscene_config.split_vertices) << 2),
+                    pImportFlags,
+                    _source.get_size()
+                };
+                XXH64_update(&_state, _version, sizeof(_version));
+
+                auto _file_name = io::get_file_name(pSourcePath);
+                XXH64_update(&_state, _file_name.data(), _file_name.size());
+                if (_source.get_size())
+                {
+                    XXH64_update(&_state, _source.get_data(), _source.get_size());
+                }
+
+                //materials of .obj are stored in other files
+                auto _extension = io::get_file_extention(pSourcePath);
+                std::transform(_extension.begin(), _extension.end(), _extension.begin(), ::tolower);
+                if (_extension == ".obj")
+                {
+                    std::vector<std::string> _dependencies;
+                    s_get_obj_dependencies(_source.get_data(), _source.get_size(), _dependencies);
+
+                    auto _directory = io::get_parent_directory(pSourcePath);
+                    for (auto& _dependency : _dependencies)
+                    {
+                        XXH64_update(&_state, _dependency.data(), _dependency.size());
+
+                        //missing materials are ignored by importer, so they change the key but do not fail
+                        w_file_view _file;
+                        auto _dependency_path = _directory.empty() ? _dependency : _directory + "/" + _dependency;
+                        if (io::get_is_file(_dependency_path.c_str()) == W_PASSED &&
+                            _file.open(_dependency_path.c_str()) == W_PASSED && _file.get_size())
+                        {
+                            XXH64_update(&_state, _file.get_data(), _file.get_size());
+                        }
+                    }
+                }
+                _source.release();
+
+                pKey = XXH64_digest(&_state);
+
+                std::lock_guard<std::mutex> _lock(this->_mutex);
+                this->_stats.hash_seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - _start).count();
+
+                return W_PASSED;
+            }
+
+            W_RESULT load(_In_ const uint64_t& pKey, _Inout_ std::vector<w_cpipeline_scene>& pScenes, _In_opt_ w_thread_pool* pThreadPool)
+            {
+                const auto _config = _get_config();
+                auto _path = s_get_file_path(_config.path, pKey);
+                if (_config.path.empty() || io::get_is_file(_path.c_str()) == W_FAILED)
+                {
+                    std::lock_guard<std::mutex> _lock(this->_mutex);
+                    this->_stats.misses++;
+                    return W_FAILED;
+                }
+
+                std::vector<w_cpipeline_scene> _scenes;
+                if (w_cpipeline_wscene::load_from_file(_path, _scenes, pThreadPool) == W_FAILED)
+                {
+                    //file is corrupted or was written by an older version, so it will be replaced
+                    logger.warning("cached file {} could not be loaded and will be removed", _path);
+                    io::delete_file(_path.c_str());
+
+                    std::lock_guard<std::mutex> _lock(this->_mutex);
+                    this->_stats.misses++;
+                    return W_FAILED;
+                }
+                s_touch_file(_path);
+                pScenes.insert(pScenes.end(), _scenes.begin(), _scenes.end());
+
+                std::lock_guard<std::mutex> _lock(this->_mutex);
+                this->_stats.hits++;
+                return W_PASSED;
+            }
+
+            W_RESULT store(_In_ const uint64_t& pKey, _Inout_ std::vector<w_cpipeline_scene>& pScenes, _In_opt_ w_thread_pool* pThreadPool)
+            {
+                const char* _trace_info = "w_cpipeline_build_cache::store";
+
+                const auto _config = _get_config();
+                if (_config.path.empty()) return W_FAILED;
+
+                //write to a temporary file first, so readers never map a partially written file
+                auto _path = s_get_file_path(_config.path, pKey);
+                auto _temp_path = _path + "." +
+                    std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + "." +
+                    std::to_string(this->_temp_counter++) + W_BUILD_CACHE_TEMP_EXTENSION;
+
+                if (w_cpipeline_wscene::save_to_file(pScenes, _temp_path, _config.wscene, pThreadPool) == W_FAILED)
+                {
+                    io::delete_file(_temp_path.c_str());
+                    return W_FAILED;
+                }
+
+#if defined(__WIN32) || defined(__UWP)
+                //rename does not replace an existing file on windows
+                io::delete_file(_path.c_str());
+#endif
+                if (std::rename(_temp_path.c_str(), _path.c_str()) != 0)
+                {
+                    io::delete_file(_temp_path.c_str());
+                    W_V(W_FAILED, w_log_type::W_ERROR, "could not rename {} to {}. trace info: {}", _temp_path, _path, _trace_info);
+                    return W_FAILED;
+                }
+
+                {
+                    std::lock_guard<std::mutex> _lock(this->_mutex);
+                    this->_stats.stores++;
+                }
+
+                return evict();
+            }
+
+            W_RESULT evict()
+            {
+                std::lock_guard<std::mutex> _lock(this->_mutex);
+
+                if (this->_config.path.empty()) return W_FAILED;
+                if (!this->_config.max_size_in_bytes) return W_PASSED;
+
+                std::vector<w_build_cache_file> _files;
+                uint64_t _total_size = 0;
+                _get_files(_files, _total_size);
+                if (_total_size <= this->_config.max_size_in_bytes) return W_PASSED;
+
+                //least recently used first, names make the order deterministic for files of same time
+                std::sort(_files.begin(), _files.end(), [](_In_ const w_build_cache_file& pLeft, _In_ const w_build_cache_file& pRight)
+                {
+                    if (pLeft.last_write_time != pRight.last_write_time) return pLeft.last_write_time < pRight.last_write_time;
+                    return pLeft.path < pRight.path;
+                });
+
+                for (auto& _file : _files)
+                {
+                    if (_total_size <= this->_config.max_size_in_bytes) break;
+
+                    //files which are mapped on windows can not be removed, they will be evicted next time
+                    if (io::delete_file(_file.path.c_str()) == 0)
+                    {
+                        _total_size -= _file.size;
+                        this->_stats.evictions++;
+                        this->_stats.evicted_bytes += _file.size;
+                    }
+                }
+
+                return W_PASSED;
+            }
+
+            W_RESULT clear()
+            {
+                std::lock_guard<std::mutex> _lock(this->_mutex);
+
+                if (this->_config.path.empty()) return W_FAILED;
+
+                auto _hr = W_PASSED;
+                std::vector<std::string> _names;
+                io::get_files_folders_in_directory(this->_config.path, _names);
+                for (auto& _name : _names)
+                {
+                    if (s_get_is_cache_file_name(_name) || s_has_suffix(_name, W_BUILD_CACHE_TEMP_EXTENSION))
+                    {
+                        if (io::delete_file((this->_config.path + "/" + _name).c_str()) != 0)
+                        {
+                            _hr = W_FAILED;
+                        }
+                    }
+                }
+                return _hr;
+            }
+
+            ULONG release()
+            {
+                std::lock_guard<std::mutex> _lock(this->_mutex);
+                this->_config = w_cpipeline_build_cache_config();
+                return 0;
+            }
+
+#pragma region Getters
+            w_cpipeline_build_cache_stats get_stats()
+            {
+                std::lock_guard<std::mutex> _lock(this->_mutex);
+                return this->_stats;
+            }
+
+            std::string get_file_path(_In_ const uint64_t& pKey)
+            {
+                return s_get_file_path(_get_config().path, pKey);
+            }
+#pragma endregion
+
+        private:
+            //copy of config, so it can be used without holding the lock during I/O
+            w_cpipeline_build_cache_config _get_config()
+            {
+                std::lock_guard<std::mutex> _lock(this->_mutex);
+                return this->_config;
+            }
+
+            //get cached files, it must be called under lock
+            void _get_files(_Inout_ std::vector<w_build_cache_file>& pFiles, _Inout_ uint64_t& pTotalSize)
+            {
+                std::vector<std::string> _names;
+                io::get_files_folders_in_directory(this->_config.path, _names);
+                for (auto& _name : _names)
+                {
+                    if (!s_get_is_cache_file_name(_name)) continue;
+
+                    w_build_cache_file _file;
+                    _file.path = this->_config.path + "/" + _name;
+                    if (s_get_file_stat(_file.path, _file.size, _file.last_write_time))
+                    {
+                        pTotalSize += _file.size;
+                        pFiles.push_back(_file);
+                    }
+                }
+            }
+
+            std::string                             _name;
+            w_cpipeline_build_cache_config          _config;
+            w_cpipeline_build_cache_stats           _stats;
+            std::atomic<uint64_t>                   _temp_counter;
+            std::mutex                              _mutex;
+        };
+	}
+}
+
+using namespace wolf::content_pipeline;
+
+w_cpipeline_build_cache::w_cpipeline_build_cache() :
+    _pimp(new w_cpipeline_build_cache_pimp())
+{
+}
+
+w_cpipeline_build_cache::~w_cpipeline_build_cache()
+{
+    delete this->_pimp;
+    this->_pimp = nullptr;
+}
+
+W_RESULT w_cpipeline_build_cache::initialize(_In_ const w_cpipeline_build_cache_config& pConfig)
+{
+    if (!this->_pimp) return W_FAILED;
+    return this->_pimp->initialize(pConfig);
+}
+
+W_RESULT w_cpipeline_build_cache::get_key(_In_z_ const std::string& pSourcePath, _In_ const uint64_t& pImportFlags, _Out_ uint64_t& pKey)
+{
+    pKey = 0;
+    if (!this->_pimp) return W_FAILED;
+    return this->_pimp->get_key(pSourcePath, pImportFlags, pKey);
+}
+
+W_RESULT w_cpipeline_build_cache::load(
+    _In_        const uint64_t& pKey,
+    _Inout_     std::vector<w_cpipeline_scene>& pScenes,
+    _In_opt_    w_thread_pool* pThreadPool)
+{
+    if (!this->_pimp) return W_FAILED;
+    return this->_pimp->load(pKey, pScenes, pThreadPool);
+}
+
+W_RESULT w_cpipeline_build_cache::store(
+    _In_        const uint64_t& pKey,
+    _Inout_     std::vector<w_cpipeline_scene>& pScenes,
+    _In_opt_    w_thread_pool* pThreadPool)
+{
+    if (!this->_pimp) return W_FAILED;
+    return this->_pimp->store(pKey, pScenes, pThreadPool);
+}
+
+W_RESULT w_cpipeline_build_cache::evict()
+{
+    if (!this->_pimp) return W_FAILED;
+    return this->_pimp->evict();
+}
+
+W_RESULT w_cpipeline_build_cache::clear()
+{
+    if (!this->_pimp) return W_FAILED;
+    return this->_pimp->clear();
+}
+
+ULONG w_cpipeline_build_cache::release()
+{
+    if (!this->_pimp) return 1;
+    return this->_pimp->release();
+}
+
+#pragma region Getters
+
+w_cpipeline_build_cache_stats w_cpipeline_build_cache::get_stats() const
+{
+    if (!this->_pimp) return w_cpipeline_build_cache_stats();
+    return this->_pimp->get_stats();
+}
+
+std::string w_cpipeline_build_cache::get_file_path(_In_ const uint64_t& pKey) const
+{
+    if (!this->_pimp) return std::string();
+    return this->_pimp->get_file_path(pKey);
+}
+
+#pragma endregion
@@ -0,0 +1,103 @@
+/*
+	Project			 : Wolf Engine. Copyright(c) Pooya Eimandar (http://PooyaEimandar.com) . All rights reserved.
+	Source			 : Please direct any bug to https://github.com/PooyaEimandar/Wolf.Engine/issues
+	Website			 : http://WolfSource.io
+	Name			 : w_cpipeline_build_cache.h
+	Description		 : Content addressed cache of imported assets, each imported scene is stored as .wscene v2 in cache directory
+	Comment          : key is xxhash64 of source file, its dependencies (material libraries of .obj), import flags and W_ASSIMP_IMPORT_VERSION.
+					   Least recently used files are evicted once size of cache exceeds the limit
+*/
+
+#if _MSC_VER > 1000
+#pragma once
+#endif
+
+#ifndef __W_CPIPELINE_BUILD_CACHE_H__
+#define __W_CPIPELINE_BUILD_CACHE_H__
+
+#include "w_cpipeline_export.h"
+#include "w_cpipeline_wscene.h"
+
+namespace wolf
+{
+	namespace content_pipeline
+	{
+        struct w_cpipeline_build_cache_config
+        {
+            //directory of cached files, it will be created if it does not exist
+            std::string                     path;
+            //least recently used files are evicted once total size of cache exceeds it, zero means no limit
+            uint64_t                        max_size_in_bytes = 1024ull * 1024 * 1024;
+            //cached scenes are mapped and used in place if chunks are not compressed, vertex format of this config is part of key
+            w_cpipeline_wscene_config       wscene;
+        };
+
+        struct w_cpipeline_build_cache_stats
+        {
+            uint64_t    hits = 0;
+            uint64_t    misses = 0;
+            uint64_t    stores = 0;
+            uint64_t    evictions = 0;
+            uint64_t    evicted_bytes = 0;
+            //time of hashing sources in seconds
+            double      hash_seconds = 0;
+        };
+
+        class w_cpipeline_build_cache_pimp;
+        class w_cpipeline_build_cache
+        {
+        public:
+            WCP_EXP w_cpipeline_build_cache();
+            WCP_EXP ~w_cpipeline_build_cache();
+
+            //create cache directory and evict files which exceed the limit
+            WCP_EXP W_RESULT initialize(_In_ const w_cpipeline_build_cache_config& pConfig);
+
+            /*
+                compute key of an asset
+                @param pSourcePath, path of source asset
+                @param pImportFlags, flags which change output of import, e.g. post process flags of assimp and optimizing passes
+                @param pKey, the key
+                @return W_FAILED if source or one of its dependencies could not be read
+            */
+            WCP_EXP W_RESULT get_key(
+                _In_z_  const std::string& pSourcePath,
+                _In_    const uint64_t& pImportFlags,
+                _Out_   uint64_t& pKey);
+
+            //load cached scenes of key, W_FAILED means miss. It is thread safe
+            WCP_EXP W_RESULT load(
+                _In_        const uint64_t& pKey,
+                _Inout_     std::vector<w_cpipeline_scene>& pScenes,
+                _In_opt_    wolf::system::w_thread_pool* pThreadPool = nullptr);
+
+            //store scenes of key and evict least recently used files if it is needed. It is thread safe
+            WCP_EXP W_RESULT store(
+                _In_        const uint64_t& pKey,
+                _Inout_     std::vector<w_cpipeline_scene>& pScenes,
+                _In_opt_    wolf::system::w_thread_pool* pThreadPool = nullptr);
+
+            //evict least recently used files till size of cache is not bigger than limit
+            WCP_EXP W_RESULT evict();
+            //remove all cached files
+            WCP_EXP W_RESULT clear();
+
+            WCP_EXP ULONG release();
+
+#pragma region Getters
+            WCP_EXP w_cpipeline_build_cache_stats get_stats() const;
+            //returns path of cached file of key
+            WCP_EXP std::string get_file_path(_In_ const uint64_t& pKey) const;
+#pragma endregion
+
+        private:
+            //Prevent copying
+            w_cpipeline_build_cache(w_cpipeline_build_cache const&);
+            w_cpipeline_build_cache& operator= (w_cpipeline_build_cache const&);
+
+            w_cpipeline_build_cache_pimp*           _pimp;
+        };
+	}
+}
+
+#endif //__W_CPIPELINE_BUILD_CACHE_H__
@@ -6,6 +6,7 @@
 
 #include <mutex>
 #include "wavefront/obj.h"
+#include "w_vertex_packing.h"
 
 using namespace std;
 using namespace wolf::system;
@@ -15,6 +16,181 @@ using namespace wolf::content_pipeline::collada;
 static std::once_flag	do_init_simplygon_once_over_time;
 static std::mutex		simplygon_mutex;
 
+#pragma region w_cpipeline_mesh
+
+static void s_get_extent(
+	_In_ const w_cpipeline_vector<w_vertex_struct>& pVertices,
+	_Inout_ float* pMin,
+	_Inout_ float* pMax,
+	_Inout_ bool& pHasExtent)
+{
+	for (auto& _vertex : pVertices)
+	{
+		for (int i = 0; i < 3; ++i)
+		{
+			pMin[i] = pHasExtent ? std::min(pMin[i], _vertex.position[i]) : _vertex.position[i];
+			pMax[i] = pHasExtent ? std::max(pMax[i], _vertex.position[i]) : _vertex.position[i];
+		}
+		pHasExtent = true;
+	}
+}
+
+static_assert(offsetof(w_vertex_struct, vertex_index) - offsetof(w_vertex_struct, normal) == offsetof(w_vertex_attributes_struct, vertex_index),
+	"attributes of w_vertex_struct and w_vertex_attributes_struct must have the same layout");
+
+W_RESULT w_cpipeline_mesh::pack_vertices(_In_ const bool& pKeepVertices)
+{
+	//vertices of split mesh are interleaved just for packing
+	const bool _interleaved = this->vertices.empty() && !this->positions.empty();
+	if (_interleaved)
+	{
+		interleave_vertices();
+	}
+
+	//fit the box to vertices for the best precision, LOD is quantized relative to the same box
+	float _min[3], _max[3];
+	bool _has_extent = false;
+	s_get_extent(this->vertices, _min, _max, _has_extent);
+	s_get_extent(this->lod_1_vertices, _min, _max, _has_extent);
+	if (_has_extent)
+	{
+		std::memcpy(this->bounding_box.min, _min, sizeof(_min));
+		std::memcpy(this->bounding_box.max, _max, sizeof(_max));
+	}
+
+	auto& _packed = this->packed_vertices.get_vector();
+	_packed.resize(this->vertices.size());
+	auto& _lod_1_packed = this->lod_1_packed_vertices.get_vector();
+	_lod_1_packed.resize(this->lod_1_vertices.size());
+	if (w_vertex_packing::pack(this->vertices.data(), this->vertices.size(), this->bounding_box, _packed.data()) == W_FAILED ||
+		w_vertex_packing::pack(this->lod_1_vertices.data(), this->lod_1_vertices.size(), this->bounding_box, _lod_1_packed.data()) == W_FAILED)
+	{
+		//mesh can not be packed, so keep the full vertices
+		this->packed_vertices.clear();
+		this->lod_1_packed_vertices.clear();
+		if (_interleaved)
+		{
+			this->vertices.clear();
+		}
+		return W_FAILED;
+	}
+
+	if (!pKeepVertices)
+	{
+		this->vertices.clear();
+		this->lod_1_vertices.clear();
+	}
+	else if (_interleaved)
+	{
+		this->vertices.clear();
+	}
+
+	return W_PASSED;
+}
+
+void w_cpipeline_mesh::unpack_vertices()
+{
+	if (this->vertices.empty() && !this->packed_vertices.empty())
+	{
+		auto& _vertices = this->vertices.get_vector();
+		_vertices.resize(this->packed_vertices.size());
+		w_vertex_packing::unpack(this->packed_vertices.data(), this->packed_vertices.size(), this->bounding_box, _vertices.data());
+	}
+	if (this->lod_1_vertices.empty() && !this->lod_1_packed_vertices.empty())
+	{
+		auto& _vertices = this->lod_1_vertices.get_vector();
+		_vertices.resize(this->lod_1_packed_vertices.size());
+		w_vertex_packing::unpack(this->lod_1_packed_vertices.data(), this->lod_1_packed_vertices.size(), this->bounding_box, _vertices.data());
+	}
+}
+
+void w_cpipeline_mesh::split_vertices(_In_ const bool& pKeepVertices)
+{
+	if (this->vertices.empty()) return;
+
+	const size_t _count = this->vertices.size();
+	auto& _positions = this->positions.get_vector();
+	auto& _attributes = this->attributes.get_vector();
+	_positions.resize(_count * 3);
+	_attributes.resize(_count);
+	for (size_t i = 0; i < _count; ++i)
+	{
+		auto& _vertex = this->vertices[i];
+		std::memcpy(&_positions[i * 3], _vertex.position, sizeof(_vertex.position));
+		std::memcpy(&_attributes[i], _vertex.normal, sizeof(w_vertex_attributes_struct));
+	}
+
+	if (!pKeepVertices)
+	{
+		this->vertices.clear();
+	}
+}
+
+void w_cpipeline_mesh::interleave_vertices()
+{
+	const size_t _count = this->positions.size() / 3;
+	if (!this->vertices.empty() || !_count) return;
+
+	//attributes are zero if attributes stream does not match positions
+	const bool _has_attributes = this->attributes.size() == _count;
+
+	auto& _vertices = this->vertices.get_vector();
+	_vertices.resize(_count);
+	for (size_t i = 0; i < _count; ++i)
+	{
+		auto& _vertex = _vertices[i];
+		std::memcpy(_vertex.position, &this->positions[i * 3], sizeof(_vertex.position));
+		if (_has_attributes)
+		{
+			std::memcpy(_vertex.normal, &this->attributes[i], sizeof(w_vertex_attributes_struct));
+		}
+	}
+}
+
+void w_cpipeline_mesh::update_bounding_box()
+{
+	auto _positions = get_positions();
+	if (!_positions) return;
+
+	auto _box = w_bounding_box::create_from_points(_positions, get_vertices_count());
+	std::memcpy(this->bounding_box.min, _box.min, sizeof(_box.min));
+	std::memcpy(this->bounding_box.max, _box.max, sizeof(_box.max));
+}
+
+size_t w_cpipeline_mesh::get_vertices_count() const
+{
+	if (!this->vertices.empty()) return this->vertices.size();
+	if (!this->positions.empty()) return this->positions.size() / 3;
+	return this->packed_vertices.size();
+}
+
+const float* w_cpipeline_mesh::get_positions()
+{
+	if (!this->positions.empty()) return this->positions.data();
+
+	//gather them to the cache, positions stream is only for split meshes
+	if (!this->vertices.empty())
+	{
+		this->_positions_cache.resize(this->vertices.size() * 3);
+		for (size_t i = 0; i < this->vertices.size(); ++i)
+		{
+			std::memcpy(&this->_positions_cache[i * 3], this->vertices[i].position, 3 * sizeof(float));
+		}
+	}
+	else if (!this->packed_vertices.empty())
+	{
+		this->_positions_cache.resize(this->packed_vertices.size() * 3);
+		w_vertex_packing::unpack_positions(this->packed_vertices.data(), this->packed_vertices.size(), this->bounding_box, this->_positions_cache.data());
+	}
+	else
+	{
+		this->_positions_cache.clear();
+	}
+	return this->_positions_cache.empty() ? nullptr : this->_positions_cache.data();
+}
+
+#pragma endregion
+
 w_cpipeline_model::w_cpipeline_model() : _id(-1)
 {
 }
@@ -48,7 +224,7 @@ w_cpipeline_model::~w_cpipeline_model()
 //    _In_ const bool& pZUp,
 //    _In_ const bool& pInvertNormal)
 //{
-//    const std::string _trace_info = "w_cpipeline_model::create_model";
+//    const char* _trace_info = "w_cpipeline_model::create_model";
 //
 //    auto _model = new w_cpipeline_model();
 //    _model->set_transform(pTransform);
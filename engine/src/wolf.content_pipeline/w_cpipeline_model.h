@@ -21,6 +21,7 @@
 #include "collada/c_skin.h"
 #include "collada/c_animation.h"
 #include "w_vertex_struct.h"
+#include "w_cpipeline_vector.h"
 #include "w_bounding.h"
 #include "python_exporter/w_boost_python_helper.h"
 
@@ -169,16 +170,24 @@ namespace wolf
 		WCP_EXP struct w_cpipeline_mesh
 		{
 			std::string							name;
-			//posX, posY, posZ
-			std::vector<w_vertex_struct>		vertices;
-			w_vector_uint32_t					indices;
+			//posX, posY, posZ, they are views into the mapping when mesh was loaded from .wscene v2
+			w_cpipeline_vector<w_vertex_struct>	vertices;
+			w_cpipeline_vector<uint32_t>		indices;
 			//c_material*						material;
 			//std::vector<c_effect*>			effects;
 			std::string							textures_path;
 			wolf::system::w_bounding_box		bounding_box;
 
-			std::vector<w_vertex_struct>		lod_1_vertices;
-			w_vector_uint32_t					lod_1_indices;
+			w_cpipeline_vector<w_vertex_struct>	lod_1_vertices;
+			w_cpipeline_vector<uint32_t>		lod_1_indices;
+
+			//vertices of w_vertex_struct_packed relative to bounding_box, they are emitted by pack_vertices
+			w_cpipeline_vector<w_vertex_struct_packed>	packed_vertices;
+			w_cpipeline_vector<w_vertex_struct_packed>	lod_1_packed_vertices;
+
+			//structure of arrays streams of vertices, they are emitted by split_vertices. positions are x, y and z of each vertex next to each other
+			w_cpipeline_vector<float>						positions;
+			w_cpipeline_vector<w_vertex_attributes_struct>	attributes;
 
 			void release()
 			{
@@ -186,25 +195,65 @@ namespace wolf
 				this->indices.clear();
 				this->lod_1_vertices.clear();
 				this->lod_1_indices.clear();
+				this->packed_vertices.clear();
+				this->lod_1_packed_vertices.clear();
+				this->positions.clear();
+				this->attributes.clear();
+				this->_positions_cache.clear();
+				this->_positions_cache.shrink_to_fit();
 			}
 
-			MSGPACK_DEFINE(vertices, indices, textures_path, bounding_box, lod_1_vertices, lod_1_indices);
+			/*
+				pack vertices and lod_1_vertices, min and max of bounding_box are fitted to vertices
+				@param pKeepVertices, if it is false vertices and lod_1_vertices will be released
+				@return W_FAILED if a blend index does not fit in 8 bits, in this case packed vertices are empty and vertices are kept
+			*/
+			WCP_EXP W_RESULT pack_vertices(_In_ const bool& pKeepVertices = false);
+			//restore vertices and lod_1_vertices from packed vertices if they are empty
+			WCP_EXP void unpack_vertices();
+
+			/*
+				split vertices to positions and attributes streams, indices are already a separate stream
+				@param pKeepVertices, if it is false vertices will be released, use interleave_vertices right before uploading them to GPU
+			*/
+			WCP_EXP void split_vertices(_In_ const bool& pKeepVertices = false);
+			//interleave positions and attributes streams to vertices if vertices are empty
+			WCP_EXP void interleave_vertices();
+			//fit min and max of bounding_box to positions
+			WCP_EXP void update_bounding_box();
+
+#pragma region Getters
+			//returns number of vertices of the first available stream
+			WCP_EXP size_t get_vertices_count() const;
+			/*
+				returns x, y and z of get_vertices_count vertices next to each other for CPU passes such as bounding box, masked occlusion culling and AMD Tootle.
+				If positions stream is empty, they will be gathered from vertices or packed vertices to a cache which is not serialized,
+				the pointer is valid till the next call or change of mesh
+			*/
+			WCP_EXP const float* get_positions();
+#pragma endregion
+
+			MSGPACK_DEFINE(vertices, indices, textures_path, bounding_box, lod_1_vertices, lod_1_indices, packed_vertices, lod_1_packed_vertices, positions, attributes);
 
 #ifdef __PYTHON__
 
 			boost::python::list					py_get_vertices()
 			{
 				boost::python::list _list;
-				std_vector_to_boost_list(_list, this->vertices);
+				std_vector_to_boost_list(_list, this->vertices.get_vector());
 				return _list;
 			}
 
 			void								py_set_vertices(_In_ boost::python::list pValue)
 			{
 				this->vertices.clear();
-				boost_list_to_std_vector(pValue, this->vertices);
+				boost_list_to_std_vector(pValue, this->vertices.get_vector());
 			}
 #endif
+
+		private:
+			//positions which were gathered by get_positions for meshes which were not split
+			std::vector<float>					_positions_cache;
 		};
 
 		class w_cpipeline_model
@@ -0,0 +1,161 @@
+/*
+	Project			 : Wolf Engine. Copyright(c) Pooya Eimandar (http://PooyaEimandar.com) . All rights reserved.
+	Source			 : Please direct any bug to https://github.com/PooyaEimandar/Wolf.Engine/issues
+	Website			 : http://WolfSource.io
+	Name			 : w_cpipeline_vector.h
+	Description		 : A vector which either owns its elements or is a view into memory of someone else, e.g. a mapped .wscene
+	Comment          : the view keeps its owner alive, so copies of a mesh which was loaded from a mapped file share the same memory.
+					   Changing the size of a view copies elements into the owned vector
+*/
+
+#if _MSC_VER > 1000
+#pragma once
+#endif
+
+#ifndef __W_CPIPELINE_VECTOR_H__
+#define __W_CPIPELINE_VECTOR_H__
+
+#include <vector>
+#include <memory>
+#include <msgpack.hpp>
+
+namespace wolf
+{
+	namespace content_pipeline
+	{
+        template<typename T>
+        class w_cpipeline_vector
+        {
+        public:
+            typedef T           value_type;
+            typedef T*          iterator;
+            typedef const T*    const_iterator;
+            typedef size_t      size_type;
+
+            w_cpipeline_vector() :
+                _view(nullptr),
+                _view_size(0)
+            {
+            }
+
+            w_cpipeline_vector(_In_ const std::vector<T>& pValue) :
+                _vector(pValue),
+                _view(nullptr),
+                _view_size(0)
+            {
+            }
+
+            /*
+                make this vector a view
+                @param pData, the first element, pages of a mapped file must be mapped as copy on write if elements will be modified
+                @param pSize, number of elements
+                @param pOwner, the owner of memory, it will be kept alive till the last copy of view released
+            */
+            void set_view(_In_ T* pData, _In_ const size_t& pSize, _In_ const std::shared_ptr<void>& pOwner)
+            {
+                std::vector<T>().swap(this->_vector);
+                this->_view = pData;
+                this->_view_size = pSize;
+                this->_owner = pOwner;
+            }
+
+            //returns owned vector, the elements of view will be copied before
+            std::vector<T>& get_vector()
+            {
+                if (this->_view)
+                {
+                    this->_vector.assign(this->_view, this->_view + this->_view_size);
+                    _release_view();
+                }
+                return this->_vector;
+            }
+
+            void push_back(_In_ const T& pValue)
+            {
+                get_vector().push_back(pValue);
+            }
+
+            void resize(_In_ const size_t& pSize)
+            {
+                get_vector().resize(pSize);
+            }
+
+            void reserve(_In_ const size_t& pSize)
+            {
+                get_vector().reserve(pSize);
+            }
+
+            void clear()
+            {
+                _release_view();
+                this->_vector.clear();
+            }
+
+            void swap(_Inout_ w_cpipeline_vector& pOther)
+            {
+                this->_vector.swap(pOther._vector);
+                std::swap(this->_view, pOther._view);
+                std::swap(this->_view_size, pOther._view_size);
+                this->_owner.swap(pOther._owner);
+            }
+
+            void swap(_Inout_ std::vector<T>& pOther)
+            {
+                get_vector().swap(pOther);
+            }
+
+            T& operator[](_In_ const size_t& pIndex)                { return data()[pIndex]; }
+            const T& operator[](_In_ const size_t& pIndex) const    { return data()[pIndex]; }
+
+            iterator begin()                                        { return data(); }
+            iterator end()                                          { return data() + size(); }
+            const_iterator begin() const                            { return data(); }
+            const_iterator end() const                              { return data() + size(); }
+
+            template <typename Packer>
+            void msgpack_pack(Packer& pPacker) const
+            {
+                pPacker.pack_array(static_cast<uint32_t>(size()));
+                for (auto& _iter : *this)
+                {
+                    pPacker.pack(_iter);
+                }
+            }
+
+            void msgpack_unpack(_In_ msgpack::object const& pObject)
+            {
+                _release_view();
+                pObject.convert(this->_vector);
+            }
+
+            void msgpack_object(_Inout_ msgpack::object* pObject, _Inout_ msgpack::zone& pZone) const
+            {
+                *pObject = msgpack::object(std::vector<T>(begin(), end()), pZone);
+            }
+
+#pragma region Getters
+            T* data()                                               { return this->_view ? this->_view : this->_vector.data(); }
+            const T* data() const                                   { return this->_view ? this->_view : this->_vector.data(); }
+            size_t size() const                                     { return this->_view ? this->_view_size : this->_vector.size(); }
+            bool empty() const                                      { return size() == 0; }
+            //returns true if elements are not owned by this vector
+            bool get_is_view() const                                { return this->_view != nullptr; }
+#pragma endregion
+
+        private:
+            void _release_view()
+            {
+                this->_view = nullptr;
+                this->_view_size = 0;
+                this->_owner.reset();
+            }
+
+            std::vector<T>                      _vector;
+            T*                                  _view;
+            size_t                              _view_size;
+            std::shared_ptr<void>               _owner;
+        };
+	}
+}
+
+#endif //__W_CPIPELINE_VECTOR_H__
@@ -0,0 +1,610 @@
+#include "w_cpipeline_pch.h"
+#include "w_cpipeline_wscene.h"
+#include <w_thread_pool.h>
+#include <w_file_view.h>
+#include <msgpack.hpp>
+
+/*
+    header of .wscene v2, 32 bytes
+    uint32 magic, uint32 version, uint32 number of chunks, uint32 size of w_vertex_struct, uint64 size of file,
+    uint32 size of w_vertex_struct_packed (zero before version 3), uint32 size of w_vertex_attributes_struct (zero before version 4)
+
+    table of contents right after header, for each chunk 32 bytes
+    uint64 offset of chunk from the beginning of file, uint64 stored size, uint64 size after decompression, uint32 type, uint32 flags
+*/
+#define W_WSCENE_MAGIC                      0x32435357//"WSC2"
+#define W_WSCENE_VERSION                    4
+#define W_WSCENE_MIN_VERSION                2
+#define W_WSCENE_HEADER_SIZE                32
+#define W_WSCENE_TOC_ENTRY_SIZE             32
+#define W_WSCENE_ALIGNMENT                  16
+#define W_WSCENE_CHUNK_FLAG_COMPRESSED      0x1
+//vertices, indices, lod_1_vertices and lod_1_indices, version 3 adds packed_vertices and lod_1_packed_vertices, version 4 adds positions and attributes
+#define W_WSCENE_CHUNKS_PER_MESH_V2         4
+#define W_WSCENE_CHUNKS_PER_MESH_V3         6
+#define W_WSCENE_CHUNKS_PER_MESH            8
+
+using namespace wolf::system;
+using namespace wolf::content_pipeline;
+
+enum w_wscene_chunk_type : uint32_t
+{
+    W_WSCENE_CHUNK_SCENES = 0,
+    W_WSCENE_CHUNK_VERTICES,
+    W_WSCENE_CHUNK_INDICES,
+    W_WSCENE_CHUNK_LOD_1_VERTICES,
+    W_WSCENE_CHUNK_LOD_1_INDICES,
+    W_WSCENE_CHUNK_PACKED_VERTICES,
+    W_WSCENE_CHUNK_LOD_1_PACKED_VERTICES,
+    W_WSCENE_CHUNK_POSITIONS,
+    W_WSCENE_CHUNK_ATTRIBUTES,
+};
+
+struct w_wscene_chunk
+{
+    uint64_t            offset = 0;
+    uint64_t            stored_size = 0;
+    uint64_t            raw_size = 0;
+    uint32_t            type = 0;
+    uint32_t            flags = 0;
+
+    //source of chunk while saving
+    const uint8_t*      src = nullptr;
+    w_compress_result   compressed = {};
+};
+
+struct w_wscene_decompress_job
+{
+    const uint8_t*      src;
+    size_t              src_size;
+    uint8_t*            dst;
+    size_t              dst_size;
+};
+
+static inline uint64_t s_align(_In_ const uint64_t& pValue)
+{
+    return (pValue + W_WSCENE_ALIGNMENT - 1) & ~static_cast<uint64_t>(W_WSCENE_ALIGNMENT - 1);
+}
+
+template<typename T>
+static inline void s_write(_Inout_ uint8_t*& pDst, _In_ const T& pValue)
+{
+    std::memcpy(pDst, &pValue, sizeof(T));
+    pDst += sizeof(T);
+}
+
+template<typename T>
+static inline T s_read(_Inout_ const uint8_t*& pSrc)
+{
+    T _value;
+    std::memcpy(&_value, pSrc, sizeof(T));
+    pSrc += sizeof(T);
+    return _value;
+}
+
+static void s_get_meshes(_Inout_ std::vector<w_cpipeline_scene>& pScenes, _Inout_ std::vector<w_cpipeline_mesh*>& pMeshes)
+{
+    for (auto& _scene : pScenes)
+    {
+        std::vector<w_cpipeline_model*> _models;
+        _scene.get_all_models(_models);
+        for (auto _model : _models)
+        {
+            _model->get_meshes(pMeshes);
+        }
+    }
+}
+
+static void s_run(
+    _In_ const size_t& pSize,
+    _In_opt_ w_thread_pool* pThreadPool,
+    _In_ const std::function<void(const size_t&)>& pFunction)
+{
+    auto _job = [&pFunction](const size_t& pBegin, const size_t& pEnd)
+    {
+        for (auto i = pBegin; i < pEnd; ++i)
+        {
+            pFunction(i);
+        }
+    };
+
+    if (pThreadPool && pThreadPool->get_pool_size() && pSize > 1)
+    {
+        pThreadPool->parallel_for(0, pSize, _job, 1);
+    }
+    else
+    {
+        _job(0, pSize);
+    }
+}
+
+template<typename T>
+static void s_add_chunk(
+    _In_ const w_cpipeline_vector<T>& pVector,
+    _In_ const uint32_t& pType,
+    _Inout_ std::vector<w_wscene_chunk>& pChunks)
+{
+    w_wscene_chunk _chunk;
+    _chunk.type = pType;
+    _chunk.src = reinterpret_cast<const uint8_t*>(pVector.data());
+    _chunk.raw_size = pVector.size() * sizeof(T);
+    _chunk.stored_size = _chunk.raw_size;
+    pChunks.push_back(_chunk);
+}
+
+template<typename T>
+static W_RESULT s_load_chunk(
+    _In_ const w_wscene_chunk& pChunk,
+    _In_ uint8_t* pWScene,
+    _In_ const std::shared_ptr<void>& pOwner,
+    _Inout_ w_cpipeline_vector<T>& pVector,
+    _Inout_ std::vector<w_wscene_decompress_job>& pJobs)
+{
+    pVector.clear();
+    if (pChunk.raw_size % sizeof(T)) return W_FAILED;
+
+    auto _count = static_cast<size_t>(pChunk.raw_size / sizeof(T));
+    if (!_count) return W_PASSED;
+
+    auto _src = pWScene + pChunk.offset;
+    if (pChunk.flags & W_WSCENE_CHUNK_FLAG_COMPRESSED)
+    {
+        auto& _vector = pVector.get_vector();
+        try
+        {
+            _vector.resize(_count);
+        }
+        catch (const std::exception&)
+        {
+            return W_FAILED;
+        }
+
+        w_wscene_decompress_job _job;
+        _job.src = _src;
+        _job.src_size = static_cast<size_t>(pChunk.stored_size);
+        _job.dst = reinterpret_cast<uint8_t*>(_vector.data());
+        _job.dst_size = static_cast<size_t>(pChunk.raw_size);
+        pJobs.push_back(_job);
+    }
+    else if (pOwner)
+    {
+        pVector.set_view(reinterpret_cast<T*>(_src), _count, pOwner);
+    }
+    else
+    {
+        auto& _vector = pVector.get_vector();
+        _vector.resize(_count);
+        std::memcpy(_vector.data(), _src, static_cast<size_t>(pChunk.raw_size));
+    }
+    return W_PASSED;
+}
+
+W_RESULT w_cpipeline_wscene::save_to_memory(
+    _Inout_     std::vector<w_cpipeline_scene>& pScenes,
+    _Inout_     std::vector<uint8_t>& pWScene,
+    _In_        const w_cpipeline_wscene_config& pConfig,
+    _In_opt_    w_thread_pool* pThreadPool)
+{
+    const char* _trace_info = "w_cpipeline_wscene::save_to_memory";
+
+    std::vector<w_cpipeline_mesh*> _meshes;
+    s_get_meshes(pScenes, _meshes);
+
+    if (pConfig.pack_vertices)
+    {
+        s_run(_meshes.size(), pThreadPool, [&](const size_t& pIndex)
+        {
+            auto _mesh = _meshes[pIndex];
+            if (_mesh->packed_vertices.empty() && (!_mesh->vertices.empty() || !_mesh->positions.empty()) &&
+                _mesh->pack_vertices(true) == W_FAILED)
+            {
+                logger.warning("mesh {} will be stored without packed vertices. trace info: {}", _mesh->name, _trace_info);
+            }
+        });
+    }
+    if (pConfig.split_vertices)
+    {
+        s_run(_meshes.size(), pThreadPool, [&](const size_t& pIndex)
+        {
+            auto _mesh = _meshes[pIndex];
+            if (_mesh->positions.empty())
+            {
+                _mesh->split_vertices(true);
+            }
+        });
+    }
+    //full vertices and streams are not stored if packed vertices replace them, meshes which could not be packed keep them
+    const w_cpipeline_vector<w_vertex_struct> _no_vertices;
+    const w_cpipeline_vector<float> _no_positions;
+    const w_cpipeline_vector<w_vertex_attributes_struct> _no_attributes;
+    const bool _store_all_vertices = !pConfig.pack_vertices || pConfig.keep_vertices;
+
+    //pack scenes without geometry, then restore geometry
+    msgpack::sbuffer _packed;
+    {
+        struct geometry
+        {
+            w_cpipeline_vector<w_vertex_struct>     vertices;
+            w_cpipeline_vector<uint32_t>            indices;
+            w_cpipeline_vector<w_vertex_struct>     lod_1_vertices;
+            w_cpipeline_vector<uint32_t>            lod_1_indices;
+            w_cpipeline_vector<w_vertex_struct_packed>  packed_vertices;
+            w_cpipeline_vector<w_vertex_struct_packed>  lod_1_packed_vertices;
+            w_cpipeline_vector<float>                   positions;
+            w_cpipeline_vector<w_vertex_attributes_struct>  attributes;
+        };
+        auto _swap = [](_Inout_ w_cpipeline_mesh* pMesh, _Inout_ geometry& pGeometry)
+        {
+            pMesh->vertices.swap(pGeometry.vertices);
+            pMesh->indices.swap(pGeometry.indices);
+            pMesh->lod_1_vertices.swap(pGeometry.lod_1_vertices);
+            pMesh->lod_1_indices.swap(pGeometry.lod_1_indices);
+            pMesh->packed_vertices.swap(pGeometry.packed_vertices);
+            pMesh->lod_1_packed_vertices.swap(pGeometry.lod_1_packed_vertices);
+            pMesh->positions.swap(pGeometry.positions);
+            pMesh->attributes.swap(pGeometry.attributes);
+        };
+
+        std::vector<geometry> _geometries(_meshes.size());
+        for (size_t i = 0; i < _meshes.size(); ++i)
+        {
+            _swap(_meshes[i], _geometries[i]);
+        }
+        msgpack::pack(_packed, pScenes);
+        for (size_t i = 0; i < _meshes.size(); ++i)
+        {
+            _swap(_meshes[i], _geometries[i]);
+        }
+    }
+
+    std::vector<w_wscene_chunk> _chunks;
+    _chunks.reserve(1 + _meshes.size() * W_WSCENE_CHUNKS_PER_MESH);
+    {
+        w_wscene_chunk _chunk;
+        _chunk.type = W_WSCENE_CHUNK_SCENES;
+        _chunk.src = reinterpret_cast<const uint8_t*>(_packed.data());
+        _chunk.raw_size = _packed.size();
+        _chunk.stored_size = _chunk.raw_size;
+        _chunks.push_back(_chunk);
+    }
+    for (auto _mesh : _meshes)
+    {
+        const bool _store_vertices = _store_all_vertices || _mesh->packed_vertices.empty();
+        //streams replace vertices of split meshes, lod_1_vertices are not split
+        const bool _store_interleaved = _store_vertices && (pConfig.keep_vertices || !pConfig.split_vertices || _mesh->positions.empty());
+        s_add_chunk(_store_interleaved ? _mesh->vertices : _no_vertices, W_WSCENE_CHUNK_VERTICES, _chunks);
+        s_add_chunk(_mesh->indices, W_WSCENE_CHUNK_INDICES, _chunks);
+        s_add_chunk(_store_vertices ? _mesh->lod_1_vertices : _no_vertices, W_WSCENE_CHUNK_LOD_1_VERTICES, _chunks);
+        s_add_chunk(_mesh->lod_1_indices, W_WSCENE_CHUNK_LOD_1_INDICES, _chunks);
+        s_add_chunk(_mesh->packed_vertices, W_WSCENE_CHUNK_PACKED_VERTICES, _chunks);
+        s_add_chunk(_mesh->lod_1_packed_vertices, W_WSCENE_CHUNK_LOD_1_PACKED_VERTICES, _chunks);
+        s_add_chunk(_store_vertices ? _mesh->positions : _no_positions, W_WSCENE_CHUNK_POSITIONS, _chunks);
+        s_add_chunk(_store_vertices ? _mesh->attributes : _no_attributes, W_WSCENE_CHUNK_ATTRIBUTES, _chunks);
+    }
+
+    if (pConfig.compress)
+    {
+        //most of chunks are small, so compress chunks in parallel instead of blocks of each chunk
+        s_run(_chunks.size(), pThreadPool, [&](const size_t& pIndex)
+        {
+            auto& _chunk = _chunks[pIndex];
+            if (_chunk.raw_size < pConfig.min_compress_size_in_bytes) return;
+
+            _chunk.compressed.size_in = static_cast<size_t>(_chunk.raw_size);
+            if (w_compress_blocks::compress(
+                reinterpret_cast<const char*>(_chunk.src),
+                &_chunk.compressed,
+                pConfig.blocks,
+                nullptr) == W_PASSED && _chunk.compressed.size_out < _chunk.raw_size)
+            {
+                _chunk.stored_size = _chunk.compressed.size_out;
+                _chunk.flags |= W_WSCENE_CHUNK_FLAG_COMPRESSED;
+            }
+        });
+    }
+
+    //layout of file
+    uint64_t _offset = s_align(W_WSCENE_HEADER_SIZE + _chunks.size() * W_WSCENE_TOC_ENTRY_SIZE);
+    for (auto& _chunk : _chunks)
+    {
+        if (!_chunk.stored_size) continue;
+        _chunk.offset = s_align(_offset);
+        _offset = _chunk.offset + _chunk.stored_size;
+    }
+
+    pWScene.assign(static_cast<size_t>(_offset), 0);
+
+    auto _dst = pWScene.data();
+    s_write<uint32_t>(_dst, W_WSCENE_MAGIC);
+    s_write<uint32_t>(_dst, W_WSCENE_VERSION);
+    s_write<uint32_t>(_dst, static_cast<uint32_t>(_chunks.size()));
+    s_write<uint32_t>(_dst, static_cast<uint32_t>(sizeof(w_vertex_struct)));
+    s_write<uint64_t>(_dst, _offset);
+    s_write<uint32_t>(_dst, static_cast<uint32_t>(sizeof(w_vertex_struct_packed)));
+    s_write<uint32_t>(_dst, static_cast<uint32_t>(sizeof(w_vertex_attributes_struct)));
+
+    for (auto& _chunk : _chunks)
+    {
+        s_write<uint64_t>(_dst, _chunk.offset);
+        s_write<uint64_t>(_dst, _chunk.stored_size);
+        s_write<uint64_t>(_dst, _chunk.raw_size);
+        s_write<uint32_t>(_dst, _chunk.type);
+        s_write<uint32_t>(_dst, _chunk.flags);
+
+        if (_chunk.stored_size)
+        {
+            auto _src = (_chunk.flags & W_WSCENE_CHUNK_FLAG_COMPRESSED) ?
+                reinterpret_cast<const uint8_t*>(_chunk.compressed.data) : _chunk.src;
+            std::memcpy(pWScene.data() + _chunk.offset, _src, static_cast<size_t>(_chunk.stored_size));
+        }
+        if (_chunk.compressed.data)
+        {
+            free(_chunk.compressed.data);
+            _chunk.compressed.data = nullptr;
+        }
+    }
+
+    if (pWScene.empty())
+    {
+        W_V(W_FAILED, w_log_type::W_ERROR, "could not write scenes. trace info: {}", _trace_info);
+        return W_FAILED;
+    }
+    return W_PASSED;
+}
+
+W_RESULT w_cpipeline_wscene::save_to_file(
+    _Inout_     std::vector<w_cpipeline_scene>& pScenes,
+    _In_z_      const std::string& pPath,
+    _In_        const w_cpipeline_wscene_config& pConfig,
+    _In_opt_    w_thread_pool* pThreadPool)
+{
+    const char* _trace_info = "w_cpipeline_wscene::save_to_file";
+
+    std::vector<uint8_t> _wscene;
+    if (save_to_memory(pScenes, _wscene, pConfig, pThreadPool) == W_FAILED) return W_FAILED;
+
+    std::ofstream _file(pPath, std::ios::out | std::ios::binary);
+    if (!_file)
+    {
+        W_V(W_FAILED, w_log_type::W_ERROR, "could not create file {}. trace info: {}", pPath, _trace_info);
+        return W_FAILED;
+    }
+    _file.write(reinterpret_cast<const char*>(_wscene.data()), static_cast<std::streamsize>(_wscene.size()));
+    _file.close();
+    if (_file.fail())
+    {
+        W_V(W_FAILED, w_log_type::W_ERROR, "could not write file {}. trace info: {}", pPath, _trace_info);
+        return W_FAILED;
+    }
+    return W_PASSED;
+}
+
+W_RESULT w_cpipeline_wscene::load_from_memory(
+    _In_        uint8_t* pWScene,
+    _In_        const size_t& pSize,
+    _In_        const std::shared_ptr<void>& pOwner,
+    _Inout_     std::vector<w_cpipeline_scene>& pScenes,
+    _In_opt_    w_thread_pool* pThreadPool)
+{
+    const char* _trace_info = "w_cpipeline_wscene::load_from_memory";
+
+    if (!get_is_wscene(pWScene, pSize))
+    {
+        W_V(W_FAILED, w_log_type::W_ERROR, "buffer is not a .wscene v2. trace info: {}", _trace_info);
+        return W_FAILED;
+    }
+    //views must be aligned, copies can be read from any address
+    if (pOwner && reinterpret_cast<uintptr_t>(pWScene) % W_WSCENE_ALIGNMENT)
+    {
+        W_V(W_FAILED, w_log_type::W_ERROR, "buffer of .wscene must be aligned to {} bytes. trace info: {}", W_WSCENE_ALIGNMENT, _trace_info);
+        return W_FAILED;
+    }
+
+#pragma region read header and table of contents
+    const uint8_t* _src = pWScene + sizeof(uint32_t);
+    auto _version = s_read<uint32_t>(_src);
+    auto _chunks_count = s_read<uint32_t>(_src);
+    auto _vertex_size = s_read<uint32_t>(_src);
+    auto _file_size = s_read<uint64_t>(_src);
+    auto _packed_vertex_size = s_read<uint32_t>(_src);
+    auto _attributes_size = s_read<uint32_t>(_src);
+
+    if (_version < W_WSCENE_MIN_VERSION || _version > W_WSCENE_VERSION ||
+        _vertex_size != sizeof(w_vertex_struct) ||
+        (_version >= 3 && _packed_vertex_size != sizeof(w_vertex_struct_packed)) ||
+        (_version >= 4 && _attributes_size != sizeof(w_vertex_attributes_struct)) ||
+        _file_size > pSize || !_chunks_count ||
+        _chunks_count > (pSize - W_WSCENE_HEADER_SIZE) / W_WSCENE_TOC_ENTRY_SIZE)
+    {
+        W_V(W_FAILED, w_log_type::W_ERROR, "header of .wscene is not supported or it is corrupted. version: {} vertex size: {}. trace info: {}",
+            _version, _vertex_size, _trace_info);
+        return W_FAILED;
+    }
+
+    std::vector<w_wscene_chunk> _chunks(_chunks_count);
+    for (auto& _chunk : _chunks)
+    {
+        _chunk.offset = s_read<uint64_t>(_src);
+        _chunk.stored_size = s_read<uint64_t>(_src);
+        _chunk.raw_size = s_read<uint64_t>(_src);
+        _chunk.type = s_read<uint32_t>(_src);
+        _chunk.flags = s_read<uint32_t>(_src);
+
+        const bool _compressed = (_chunk.flags & W_WSCENE_CHUNK_FLAG_COMPRESSED) != 0;
+        if (_chunk.offset > _file_size || _chunk.stored_size > _file_size - _chunk.offset ||
+            _chunk.offset % W_WSCENE_ALIGNMENT ||
+            (!_compressed && _chunk.stored_size != _chunk.raw_size) ||
+            (_compressed && !_chunk.stored_size) ||
+            _chunk.raw_size > SIZE_MAX)
+        {
+            W_V(W_FAILED, w_log_type::W_ERROR, "table of contents of .wscene is corrupted. trace info: {}", _trace_info);
+            return W_FAILED;
+        }
+
+        //raw size is used for allocation, so it must match the block container before anything is allocated
+        w_compress_blocks_info _info;
+        if (_compressed &&
+            (w_compress_blocks::get_info(
+                reinterpret_cast<const char*>(pWScene + _chunk.offset),
+                static_cast<size_t>(_chunk.stored_size),
+                _info) == W_FAILED ||
+             _info.content_size != _chunk.raw_size))
+        {
+            W_V(W_FAILED, w_log_type::W_ERROR, "size of compressed chunk does not match its table of contents entry in .wscene. trace info: {}", _trace_info);
+            return W_FAILED;
+        }
+    }
+    if (_chunks[0].type != W_WSCENE_CHUNK_SCENES || !_chunks[0].raw_size)
+    {
+        W_V(W_FAILED, w_log_type::W_ERROR, "missing scenes chunk of .wscene. trace info: {}", _trace_info);
+        return W_FAILED;
+    }
+#pragma endregion
+
+#pragma region unpack scenes
+    {
+        auto& _chunk = _chunks[0];
+        std::vector<char> _decompressed;
+        auto _packed = reinterpret_cast<const char*>(pWScene + _chunk.offset);
+        if (_chunk.flags & W_WSCENE_CHUNK_FLAG_COMPRESSED)
+        {
+            try
+            {
+                _decompressed.resize(static_cast<size_t>(_chunk.raw_size));
+            }
+            catch (const std::exception& pException)
+            {
+                W_V(W_FAILED, w_log_type::W_ERROR, "could not allocate scenes chunk of .wscene. error: {}. trace info: {}", pException.what(), _trace_info);
+                return W_FAILED;
+            }
+            if (w_compress_blocks::read(_packed, static_cast<size_t>(_chunk.stored_size), 0,
+                _decompressed.size(), _decompressed.data(), nullptr) == W_FAILED)
+            {
+                W_V(W_FAILED, w_log_type::W_ERROR, "could not decompress scenes chunk of .wscene. trace info: {}", _trace_info);
+                return W_FAILED;
+            }
+            _packed = _decompressed.data();
+        }
+
+        try
+        {
+            auto _msg = msgpack::unpack(_packed, static_cast<size_t>(_chunk.raw_size));
+            _msg.get().convert(pScenes);
+        }
+        catch (const std::exception& pException)
+        {
+            W_V(W_FAILED, w_log_type::W_ERROR, "could not unpack scenes chunk of .wscene. error: {}. trace info: {}", pException.what(), _trace_info);
+            pScenes.clear();
+            return W_FAILED;
+        }
+    }
+#pragma endregion
+
+#pragma region geometry
+    std::vector<w_cpipeline_mesh*> _meshes;
+    s_get_meshes(pScenes, _meshes);
+    const size_t _chunks_per_mesh =
+        _version >= 4 ? W_WSCENE_CHUNKS_PER_MESH :
+        _version == 3 ? W_WSCENE_CHUNKS_PER_MESH_V3 : W_WSCENE_CHUNKS_PER_MESH_V2;
+    if (_chunks.size() != 1 + _meshes.size() * _chunks_per_mesh)
+    {
+        W_V(W_FAILED, w_log_type::W_ERROR, "number of chunks does not match meshes of .wscene. trace info: {}", _trace_info);
+        pScenes.clear();
+        return W_FAILED;
+    }
+
+    auto _hr = W_PASSED;
+    std::vector<w_wscene_decompress_job> _jobs;
+    for (size_t i = 0; i < _meshes.size() && _hr == W_PASSED; ++i)
+    {
+        auto _mesh = _meshes[i];
+        auto _chunk = &_chunks[1 + i * _chunks_per_mesh];
+        if (_chunk[0].type != W_WSCENE_CHUNK_VERTICES ||
+            _chunk[1].type != W_WSCENE_CHUNK_INDICES ||
+            _chunk[2].type != W_WSCENE_CHUNK_LOD_1_VERTICES ||
+            _chunk[3].type != W_WSCENE_CHUNK_LOD_1_INDICES ||
+            (_chunks_per_mesh >= W_WSCENE_CHUNKS_PER_MESH_V3 &&
+            (_chunk[4].type != W_WSCENE_CHUNK_PACKED_VERTICES ||
+             _chunk[5].type != W_WSCENE_CHUNK_LOD_1_PACKED_VERTICES)) ||
+            (_chunks_per_mesh >= W_WSCENE_CHUNKS_PER_MESH &&
+            (_chunk[6].type != W_WSCENE_CHUNK_POSITIONS ||
+             _chunk[7].type != W_WSCENE_CHUNK_ATTRIBUTES)))
+        {
+            _hr = W_FAILED;
+            break;
+        }
+
+        _hr = s_load_chunk(_chunk[0], pWScene, pOwner, _mesh->vertices, _jobs);
+        if (_hr == W_PASSED) _hr = s_load_chunk(_chunk[1], pWScene, pOwner, _mesh->indices, _jobs);
+        if (_hr == W_PASSED) _hr = s_load_chunk(_chunk[2], pWScene, pOwner, _mesh->lod_1_vertices, _jobs);
+        if (_hr == W_PASSED) _hr = s_load_chunk(_chunk[3], pWScene, pOwner, _mesh->lod_1_indices, _jobs);
+        if (_hr == W_PASSED && _chunks_per_mesh >= W_WSCENE_CHUNKS_PER_MESH_V3)
+        {
+            _hr = s_load_chunk(_chunk[4], pWScene, pOwner, _mesh->packed_vertices, _jobs);
+            if (_hr == W_PASSED) _hr = s_load_chunk(_chunk[5], pWScene, pOwner, _mesh->lod_1_packed_vertices, _jobs);
+        }
+        if (_hr == W_PASSED && _chunks_per_mesh >= W_WSCENE_CHUNKS_PER_MESH)
+        {
+            _hr = s_load_chunk(_chunk[6], pWScene, pOwner, _mesh->positions, _jobs);
+            if (_hr == W_PASSED) _hr = s_load_chunk(_chunk[7], pWScene, pOwner, _mesh->attributes, _jobs);
+        }
+    }
+    if (_hr == W_FAILED)
+    {
+        W_V(W_FAILED, w_log_type::W_ERROR, "geometry chunks of .wscene are corrupted. trace info: {}", _trace_info);
+        pScenes.clear();
+        return W_FAILED;
+    }
+
+    std::atomic<bool> _failed(false);
+    s_run(_jobs.size(), pThreadPool, [&](const size_t& pIndex)
+    {
+        auto& _job = _jobs[pIndex];
+        if (w_compress_blocks::read(
+            reinterpret_cast<const char*>(_job.src),
+            _job.src_size,
+            0,
+            _job.dst_size,
+            reinterpret_cast<char*>(_job.dst),
+            nullptr) == W_FAILED)
+        {
+            _failed = true;
+        }
+    });
+    if (_failed)
+    {
+        W_V(W_FAILED, w_log_type::W_ERROR, "could not decompress geometry chunks of .wscene. trace info: {}", _trace_info);
+        pScenes.clear();
+        return W_FAILED;
+    }
+
+    //meshes which were stored only as packed vertices stay packed, callers which need w_vertex_struct call unpack_vertices
+#pragma endregion
+
+    return W_PASSED;
+}
+
+W_RESULT w_cpipeline_wscene::load_from_file(
+    _In_z_      const std::string& pPath,
+    _Inout_     std::vector<w_cpipeline_scene>& pScenes,
+    _In_opt_    w_thread_pool* pThreadPool)
+{
+    //meshes may modify their vertices in place, so pages are mapped as copy on write
+    auto _file = std::make_shared<w_file_view>();
+    if (_file->open(pPath.c_str(), W_FILE_VIEW_SEQUENTIAL, true) == W_FAILED) return W_FAILED;
+
+    return load_from_memory(_file->get_writable_data(), _file->get_size(), _file, pScenes, pThreadPool);
+}
+
+#pragma region Getters
+
+bool w_cpipeline_wscene::get_is_wscene(_In_ const uint8_t* pBuffer, _In_ const size_t& pSize)
+{
+    if (!pBuffer || pSize < W_WSCENE_HEADER_SIZE) return false;
+
+    uint32_t _magic;
+    std::memcpy(&_magic, pBuffer, sizeof(_magic));
+    return _magic == W_WSCENE_MAGIC;
+}
+
+#pragma endregion
@@ -0,0 +1,103 @@
+/*
+	Project			 : Wolf Engine. Copyright(c) Pooya Eimandar (http://PooyaEimandar.com) . All rights reserved.
+	Source			 : Please direct any bug to https://github.com/PooyaEimandar/Wolf.Engine/issues
+	Website			 : http://WolfSource.io
+	Name			 : w_cpipeline_wscene.h
+	Description		 : Version 2 of .wscene, a binary container which can be mapped and used in place
+	Comment          : layout is header, table of contents, then chunks. The first chunk is msgpack of scenes without geometry,
+					   the rest are vertices, indices, lod_1_vertices, lod_1_indices, packed_vertices, lod_1_packed_vertices, positions and attributes
+					   of each mesh in order of models and meshes, files of header version 2 do not have packed vertices and files of version 3 do not have streams.
+					   Uncompressed chunks are aligned to 16 bytes and meshes become views into the mapping, compressed chunks are
+					   block containers of w_compress_blocks. Geometry is stored in little endian with the memory layout of
+					   w_vertex_struct, w_vertex_struct_packed and w_vertex_attributes_struct
+*/
+
+#if _MSC_VER > 1000
+#pragma once
+#endif
+
+#ifndef __W_CPIPELINE_WSCENE_H__
+#define __W_CPIPELINE_WSCENE_H__
+
+#include "w_cpipeline_export.h"
+#include "w_cpipeline_scene.h"
+#include <w_compress_blocks.h>
+#include <memory>
+
+namespace wolf
+{
+	namespace system
+	{
+		class w_thread_pool;
+	}
+
+	namespace content_pipeline
+	{
+        struct w_cpipeline_wscene_config
+        {
+            //compress each chunk with LZ4, compressed chunks must be decompressed on load, so use it for distribution not for iteration
+            bool                                        compress = false;
+            //chunks smaller than this size are stored uncompressed
+            uint32_t                                    min_compress_size_in_bytes = 4096;
+            //store w_vertex_struct_packed of meshes, meshes which do not have packed vertices are packed before writing
+            bool                                        pack_vertices = false;
+            //store positions and attributes streams instead of w_vertex_struct, meshes which are not split are split before writing. CPU passes read positions of loaded meshes in place
+            bool                                        split_vertices = false;
+            //store w_vertex_struct and streams of split meshes too, otherwise only packed vertices are stored if pack_vertices is true or only streams if split_vertices is true
+            bool                                        keep_vertices = false;
+            wolf::system::w_compress_blocks_config      blocks;
+        };
+
+        struct w_cpipeline_wscene
+        {
+            /*
+                write scenes as .wscene v2
+                @param pScenes, the scenes, they will be restored after writing. If pack_vertices or split_vertices is true, packed vertices or streams of meshes will be generated
+                @param pWScene, the content of file
+                @param pConfig, the configuration of chunks
+                @param pThreadPool, the thread pool which compresses chunks, nullptr means the calling thread
+                @return W_PASSED on success
+            */
+            WCP_EXP static W_RESULT save_to_memory(
+                _Inout_     std::vector<w_cpipeline_scene>& pScenes,
+                _Inout_     std::vector<uint8_t>& pWScene,
+                _In_        const w_cpipeline_wscene_config& pConfig = w_cpipeline_wscene_config(),
+                _In_opt_    wolf::system::w_thread_pool* pThreadPool = nullptr);
+
+            WCP_EXP static W_RESULT save_to_file(
+                _Inout_     std::vector<w_cpipeline_scene>& pScenes,
+                _In_z_      const std::string& pPath,
+                _In_        const w_cpipeline_wscene_config& pConfig = w_cpipeline_wscene_config(),
+                _In_opt_    wolf::system::w_thread_pool* pThreadPool = nullptr);
+
+            /*
+                load scenes from .wscene v2
+                @param pWScene, content of file, it must be aligned to 16 bytes if pOwner is not nullptr, e.g. data of w_file_view
+                @param pSize, size of content
+                @param pOwner, the owner of content, meshes keep it alive and use content in place. If it is nullptr geometry will be copied
+                @param pScenes, the loaded scenes, meshes which were stored only as packed vertices keep only packed_vertices, call w_cpipeline_mesh::unpack_vertices before reading their vertices
+                @param pThreadPool, the thread pool which decompresses chunks, nullptr means the calling thread
+                @return W_PASSED on success
+            */
+            WCP_EXP static W_RESULT load_from_memory(
+                _In_        uint8_t* pWScene,
+                _In_        const size_t& pSize,
+                _In_        const std::shared_ptr<void>& pOwner,
+                _Inout_     std::vector<w_cpipeline_scene>& pScenes,
+                _In_opt_    wolf::system::w_thread_pool* pThreadPool = nullptr);
+
+            //map file as copy on write and load it in place
+            WCP_EXP static W_RESULT load_from_file(
+                _In_z_      const std::string& pPath,
+                _Inout_     std::vector<w_cpipeline_scene>& pScenes,
+                _In_opt_    wolf::system::w_thread_pool* pThreadPool = nullptr);
+
+#pragma region Getters
+            //returns true if buffer starts with header of .wscene v2
+            WCP_EXP static bool get_is_wscene(_In_ const uint8_t* pBuffer, _In_ const size_t& pSize);
+#pragma endregion
+        };
+	}
+}
+
+#endif //__W_CPIPELINE_WSCENE_H__
@@ -18,6 +18,7 @@
 #include <glm/vec3.hpp>
 #include <glm/vec4.hpp>
 #include <glm/gtx/compatibility.hpp>
+#include <glm/gtc/type_precision.hpp>
 
 namespace wolf
 {
@@ -82,6 +83,17 @@ namespace wolf
 				glm::vec4 blend_weight;
 				glm::int4 blend_indices;
 			};
+
+			//same layout as w_vertex_struct_packed, see w_vertex_struct.h for decoding
+			struct vertex_packed_position_normal_uv_tangent_weight_indices
+			{
+				glm::u16vec4 position;//UNORM16 relative to bounding box, w is sign of binormal
+				glm::i16vec2 normal;//octahedral SNORM16
+				glm::i16vec2 tangent;//octahedral SNORM16
+				glm::u16vec2 uv;//half float
+				glm::u8vec4	 blend_weight;//UNORM8
+				glm::u8vec4	 blend_indices;//UINT8
+			};
 		}
 	}
 }
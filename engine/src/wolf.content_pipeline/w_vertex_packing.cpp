@@ -0,0 +1,228 @@
+#include "w_cpipeline_pch.h"
+#include "w_vertex_packing.h"
+#include <glm/gtc/packing.hpp>
+
+using namespace wolf::system;
+using namespace wolf::content_pipeline;
+
+static_assert(sizeof(w_vertex_struct_packed) == 28, "w_vertex_struct_packed must not have padding");
+
+static inline float s_clamp(_In_ const float& pValue, _In_ const float& pMin, _In_ const float& pMax)
+{
+    return pValue < pMin ? pMin : (pValue > pMax ? pMax : pValue);
+}
+
+static inline float s_sign_not_zero(_In_ const float& pValue)
+{
+    return pValue >= 0.0f ? 1.0f : -1.0f;
+}
+
+static inline int16_t s_to_snorm16(_In_ const float& pValue)
+{
+    return static_cast<int16_t>(std::lround(s_clamp(pValue, -1.0f, 1.0f) * 32767.0f));
+}
+
+static inline float s_from_snorm16(_In_ const int16_t& pValue)
+{
+    //-32768 and -32767 are both -1
+    return s_clamp(static_cast<float>(pValue) / 32767.0f, -1.0f, 1.0f);
+}
+
+void w_vertex_packing::encode_octahedral(_In_ const float* pDirection, _Out_ int16_t* pEncoded)
+{
+    const float _sum = std::fabs(pDirection[0]) + std::fabs(pDirection[1]) + std::fabs(pDirection[2]);
+    if (_sum <= 0.0f || !std::isfinite(_sum))
+    {
+        pEncoded[0] = pEncoded[1] = 0;
+        return;
+    }
+
+    //project to octahedron, then fold lower hemisphere over upper one
+    float _x = pDirection[0] / _sum;
+    float _y = pDirection[1] / _sum;
+    if (pDirection[2] < 0.0f)
+    {
+        const float _fold_x = (1.0f - std::fabs(_y)) * s_sign_not_zero(_x);
+        const float _fold_y = (1.0f - std::fabs(_x)) * s_sign_not_zero(_y);
+        _x = _fold_x;
+        _y = _fold_y;
+    }
+
+    pEncoded[0] = s_to_snorm16(_x);
+    pEncoded[1] = s_to_snorm16(_y);
+}
+
+void w_vertex_packing::decode_octahedral(_In_ const int16_t* pEncoded, _Out_ float* pDirection)
+{
+    float _x = s_from_snorm16(pEncoded[0]);
+    float _y = s_from_snorm16(pEncoded[1]);
+    const float _z = 1.0f - std::fabs(_x) - std::fabs(_y);
+    if (_z < 0.0f)
+    {
+        const float _t = -_z;
+        _x += _x >= 0.0f ? -_t : _t;
+        _y += _y >= 0.0f ? -_t : _t;
+    }
+
+    const float _length = std::sqrt(_x * _x + _y * _y + _z * _z);
+    pDirection[0] = _x / _length;
+    pDirection[1] = _y / _length;
+    pDirection[2] = _z / _length;
+}
+
+W_RESULT w_vertex_packing::pack(
+    _In_ const w_vertex_struct* pVertices,
+    _In_ const size_t& pCount,
+    _In_ const w_bounding_box& pBoundingBox,
+    _Out_ w_vertex_struct_packed* pPacked)
+{
+    const char* _trace_info = "w_vertex_packing::pack";
+
+    //8 bit blend indices can not address more than 256 bones
+    for (size_t v = 0; v < pCount; ++v)
+    {
+        for (int i = 0; i < 4; ++i)
+        {
+            const int _index = pVertices[v].blend_indices[i];
+            if (_index < 0 || _index > 255)
+            {
+                W_V(W_FAILED,
+                    w_log_type::W_ERROR,
+                    "blend index {} of vertex {} is out of range of packed vertices, skeleton must not have more than 256 bones. trace info: {}",
+                    _index, v, _trace_info);
+                return W_FAILED;
+            }
+        }
+    }
+
+    float _scale[3];
+    for (int i = 0; i < 3; ++i)
+    {
+        const float _extent = pBoundingBox.max[i] - pBoundingBox.min[i];
+        _scale[i] = _extent > 0.0f ? 65535.0f / _extent : 0.0f;
+    }
+
+    for (size_t v = 0; v < pCount; ++v)
+    {
+        auto& _src = pVertices[v];
+        auto& _dst = pPacked[v];
+
+        for (int i = 0; i < 3; ++i)
+        {
+            _dst.position[i] = static_cast<uint16_t>(std::lround(
+                s_clamp((_src.position[i] - pBoundingBox.min[i]) * _scale[i], 0.0f, 65535.0f)));
+        }
+
+        encode_octahedral(_src.normal, _dst.normal);
+        encode_octahedral(_src.tangent, _dst.tangent);
+
+        //handedness of tangent frame, binormal will be cross(normal, tangent) * sign
+        const float _cross[3] =
+        {
+            _src.normal[1] * _src.tangent[2] - _src.normal[2] * _src.tangent[1],
+            _src.normal[2] * _src.tangent[0] - _src.normal[0] * _src.tangent[2],
+            _src.normal[0] * _src.tangent[1] - _src.normal[1] * _src.tangent[0]
+        };
+        const float _dot = _cross[0] * _src.binormal[0] + _cross[1] * _src.binormal[1] + _cross[2] * _src.binormal[2];
+        _dst.position[3] = _dot < 0.0f ? 0 : 65535;
+
+        _dst.uv[0] = glm::packHalf1x16(_src.uv[0]);
+        _dst.uv[1] = glm::packHalf1x16(_src.uv[1]);
+
+        //quantize weights and give rounding error to the biggest one, so they still sum to 255
+        int _sum = 0, _biggest = 0;
+        for (int i = 0; i < 4; ++i)
+        {
+            _dst.blend_weight[i] = static_cast<uint8_t>(std::lround(s_clamp(_src.blend_weight[i], 0.0f, 1.0f) * 255.0f));
+            _sum += _dst.blend_weight[i];
+            if (_dst.blend_weight[i] > _dst.blend_weight[_biggest]) _biggest = i;
+
+            _dst.blend_indices[i] = static_cast<uint8_t>(_src.blend_indices[i]);
+        }
+        if (_sum && _sum != 255)
+        {
+            const int _weight = _dst.blend_weight[_biggest] + 255 - _sum;
+            _dst.blend_weight[_biggest] = static_cast<uint8_t>(_weight < 0 ? 0 : (_weight > 255 ? 255 : _weight));
+        }
+    }
+
+    return W_PASSED;
+}
+
+void w_vertex_packing::unpack(
+    _In_ const w_vertex_struct_packed* pPacked,
+    _In_ const size_t& pCount,
+    _In_ const w_bounding_box& pBoundingBox,
+    _Out_ w_vertex_struct* pVertices)
+{
+    float _scale[3];
+    for (int i = 0; i < 3; ++i)
+    {
+        _scale[i] = (pBoundingBox.max[i] - pBoundingBox.min[i]) / 65535.0f;
+    }
+
+    for (size_t v = 0; v < pCount; ++v)
+    {
+        auto& _src = pPacked[v];
+        auto& _dst = pVertices[v];
+        _dst = {};
+
+        for (int i = 0; i < 3; ++i)
+        {
+            _dst.position[i] = pBoundingBox.min[i] + static_cast<float>(_src.position[i]) * _scale[i];
+        }
+
+        decode_octahedral(_src.normal, _dst.normal);
+        decode_octahedral(_src.tangent, _dst.tangent);
+
+        const float _sign = _src.position[3] ? 1.0f : -1.0f;
+        _dst.binormal[0] = (_dst.normal[1] * _dst.tangent[2] - _dst.normal[2] * _dst.tangent[1]) * _sign;
+        _dst.binormal[1] = (_dst.normal[2] * _dst.tangent[0] - _dst.normal[0] * _dst.tangent[2]) * _sign;
+        _dst.binormal[2] = (_dst.normal[0] * _dst.tangent[1] - _dst.normal[1] * _dst.tangent[0]) * _sign;
+
+        _dst.uv[0] = glm::unpackHalf1x16(_src.uv[0]);
+        _dst.uv[1] = glm::unpackHalf1x16(_src.uv[1]);
+
+        for (int i = 0; i < 4; ++i)
+        {
+            _dst.blend_weight[i] = static_cast<float>(_src.blend_weight[i]) / 255.0f;
+            _dst.blend_indices[i] = _src.blend_indices[i];
+        }
+    }
+}
+
+void w_vertex_packing::store_to_batch(
+    _In_ const w_vertex_struct_packed* pPacked,
+    _In_ const size_t& pCount,
+    _Inout_ std::vector<float>& pBatchVertices)
+{
+    static_assert(sizeof(w_vertex_struct_packed) % sizeof(float) == 0, "packed vertex must be a multiple of 4 bytes");
+
+    const size_t _offset = pBatchVertices.size();
+    pBatchVertices.resize(_offset + pCount * sizeof(w_vertex_struct_packed) / sizeof(float));
+    if (pCount)
+    {
+        std::memcpy(&pBatchVertices[_offset], pPacked, pCount * sizeof(w_vertex_struct_packed));
+    }
+}
+
+void w_vertex_packing::unpack_positions(
+    _In_ const w_vertex_struct_packed* pPacked,
+    _In_ const size_t& pCount,
+    _In_ const w_bounding_box& pBoundingBox,
+    _Out_ float* pPositions)
+{
+    float _scale[3];
+    for (int i = 0; i < 3; ++i)
+    {
+        _scale[i] = (pBoundingBox.max[i] - pBoundingBox.min[i]) / 65535.0f;
+    }
+
+    for (size_t v = 0; v < pCount; ++v)
+    {
+        for (int i = 0; i < 3; ++i)
+        {
+            pPositions[v * 3 + i] = pBoundingBox.min[i] + static_cast<float>(pPacked[v].position[i]) * _scale[i];
+        }
+    }
+}
@@ -0,0 +1,70 @@
+/*
+	Project			 : Wolf Engine. Copyright(c) Pooya Eimandar (http://PooyaEimandar.com) . All rights reserved.
+	Source			 : Please direct any bug to https://github.com/PooyaEimandar/Wolf.Engine/issues
+	Website			 : http://WolfSource.io
+	Name			 : w_vertex_packing.h
+	Description		 : Convert w_vertex_struct to w_vertex_struct_packed and back
+	Comment          : vertex_index and color are not packed, they are zero after unpacking
+*/
+
+#if _MSC_VER > 1000
+#pragma once
+#endif
+
+#ifndef __W_VERTEX_PACKING_H__
+#define __W_VERTEX_PACKING_H__
+
+#include "w_cpipeline_export.h"
+#include "w_vertex_struct.h"
+#include <w_bounding.h>
+#include <vector>
+
+namespace wolf
+{
+	namespace content_pipeline
+	{
+        struct w_vertex_packing
+        {
+            /*
+                pack vertices
+                @param pVertices, the vertices
+                @param pCount, number of vertices
+                @param pBoundingBox, positions are quantized relative to this box, positions out of box are clamped
+                @param pPacked, the output, it must have room for pCount vertices
+                @return W_FAILED if a blend index is out of 0 to 255, in this case pPacked is not changed
+            */
+            WCP_EXP static W_RESULT pack(
+                _In_ const w_vertex_struct* pVertices,
+                _In_ const size_t& pCount,
+                _In_ const wolf::system::w_bounding_box& pBoundingBox,
+                _Out_ w_vertex_struct_packed* pPacked);
+
+            //unpack vertices which were packed with the same bounding box
+            WCP_EXP static void unpack(
+                _In_ const w_vertex_struct_packed* pPacked,
+                _In_ const size_t& pCount,
+                _In_ const wolf::system::w_bounding_box& pBoundingBox,
+                _Out_ w_vertex_struct* pVertices);
+
+            //unpack only positions to x, y and z of each vertex, pPositions must have room for pCount * 3 floats
+            WCP_EXP static void unpack_positions(
+                _In_ const w_vertex_struct_packed* pPacked,
+                _In_ const size_t& pCount,
+                _In_ const wolf::system::w_bounding_box& pBoundingBox,
+                _Out_ float* pPositions);
+
+            //append raw bytes of packed vertices to a vertex batch, each vertex takes 7 floats of batch
+            WCP_EXP static void store_to_batch(
+                _In_ const w_vertex_struct_packed* pPacked,
+                _In_ const size_t& pCount,
+                _Inout_ std::vector<float>& pBatchVertices);
+
+            //encode a direction to octahedral SNORM16, zero vector is encoded as +Z
+            WCP_EXP static void encode_octahedral(_In_ const float* pDirection, _Out_ int16_t* pEncoded);
+            //decode an octahedral SNORM16 to a unit direction
+            WCP_EXP static void decode_octahedral(_In_ const int16_t* pEncoded, _Out_ float* pDirection);
+        };
+	}
+}
+
+#endif //__W_VERTEX_PACKING_H__
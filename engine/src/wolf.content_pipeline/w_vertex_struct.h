@@ -71,6 +71,39 @@ namespace wolf
 
 #endif
 		};
+
+        //attributes of w_vertex_struct except position, in the same order, it is the attribute stream of w_cpipeline_mesh
+        struct w_vertex_attributes_struct
+        {
+            float		    normal[3];
+            float		    uv[2];
+            float		    blend_weight[4];
+            int	            blend_indices[4];
+            float		    tangent[3];
+            float		    binormal[3];
+            float		    color[4];
+            uint32_t	    vertex_index;
+
+            MSGPACK_DEFINE(normal, uv, blend_weight, blend_indices, tangent, binormal, color, vertex_index);
+        };
+
+        /*
+            compact vertex of static and skinned meshes, 28 bytes instead of 108 bytes of w_vertex_struct
+            position is UNORM16 relative to bounding box of mesh, position = min + position * (max - min). The 4th component is sign of binormal,
+            binormal = cross(normal, tangent) * (position[3] ? 1 : -1). Normal and tangent are octahedral SNORM16, uv is half float,
+            blend weight is UNORM8 and blend indices are UINT8
+        */
+        struct w_vertex_struct_packed
+        {
+            uint16_t        position[4];
+            int16_t         normal[2];
+            int16_t         tangent[2];
+            uint16_t        uv[2];
+            uint8_t         blend_weight[4];
+            uint8_t         blend_indices[4];
+
+            MSGPACK_DEFINE(position, normal, tangent, uv, blend_weight, blend_indices);
+        };
     }
 }
 
@@ -16,7 +16,7 @@ void obj::write(
 	_In_ std::vector<uint32_t>& pIndicesData,
 	_In_z_ const std::string& pOutputFilePath)
 {
-	const std::string _trace_info = "w_wavefront_obj::write";
+	const char* _trace_info = "w_wavefront_obj::write";
 
 	w_thread_pool _thread_pool;
 	_thread_pool.allocate(2);
@@ -52,6 +52,7 @@ void obj::write(
 				_trace_info);
 			continue;
 		}
+		w_job_counter _counter;
 		//vertex position in first thread
 		_thread_pool.add_job_for_thread(0, [&]()
 		{
@@ -72,7 +73,7 @@ void obj::write(
 			{
 				_v_i[_face_index] = std::distance(_pos.begin(), _iter_pos) + 1;
 			}
-		});
+		}, &_counter);
 
 		//write normal and uv in another thread
 		_thread_pool.add_job_for_thread(1, [&]()
@@ -109,9 +110,9 @@ void obj::write(
 			{
 				_vn_i[_face_index] = std::distance(_nor.begin(), _iter_nor) + 1;
 			}
-		});
+		}, &_counter);
 
-		_thread_pool.wait_all();
+		_thread_pool.wait(_counter);
 
 		_face_index++;
 		if (_face_index == 3)
@@ -154,7 +155,7 @@ W_RESULT obj::read(
 	//_Inout_ std::vector<float>& pJustVertexPosition,
 	_In_z_ const std::string& pInputFilePath)
 {
-	const std::string _trace_info = "w_wavefront_obj::read";
+	const char* _trace_info = "w_wavefront_obj::read";
 
 	tinyobj::attrib_t attrib;
 	std::vector<tinyobj::shape_t> shapes;
@@ -78,7 +78,7 @@ namespace wolf
 
             W_RESULT open_media(_In_z_ std::wstring pMediaPath, _In_ int64_t pSeekToFrame)
             {
-				const auto _trace_info = this->_name + "::open_media";
+				const char* _trace_info = "w_media_core::open_media";
 
                 if (pMediaPath.empty()) return W_FAILED;
 
@@ -110,7 +110,7 @@ namespace wolf
                     if (avformat_open_input(&_av_format_ctx, this->_media_full_path.c_str(), NULL, NULL) != 0)
                     {
                         hr = W_FAILED;
-                        V(hr, "openning file. trace info: {}", _trace_info);
+                        W_V(hr, w_log_type::W_ERROR, "openning file. trace info: {}", _trace_info);
                         release_media();
                         return hr;
                     }
@@ -119,7 +119,7 @@ namespace wolf
 					if (avformat_find_stream_info(_av_format_ctx, NULL) < 0)
 					{
 						hr = W_FAILED;
-						V(hr, "finding file stream information. trace info: {}", _trace_info);
+						W_V(hr, w_log_type::W_ERROR, "finding file stream information. trace info: {}", _trace_info);
 						release_media();
 						return hr;
 					}
@@ -140,19 +140,19 @@ namespace wolf
                     {
                         hr = W_FAILED;
 						_has_video_stream = false;
-                        V(hr, "finding stream of video, media file does not have any video frame. trace info: {}", _trace_info);
+                        W_V(hr, w_log_type::W_INFO, "finding stream of video, media file does not have any video frame. trace info: {}", _trace_info);
                     }
                     if (this->_audio_stream_index <= -1)
                     {
                         hr = W_FAILED;
 						_has_audio_stream = false;
-                        V(hr, "finding stream of audio, media file does not have any audio frame. trace info: {}", _trace_info);
+                        W_V(hr, w_log_type::W_INFO, "finding stream of audio, media file does not have any audio frame. trace info: {}", _trace_info);
                     }
 
                     if (!_has_video_stream && !_has_audio_stream)
                     {
 						hr = W_FAILED;
-						V(hr, "File {} did not load. trace info: {}", this->_media_full_path, _trace_info);
+						W_V(hr, w_log_type::W_ERROR, "File {} did not load. trace info: {}", this->_media_full_path, _trace_info);
                         release_media();
                         return W_FAILED;
                     }
@@ -257,7 +257,7 @@ namespace wolf
                         if (_video_codec.avCodec == NULL)
                         {
                             hr = W_FAILED;
-                            V(hr, "unsupported codec for video. trace info: {}.", _trace_info);
+                            W_V(hr, w_log_type::W_ERROR, "unsupported codec for video. trace info: {}.", _trace_info);
                             release_media();
                             return hr;
                         }
@@ -266,7 +266,7 @@ namespace wolf
                         if (avcodec_open2(_video_codec.avCodecCtx, _video_codec.avCodec, NULL) < 0)
                         {
                             hr = W_FAILED;
-                            V(hr, "could not open video codec. trace info: {}", _trace_info);
+                            W_V(hr, w_log_type::W_ERROR, "could not open video codec. trace info: {}", _trace_info);
                             release_media();
                             return hr;
                         }
@@ -309,7 +309,7 @@ namespace wolf
 						if (_audio_codec.avCodec == NULL)
 						{
 							hr = W_FAILED;
-							V(hr, "unsupported codec for audio. trace info: {}", _trace_info);
+							W_V(hr, w_log_type::W_ERROR, "unsupported codec for audio. trace info: {}", _trace_info);
 							release_media();
 							return hr;
 						}
@@ -317,7 +317,7 @@ namespace wolf
 						if (avcodec_open2(_audio_codec.avCodecCtx, _audio_codec.avCodec, NULL) < 0)
 						{
 							hr = W_FAILED;
-							V(hr, "could not open audio codec. trace info: {}", _trace_info);
+							W_V(hr, w_log_type::W_ERROR, "could not open audio codec. trace info: {}", _trace_info);
 							release_media();
 							return hr;
 						}
@@ -381,19 +381,19 @@ namespace wolf
 				_In_ w_signal<void(const w_media_core::w_stream_frame_info&)>& pOnFillingVideoFrameBuffer,
 				_In_ w_signal<void(const char*)>& pOnConnectionClosed)
 			{
-				const std::string _trace_info = this->_name + "::open_stream_server";
+				const char* _trace_info = "w_media_core::open_stream_server";
 
 				//create output context
 				avformat_alloc_output_context2(&this->_stream_out_ctx, NULL, pFormatName, pURL);
 				if (!this->_stream_out_ctx)
 				{
-					V(W_FAILED, w_log_type::W_ERROR,
+					W_V(W_FAILED, w_log_type::W_ERROR,
 						"allocating output context for output streaming {}. trace info: {}", pURL, _trace_info);
 					return W_FAILED;
 				}
 				if (!this->_stream_out_ctx->oformat)
 				{
-					V(W_FAILED, w_log_type::W_ERROR,
+					W_V(W_FAILED, w_log_type::W_ERROR,
 						"creating output streaming {} format: {}. trace info: {}", pURL, pFormatName, _trace_info);
 					release_output_stream_server();
 					return W_FAILED;
@@ -403,7 +403,7 @@ namespace wolf
 				auto _stream_video_codec = avcodec_find_encoder(pCodecID);
 				if (!_stream_video_codec)
 				{
-					V(W_FAILED, w_log_type::W_ERROR,
+					W_V(W_FAILED, w_log_type::W_ERROR,
 						"finding encoder for codec id: {} for output stream {}. trace info: {}",
 						avcodec_get_name(pCodecID), pURL, _trace_info);
 					release_output_stream_server();
@@ -414,7 +414,7 @@ namespace wolf
 					this->_stream_out = avformat_new_stream(this->_stream_out_ctx, _stream_video_codec);
 					if (!this->_stream_out)
 					{
-						V(W_FAILED, w_log_type::W_ERROR,
+						W_V(W_FAILED, w_log_type::W_ERROR,
 							"allocating output stream {}. trace info: {}", pURL, _trace_info);
 						release_output_stream_server();
 						return W_FAILED;
@@ -448,7 +448,7 @@ namespace wolf
 				//now open video stream 
 				if (avcodec_open2(this->_stream_out->codec, _stream_video_codec, &_av_dic))
 				{
-					V(W_FAILED, w_log_type::W_ERROR,
+					W_V(W_FAILED, w_log_type::W_ERROR,
 						"opening video codec for output stream {}. trace info: {}", pURL, _trace_info);
 					release_output_stream_server();
 					return W_FAILED;
@@ -459,7 +459,7 @@ namespace wolf
 					this->_stream_out_frame = av_frame_alloc();
 					if (!this->_stream_out_frame)
 					{
-						V(W_FAILED, w_log_type::W_ERROR,
+						W_V(W_FAILED, w_log_type::W_ERROR,
 							"allocating video stream frame for output stream {} . trace info: {}", pURL, _trace_info);
 						release_output_stream_server();
 						return W_FAILED;
@@ -476,7 +476,7 @@ namespace wolf
 						//Allocate the encoded raw picture.
 						if (avpicture_alloc(&_stream_dst_picture, this->_stream_out->codec->pix_fmt, _width, _height) < 0)
 						{
-							V(W_FAILED, w_log_type::W_ERROR,
+							W_V(W_FAILED, w_log_type::W_ERROR,
 								"allocating video stream picture for output stream {} . trace info: {}", pURL, _trace_info);
 							release_output_stream_server();
 							return W_FAILED;
@@ -491,7 +491,7 @@ namespace wolf
 
 				if (avformat_write_header(this->_stream_out_ctx, NULL) < 0)
 				{
-					V(W_FAILED, w_log_type::W_ERROR,
+					W_V(W_FAILED, w_log_type::W_ERROR,
 						"connecting to output stream server {}. trace info: {}", pURL, _trace_info);
 					release_output_stream_server();
 					return W_FAILED;
@@ -506,7 +506,7 @@ namespace wolf
 					pPixelFormat, 0, 0, 0, 0);
 				if (!_sws_ctx)
 				{
-					V(W_FAILED, w_log_type::W_ERROR,
+					W_V(W_FAILED, w_log_type::W_ERROR,
 						"getting sws context for output stream server {}. trace info: {}", pURL, _trace_info);
 					release_output_stream_server();
 					return W_FAILED;
@@ -561,7 +561,7 @@ namespace wolf
 							this->_stream_out_frame,
 							&_got_packet) < 0)
 						{
-							V(W_FAILED, w_log_type::W_ERROR,
+							W_V(W_FAILED, w_log_type::W_ERROR,
 								"encoding video frame for output stream {}. trace info: {}", pURL, _trace_info);
 						}
 						else
@@ -577,7 +577,7 @@ namespace wolf
 								if (av_write_frame(this->_stream_out_ctx, &_packet) < 0)
 								{
 									_frame_info.last_dropped_frames++;
-									V(W_FAILED, w_log_type::W_ERROR,
+									W_V(W_FAILED, w_log_type::W_ERROR,
 										"writing video frame for output stream {}. trace info: {}", pURL, _trace_info);
 								}
 								else
@@ -593,7 +593,7 @@ namespace wolf
 						_frame_info.frame_duration = std::chrono::duration_cast<std::chrono::milliseconds>(_now - _start_frame_time).count();
 						if (_frame_info.frame_duration > _frame_max_delay_in_ms)
 						{
-							V(W_FAILED, w_log_type::W_ERROR,
+							W_V(W_FAILED, w_log_type::W_ERROR,
 								"streaming delay is greater than max frame delay for output stream server {}. trace info: {}", pURL, _trace_info);
 							break;
 						}
@@ -638,7 +638,7 @@ namespace wolf
 				_In_ w_signal<void(const char*)>& pOnConnectionLost,
 				_In_ w_signal<void(const char*)>& pOnConnectionClosed)
 			{
-				const std::string _trace_info = this->_name + "::open_stream_client";
+				const char* _trace_info = "w_media_core::open_stream_client";
 
 				std::string _fromat_str(pFormatName);
 				std::transform(_fromat_str.begin(), _fromat_str.end(), _fromat_str.begin(), ::tolower);
@@ -654,21 +654,21 @@ namespace wolf
 				//create an input context
 				if (avformat_open_input(&_stream_in_format_ctx, pURL, NULL, &_av_dic) < 0)
 				{
-					V(W_FAILED, w_log_type::W_ERROR,
+					W_V(W_FAILED, w_log_type::W_ERROR,
 						"openning context for input stream {}. trace info: {}", pURL, _trace_info);
 					return W_FAILED;
 				}
 
 				if (!_stream_in_format_ctx)
 				{
-					V(W_FAILED, w_log_type::W_ERROR,
+					W_V(W_FAILED, w_log_type::W_ERROR,
 						"allocating context for input stream {}. trace info: {}", pURL, _trace_info);
 					return W_FAILED;
 				}
 
 				if (avformat_find_stream_info(_stream_in_format_ctx, NULL) < 0)
 				{
-					V(W_FAILED, w_log_type::W_ERROR,
+					W_V(W_FAILED, w_log_type::W_ERROR,
 						"could not find input stream {} format: {}. trace info: {}", pURL, pFormatName, _trace_info);
 					avformat_free_context(_stream_in_format_ctx);
 					return W_FAILED;
@@ -689,7 +689,7 @@ namespace wolf
 				auto _stream_in_frame_ctx = avformat_alloc_context();
 				if (!_stream_in_frame_ctx)
 				{
-					V(W_FAILED, w_log_type::W_ERROR,
+					W_V(W_FAILED, w_log_type::W_ERROR,
 						"allocating context for input stream: {}. trace info: {}", pURL, _trace_info);
 					avformat_free_context(_stream_in_format_ctx);
 					return W_FAILED;
@@ -702,7 +702,7 @@ namespace wolf
 				_codec = avcodec_find_decoder(pCodecID);
 				if (!_codec)
 				{
-					V(W_FAILED, w_log_type::W_ERROR,
+					W_V(W_FAILED, w_log_type::W_ERROR,
 						"could not find decoder for codec {}. input stream: {}. trace info: {}", pCodecID, pURL, _trace_info);
 					avformat_free_context(_stream_in_format_ctx);
 					avformat_free_context(_stream_in_frame_ctx);
@@ -713,7 +713,7 @@ namespace wolf
 				auto _codec_ctx = avcodec_alloc_context3(_codec);
 				if (!_codec_ctx)
 				{
-					V(W_FAILED, w_log_type::W_ERROR,
+					W_V(W_FAILED, w_log_type::W_ERROR,
 						"allocating context for codec {}. input stream: {}. trace info: {}", pCodecID, pURL, _trace_info);
 					avformat_free_context(_stream_in_format_ctx);
 					avformat_free_context(_stream_in_frame_ctx);
@@ -722,7 +722,7 @@ namespace wolf
 
 				if (avcodec_get_context_defaults3(_codec_ctx, _codec) < 0)
 				{
-					V(W_FAILED, w_log_type::W_ERROR,
+					W_V(W_FAILED, w_log_type::W_ERROR,
 						"getting context for codec {}. input stream: {}. trace info: {}", pCodecID, pURL, _trace_info);
 					avcodec_free_context(&_codec_ctx);
 					avformat_free_context(_stream_in_format_ctx);
@@ -733,7 +733,7 @@ namespace wolf
 				if (avcodec_copy_context(_codec_ctx,
 					_stream_in_format_ctx->streams[_video_stream_index]->codec) < 0)
 				{
-					V(W_FAILED, w_log_type::W_ERROR,
+					W_V(W_FAILED, w_log_type::W_ERROR,
 						"copying context for codec {}. input stream: {}. trace info: {}", pCodecID, pURL, _trace_info);
 					avcodec_free_context(&_codec_ctx);
 					avformat_free_context(_stream_in_format_ctx);
@@ -743,7 +743,7 @@ namespace wolf
 
 				if (avcodec_open2(_codec_ctx, _codec, NULL) < 0)
 				{
-					V(W_FAILED, w_log_type::W_ERROR,
+					W_V(W_FAILED, w_log_type::W_ERROR,
 						"opening codec {}. input stream: {}. trace info: {}", pCodecID, pURL, _trace_info);
 					avcodec_free_context(&_codec_ctx);
 					avformat_free_context(_stream_in_format_ctx);
@@ -756,7 +756,7 @@ namespace wolf
 					_stream_in_format_ctx->streams[_video_stream_index]->codec->codec);
 				if (!_stream_in)
 				{
-					V(W_FAILED, w_log_type::W_ERROR,
+					W_V(W_FAILED, w_log_type::W_ERROR,
 						"creating stream for {}. trace info: {}", pURL, _trace_info);
 					avcodec_free_context(&_codec_ctx);
 					avformat_free_context(_stream_in_format_ctx);
@@ -768,7 +768,7 @@ namespace wolf
 					_stream_in->codec,
 					_stream_in_format_ctx->streams[_video_stream_index]->codec) < 0)
 				{
-					V(W_FAILED, w_log_type::W_ERROR,
+					W_V(W_FAILED, w_log_type::W_ERROR,
 						"codec copy context for stream for {}. trace info: {}", pURL, _trace_info);
 					avcodec_close(_stream_in->codec);
 					avcodec_free_context(&_codec_ctx);
@@ -792,7 +792,7 @@ namespace wolf
 					NULL);
 				if (!_img_convert_ctx)
 				{
-					V(W_FAILED, w_log_type::W_ERROR,
+					W_V(W_FAILED, w_log_type::W_ERROR,
 						"getting sws context. input stream: {}. trace info: {}", pURL, _trace_info);
 					avcodec_close(_stream_in->codec);
 					avcodec_free_context(&_codec_ctx);
@@ -1005,17 +1005,37 @@ namespace wolf
             }
                       
 			W_RESULT write_video_frame_to_buffer(
-					wolf::system::w_memory_pool& pMemory,
+					wolf::system::w_ring_buffer& pMemory,
 					uint32_t pDownSamplingScale,
 					bool pBGRA_or_RGBA)
 			{
-				const std::string _trace_info = this->_name + "::write_video_frame_to_buffer";
+				const char* _trace_info = "w_media_core::write_video_frame_to_buffer";
 
 				W_RESULT _hr = W_PASSED;
 
 				auto _width = get_video_frame_width();
 				auto _height = get_video_frame_height();
 
+				auto _down_sample_width = _width;
+				auto _down_sample_height = _height;
+				if (pDownSamplingScale > 1)
+				{
+					_down_sample_width /= pDownSamplingScale;
+					_down_sample_height /= pDownSamplingScale;
+				}
+
+				//make sure the frame fits before decoding it, so no frame will be dropped
+				const size_t _write_size_in_bytes = 4/*RGBA or BGRA*/ * _down_sample_width * _down_sample_height * sizeof(uint8_t);
+				if (_write_size_in_bytes > pMemory.get_max_write_size())
+				{
+					_hr = W_FAILED;
+					if (_write_size_in_bytes > pMemory.get_capacity())
+					{
+						W_V(_hr, w_log_type::W_ERROR, "size of frame bytes is greater than size of ring buffer. trace info: {}", _trace_info);
+					}
+					return _hr;
+				}
+
 				int _got_frame = 0;
 				while (!_got_frame && av_read_frame(_av_format_ctx, this->_av_packet) >= 0)
 				{
@@ -1027,7 +1047,7 @@ namespace wolf
 						if (_result < 0)
 						{
 							_hr = W_FAILED;
-							V(_hr, w_log_type::W_ERROR, "decoding video frame. trace info: {}", _trace_info);
+							W_V(_hr, w_log_type::W_ERROR, "decoding video frame. trace info: {}", _trace_info);
 							return _hr;
 						}
 
@@ -1056,17 +1076,6 @@ namespace wolf
 						//Set the target convert properties
 						auto _format = (AVPixelFormat)this->_video_codec.avFrame->format;
 
-						auto _down_sample_width = _width;
-						auto _down_sample_height = _height;
-
-						bool _need_down_sampling = false;
-						if (pDownSamplingScale > 1)
-						{
-							_need_down_sampling = true;
-							_down_sample_width /= pDownSamplingScale;
-							_down_sample_height /= pDownSamplingScale;
-						}
-
 						struct SwsContext* _sws_context = sws_getContext(
 							_width,
 							_height,
@@ -1079,57 +1088,29 @@ namespace wolf
 							NULL,
 							NULL);
 
-						W_RESULT _hr = W_FAILED;
-						uint8_t* _frame = nullptr;
-						size_t _write_size_in_bytes = 0;
-						if (_need_down_sampling)
+						//convert the frame straight into the ring buffer, so it does not need any extra copy
+						auto _memory = pMemory.reserve_write(_write_size_in_bytes);
+						if (_memory)
 						{
-							//Re-Scale it
-							sws_scale(
-								_sws_context,
-								this->_video_codec.avFrame->data,
-								this->_video_codec.avFrame->linesize,
-								0,
-								_height,
-								this->_down_sample_avFrame->data,
-								this->_down_sample_avFrame->linesize);
+							uint8_t* _dst_data[4] = { _memory, nullptr, nullptr, nullptr };
+							int _dst_linesize[4] = { static_cast<int>(4 * _down_sample_width), 0, 0, 0 };
 
-							//get frame data
-							_frame = (uint8_t*)(this->_down_sample_avFrame->data[0]);
-							_write_size_in_bytes = 4/*RGBA or BGRA*/ * _down_sample_width * _down_sample_height * sizeof(uint8_t);
-						}
-						else
-						{
 							sws_scale(
 								_sws_context,
 								this->_video_codec.avFrame->data,
 								this->_video_codec.avFrame->linesize,
 								0,
 								_height,
-								this->_av_frame->data,
-								this->_av_frame->linesize);
+								_dst_data,
+								_dst_linesize);
 
-							//get frame data
-							_frame = (uint8_t*)(this->_av_frame->data[0]);
-							_write_size_in_bytes = 4/*RGBA or BGRA*/ * _width * _height * sizeof(uint8_t);
+							pMemory.commit(_write_size_in_bytes);
 						}
-
-						auto _memory_chuck_size_in_bytes = pMemory.get_size_in_bytes();
-						if (_write_size_in_bytes > _memory_chuck_size_in_bytes)
+						else
 						{
 							_hr = W_FAILED;
-							V(_hr, "size of frame bytes is greater than size of memory pool. trace info: {}", _trace_info);
-							break;
-						}
-
-						auto _memory = (uint8_t*)pMemory.get_start_ptr();
-						if (_memory)
-						{
-							//first clear memory
-							std::memcpy(&_memory[pMemory.write_index], &_frame[0], _write_size_in_bytes);
-							pMemory.write_index = (pMemory.write_index + _write_size_in_bytes) % _memory_chuck_size_in_bytes;
+							W_V(_hr, w_log_type::W_ERROR, "reserving memory of ring buffer for video frame. trace info: {}", _trace_info);
 						}
-						_frame = nullptr;
 						sws_freeContext(_sws_context);
 #pragma endregion
 					}
@@ -1652,14 +1633,14 @@ namespace wolf
             {
                 if (this->_audio_stream_index <= -1) return W_PASSED;
 
-				const std::string _trace_info = this->_name + "::_copy_audio_frame_to";
+				const char* _trace_info = "w_media_core::_copy_audio_frame_to";
 
                 int frameFinished = 0;
                 auto result = avcodec_decode_audio4(this->_audio_codec.avCodecCtx, this->_audio_codec.avFrame, &frameFinished, _av_packet);
                 if (result < 0)
                 {
                     auto hr = W_FAILED;
-                    V(hr, "decoding audio frame. trace info: {}", _trace_info);
+                    W_V(hr, w_log_type::W_ERROR, "decoding audio frame. trace info: {}", _trace_info);
                     return hr;
                 }
 
@@ -1879,7 +1860,7 @@ int w_media_core::seek_frame(int64_t pFrame)
 }
 
 W_RESULT w_media_core::write_video_frame_to_buffer(
-	wolf::system::w_memory_pool& pMemory,
+	wolf::system::w_ring_buffer& pMemory,
 	uint32_t pDownSamplingScale,
 	bool pBGRA_or_RGBA)
 {
@@ -14,7 +14,7 @@
 
 #include <w_object.h>
 #include <w_time_span.h>
-#include "w_memory_pool.h"
+#include "w_ring_buffer.h"
 #include <stdint.h>
 #include <memory>
 #include <array>
@@ -177,14 +177,14 @@ namespace wolf
             WMC_EXP int seek_frame_milliSecond(int64_t pMilliSecond);
 
 			/*
-				Store video frames data in to the memory pool:
-				@param	pMemory, memory pool for storing
+				Store video frames data in to the ring buffer, frames are converted in place without extra copies:
+				@param	pMemory, ring buffer for storing, the caller is the producer of ring buffer
 				@param	pDownSamplingScale, down sampling value, 1 is default value, send greater than 1 for downsampling
 				@param	pBGRA_or_RGBA, Number of samples of the image; The value greater than 1 means multisampling
 				@return W_PASSED when succeeded 
 			*/
 			WMC_EXP W_RESULT write_video_frame_to_buffer(
-				wolf::system::w_memory_pool& pMemory,
+				wolf::system::w_ring_buffer& pMemory,
 				uint32_t pDownSamplingScale = 1,
 				bool pBGRA_or_RGBA = true);
 
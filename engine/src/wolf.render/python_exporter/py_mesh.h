@@ -41,6 +41,7 @@ namespace pyWolf
 			.value("VERTEX_POSITION_NORMAL_UV_INDEX_TANGENT_BINORMAL", w_vertex_declaration::VERTEX_POSITION_NORMAL_UV_INDEX_TANGENT_BINORMAL)
 			.value("VERTEX_POSITION_NORMAL_UV_TANGENT_BINORMAL_BLEND_WEIGHT_BLEND_INDICES", w_vertex_declaration::VERTEX_POSITION_NORMAL_UV_TANGENT_BINORMAL_BLEND_WEIGHT_BLEND_INDICES)
 			.value("VERTEX_POSITION_NORMAL_UV_INDEX_TANGENT_BINORMAL_BLEND_WEIGHT_BLEND_INDICES", w_vertex_declaration::VERTEX_POSITION_NORMAL_UV_INDEX_TANGENT_BINORMAL_BLEND_WEIGHT_BLEND_INDICES)
+			.value("VERTEX_PACKED_POSITION_NORMAL_UV_TANGENT_BLEND_WEIGHT_BLEND_INDICES", w_vertex_declaration::VERTEX_PACKED_POSITION_NORMAL_UV_TANGENT_BLEND_WEIGHT_BLEND_INDICES)
 			.export_values()
 			;
 
@@ -41,13 +41,14 @@ namespace pyWolf
 		{
 			if (!pGDevice.get()) return W_FAILED;
 
-			const std::string _trace = this->_name + "update";
+			const char* _trace_info = "py_uniform::load";
 			if (!pBufferSize)
 			{
-				V(W_FAILED, "uniform buffer could not be zero" +
-					_gDevice->get_info(),
-					_trace,
-					3);
+				W_V(W_FAILED,
+					w_log_type::W_ERROR,
+					"uniform buffer could not be zero. graphics device: {}. trace info: {}",
+					pGDevice->get_info(),
+					_trace_info);
 				return W_FAILED;
 			}
 
@@ -66,10 +67,11 @@ namespace pyWolf
 
 				if (_hr == W_FAILED)
 				{
-					V(_hr, "loading host visible buffer " +
+					W_V(_hr,
+						w_log_type::W_ERROR,
+						"loading host visible buffer. graphics device: {}. trace info: {}",
 						this->_gDevice->get_info(),
-						_trace,
-						3);
+						_trace_info);
 					return _hr;
 				}
 			}
@@ -82,10 +84,11 @@ namespace pyWolf
 
 				if (_hr == W_FAILED)
 				{
-					V(_hr, "loading device buffer " +
+					W_V(_hr,
+						w_log_type::W_ERROR,
+						"loading device buffer. graphics device: {}. trace info: {}",
 						this->_gDevice->get_info(),
-						_trace,
-						3);
+						_trace_info);
 					return _hr;
 				}
 
@@ -96,20 +99,22 @@ namespace pyWolf
 					VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT);
 				if (_hr == W_FAILED)
 				{
-					V(_hr, "loading staging buffer " +
+					W_V(_hr,
+						w_log_type::W_ERROR,
+						"loading staging buffer. graphics device: {}. trace info: {}",
 						this->_gDevice->get_info(),
-						_trace,
-						3);
+						_trace_info);
 					return _hr;
 				}
 
 				_hr = this->_staging_buffer.bind();
 				if (_hr == W_FAILED)
 				{
-					V(_hr, "binding device buffer " +
+					W_V(_hr,
+						w_log_type::W_ERROR,
+						"binding device buffer. graphics device: {}. trace info: {}",
 						this->_gDevice->get_info(),
-						_trace,
-						3);
+						_trace_info);
 					return _hr;
 				}
 			}
@@ -117,10 +122,11 @@ namespace pyWolf
 			_hr = this->_buffer.bind();
 			if (_hr == W_FAILED)
 			{
-				V(_hr, "binding buffer " +
+				W_V(_hr,
+					w_log_type::W_ERROR,
+					"binding buffer. graphics device: {}. trace info: {}",
 					this->_gDevice->get_info(),
-					_trace,
-					3);
+					_trace_info);
 				return _hr;
 			}
 
@@ -129,27 +135,29 @@ namespace pyWolf
 
 		W_RESULT update(_In_ boost::python::list pDataStructure)
 		{
-			const std::string _trace = this->_name + "update";
+			const char* _trace_info = "py_uniform::update";
 
 			W_RESULT _hr = W_PASSED;
 
 			std::vector<float> _v;
 			if (!boost_list_to_std_vector(pDataStructure, _v))
 			{
-				V(_hr, "lenght of extracted list is not valid" +
+				W_V(W_FAILED,
+					w_log_type::W_ERROR,
+					"lenght of extracted list is not valid. graphics device: {}. trace info: {}",
 					_gDevice->get_info(),
-					_trace,
-					3);
+					_trace_info);
 				return W_FAILED;
 			}
 			
 			if (this->_host_visible)
 			{
 				_hr = this->_buffer.set_data(_v.data());
-				V(_hr, "setting to host visible buffer " +
+				W_V(_hr,
+					w_log_type::W_ERROR,
+					"setting to host visible buffer. graphics device: {}. trace info: {}",
 					_gDevice->get_info(),
-					_trace,
-					3);
+					_trace_info);
 			}
 			else
 			{
@@ -163,20 +171,22 @@ namespace pyWolf
 				else
 				{
 					_hr = W_FAILED;
-					V(_hr, "begining command buffer " +
+					W_V(_hr,
+						w_log_type::W_ERROR,
+						"begining command buffer. graphics device: {}. trace info: {}",
 						_gDevice->get_info(),
-						_trace,
-						3);
+						_trace_info);
 				}
 				this->_staging_buffer.unmap();
 
 				if (_hr == W_FAILED) return _hr;
 
 				_hr = this->_staging_buffer.copy_to(this->_buffer);
-				V(_hr, "copy staging buffer to device buffer " +
+				W_V(_hr,
+					w_log_type::W_ERROR,
+					"copy staging buffer to device buffer. graphics device: {}. trace info: {}",
 					_gDevice->get_info(),
-					_trace,
-					3);
+					_trace_info);
 			}
 
 			return _hr;
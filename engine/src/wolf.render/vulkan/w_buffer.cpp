@@ -32,7 +32,7 @@ namespace wolf
 					_In_ const w_memory_usage_flag& pMemoryFlag,
 					_In_ const bool& pAllocateFromMemoryPool)
 				{
-					const char* _trace_info = (this->_name + "::allocate").c_str();
+					const char* _trace_info = "w_buffer::allocate";
 
 					this->_gDevice = pGDevice;
 					this->_usage_flags = pUsageFlags;
@@ -63,7 +63,7 @@ namespace wolf
 							this->_memory_allocation_info);
 						if (!this->_memory_allocation)
 						{
-							V(W_FAILED,
+							W_V(W_FAILED,
 								w_log_type::W_ERROR,
 								"allocating memory for graphics device: {}. trace info: {}",
 								this->_gDevice->get_info(),
@@ -102,7 +102,7 @@ namespace wolf
 							&this->_buffer_handle.handle);
 						if (_hr)
 						{
-							V(W_FAILED,
+							W_V(W_FAILED,
 								w_log_type::W_ERROR,
 								"creating buffer for graphics device: {}. trace info: {}",
 								this->_gDevice->get_info(),
@@ -125,7 +125,7 @@ namespace wolf
 							_memory_property_flags,
 							&_mem_index))
 						{
-							V(W_FAILED,
+							W_V(W_FAILED,
 								w_log_type::W_ERROR,
 								"finding memory index of buffer for graphics device: {}. trace info; {}",
 								this->_gDevice->get_info(),
@@ -146,7 +146,7 @@ namespace wolf
 							&this->_memory_allocation_info.deviceMemory))
 						{
 
-							V(W_FAILED,
+							W_V(W_FAILED,
 								w_log_type::W_ERROR,
 								"allocating memory of buffer for graphics device: {}. trace info: {}",
 								this->_gDevice->get_info(),
@@ -168,7 +168,7 @@ namespace wolf
 
 				W_RESULT reallocate(_In_ uint32_t& pBufferSizeInBytes)
 				{
-					//const char* _trace_info = (this->_name + "::reallocate").c_str();
+					//const char* _trace_info = "w_buffer::reallocate";
 
 					if (!this->_gDevice) return W_FAILED;
 
@@ -210,14 +210,14 @@ namespace wolf
 
 				W_RESULT copy_to(_In_ w_buffer& pDestinationBuffer)
 				{
-					const char* _trace_info = (this->_name + "::copy_to").c_str();
+					const char* _trace_info = "w_buffer::copy_to";
 
 					//create one command buffer
 					w_command_buffers _copy_command_buffer;
 					auto _hr = _copy_command_buffer.load(this->_gDevice, 1);
 					if (_hr != W_PASSED)
 					{
-						V(W_FAILED,
+						W_V(W_FAILED,
 							w_log_type::W_ERROR,
 							"loading command buffer for graphics device: {}. trace info: {}",
 							_gDevice->get_info(),
@@ -228,7 +228,7 @@ namespace wolf
 					_hr = _copy_command_buffer.begin(0);
 					if (_hr != W_PASSED)
 					{
-						V(W_FAILED,
+						W_V(W_FAILED,
 							w_log_type::W_ERROR,
 							"begining command buffer for graphics device: {}. trace info: {}",
 							_gDevice->get_info(),
@@ -259,7 +259,7 @@ namespace wolf
 					if (_hr != W_PASSED)
 					{
 						_copy_cmd.handle = nullptr;
-						V(W_FAILED,
+						W_V(W_FAILED,
 							w_log_type::W_ERROR,
 							"flushing command buffer of graphics device: {}. trace info: {}",
 							_gDevice->get_info(),
@@ -275,14 +275,14 @@ namespace wolf
 
 				void* map()
 				{
-					const char* _trace_info = (this->_name + "::map").c_str();
+					const char* _trace_info = "w_buffer::map";
 
 					if (this->_allocated_from_pool)
 					{
 						if (this->_gDevice->memory_allocator.map(this->_memory_allocation, &this->_map_data) == W_FAILED)
 						{
 							this->_map_data = nullptr;
-							V(W_FAILED,
+							W_V(W_FAILED,
 								w_log_type::W_ERROR,
 								"mapping memory for graphics device: {}. trace info: {}",
 								this->_gDevice->get_info(),
@@ -301,7 +301,7 @@ namespace wolf
 							&this->_map_data))
 						{
 							this->_map_data = nullptr;
-							V(W_FAILED,
+							W_V(W_FAILED,
 								w_log_type::W_ERROR,
 								"mapping memory for graphics device: {}. trace info: {}",
 								this->_gDevice->get_info(),
@@ -24,7 +24,7 @@ namespace wolf
 					_In_ const bool& pCreateCommandPool,
 					_In_ const w_queue* pCommandPoolQueue)
 				{
-					const char* _trace_info = (this->_name + "::load").c_str();
+					const char* _trace_info = "w_command_buffer::load";
 
 					if (pCreateCommandPool)
 					{
@@ -40,7 +40,7 @@ namespace wolf
 							&this->_command_pool);
 						if (_hr)
 						{
-							V(W_FAILED,
+							W_V(W_FAILED,
 								w_log_type::W_ERROR,
 								"creating vulkan command pool for graphics device: {}. trace info: {}",
 								this->_gDevice->get_info(),
@@ -93,7 +93,7 @@ namespace wolf
 						this->_commands.clear();
 						_cmds.clear();
 
-						V(W_FAILED,
+						W_V(W_FAILED,
 							w_log_type::W_ERROR,
 							"creating vulkan command buffers for graphics device: {}. trace info: {}",
 							this->_gDevice->get_info(),
@@ -114,7 +114,7 @@ namespace wolf
 				{
 					if (pCommandBufferIndex >= this->_commands.size()) return W_FAILED;
 
-					const char* _trace_info = (this->_name + "::begin").c_str();
+					const char* _trace_info = "w_command_buffer::begin";
 
 					//prepare data for recording command buffers
 					const VkCommandBufferBeginInfo _command_buffer_begin_info =
@@ -128,7 +128,7 @@ namespace wolf
 					auto _hr = vkBeginCommandBuffer(this->_commands.at(pCommandBufferIndex).handle, &_command_buffer_begin_info);
 					if (_hr != VK_SUCCESS)
 					{
-						V(W_FAILED,
+						W_V(W_FAILED,
 							w_log_type::W_ERROR,
 							"begining command buffer for graphics device: {}. trace info: {}",
 							this->_gDevice->get_info(),
@@ -143,12 +143,12 @@ namespace wolf
 				{
 					if (pCommandBufferIndex >= this->_commands.size()) return W_FAILED;
 
-					const char* _trace_info = (this->_name + "::end").c_str();
+					const char* _trace_info = "w_command_buffer::end";
 
 					auto _hr = vkEndCommandBuffer(this->_commands.at(pCommandBufferIndex).handle);
 					if (_hr != VK_SUCCESS)
 					{
-						V(W_FAILED,
+						W_V(W_FAILED,
 							w_log_type::W_ERROR,
 							"ending command buffer for graphics device: {}. trace info: {}:",
 							this->_gDevice->get_info(),
@@ -161,14 +161,14 @@ namespace wolf
 				{
 					if (pCommandBufferIndex >= this->_commands.size()) return W_FAILED;
 
-					const char* _trace_info = (this->_name + "::end").c_str();
+					const char* _trace_info = "w_command_buffer::flush";
 
 					auto _cmd = this->_commands.at(pCommandBufferIndex);
 
 					auto _hr = vkEndCommandBuffer(_cmd.handle);
 					if (_hr)
 					{
-						V(W_FAILED,
+						W_V(W_FAILED,
 							w_log_type::W_ERROR,
 							"ending command buffer buffer for graphics device: {}. trace info: {}",
 							this->_gDevice->get_info(),
@@ -191,7 +191,7 @@ namespace wolf
 					_hr = vkCreateFence(this->_gDevice->vk_device, &_fence_create_info, nullptr, &_fence);
 					if (_hr)
 					{
-						V(W_FAILED,
+						W_V(W_FAILED,
 							w_log_type::W_ERROR,
 							"creating fence for command buffer for graphics device: {}. trace info: {}",
 							this->_gDevice->get_info(),
@@ -206,7 +206,7 @@ namespace wolf
 						_fence);
 					if (_hr)
 					{
-						V(W_FAILED,
+						W_V(W_FAILED,
 							w_log_type::W_ERROR,
 							"submiting queue for graphics device: {}. trace info: {}",
 							this->_gDevice->get_info(),
@@ -378,11 +378,11 @@ const size_t w_command_buffers::get_commands_size() const
 
 W_RESULT w_indirect_draws_command_buffer::load(_In_ const std::shared_ptr<w_graphics_device>& pGDevice, _In_ const uint32_t& pDrawCount)
 {
-	const std::string _trace_info = "w_indirect_draws_command_buffer::load";
+	const char* _trace_info = "w_indirect_draws_command_buffer::load";
 
 	if (!this->drawing_commands.size())
 	{
-		V(W_FAILED,
+		W_V(W_FAILED,
 			w_log_type::W_ERROR,
 			"empty indirect drawing commands. trace info: {}",
 			_trace_info);
@@ -390,7 +390,7 @@ W_RESULT w_indirect_draws_command_buffer::load(_In_ const std::shared_ptr<w_grap
 	}
 	if (pDrawCount > this->drawing_commands.size())
 	{
-		V(W_FAILED,
+		W_V(W_FAILED,
 			w_log_type::W_ERROR,
 			"draw count is greater than indirect drawing commands. trace info: {}",
 			_trace_info);
@@ -406,7 +406,7 @@ W_RESULT w_indirect_draws_command_buffer::load(_In_ const std::shared_ptr<w_grap
 	uint32_t _size = (uint32_t)(pDrawCount * sizeof(w_draw_indexed_indirect_command));
 	//if (_staging_buffer.allocate_as_staging(pGDevice, _size) == W_FAILED)
 	//{
-	//	V(W_FAILED, "loading staging buffer of indirect_draw_commands", _trace_info, 3);
+	//	W_V(W_FAILED, w_log_type::W_ERROR, "loading staging buffer of indirect_draw_commands. trace info: {}", _trace_info);
 	//	return W_FAILED;
 	//}
 
@@ -417,7 +417,7 @@ W_RESULT w_indirect_draws_command_buffer::load(_In_ const std::shared_ptr<w_grap
 		w_memory_usage_flag::MEMORY_USAGE_CPU_ONLY,
 		false) == W_FAILED)
 	{
-		V(W_FAILED,
+		W_V(W_FAILED,
 			w_log_type::W_ERROR,
 			"loading staging buffer of indirect_draw_commands. trace info: {}",
 			_trace_info);
@@ -426,7 +426,7 @@ W_RESULT w_indirect_draws_command_buffer::load(_In_ const std::shared_ptr<w_grap
 
 	if (_staging_buffer.bind() == W_FAILED)
 	{
-		V(W_FAILED,
+		W_V(W_FAILED,
 			w_log_type::W_ERROR,
 			"binding to staging buffer of indirect_draw_commands. trace info: {}",
 			_trace_info);
@@ -435,7 +435,7 @@ W_RESULT w_indirect_draws_command_buffer::load(_In_ const std::shared_ptr<w_grap
 
 	if (_staging_buffer.set_data(this->drawing_commands.data()) == W_FAILED)
 	{
-		V(W_FAILED,
+		W_V(W_FAILED,
 			w_log_type::W_ERROR,
 			"setting data for staging buffer of indirect_draw_commands. trace info: {}",
 			_trace_info);
@@ -450,7 +450,7 @@ W_RESULT w_indirect_draws_command_buffer::load(_In_ const std::shared_ptr<w_grap
 		w_memory_usage_flag::MEMORY_USAGE_GPU_ONLY,
 		false) == W_FAILED)
 	{
-		V(W_FAILED,
+		W_V(W_FAILED,
 			w_log_type::W_ERROR,
 			"loading staging buffer of indirect_commands_buffer. trace info: {}",
 			_trace_info);
@@ -460,7 +460,7 @@ W_RESULT w_indirect_draws_command_buffer::load(_In_ const std::shared_ptr<w_grap
 	//bind indircet buffer
 	if (this->buffer.bind() == W_FAILED)
 	{
-		V(W_FAILED,
+		W_V(W_FAILED,
 			w_log_type::W_ERROR,
 			"binding to staging buffer of indirect_commands_buffer. trace info: {}",
 			_trace_info);
@@ -469,7 +469,7 @@ W_RESULT w_indirect_draws_command_buffer::load(_In_ const std::shared_ptr<w_grap
 
 	if (_staging_buffer.copy_to(this->buffer) == W_FAILED)
 	{
-		V(W_FAILED,
+		W_V(W_FAILED,
 			w_log_type::W_ERROR,
 			"copy staging buffer to device buffer of indirect_commands_buffer. trace info: {}",
 			_trace_info);
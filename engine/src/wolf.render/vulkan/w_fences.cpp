@@ -29,7 +29,7 @@ W_RESULT w_fences::initialize(_In_ const std::shared_ptr<w_graphics_device>& pGD
                       nullptr,
                       &_fence))
         {
-            V(W_FAILED, 
+            W_V(W_FAILED, 
 				w_log_type::W_ERROR,
 				"creating fence. trace info: {}", 
 				"w_fence::initialize");
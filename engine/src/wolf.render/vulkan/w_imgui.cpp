@@ -35,7 +35,7 @@ namespace wolf
 					_In_ const char* pFontPath,
 					_In_ const float& pFontPixelSize)
 				{
-					const std::string _trace_info = this->_name + "::load";
+					const char* _trace_info = "w_imgui::load";
 
 #ifdef __WIN32
 					this->_hwnd = pOutputPresentationWindow->hwnd;
@@ -125,7 +125,7 @@ namespace wolf
 						_attachments);
 					if (__hr == W_FAILED)
 					{
-						V(W_FAILED,
+						W_V(W_FAILED,
 							w_log_type::W_ERROR,
 							"creating render pass with graphics device: {}. trace info: {}",
 							pGDevice->get_info(),
@@ -139,7 +139,7 @@ namespace wolf
 					if (__hr == W_FAILED)
 					{
 						release();
-						V(W_FAILED,
+						W_V(W_FAILED,
 							w_log_type::W_ERROR,
 							"creating command buffers with graphics device: {}. trace info: {}",
 							pGDevice->get_info(),
@@ -169,7 +169,7 @@ namespace wolf
 					__hr = this->_shader.load(pGDevice, content_path + L"shaders/imgui.vert.spv", w_shader_stage_flag_bits::VERTEX_SHADER);
 					if (__hr != W_PASSED)
 					{
-						V(__hr,
+						W_V(__hr,
 							w_log_type::W_ERROR,
 							"loading vertex shader with graphics device: {}. trace info: {}",
 							pGDevice->get_info(),
@@ -180,7 +180,7 @@ namespace wolf
 					__hr = this->_shader.load(pGDevice, content_path + L"shaders/imgui.frag.spv", w_shader_stage_flag_bits::FRAGMENT_SHADER);
 					if (__hr != W_PASSED)
 					{
-						V(__hr,
+						W_V(__hr,
 							w_log_type::W_ERROR,
 							"loading fragment shader with graphics device: {}. trace info: {}",
 							pGDevice->get_info(),
@@ -239,7 +239,7 @@ namespace wolf
 					this->_pipeline_layout = w_pipeline::create_pipeline_layout(_gDevice, &_pipeline_layout_create_info);
 					if (!this->_pipeline_layout)
 					{
-						V(W_FAILED,
+						W_V(W_FAILED,
 							w_log_type::W_ERROR,
 							"creating pipeline layout with graphics device: {}. trace info: {}",
 							pGDevice->get_info(),
@@ -393,7 +393,7 @@ namespace wolf
 						&this->_pipeline);
 					if (_hr)
 					{
-						V(W_FAILED,
+						W_V(W_FAILED,
 							w_log_type::W_ERROR,
 							"creating graphics pipeline with graphics device: {}. trace info: {}",
 							pGDevice->get_info(),
@@ -466,7 +466,7 @@ namespace wolf
 
 				W_RESULT render()
 				{
-					const std::string _trace_info = this->_name + "::render";
+					const char* _trace_info = "w_imgui::render";
 					W_RESULT _hr = W_PASSED;
 
 					auto _size = this->_command_buffers.get_commands_size();
@@ -565,7 +565,7 @@ namespace wolf
 			private:
 				W_RESULT _update_buffers()
 				{
-					const std::string _trace_info = this->_name + "::_update_buffers";
+					const char* _trace_info = "w_imgui::_update_buffers";
 
 					ImDrawData* _im_draw_data = ImGui::GetDrawData();
 					if (!_im_draw_data || !_im_draw_data->CmdListsCount) return W_PASSED;
@@ -577,7 +577,7 @@ namespace wolf
 						this->_vertex_buffer = new (std::nothrow) w_buffer();
 						if (!this->_vertex_buffer)
 						{
-							V(W_FAILED,
+							W_V(W_FAILED,
 								w_log_type::W_ERROR,
 								"loading staging vertex buffer with graphics device: {}. trace info: {}",
 								this->_gDevice->get_info(),
@@ -592,7 +592,7 @@ namespace wolf
 							VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
 							w_memory_usage_flag::MEMORY_USAGE_CPU_ONLY) == W_FAILED)
 						{
-							V(W_FAILED,
+							W_V(W_FAILED,
 								w_log_type::W_ERROR,
 								"allocating staging vertex buffer with graphics device: {}. trace info: {}",
 								this->_gDevice->get_info(),
@@ -606,7 +606,7 @@ namespace wolf
 					{
 						if (this->_vertex_buffer->reallocate(_vertex_buffer_size) == W_FAILED)
 						{
-							V(W_FAILED,
+							W_V(W_FAILED, w_log_type::W_INFO,
 								"reallocating staging vertex buffer with graphics device: {}. trace info: {}",
 								this->_gDevice->get_info(),
 								_trace_info);
@@ -621,7 +621,7 @@ namespace wolf
 						this->_index_buffer = new (std::nothrow) w_buffer();
 						if (!this->_index_buffer)
 						{
-							V(W_FAILED,
+							W_V(W_FAILED,
 								w_log_type::W_ERROR,
 								"loading staging index buffer with graphics device: {}. trace info: {}",
 								this->_gDevice->get_info(),
@@ -636,7 +636,7 @@ namespace wolf
 							VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
 							w_memory_usage_flag::MEMORY_USAGE_CPU_ONLY) == W_FAILED)
 						{
-							V(W_FAILED,
+							W_V(W_FAILED,
 								w_log_type::W_ERROR,
 								"allocating staging index buffer with graphics device: {}. trace info: {}",
 								this->_gDevice->get_info(),
@@ -650,7 +650,7 @@ namespace wolf
 					{
 						if (this->_index_buffer->reallocate(_index_buffer_size) == W_FAILED)
 						{
-							V(W_FAILED,
+							W_V(W_FAILED, w_log_type::W_INFO,
 								"reallocating staging index buffer with graphics device: {}. trace info: {}",
 								this->_gDevice->get_info(),
 								_trace_info);
@@ -678,7 +678,7 @@ namespace wolf
 						this->_vertex_buffer->unmap();
 						if (_hr == W_FAILED)
 						{
-							V(_hr,
+							W_V(_hr, w_log_type::W_INFO,
 								"flushing staging index buffer with graphics device: {}. trace info: {}",
 								this->_gDevice->get_info(),
 								_trace_info);
@@ -687,7 +687,7 @@ namespace wolf
 						this->_index_buffer->unmap();
 						if (_hr == W_FAILED)
 						{
-							V(_hr,
+							W_V(_hr, w_log_type::W_INFO,
 								"flushing staging index buffer graphics device: {}. trace info: {}",
 								this->_gDevice->get_info(),
 								_trace_info);
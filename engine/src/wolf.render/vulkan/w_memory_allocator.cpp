@@ -15,8 +15,18 @@
 #include "vk_mem_alloc.h"
 
 #include <assert.h>
+#include <cstring>
+#include <w_memory_tracker.h>
 
 static void* const CUSTOM_CPU_ALLOCATION_CALLBACK_USER_DATA = (void*)(intptr_t)43564544;
+
+//each cpu allocation starts with a header which keeps offset of header and size of allocation, so frees can be accounted
+static size_t custom_cpu_header_size(_In_ size_t pAlignment)
+{
+	const size_t _min_header_size = 2 * sizeof(size_t);
+	return pAlignment > _min_header_size ? pAlignment : _min_header_size;
+}
+
 static void* custom_cpu_allocation(
 	_In_ void* pUserData,
 	_In_ size_t pSize,
@@ -25,36 +35,80 @@ static void* custom_cpu_allocation(
 {
 	assert(pUserData == CUSTOM_CPU_ALLOCATION_CALLBACK_USER_DATA);
 
+	auto _header_size = custom_cpu_header_size(pAlignment);
 #ifdef __WIN32
-	return _aligned_malloc(pSize, pAlignment);
+	auto _base = static_cast<uint8_t*>(_aligned_malloc(pSize + _header_size, pAlignment));
 #else
-	return aligned_malloc(pSize, pAlignment);
+	auto _base = static_cast<uint8_t*>(aligned_malloc(pSize + _header_size, pAlignment));
 #endif
+	if (!_base) return nullptr;
+
+	auto _ptr = _base + _header_size;
+	reinterpret_cast<size_t*>(_ptr)[-2] = _header_size;
+	reinterpret_cast<size_t*>(_ptr)[-1] = pSize;
+
+	wolf::system::w_memory_tracker::track_alloc(wolf::system::W_MEMORY_CATEGORY_RENDER_CPU, pSize);
+	return _ptr;
 }
 
-static void* custom_cpu_reallocation(
-	void* pUserData, void* pOriginal, size_t pSize, size_t pAlignment,
-	VkSystemAllocationScope allocationScope)
+static void custom_cpu_free(void* pUserData, void* pMemory)
 {
 	assert(pUserData == CUSTOM_CPU_ALLOCATION_CALLBACK_USER_DATA);
+	if (!pMemory) return;
 
+	auto _header_size = reinterpret_cast<size_t*>(pMemory)[-2];
+	auto _size = reinterpret_cast<size_t*>(pMemory)[-1];
+	wolf::system::w_memory_tracker::track_free(wolf::system::W_MEMORY_CATEGORY_RENDER_CPU, _size);
+
+	auto _base = static_cast<uint8_t*>(pMemory) - _header_size;
 #ifdef __WIN32
-	return _aligned_realloc(pOriginal, pSize, pAlignment);
+	_aligned_free(_base);
 #else
-	aligned_free(pOriginal);
-	return aligned_alloc(pSize, pAlignment);
+	aligned_free(_base);
 #endif
 }
 
-static void custom_cpu_free(void* pUserData, void* pMemory)
+static void* custom_cpu_reallocation(
+	void* pUserData, void* pOriginal, size_t pSize, size_t pAlignment,
+	VkSystemAllocationScope allocationScope)
 {
 	assert(pUserData == CUSTOM_CPU_ALLOCATION_CALLBACK_USER_DATA);
 
-#ifdef __WIN32
-	_aligned_free(pMemory);
-#else
-	aligned_free(pMemory);
-#endif
+	if (!pOriginal) return custom_cpu_allocation(pUserData, pSize, pAlignment, allocationScope);
+	if (!pSize)
+	{
+		custom_cpu_free(pUserData, pOriginal);
+		return nullptr;
+	}
+
+	//keep the content, on failure the original memory must stay valid
+	auto _ptr = custom_cpu_allocation(pUserData, pSize, pAlignment, allocationScope);
+	if (!_ptr) return nullptr;
+
+	auto _original_size = reinterpret_cast<size_t*>(pOriginal)[-1];
+	std::memcpy(_ptr, pOriginal, _original_size < pSize ? _original_size : pSize);
+	custom_cpu_free(pUserData, pOriginal);
+
+	return _ptr;
+}
+
+//device memory of vulkan memory allocator is accounted to render_gpu
+static void VKAPI_PTR custom_device_memory_allocation(
+	_In_ VmaAllocator pAllocator,
+	_In_ uint32_t pMemoryType,
+	_In_ VkDeviceMemory pMemory,
+	_In_ VkDeviceSize pSize)
+{
+	wolf::system::w_memory_tracker::track_alloc(wolf::system::W_MEMORY_CATEGORY_RENDER_GPU, static_cast<size_t>(pSize));
+}
+
+static void VKAPI_PTR custom_device_memory_free(
+	_In_ VmaAllocator pAllocator,
+	_In_ uint32_t pMemoryType,
+	_In_ VkDeviceMemory pMemory,
+	_In_ VkDeviceSize pSize)
+{
+	wolf::system::w_memory_tracker::track_free(wolf::system::W_MEMORY_CATEGORY_RENDER_GPU, static_cast<size_t>(pSize));
 }
 
 namespace wolf
@@ -82,9 +136,14 @@ namespace wolf
 					_allocator_info.device = pGDevice->vk_device;
 					_allocator_info.preferredLargeHeapBlockSize = pPreferredLargeHeapBlockSize ? static_cast<VkDeviceSize>(VMA_DEFAULT_LARGE_HEAP_BLOCK_SIZE) : 0;
 
+					VmaDeviceMemoryCallbacks _device_memory_callbacks = {};
+					_device_memory_callbacks.pfnAllocate = &custom_device_memory_allocation;
+					_device_memory_callbacks.pfnFree = &custom_device_memory_free;
+					_allocator_info.pDeviceMemoryCallbacks = &_device_memory_callbacks;
+
+					VkAllocationCallbacks _cpu_allocation_callbacks = {};
 					if (pUseCustomCpuAllocation_Callbacks)
 					{
-						VkAllocationCallbacks _cpu_allocation_callbacks = {};
 						_cpu_allocation_callbacks.pUserData = CUSTOM_CPU_ALLOCATION_CALLBACK_USER_DATA;
 						_cpu_allocation_callbacks.pfnAllocation = &custom_cpu_allocation;
 						_cpu_allocation_callbacks.pfnReallocation = &custom_cpu_reallocation;
@@ -99,7 +158,7 @@ namespace wolf
 					_Inout_ VkBuffer& pBufferHandle,
 					_Inout_ VmaAllocationInfo& pAllocInfo)
 				{
-					const std::string _trace_info = this->_name + "::allocate_buffer";
+					const char* _trace_info = "w_memory_allocator::allocate_buffer";
 
 					VmaAllocationCreateInfo _alloc_info = {};
 					_alloc_info.usage = pMemoryUsage;
@@ -111,7 +170,7 @@ namespace wolf
 					auto _allocation = new (std::nothrow) VmaAllocation();
 					if (!_allocation)
 					{
-						V(W_FAILED,
+						W_V(W_FAILED,
 							w_log_type::W_ERROR,
 							"allocating memory for VmaAllocation with graphics device: {}. trace info: {}",
 							this->_device_info.c_str(),
@@ -132,7 +191,7 @@ namespace wolf
 					_Inout_ VkImage& pImageHandle,
 					_Inout_ VmaAllocationInfo& pAllocInfo)
 				{
-					const std::string _trace_info = this->_name + "::alloc";
+					const char* _trace_info = "w_memory_allocator::alloc";
 
 					VmaAllocationCreateInfo _alloc_info = {};
 					_alloc_info.usage = pMemoryUsage;
@@ -140,7 +199,7 @@ namespace wolf
 					auto _allocation = new (std::nothrow) VmaAllocation();
 					if (!_allocation)
 					{
-						V(W_FAILED,
+						W_V(W_FAILED,
 							w_log_type::W_ERROR,
 							"allocating memory for VmaAllocation with graphics device: {}. trace info: {}",
 							this->_device_info.c_str(),
@@ -145,11 +145,11 @@ namespace wolf
 					_In_ const uint32_t* const pIndicesData,
 					_In_ const uint32_t& pIndicesCount)
 				{
-					const char* _trace_info = (this->_name + "").c_str();
+					const char* _trace_info = "w_mesh::update_dynamic_buffer";
 
 					if (!this->_dynamic_buffer)
 					{
-						V(W_FAILED,
+						W_V(W_FAILED,
 							w_log_type::W_WARNING,
 							"could not update none dynamic buffer for graphics device: {}. trace info: {}",
 							pGDevice->get_info(),
@@ -159,7 +159,7 @@ namespace wolf
 					if (pVerticesCount != this->_vertices_count ||
 						pIndicesCount != this->_indices_count)
 					{
-						V(W_FAILED,
+						W_V(W_FAILED,
 							w_log_type::W_WARNING,
 							"size of vertex or index buffer does not match for graphics device: {}. trace info: {}",
 							pGDevice->get_info(),
@@ -168,31 +168,31 @@ namespace wolf
 					}
 
 					auto _hr = this->_stagings_buffers.vertices.set_data(pVerticesData);
-					V(_hr,
+					W_V(_hr,
 						w_log_type::W_ERROR,
 						"updating staging vertex buffer for graphics device: {}. trace info: {}",
 						pGDevice->get_info(),
 						_trace_info);
 
 					//_hr = this->_stagings_buffers.vertices.bind();
-					//V(_hr, "binding to staging vertex buffer", this->_name, 3);
+					//W_V(_hr, w_log_type::W_ERROR, "binding to staging vertex buffer. trace info: {}", _trace_info);
 
 					if (pIndicesCount && pIndicesData)
 					{
 						_hr = this->_stagings_buffers.indices.set_data(pIndicesData);
-						V(_hr,
+						W_V(_hr,
 							w_log_type::W_ERROR,
 							"updating staging index buffer for graphics device: {}. trace info: {}",
 							pGDevice->get_info(),
 							_trace_info);
 
 						//_hr = this->_stagings_buffers.vertices.bind();
-						//V(_hr, "binding staging index buffer", this->_name, 3);
+						//W_V(_hr, w_log_type::W_ERROR, "binding staging index buffer. trace info: {}", _trace_info);
 					}
 
 					if (_stagings_buffers.vertices.copy_to(this->_vertex_buffer) == W_FAILED)
 					{
-						V(_hr,
+						W_V(_hr,
 							w_log_type::W_ERROR,
 							"copying staging vertex buffer to gpu vertex buffer for graphics device: {}. trace info: {}",
 							pGDevice->get_info(),
@@ -205,7 +205,7 @@ namespace wolf
 					{
 						if (_stagings_buffers.indices.copy_to(this->_index_buffer) == W_FAILED)
 						{
-							V(_hr,
+							W_V(_hr,
 								w_log_type::W_ERROR,
 								"copying staging index buffer to gpu index buffer for graphics device: {}. trace info: {}",
 								pGDevice->get_info(),
@@ -442,11 +442,11 @@ namespace wolf
 					_In_ const w_memory_usage_flag& pMemoryFlag,
 					_Inout_ w_buffer& pBuffer)
 				{
-					const char* _trace_info = (this->_name + "::_create_buffer").c_str();
+					const char* _trace_info = "w_mesh::_create_buffer";
 
 					if (pBuffer.allocate(this->_gDevice, pBufferSizeInBytes, pBufferUsageFlag, pMemoryFlag))
 					{
-						V(W_FAILED,
+						W_V(W_FAILED,
 							w_log_type::W_ERROR,
 							"loading memory of buffer for graphics device: {}. trace info: {}",
 							_gDevice->get_info(),
@@ -463,7 +463,7 @@ namespace wolf
 						_hr = pBuffer.set_data(pBufferData);
 						if (_hr == W_FAILED)
 						{
-							V(W_FAILED,
+							W_V(W_FAILED,
 								w_log_type::W_ERROR,
 								"setting data to vertex buffer's memory staging for graphics device: {}. trace info: {}",
 								_gDevice->get_info(),
@@ -477,9 +477,11 @@ namespace wolf
 					//_hr = pBuffer.bind();
 					//if(_hr == W_FAILED)
 					//{
-					//    V(W_FAILED, "binding to vertex buffer's memory for graphics device: " +
-					//      _gDevice->device_info->get_device_name() + " ID:" + std::to_string(_gDevice->device_info->get_device_id()),
-					//      this->_name, 3, false);
+					//    W_V(W_FAILED,
+					//        w_log_type::W_ERROR,
+					//        "binding to vertex buffer's memory for graphics device: {}. trace info: {}",
+					//        _gDevice->get_info(),
+					//        _trace_info);
 					//    
 					//    return W_FAILED;
 					//}
@@ -56,7 +56,10 @@ namespace wolf
 				//Position(Float3) + Float3 + Float2 + Float3 + Float3 + Float3 + Float3
 				VERTEX_POSITION_NORMAL_UV_TANGENT_BINORMAL_BLEND_WEIGHT_BLEND_INDICES,
 				//Position(Float3) + Float3 + Float3 + Float3 + Float3 + Float3 + Float3
-				VERTEX_POSITION_NORMAL_UV_INDEX_TANGENT_BINORMAL_BLEND_WEIGHT_BLEND_INDICES
+				VERTEX_POSITION_NORMAL_UV_INDEX_TANGENT_BINORMAL_BLEND_WEIGHT_BLEND_INDICES,
+				//Position(UNorm16x4) + Octahedral normal(SNorm16x2) + Octahedral tangent(SNorm16x2) + UV(Half2) + UNorm8x4 + UInt8x4
+				//positions are relative to bounding box of their mesh, so meshes can not be merged in one vertex buffer and the vertex shader must decode them
+				VERTEX_PACKED_POSITION_NORMAL_UV_TANGENT_BLEND_WEIGHT_BLEND_INDICES
 			} w_vertex_declaration;
 
 			typedef enum w_vertex_attribute : uint32_t
@@ -75,7 +78,13 @@ namespace wolf
 				W_VEC4,
 				W_COLOR,
 				W_BLEND_WEIGHT,
-				W_BLEND_INDICES
+				W_BLEND_INDICES,
+				//packed attributes of w_vertex_struct_packed
+				W_UNORM16_VEC4,
+				W_SNORM16_VEC2,
+				W_HALF_VEC2,
+				W_UNORM8_VEC4,
+				W_UINT8_VEC4
 			} w_vertex_attribute;
 
 			struct w_vertex_binding_attributes
@@ -147,6 +156,14 @@ namespace wolf
 						 _v.attributes.push_back(w_mesh::w_vertex_attribute::Vec3);
 						 _v.attributes.push_back(w_mesh::w_vertex_attribute::Vec3);*/
 						break;
+					case w_vertex_declaration::VERTEX_PACKED_POSITION_NORMAL_UV_TANGENT_BLEND_WEIGHT_BLEND_INDICES:
+						_attr.push_back(w_vertex_attribute::W_UNORM16_VEC4);//position relative to bounding box and sign of binormal
+						_attr.push_back(w_vertex_attribute::W_SNORM16_VEC2);//octahedral normal
+						_attr.push_back(w_vertex_attribute::W_SNORM16_VEC2);//octahedral tangent
+						_attr.push_back(w_vertex_attribute::W_HALF_VEC2);//texture coordinate
+						_attr.push_back(w_vertex_attribute::W_UNORM8_VEC4);//blend weight
+						_attr.push_back(w_vertex_attribute::W_UINT8_VEC4);//blend indices
+						break;
 					case w_vertex_declaration::VERTEX_POSITION_UV:
 						_attr.push_back(w_vertex_attribute::W_VEC3);//position
 						_attr.push_back(w_vertex_attribute::W_VEC2);//texture coordinate
@@ -36,13 +36,13 @@ namespace wolf
 					_In_ const w_pipeline_color_blend_attachment_state& pBlendState,
 					_In_ const w_color& pBlendColors)
 				{
-					const char* _trace_info = (this->_name + "::load").c_str();
+					const char* _trace_info = "w_pipeline::load";
 
 					this->_gDevice = pGDevice;
 
 					if (pVertexBindingAttributes.declaration == w_vertex_declaration::NOT_DEFINED)
 					{
-						V(W_FAILED,
+						W_V(W_FAILED,
 							w_log_type::W_WARNING,
 							"vertex type not defined for graphics device: {}. trace info: {}",
 							this->_gDevice->get_info(),
@@ -50,7 +50,7 @@ namespace wolf
 					}
 					if (!pShaderBinding)
 					{
-						V(W_FAILED,
+						W_V(W_FAILED,
 							w_log_type::W_WARNING,
 							"shader can not be nullptr. graphics device: {}. trace info: {}",
 							this->_gDevice->get_info(),
@@ -59,7 +59,7 @@ namespace wolf
 					}
 					if (!pShaderBinding->get_shader_stages())
 					{
-						V(W_FAILED,
+						W_V(W_FAILED,
 							w_log_type::W_ERROR,
 							"shader stages can not be nullptr. graphics device: {}. trace info: {}",
 							this->_gDevice->get_info(),
@@ -68,7 +68,7 @@ namespace wolf
 					}
 					if (!pRenderPassBinding)
 					{
-						V(W_FAILED,
+						W_V(W_FAILED,
 							w_log_type::W_ERROR,
 							"render pass can not be nullptr. graphics device: {}. trace info: {}",
 							this->_gDevice->get_info(),
@@ -192,7 +192,7 @@ namespace wolf
 						&this->_pipeline);
 					if (_hr)
 					{
-						V(W_FAILED,
+						W_V(W_FAILED,
 							w_log_type::W_ERROR,
 							"creating pipeline for graphics device: {}. trace info: {}",
 							this->_gDevice->get_info(),
@@ -209,7 +209,7 @@ namespace wolf
 					_In_ const std::string& pPipelineCacheName,
 					_In_ const std::vector<w_push_constant_range> pPushConstantRanges)
 				{
-					const char* _trace_info = (this->_name + "::load_compute").c_str();
+					const char* _trace_info = "w_pipeline::load_compute";
 
 					this->_gDevice = pGDevice;
 
@@ -242,7 +242,7 @@ namespace wolf
 
 					if (_hr)
 					{
-						V(W_FAILED,
+						W_V(W_FAILED,
 							w_log_type::W_ERROR,
 							"creating compute pipeline layout for graphics device: {}. trace info: {}",
 							this->_gDevice->get_info(),
@@ -283,7 +283,7 @@ namespace wolf
 
 					if (_hr)
 					{
-						V(W_FAILED,
+						W_V(W_FAILED,
 							w_log_type::W_ERROR,
 							"creating compute pipeline for graphics device: {}. trace info: {}",
 							this->_gDevice->get_info(),
@@ -442,6 +442,17 @@ namespace wolf
 							case w_vertex_attribute::W_BLEND_INDICES:
 								_stride += 16;//floats
 								break;
+							case w_vertex_attribute::W_UNORM16_VEC4:
+								_stride += 8;//shorts
+								break;
+							case w_vertex_attribute::W_SNORM16_VEC2:
+							case w_vertex_attribute::W_HALF_VEC2:
+								_stride += 4;//shorts
+								break;
+							case w_vertex_attribute::W_UNORM8_VEC4:
+							case w_vertex_attribute::W_UINT8_VEC4:
+								_stride += 4;//bytes
+								break;
 							}
 						}
 
@@ -508,6 +519,56 @@ namespace wolf
 									});
 								_offset += 16;//floats
 								break;
+							case w_vertex_attribute::W_UNORM16_VEC4:
+								_vertex_attribute_descriptions->push_back(
+									{
+										_location_index,                                               // Location
+										_vertex_binding_descriptions->at(_binding.first).binding,      // Binding
+										VK_FORMAT_R16G16B16A16_UNORM,                                  // Format
+										_offset                                                        // Offset
+									});
+								_offset += 8;//shorts
+								break;
+							case w_vertex_attribute::W_SNORM16_VEC2:
+								_vertex_attribute_descriptions->push_back(
+									{
+										_location_index,                                               // Location
+										_vertex_binding_descriptions->at(_binding.first).binding,      // Binding
+										VK_FORMAT_R16G16_SNORM,                                        // Format
+										_offset                                                        // Offset
+									});
+								_offset += 4;//shorts
+								break;
+							case w_vertex_attribute::W_HALF_VEC2:
+								_vertex_attribute_descriptions->push_back(
+									{
+										_location_index,                                               // Location
+										_vertex_binding_descriptions->at(_binding.first).binding,      // Binding
+										VK_FORMAT_R16G16_SFLOAT,                                       // Format
+										_offset                                                        // Offset
+									});
+								_offset += 4;//shorts
+								break;
+							case w_vertex_attribute::W_UNORM8_VEC4:
+								_vertex_attribute_descriptions->push_back(
+									{
+										_location_index,                                               // Location
+										_vertex_binding_descriptions->at(_binding.first).binding,      // Binding
+										VK_FORMAT_R8G8B8A8_UNORM,                                      // Format
+										_offset                                                        // Offset
+									});
+								_offset += 4;//bytes
+								break;
+							case w_vertex_attribute::W_UINT8_VEC4:
+								_vertex_attribute_descriptions->push_back(
+									{
+										_location_index,                                               // Location
+										_vertex_binding_descriptions->at(_binding.first).binding,      // Binding
+										VK_FORMAT_R8G8B8A8_UINT,                                       // Format
+										_offset                                                        // Offset
+									});
+								_offset += 4;//bytes
+								break;
 							}
 
 							_location_index++;
@@ -705,7 +766,7 @@ VkPipelineLayout w_pipeline::create_pipeline_layout(_In_ const std::shared_ptr<w
 		&_pipeline_layout);
 	if (_hr)
 	{
-		V(W_FAILED, 
+		W_V(W_FAILED, 
 			w_log_type::W_ERROR,
 			"creating pipeline layout for graphics device: {}. trace info: {}",
 			pGDevice->get_info(), 
@@ -730,7 +791,7 @@ W_RESULT w_pipeline::create_pipeline_cache(_In_ const std::shared_ptr<w_graphics
     auto _hr = vkCreatePipelineCache(pGDevice->vk_device, &_pipeline_cache_create_info, nullptr, &_pipeline_cache);
 	if (_hr)
 	{
-		V(W_FAILED,
+		W_V(W_FAILED,
 			w_log_type::W_ERROR,
 			"error on creating pipeline cache with graphics device: {}. trace info: {}",
 			pGDevice->get_info(),
@@ -26,11 +26,11 @@ namespace wolf
 					_In_ const std::vector<VkSubpassDescription>* pSubpassDescriptions,
 					_In_ const std::vector<VkSubpassDependency>* pSubpassDependencies)
 				{
-					const char* _trace_info = (this->_name + "::load").c_str();
+					const char* _trace_info = "w_render_pass::load";
 
 					if (!pAttachments.size())
 					{
-						V(W_FAILED,
+						W_V(W_FAILED,
 							w_log_type::W_ERROR,
 							"attachments not defined for render pass of graphics device: {}. trace info: {}",
 							this->_gDevice->get_info(),
@@ -122,7 +122,7 @@ namespace wolf
 						&this->_render_pass.handle);
 					if (_hr)
 					{
-						V(W_FAILED,
+						W_V(W_FAILED,
 							w_log_type::W_ERROR,
 							"creating render pass for graphics device: {}. trace info: {}",
 							this->_gDevice->get_info(),
@@ -148,7 +148,7 @@ namespace wolf
 							if (_width != _iter.width || _height != _iter.height)
 							{
 								__hr = W_FAILED;
-								V(__hr,
+								W_V(__hr,
 									w_log_type::W_ERROR,
 									"width and height of all attachments must be same. creating frame buffers for graphics device: {}. trace info: {}",
 									this->_gDevice->get_info(),
@@ -181,7 +181,7 @@ namespace wolf
 						else
 						{
 							__hr = W_FAILED;
-							V(__hr,
+							W_V(__hr,
 								w_log_type::W_ERROR,
 								"creating frame buffer for graphics device: {}. trace info: {}",
 								this->_gDevice->get_info(),
@@ -202,11 +202,11 @@ namespace wolf
 					_In_ const uint32_t& pClearStencil,
 					_In_ const VkSubpassContents& pSubpassContents)
 				{
-					const std::string _trace_info = this->_name + "::begin";
+					const char* _trace_info = "w_render_pass::begin";
 
 					if (pFrameBufferIndex >= this->_frame_buffers.size())
 					{
-						V(W_FAILED,
+						W_V(W_FAILED,
 							w_log_type::W_ERROR,
 							"parameter count mismatch, index of frame buffer does not match with index of command buffer for graphics device: {}. trace info: {}",
 							this->_gDevice->get_info(),
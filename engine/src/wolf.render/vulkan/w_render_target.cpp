@@ -25,7 +25,7 @@ namespace wolf
 					_In_ std::vector<w_image_view> pAttachments,
 					_In_ const size_t& pCount)
 				{
-					const std::string _trace_info = this->_name + "::load";
+					const char* _trace_info = "w_render_target::load";
 
 					this->_gDevice = pGDevice;
 					this->_viewport = pViewPort;
@@ -45,7 +45,7 @@ namespace wolf
 							if (!_texture_buffer)
 							{
 								_hr = W_FAILED;
-								V(_hr,
+								W_V(_hr,
 									w_log_type::W_ERROR,
 									"allocating memory for texture for graphics device: {}. trace info: {}",
 									pGDevice->get_info(),
@@ -71,7 +71,7 @@ namespace wolf
 							auto _hr = _texture_buffer->initialize(pGDevice, pViewPort.width, pViewPort.height, false, _attachment.attachment_desc.memory_flag);
 							if (_hr == W_FAILED)
 							{
-								V(W_FAILED,
+								W_V(W_FAILED,
 									w_log_type::W_ERROR,
 									"loading texture with graphics device: {}. trace info: {}",
 									pGDevice->get_info(),
@@ -81,7 +81,7 @@ namespace wolf
 							_hr = _texture_buffer->load();
 							if (_hr == W_FAILED)
 							{
-								V(W_FAILED,
+								W_V(W_FAILED,
 									w_log_type::W_ERROR,
 									"initializing texture graphics device: {}. trace info: {}",
 									pGDevice->get_info(),
@@ -115,7 +115,7 @@ namespace wolf
 					{
 						_frame_buffers.clear();
 						release();
-						V(W_FAILED,
+						W_V(W_FAILED,
 							w_log_type::W_ERROR,
 							"loading render pass with graphics device: {}. trace info: {}",
 							pGDevice->get_info(),
@@ -137,14 +137,14 @@ namespace wolf
 				{
 					if (!pCommandBuffers) return W_FAILED;
 
-					const std::string _trace_info = this->_name + "::record_command_buffer";
+					const char* _trace_info = "w_render_target::record_command_buffer";
 
 					if (!pCommandBuffers) return W_FAILED;
 
 					auto _cmd_size = pCommandBuffers->get_commands_size();
 					if (_cmd_size != this->_render_pass.get_number_of_frame_buffers())
 					{
-						V(W_FAILED,
+						W_V(W_FAILED,
 							w_log_type::W_ERROR,
 							"parameter count mismatch. Number of command buffers must equal to number of frame buffers. graphics device:{} trace info: {}",
 							this->_gDevice->get_info(),
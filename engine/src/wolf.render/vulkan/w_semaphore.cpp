@@ -23,7 +23,7 @@ W_RESULT w_semaphore::initialize(_In_ const std::shared_ptr<w_graphics_device>&
                           nullptr,
                           &this->_semaphore))
     {
-        V(W_FAILED, 
+        W_V(W_FAILED, 
 			w_log_type::W_ERROR,
 			"creating semaphore with graphics device: {} . trace info: {}", 
 			pGDevice->get_info(),
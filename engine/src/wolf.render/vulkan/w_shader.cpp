@@ -78,14 +78,14 @@ namespace wolf
 					if (_hr)
 					{
 #if defined(__WIN32) || defined(__UWP)
-						V(W_FAILED,
+						W_V(W_FAILED,
 							w_log_type::W_ERROR,
 							L"creating shader module for shader on following path: {}. graphics device: {} trace info: {}",
 							_path,
 							_gDevice->get_info(),
 							L"w_shader::load");
 #else
-						V(W_FAILED,
+						W_V(W_FAILED,
 							w_log_type::W_ERROR,
 							"creating shader module for shader on following path: {}. graphics device: {} trace info: {}",
 							_path,
@@ -368,7 +368,7 @@ namespace wolf
 					_In_ const std::vector<VkDescriptorPoolSize> pDescriptorPoolSize,
 					_In_ const uint32_t& pMaxPoolSets)
 				{
-					const char* _trace_info = (this->_name + "_create_descriptor_pool").c_str();
+					const char* _trace_info = "w_shader::_create_descriptor_pool";
 
 					VkDescriptorPoolCreateInfo _descriptor_pool_create_info =
 					{
@@ -386,7 +386,7 @@ namespace wolf
 						&this->_descriptor_pool);
 					if (_hr)
 					{
-						V(W_FAILED,
+						W_V(W_FAILED,
 							w_log_type::W_ERROR,
 							"creating descriptor pool for graphics device: {}. trace info: {}",
 							this->_gDevice->get_info(),
@@ -481,7 +481,7 @@ namespace wolf
 					_Inout_ VkDescriptorSet& pDescriptorSet,
 					_Inout_ VkDescriptorSetLayout& pDescriptorSetLyout)
 				{
-					const char* _trace_info = (this->_name + "_create_descriptor_set_layout_binding").c_str();
+					const char* _trace_info = "w_shader::_create_descriptor_set_layout_binding";
 
 					VkDescriptorSetLayoutCreateInfo _descriptor_set_layout_create_info =
 					{
@@ -498,7 +498,7 @@ namespace wolf
 						&pDescriptorSetLyout);
 					if (_hr)
 					{
-						V(W_FAILED,
+						W_V(W_FAILED,
 							w_log_type::W_ERROR,
 							"creating descriptor set layout for graphics device: {}. trace info: {}",
 							this->_gDevice->get_info(),
@@ -527,7 +527,7 @@ namespace wolf
 						&pDescriptorSet);
 					if (_hr)
 					{
-						V(W_FAILED,
+						W_V(W_FAILED,
 							w_log_type::W_ERROR,
 							"creating descriptor set for graphics device: {}. trace info: {}",
 							this->_gDevice->get_info(),
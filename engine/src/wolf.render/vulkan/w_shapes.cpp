@@ -81,7 +81,7 @@ namespace wolf
 					this->_bounding_box = new (std::nothrow) wolf::system::w_bounding_box();
 					if (!this->_bounding_box)
 					{
-						V(W_FAILED,
+						W_V(W_FAILED,
 							w_log_type::W_ERROR,
 							"allocating memory for w_bounding_box in w_shapes. graphics device: {}. trace info: {}",
 							_gDevice->get_info(),
@@ -107,7 +107,7 @@ namespace wolf
 					this->_bounding_sphere = new (std::nothrow) wolf::system::w_bounding_sphere();
 					if (!this->_bounding_sphere)
 					{
-						V(W_FAILED,
+						W_V(W_FAILED,
 							w_log_type::W_ERROR,
 							"allocating memory for _bounding_sphere in w_shapes. graphics device: {}. trace info: {}",
 							_gDevice->get_info(),
@@ -135,7 +135,7 @@ namespace wolf
 					_In_ const w_viewport& pViewport,
 					_In_ const w_viewport_scissor& pViewportScissor)
 				{
-					const std::string _trace_info = this->_name + "::load";
+					const char* _trace_info = "w_shapes::load";
 
 					this->_gDevice = pGDevice;
 
@@ -176,7 +176,7 @@ namespace wolf
 					if (_hr == W_FAILED)
 					{
 						release();
-						V(W_FAILED,
+						W_V(W_FAILED,
 							w_log_type::W_ERROR,
 							"loading mesh with graphics device: {}. trace info: {}",
 							pGDevice->get_info(),
@@ -191,7 +191,7 @@ namespace wolf
 					if (_hr == W_FAILED)
 					{
 						release();
-						V(W_FAILED,
+						W_V(W_FAILED,
 							w_log_type::W_WARNING,
 							"loading vertex shader width graphics device: {}. trace info: {}",
 							pGDevice->get_info(),
@@ -206,7 +206,7 @@ namespace wolf
 					if (_hr == W_FAILED)
 					{
 						release();
-						V(W_FAILED,
+						W_V(W_FAILED,
 							w_log_type::W_WARNING,
 							"loading fragment shader. graphics device: {}. trace info: {}",
 							pGDevice->get_info(),
@@ -219,7 +219,7 @@ namespace wolf
 					if (_hr == W_FAILED)
 					{
 						release();
-						V(W_FAILED,
+						W_V(W_FAILED,
 							w_log_type::W_WARNING,
 							"loading WorldViewProjection uniform. graphics device: {}. trace info: {}",
 							pGDevice->get_info(),
@@ -230,7 +230,7 @@ namespace wolf
 					if (_hr == W_FAILED)
 					{
 						release();
-						V(W_FAILED,
+						W_V(W_FAILED,
 							w_log_type::W_WARNING,
 							"loading color uniform. graphics device : {}.trace info : {}",
 							pGDevice->get_info(),
@@ -256,7 +256,7 @@ namespace wolf
 					if (_hr == W_FAILED)
 					{
 						release();
-						V(W_FAILED,
+						W_V(W_FAILED,
 							w_log_type::W_ERROR,
 							"setting shader binding param. graphics device : {}.trace info : {}",
 							pGDevice->get_info(),
@@ -281,7 +281,7 @@ namespace wolf
 					if (_hr == W_FAILED)
 					{
 						release();
-						V(W_FAILED,
+						W_V(W_FAILED,
 							w_log_type::W_ERROR,
 							"creating solid pipeline. graphics device : {}.trace info : {}",
 							pGDevice->get_info(),
@@ -294,14 +294,14 @@ namespace wolf
 
 				W_RESULT update(_In_ const glm::mat4& pWorldViewProjection)
 				{
-					const std::string _trace_info = this->_name + "::update";
+					const char* _trace_info = "w_shapes::update";
 
 					//we must update uniform
 					this->_u0.data.wvp = pWorldViewProjection;
 					auto _hr = this->_u0.update();
 					if (_hr == W_FAILED)
 					{
-						V(W_FAILED,
+						W_V(W_FAILED,
 							w_log_type::W_WARNING,
 							"updating uniform WorldViewProjection. graphics device : {}.trace info : {}",
 							this->_gDevice->get_info(),
@@ -313,7 +313,7 @@ namespace wolf
 
 				W_RESULT set_color(_In_ w_color pColor)
 				{
-					const std::string _trace_info = this->_name + "::set_color";
+					const char* _trace_info = "w_shapes::set_color";
 
 					this->_color = pColor;
 
@@ -326,7 +326,7 @@ namespace wolf
 					auto _hr = this->_u1.update();
 					if (_hr == W_FAILED)
 					{
-						V(W_FAILED,
+						W_V(W_FAILED,
 							w_log_type::W_ERROR,
 							"updating uniform color. graphics device : {}.trace info : {}",
 							this->_gDevice->get_info(),
@@ -338,13 +338,13 @@ namespace wolf
 
 				W_RESULT draw(_In_ const w_command_buffer& pCommandBuffer)
 				{
-					const std::string _trace_info = this->_name + "::draw";
+					const char* _trace_info = "w_shapes::draw";
 
 					this->_pipeline.bind(pCommandBuffer, w_pipeline_bind_point::GRAPHICS);
 
 					if (this->_shape_drawer.draw(pCommandBuffer, nullptr, 0) == W_FAILED)
 					{
-						V(W_FAILED,
+						W_V(W_FAILED,
 							w_log_type::W_ERROR,
 							"drawing shape. graphics device : {}.trace info : {}",
 							this->_gDevice->get_info(),
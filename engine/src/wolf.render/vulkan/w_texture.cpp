@@ -70,7 +70,7 @@ namespace wolf
 
 			W_RESULT load()
 			{
-				const char* _trace_info = (this->_name + "::load").c_str();
+				const char* _trace_info = "w_texture::load";
 
 				auto _hr = _create_image();
 				if (_hr == W_FAILED) return W_FAILED;
@@ -84,7 +84,7 @@ namespace wolf
 					this->_memory.handle,
 					0))
 				{
-					V(W_FAILED, 
+					W_V(W_FAILED, 
 						w_log_type::W_ERROR,
 						"binding VkImage for graphics device: {}. trace info: {}",
 						this->_gDevice->get_info(),
@@ -126,7 +126,7 @@ namespace wolf
 
                 if (_hr == W_FAILED)
                 {
-					V(W_FAILED,
+					W_V(W_FAILED,
 						w_log_type::W_ERROR,
 						L"could not find the texture file: {} . graphics device: {}. trace info: {}",
 						_path,
@@ -207,7 +207,7 @@ namespace wolf
 				
 				if (this->_image_view.width == 0 || this->_image_view.height == 0)
 				{
-					V(W_FAILED,
+					W_V(W_FAILED,
 						w_log_type::W_ERROR,
 						L"Width or Height of texture file is zero for texture: {} . graphics device: {}. trace info: {}",
 						_path,
@@ -253,7 +253,7 @@ namespace wolf
 					this->_memory.handle,
 					0))
 				{
-					V(W_FAILED,
+					W_V(W_FAILED,
 						w_log_type::W_ERROR,
 						"binding VkImage for graphics device: {}. trace info: {}",
 						this->_gDevice->get_info(),
@@ -278,7 +278,7 @@ namespace wolf
 				}
 				else
 				{
-					V(W_FAILED,
+					W_V(W_FAILED,
 						w_log_type::W_ERROR,
 						L"texture file is corrupted: {}. graphics device: {}. trace info: {}",
 						_path,
@@ -314,7 +314,7 @@ namespace wolf
 					this->_memory.handle,
 					0))
 				{
-					V(W_FAILED,
+					W_V(W_FAILED,
 						w_log_type::W_ERROR,
 						"binding VkImage for graphics device: {}. trace info: {}",
 						this->_gDevice->get_info(),
@@ -382,7 +382,7 @@ namespace wolf
 					&this->_image_view.image);
 				if (_hr)
 				{
-					V(W_FAILED,
+					W_V(W_FAILED,
 						w_log_type::W_ERROR,
 						"creating VkImage for graphics device: {}. trace info: {}",
 						this->_gDevice->get_info(),
@@ -417,7 +417,7 @@ namespace wolf
 					(VkMemoryPropertyFlags)this->_memory_property_flags,
 					&_mem_index))
 				{
-					V(W_FAILED,
+					W_V(W_FAILED,
 						w_log_type::W_ERROR,
 						"finding memory index of Image for graphics device: {}. trace info: {}",
 						this->_gDevice->get_info(),
@@ -438,7 +438,7 @@ namespace wolf
 					nullptr,
 					&this->_memory.handle))
 				{
-					V(W_FAILED,
+					W_V(W_FAILED,
 						w_log_type::W_ERROR,
 						"allocating memory for Image. graphics device: {}. trace info: {}",
 						this->_gDevice->get_info(),
@@ -487,7 +487,7 @@ namespace wolf
 					&this->_image_view.view);
 				if (_hr)
 				{
-					V(W_FAILED,
+					W_V(W_FAILED,
 						w_log_type::W_ERROR,
 						"creating image view. graphics device: {}. trace info: {}",
 						this->_gDevice->get_info(),
@@ -503,7 +503,7 @@ namespace wolf
             
 			W_RESULT _create_sampler()
 			{
-				const char* _trace_info = (this->_name + "::_create_sampler").c_str();
+				const char* _trace_info = "w_texture::_create_sampler";
 
 				VkSamplerCreateInfo _sampler_create_info = {};
 				_sampler_create_info.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
@@ -534,7 +534,7 @@ namespace wolf
 					&_no_mip_map_no_anisotropy_sampler.handle);
 				if (_hr)
 				{
-					V(W_FAILED,
+					W_V(W_FAILED,
 						w_log_type::W_ERROR,
 						"creating sampler without mip map and without anisotropy. graphics device: {}. trace info: {}",
 						this->_gDevice->get_info(),
@@ -554,7 +554,7 @@ namespace wolf
 					&_mip_map_no_anisotropy_sampler.handle);
 				if (_hr)
 				{
-					V(W_FAILED,
+					W_V(W_FAILED,
 						w_log_type::W_ERROR,
 						"creating sampler with mip map and without anisotropy. graphics device: {}. trace info: {}",
 						this->_gDevice->get_info(),
@@ -578,7 +578,7 @@ namespace wolf
 						&_mip_map_anisotropy_sampler.handle);
 					if (_hr)
 					{
-						V(W_FAILED,
+						W_V(W_FAILED,
 							w_log_type::W_ERROR,
 							"creating sampler with mip map and with anisotropy. graphics device: {}. trace info: {}",
 							this->_gDevice->get_info(),
@@ -599,7 +599,7 @@ namespace wolf
 						&_no_mip_map_anisotropy_sampler.handle);
 					if (_hr)
 					{
-						V(W_FAILED,
+						W_V(W_FAILED,
 							w_log_type::W_ERROR,
 							"creating sampler without mip map and with anisotropy. graphics device: {}. trace info: {}",
 							this->_gDevice->get_info(),
@@ -620,7 +620,7 @@ namespace wolf
 
             W_RESULT copy_data_to_texture_2D(_In_ const uint8_t* pRGBA)
             {
-				const char* _trace_info = (this->_name + "::copy_data_to_texture_2D").c_str();
+				const char* _trace_info = "w_texture::copy_data_to_texture_2D";
 				
                 auto _data_size = this->_image_view.width * this->_image_view.height * 4;
 				W_RESULT _hr = W_RESULT::W_FAILED;
@@ -644,7 +644,7 @@ namespace wolf
 
 					if (_hr == W_FAILED)
 					{
-						V(W_FAILED,
+						W_V(W_FAILED,
 							w_log_type::W_ERROR,
 							"flushing staging memory for graphics device: {}. trace info: {}",
 							this->_gDevice->get_info(),
@@ -655,7 +655,7 @@ namespace wolf
 				}
 				else
 				{
-					V(W_FAILED,
+					W_V(W_FAILED,
 						w_log_type::W_ERROR,
 						"mapping staging memory for graphics device: {}. trace info: {}",
 						this->_gDevice->get_info(),
@@ -767,7 +767,7 @@ namespace wolf
 
 				if (_hr == W_FAILED)
 				{
-					V(W_FAILED,
+					W_V(W_FAILED,
 						w_log_type::W_ERROR,
 						"submit commad buffer for generating mipmaps for graphics device: {}. trace info: {}",
 						this->_gDevice->get_info(),
@@ -785,7 +785,7 @@ namespace wolf
 				{
 					if (_copy_mip_maps() == W_FAILED)
 					{
-						V(W_FAILED,
+						W_V(W_FAILED,
 							w_log_type::W_ERROR,
 							"copying mip maps data to texture buffer on graphics device: {}. trace info: {}",
 							this->_gDevice->get_info(),
@@ -800,7 +800,7 @@ namespace wolf
             
 			W_RESULT copy_data_to_texture_2D_array(_In_ const gli::texture2d_array& pTextureArrayRGBA)
 			{				
-				const char* _trace_info = (this->_name + "::copy_data_to_texture_2D_array").c_str();
+				const char* _trace_info = "w_texture::copy_data_to_texture_2D_array";
 
 				auto _data_size = static_cast<uint32_t>(pTextureArrayRGBA.size());
 
@@ -825,7 +825,7 @@ namespace wolf
 					0,
 					&this->_staging_buffer_memory_pointer))
 				{
-					V(W_FAILED,
+					W_V(W_FAILED,
 						w_log_type::W_ERROR,
 						"Could not map memory and upload texture data to a staging buffer on graphics device: {}. trace info: {}",
 						this->_gDevice->get_info(),
@@ -964,7 +964,7 @@ namespace wolf
 				_command_buffer.release();
 				if (_hr == W_FAILED)
 				{
-					V(W_FAILED,
+					W_V(W_FAILED,
 						w_log_type::W_ERROR,
 						"could submit map memory and upload texture data to a staging buffer on graphics device: {}. trace info: {}",
 						this->_gDevice->get_info(),
@@ -983,11 +983,11 @@ namespace wolf
                 {
                     if (_copy_mip_maps() == W_FAILED)
                     {
-                        V(W_FAILED, "copying mip maps data to texture buffer on graphics device: " +
-                          this->_gDevice->device_info->get_device_name() + " ID: " + std::to_string(this->_gDevice->device_info->get_device_id()),
-                          this->_name,
-                          3,
-                          false);
+                        W_V(W_FAILED,
+                            w_log_type::W_ERROR,
+                            "copying mip maps data to texture buffer on graphics device: {}. trace info: {}",
+                            this->_gDevice->get_info(),
+                            _trace_info);
                         
                         return W_FAILED;
                     }
@@ -998,7 +998,7 @@ namespace wolf
             
             W_RESULT _copy_mip_maps()
             {
-				const char* _trace_info = (this->_name + "::_copy_mip_maps").c_str();
+				const char* _trace_info = "w_texture::_copy_mip_maps";
 				                
                 bool _bliting_supported = true;
                 
@@ -1012,7 +1012,7 @@ namespace wolf
                     &_format_properties);
 				if (!(_format_properties.optimalTilingFeatures & VK_FORMAT_FEATURE_BLIT_SRC_BIT))
 				{
-					V(W_FAILED,
+					W_V(W_FAILED,
 						w_log_type::W_ERROR,
 						"Blitting feature not supported from optimal tiled image for graphics device: {}. trace info: {}",
 						this->_gDevice->get_info(),
@@ -1170,7 +1170,7 @@ namespace wolf
 
 					if (_hr == W_FAILED)
 					{
-						V(W_FAILED,
+						W_V(W_FAILED,
 							w_log_type::W_ERROR,
 							"submit commad buffer for generating mipmaps for graphics device: {}. trace info: {}",
 							this->_gDevice->get_info(),
@@ -1220,11 +1220,11 @@ namespace wolf
 
 				//if (_hr)
 				//{
-				//	V(W_FAILED, "Could not map memory and upload texture data to a staging buffer on graphics device: " +
-				//		this->_gDevice->device_name + " ID: " + std::to_string(this->_gDevice->device_id),
-				//		this->_name,
-				//		3,
-				//		false);
+				//	W_V(W_FAILED,
+				//		w_log_type::W_ERROR,
+				//		"Could not map memory and upload texture data to a staging buffer on graphics device: {}. trace info: {}",
+				//		this->_gDevice->get_info(),
+				//		_trace_info);
 				//	return W_FAILED;
 				//}
 
@@ -1363,7 +1363,7 @@ namespace wolf
 				auto _hr = vkQueueSubmit(this->_gDevice->vk_graphics_queue.queue, 1, &_submit_info, VK_NULL_HANDLE);
 				if (_hr)
 				{
-					V(W_FAILED,
+					W_V(W_FAILED,
 						w_log_type::W_ERROR,
 						"could submit map memory and upload texture data to a staging buffer on graphics device: {}. trace info: {}",
 						this->_gDevice->get_info(),
@@ -1512,7 +1512,7 @@ namespace wolf
                 auto _vhr = vkQueueSubmit(this->_gDevice->vk_graphics_queue.queue, 1, &_submit_info, VK_NULL_HANDLE);
                 if (_vhr)
                 {
-					V(W_FAILED,
+					W_V(W_FAILED,
 						w_log_type::W_ERROR,
 						"could submit map memory and upload texture data to a staging buffer on graphics device: {}. trace info: {}",
 						this->_gDevice->get_info(),
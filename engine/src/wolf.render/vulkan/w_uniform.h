@@ -43,7 +43,7 @@ namespace wolf
 				W_RESULT load(_In_ const std::shared_ptr<w_graphics_device>& pGDevice,
 					_In_ const bool& pHostVisible = false)
 				{
-					const char* _trace_info = (this->name + "::update").c_str();
+					const char* _trace_info = "w_uniform::load";
 
 					this->_host_visible = pHostVisible;
 
@@ -64,7 +64,7 @@ namespace wolf
 
 						if (_hr == W_FAILED)
 						{
-							V(_hr,
+							W_V(_hr,
 								w_log_type::W_ERROR,
 								"loading host visible buffer. graphics device: {}. trace info: {}",
 								_gDevice->get_info(),
@@ -81,7 +81,7 @@ namespace wolf
 
 						if (_hr == W_FAILED)
 						{
-							V(_hr,
+							W_V(_hr,
 								w_log_type::W_ERROR,
 								"loading device buffer. graphics device: {}. trace info: {}",
 								_gDevice->get_info(),
@@ -96,7 +96,7 @@ namespace wolf
 							w_memory_usage_flag::MEMORY_USAGE_CPU_ONLY);
 						if (_hr == W_FAILED)
 						{
-							V(_hr,
+							W_V(_hr,
 								w_log_type::W_ERROR,
 								"loading staging buffer. graphics device: {}. trace info: {}",
 								_gDevice->get_info(),
@@ -107,10 +107,11 @@ namespace wolf
 						//_hr = this->_staging_buffer.bind();
 						//if (_hr == W_FAILED)
 						//{
-						//    V(_hr, "binding device buffer " +
+						//    W_V(_hr,
+						//        w_log_type::W_ERROR,
+						//        "binding device buffer. graphics device: {}. trace info: {}",
 						//        _gDevice->get_info(),
-						//        _trace,
-						//        3);
+						//        _trace_info);
 						//    return _hr;
 						//}
 					}
@@ -118,10 +119,11 @@ namespace wolf
 					//_hr = this->_buffer.bind();
 					//if (_hr == W_FAILED)
 					//{
-					//    V(_hr, "binding buffer " +
+					//    W_V(_hr,
+					//        w_log_type::W_ERROR,
+					//        "binding buffer. graphics device: {}. trace info: {}",
 					//        _gDevice->get_info(),
-					//        _trace,
-					//        3);
+					//        _trace_info);
 					//    return _hr;
 					//}
 
@@ -130,14 +132,14 @@ namespace wolf
 
 				W_RESULT update()
 				{
-					const std::string _trace_info = this->name + "update";
+					const char* _trace_info = "w_uniform::update";
 
 					W_RESULT _hr = W_PASSED;
 
 					if (this->_host_visible)
 					{
 						_hr = this->_buffer.set_data(&this->data);
-						V(_hr,
+						W_V(_hr,
 							w_log_type::W_ERROR,
 							"setting to host visible buffer. graphics device : {}.trace info : {}",
 							_gDevice->get_info(),
@@ -155,7 +157,7 @@ namespace wolf
 						else
 						{
 							_hr = W_FAILED;
-							V(_hr,
+							W_V(_hr,
 								w_log_type::W_ERROR,
 								"begining command buffer . graphics device : {}.trace info : {}",
 								_gDevice->get_info(),
@@ -166,7 +168,7 @@ namespace wolf
 						if (_hr == W_FAILED) return _hr;
 
 						_hr = this->_staging_buffer.copy_to(this->_buffer);
-						V(_hr,
+						W_V(_hr,
 							w_log_type::W_ERROR,
 							"copy staging buffer to device buffer . graphics device : {}.trace info : {}",
 							_gDevice->get_info(),
@@ -1,6 +1,7 @@
 #include "w_render_pch.h"
 #include "w_game.h"
 #include <future>
+#include <w_frame_arena.h>
 
 using namespace std;
 using namespace wolf;
@@ -95,6 +96,9 @@ bool w_game::run(_In_ map<int, w_present_info>& pOutputWindowsInfo)
 
     if (this->load_state != LOAD_STATE::LOADED) return true;
 
+    //scratch memory of frame arenas will be reused from now on
+    wolf::system::w_frame_arena::begin_frame();
+
     update(this->_game_time);
 
     this->_game_time.tick([&]()
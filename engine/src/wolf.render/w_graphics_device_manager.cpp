@@ -185,7 +185,7 @@ W_RESULT w_graphics_device::submit(
 	_In_ w_fences*										pFence,
 	_In_ const bool&									pWaitIdleForDone)
 {
-	const std::string _trace_info = "w_graphics_device::submit";
+	const char* _trace_info = "w_graphics_device::submit";
 
 	auto _size = static_cast<uint32_t>(pCommandBuffers.size());
 	if (!_size) return W_FAILED;
@@ -242,7 +242,7 @@ W_RESULT w_graphics_device::submit(
 	if (vkQueueSubmit(pQueue.queue, 1, &_submit_info, _fence))
 	{
 		_hr = W_FAILED;
-		V(_hr,
+		W_V(_hr,
 			w_log_type::W_ERROR,
 			"submiting queue for graphics device: {}. trace info: {}", 
 			this->get_info(),
@@ -255,7 +255,7 @@ W_RESULT w_graphics_device::submit(
 		if (vkQueueWaitIdle(pQueue.queue))
 		{
 			_hr = W_FAILED;
-			V(_hr,
+			W_V(_hr,
 				w_log_type::W_ERROR,
 				"waiting idle queue for graphics device: {} . trace info: {}",
 				this->get_info(),
@@ -282,7 +282,7 @@ W_RESULT w_graphics_device::capture(
 {
     W_RESULT _return_result = W_PASSED;
 
-    const std::string _trace_info = "w_graphics_device::capture";
+    const char* _trace_info = "w_graphics_device::capture";
     
     VkImage _dst_image = 0;
     VkDeviceMemory _dst_image_memory = 0;
@@ -339,7 +339,7 @@ W_RESULT w_graphics_device::capture(
 	if (_hr)
 	{
 		_return_result = W_FAILED;
-		V(_return_result,
+		W_V(_return_result,
 			w_log_type::W_ERROR,
 			"creating destination image for graphics device: {}. trace info: {}",
 			this->get_info(),
@@ -371,7 +371,7 @@ W_RESULT w_graphics_device::capture(
         if (_hr)
         {
             _return_result = W_FAILED;
-            V(_return_result,
+            W_V(_return_result,
 				w_log_type::W_ERROR,
                 "creating destination image for graphics device: {}. trace info: {}", 
 				this->get_info(),
@@ -386,7 +386,7 @@ W_RESULT w_graphics_device::capture(
     if (_hr)
     {
         _return_result = W_FAILED;
-        V(_return_result,
+        W_V(_return_result,
 			w_log_type::W_ERROR,
             "binding to destination image for graphics graphics device: {}. trace info: {}",
 			this->get_info(),
@@ -414,7 +414,7 @@ W_RESULT w_graphics_device::capture(
 		if (_hr)
 		{
 			_return_result = W_FAILED;
-			V(_return_result,
+			W_V(_return_result,
 				w_log_type::W_ERROR,
 				"allocating buffer for copy command buffer for graphics device: {}. trace info: {}",
 				this->get_info(),
@@ -430,7 +430,7 @@ W_RESULT w_graphics_device::capture(
 		if (_hr)
 		{
 			_return_result = W_FAILED;
-			V(_return_result,
+			W_V(_return_result,
 				w_log_type::W_ERROR,
 				"beginning copy command buffer for graphics device: {} . trace info: {}",
 				this->get_info(),
@@ -599,7 +599,7 @@ W_RESULT w_graphics_device::capture(
 		if (_hr)
 		{
 			_return_result = W_FAILED;
-			V(_return_result,
+			W_V(_return_result,
 				w_log_type::W_ERROR,
 				"ending copy command buffer for graphics device: {}. trace info: {}",
 				this->get_info(),
@@ -617,7 +617,7 @@ W_RESULT w_graphics_device::capture(
 		if (_hr)
 		{
 			_return_result = W_FAILED;
-			V(_return_result,
+			W_V(_return_result,
 				w_log_type::W_ERROR,
 				"creating fence of copy command buffer for graphics device: {} . trace info: {}",
 				this->get_info(),
@@ -636,7 +636,8 @@ W_RESULT w_graphics_device::capture(
 		if (_hr)
 		{
 			_return_result = W_FAILED;
-			V(_return_result,
+			W_V(_return_result,
+				w_log_type::W_ERROR,
 				"submiting copy command buffer to queue for graphics device: {}. trace info: {}",
 				this->get_info(),
 				_trace_info);
@@ -647,7 +648,8 @@ W_RESULT w_graphics_device::capture(
 		if (_hr)
 		{
 			_return_result = W_FAILED;
-			V(_return_result,
+			W_V(_return_result,
+				w_log_type::W_ERROR,
 				"submiting copy command buffer to queue for graphics device: {}. trace info: {}",
 				this->get_info(),
 				_trace_info);
@@ -692,7 +694,8 @@ clean_up:
             _hr = vkEndCommandBuffer(_copy_cmd);
 			if (_hr)
 			{
-				V(W_FAILED,
+				W_V(W_FAILED,
+					w_log_type::W_ERROR,
 					"ending copy command buffer for graphics device: {}. trace info: {}",
 					this->get_info(),
 					_trace_info);
@@ -719,7 +722,7 @@ W_RESULT w_graphics_device::capture_presented_swap_chain_buffer(
 	_In_ wolf::system::w_signal<void(const w_point_t, uint8_t*)>& pOnPixelsDataCaptured)
 {
 	W_RESULT _return_result = W_PASSED;
-	const std::string _trace_info = "w_graphics_device::capture_presented_swap_chain_buffer";
+	const char* _trace_info = "w_graphics_device::capture_presented_swap_chain_buffer";
 
 	auto _objs_ptr = this->output_presentation_window.objs_between_cpu_gpu;
 	if (!_objs_ptr) return W_FAILED;
@@ -744,7 +747,7 @@ W_RESULT w_graphics_device::capture_presented_swap_chain_buffer(
 
 	if (_hr)
 	{
-		V(_return_result,
+		W_V(_return_result,
 			w_log_type::W_ERROR,
 			"beginning copy command buffer for graphics device {}. trace info: {}",
 			this->get_info(),
@@ -902,7 +905,8 @@ W_RESULT w_graphics_device::capture_presented_swap_chain_buffer(
 			if (_hr)
 			{
 				_return_result = W_FAILED;
-				V(_return_result,
+				W_V(_return_result,
+					w_log_type::W_ERROR,
 					"ending copy command buffer for graphics device: {}. trace info: {}",
 					this->get_info(),
 					_trace_info);
@@ -919,7 +923,8 @@ W_RESULT w_graphics_device::capture_presented_swap_chain_buffer(
 			if (_hr)
 			{
 				_return_result = W_FAILED;
-				V(_return_result,
+				W_V(_return_result,
+					w_log_type::W_ERROR,
 					"creating fence of copy command buffer for graphics device: {}. trace info: {}",
 					this->get_info(),
 					_trace_info);
@@ -937,7 +942,8 @@ W_RESULT w_graphics_device::capture_presented_swap_chain_buffer(
 			if (_hr)
 			{
 				_return_result = W_FAILED;
-				V(_return_result,
+				W_V(_return_result,
+					w_log_type::W_ERROR,
 					"submiting copy command buffer to queue for graphics device: {}. trace info: {}",
 					this->get_info(),
 					_trace_info);
@@ -948,7 +954,8 @@ W_RESULT w_graphics_device::capture_presented_swap_chain_buffer(
 			if (_hr)
 			{
 				_return_result = W_FAILED;
-				V(_return_result,
+				W_V(_return_result,
+					w_log_type::W_ERROR,
 					"submiting copy command buffer to queue for graphics device: {}. trace info: {}",
 					this->get_info(),
 					_trace_info);
@@ -982,7 +989,8 @@ clean_up:
 		if (_hr)
 		{
 			_return_result = W_FAILED;
-			V(_return_result,
+			W_V(_return_result,
+				w_log_type::W_ERROR,
 				"ending copy command buffer for graphics device: {}. trace info: {}",
 				this->get_info(),
 				_trace_info);
@@ -1021,12 +1029,11 @@ void w_graphics_device::_clean_swap_chain()
 				auto _hr = vkEndCommandBuffer(_shared_obj->copy_command_buffer);
 				if (_hr)
 				{
-					V(W_FAILED,
+					W_V(W_FAILED,
+						w_log_type::W_ERROR,
 						"ending remained copy command buffer between CPU-GPU for graphics device: {}. trace info: {}",
 						this->get_info(),
-						"w_graphics_device::release",
-						3,
-						false);
+						"w_graphics_device::release");
 				}
 				_shared_obj->command_buffer_began = false;
 			}
@@ -1513,7 +1520,11 @@ namespace wolf
 #ifdef __WIN32
 						//get the monitors numerator and denominator
 						_hr = _adapter->EnumOutputs(0, &_gDevice->dx_dxgi_outputs);
-						V(_hr, "enumurate output monitors", this->_name, 2);
+						W_V(FAILED(_hr) ? W_FAILED : W_PASSED,
+							w_log_type::W_WARNING,
+							"enumurate output monitors for graphics device: {}. trace info: {}",
+							_gDevice->get_info(),
+							"w_graphics_device_manager::enumerate_devices");
 
 #endif
 						//add harware device to graphics devices list
@@ -2417,8 +2428,11 @@ namespace wolf
 				{
 					// Disable full screen with ALT+Enter
 					_hr = w_graphics_device::dx_dxgi_factory->MakeWindowAssociation(_output_presentation_window->hwnd, DXGI_MWA_NO_ALT_ENTER);
-					V(_hr, L"disabling ALT+Enter for presentation window: " + std::to_wstring(pOutputPresentationWindowIndex),
-						this->_name, 2);
+					W_V(FAILED(_hr) ? W_FAILED : W_PASSED,
+						w_log_type::W_WARNING,
+						"disabling ALT+Enter for presentation window: {}. trace info: {}",
+						pOutputPresentationWindowIndex,
+						_trace_info);
 
 					// Describe and create the swap chain.
 					DXGI_SWAP_CHAIN_DESC1 _swap_chain_desc = {};
@@ -2446,9 +2460,12 @@ namespace wolf
 							nullptr,
 							&_swap_chain);
 
-						V(_hr, L"create swap chain from hwnd for graphics device: " + _device_name + L" ID:" + std::to_wstring(_device_id) +
-							L" and presentation window: " + std::to_wstring(pOutputPresentationWindowIndex),
-							this->_name, 2);
+						W_V(FAILED(_hr) ? W_FAILED : W_PASSED,
+							w_log_type::W_WARNING,
+							"create swap chain from hwnd for graphics device: {} and presentation window: {}. trace info: {}",
+							pGDevice->get_info(),
+							pOutputPresentationWindowIndex,
+							_trace_info);
 
 						_hr = _swap_chain->QueryInterface(__uuidof(IDXGISwapChain3), (void**)&_output_presentation_window->dx_swap_chain);
 						if (FAILED(_hr))
@@ -2584,9 +2601,12 @@ namespace wolf
 						&_swap_chain_desc,
 						nullptr,
 						&_swap_chain);
-					V(_hr, L"create swap chain from core window for graphics device: " + _device_name + L" ID:" + std::to_wstring(_device_id) +
-						L" and presentation window: " + std::to_wstring(pOutputPresentationWindowIndex),
-						this->_name, 2);
+					W_V(FAILED(_hr) ? W_FAILED : W_PASSED,
+						w_log_type::W_WARNING,
+						"create swap chain from core window for graphics device: {} and presentation window: {}. trace info: {}",
+						pGDevice->get_info(),
+						pOutputPresentationWindowIndex,
+						_trace_info);
 
 					//getting swap chain 3 from swap chain 1
 					_hr = _swap_chain.As(&_output_presentation_window->dx_swap_chain);
@@ -2664,9 +2684,12 @@ namespace wolf
 				_render_target_view_heap_desc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
 
 				_hr = pGDevice->dx_device->CreateDescriptorHeap(&_render_target_view_heap_desc, IID_PPV_ARGS(&_output_presentation_window->dx_render_target_view_heap));
-				V(_hr, L"creating render target heap descriptorfor graphics device: " + _device_name + L" ID:" + std::to_wstring(_device_id) +
-					L" and presentation window: " + std::to_wstring(pOutputPresentationWindowIndex),
-					this->_name, 2);
+				W_V(FAILED(_hr) ? W_FAILED : W_PASSED,
+					w_log_type::W_WARNING,
+					"creating render target heap descriptor for graphics device: {} and presentation window: {}. trace info: {}",
+					pGDevice->get_info(),
+					pOutputPresentationWindowIndex,
+					_trace_info);
 
 				_output_presentation_window->dx_render_target_descriptor_size = pGDevice->dx_device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_RTV);
 
@@ -2678,9 +2701,12 @@ namespace wolf
 				for (UINT i = 0; i < _desired_number_of_swapchain_images; ++i)
 				{
 					_hr = _output_presentation_window->dx_swap_chain->GetBuffer(i, IID_PPV_ARGS(&_output_presentation_window->dx_swap_chain_image_views[i]));
-					V(_hr, L"creating render target image view for swap chain of graphics device: " + _device_name + L" ID:" + std::to_wstring(_device_id) +
-						L" and presentation window: " + std::to_wstring(pOutputPresentationWindowIndex),
-						this->_name, 2);
+					W_V(FAILED(_hr) ? W_FAILED : W_PASSED,
+						w_log_type::W_WARNING,
+						"creating render target image view for swap chain of graphics device: {} and presentation window: {}. trace info: {}",
+						pGDevice->get_info(),
+						pOutputPresentationWindowIndex,
+						_trace_info);
 
 					pGDevice->dx_device->CreateRenderTargetView(_output_presentation_window->dx_swap_chain_image_views[i], nullptr, _render_target_descriptor_handle);
 
@@ -2708,7 +2734,7 @@ namespace wolf
 						_vk_presentation_surface,
 						&pGDevice->vk_queue_family_supports_present[j]);
 
-					V(_hr == 0 ? W_PASSED : W_FAILED,
+					W_V(_hr == 0 ? W_PASSED : W_FAILED,
 						w_log_type::W_WARNING,
 						"could not get physical device surface support for graphics device: {}. trace info: {}",
 						pGDevice->get_info(),
@@ -2722,7 +2748,7 @@ namespace wolf
 					}
 				}
 
-				V(pGDevice->vk_present_queue.index == UINT32_MAX ? W_FAILED : W_PASSED,
+				W_V(pGDevice->vk_present_queue.index == UINT32_MAX ? W_FAILED : W_PASSED,
 					w_log_type::W_WARNING,
 					"could not find queue family which supports presentation for graphics device: {}. trace info: {}",
 					pGDevice->get_info(),
@@ -3370,7 +3396,7 @@ namespace wolf
                 auto _output_window = &(pGDevice->output_presentation_window);
                 if (!_output_window) return;
 
-                const std::string _trace_info = "w_graphics_device::_create_shared_objects_between_cpu_gpu";
+                const char* _trace_info = "w_graphics_device::_create_shared_objects_between_cpu_gpu";
                 //auto _device_id = pGDevice->device_info->get_device_id();
                 auto _device_name = pGDevice->device_info->get_device_name();
 
@@ -3592,7 +3618,10 @@ w_graphics_device_manager::w_graphics_device_manager() : _pimp(new w_graphics_de
    
 #if defined(__WIN32) && !defined(__PYTHON__)
     auto _hr = CoInitialize(NULL);
-	V(_hr == S_OK ? W_PASSED : W_FAILED, L"CoInitialize already been called", _super::name, 3, false);
+	W_V(_hr == S_OK ? W_PASSED : W_FAILED,
+		w_log_type::W_WARNING,
+		"CoInitialize already been called. trace info: {}",
+		"w_graphics_device_manager::w_graphics_device_manager");
 #endif
 
 #ifdef __ANDROID
@@ -3701,7 +3730,11 @@ void w_graphics_device_manager::on_suspend()
 		auto _hr = _gDevice->dx_device.As(&_dxgi_device);
 		if (FAILED(_hr))
 		{
-			V(W_FAILED, "getting dxgi device from d3d11device for graphics device: " + _gDevice->device_name + " ID:" + std::to_string(_gDevice->device_id) + , this->name, 2);
+			W_V(W_FAILED,
+				w_log_type::W_WARNING,
+				"getting dxgi device from d3d11device for graphics device: {}. trace info: {}",
+				_gDevice->get_info(),
+				"w_graphics_device_manager::on_suspend");
 		}
 		else
 		{
@@ -4,11 +4,11 @@
 /// \file
 ****************************************************************************************/
 // This is the implementation of address-aligned malloc and free using a linked list (inserting at front).
-// These functions are not thread-safe because there is an access to the addressList global variable.
-// Use a mutex when you access the global variable to make it thread-safe.
+// Accesses to the addressList global variable are guarded by a mutex, so these functions are thread-safe.
 #include "w_system_pch.h"
 #include <stdlib.h>
 #include <stdio.h>
+#include <mutex>
 
 // a linked list node to store a coupled memory address of the original and aligned address.
 typedef struct llnode
@@ -19,6 +19,7 @@ typedef struct llnode
 } node;
 
 static node* s_addressList = NULL;
+static std::mutex s_addressListMutex;
 static void PrintList();
 template <typename T>
 static T GetNextPowerOfTwo(T nValue);
@@ -85,6 +86,8 @@ void* aligned_malloc(size_t bytes, size_t alignment)
     //  that the linked list does not store multiple entry of the same memory address.
     node* addressEntry;
 
+    std::lock_guard<std::mutex> lock(s_addressListMutex);
+
     for (addressEntry = s_addressList;
          addressEntry != NULL;
          addressEntry = addressEntry->next)
@@ -146,6 +149,8 @@ void aligned_free(void* p)
     node* addressEntry;
     node* prevAddressEntry;
 
+    std::lock_guard<std::mutex> lock(s_addressListMutex);
+
     prevAddressEntry = s_addressList;
 
     for (addressEntry = s_addressList;
@@ -0,0 +1,592 @@
+#include "w_system_pch.h"
+#include "w_async_file_reader.h"
+#include "w_thread_pool.h"
+#include <mutex>
+#include <thread>
+#include <cstring>
+#include <fstream>
+
+#if defined(__linux) || defined(__ANDROID) || defined(__APPLE__)
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#if defined(__linux) && !defined(__ANDROID)
+#include <sys/syscall.h>
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/uio.h>
+#define W_ASYNC_FILE_READER_USE_IO_URING
+#endif
+#endif
+
+namespace wolf
+{
+    namespace system
+    {
+        //read whole file with bulk reads, returns zero or errno
+        static int s_read_file(_In_z_ const char* pPath, _Inout_ std::vector<uint8_t>& pData)
+        {
+#if defined(__linux) || defined(__ANDROID) || defined(__APPLE__)
+            auto _fd = open(pPath, O_RDONLY | O_CLOEXEC);
+            if (_fd == -1) return errno;
+
+            struct stat _stat;
+            if (fstat(_fd, &_stat) != 0)
+            {
+                auto _error = errno;
+                close(_fd);
+                return _error;
+            }
+
+            pData.resize(static_cast<size_t>(_stat.st_size));
+
+            int _error = 0;
+            size_t _read = 0;
+            while (_read < pData.size())
+            {
+                auto _size = pread(_fd, pData.data() + _read, pData.size() - _read, static_cast<off_t>(_read));
+                if (_size < 0 && errno == EINTR) continue;
+                if (_size < 0)
+                {
+                    _error = errno;
+                    break;
+                }
+                if (_size == 0)
+                {
+                    //file was truncated while reading
+                    _error = EIO;
+                    break;
+                }
+                _read += static_cast<size_t>(_size);
+            }
+            close(_fd);
+
+            pData.resize(_read);
+            return _error;
+#else
+            std::ifstream _file(pPath, std::ios::binary | std::ios::ate);
+            if (!_file) return ENOENT;
+
+            auto _size = static_cast<size_t>(_file.tellg());
+            _file.seekg(0, std::ios::beg);
+
+            pData.resize(_size);
+            if (_size && !_file.read(reinterpret_cast<char*>(pData.data()), static_cast<std::streamsize>(_size)))
+            {
+                pData.resize(static_cast<size_t>(_file.gcount()));
+                return EIO;
+            }
+            return 0;
+#endif
+        }
+
+        class w_async_file_reader_pimp
+        {
+        public:
+            w_async_file_reader_pimp() :
+                _name("w_async_file_reader"),
+                _thread_pool(nullptr),
+                _queue_depth(0)
+#ifdef W_ASYNC_FILE_READER_USE_IO_URING
+                , _ring_fd(-1),
+                _sq_ring(nullptr),
+                _cq_ring(nullptr),
+                _sqes(nullptr),
+                _sq_ring_size(0),
+                _cq_ring_size(0),
+                _sqes_size(0),
+                _sq_head(nullptr),
+                _sq_tail(nullptr),
+                _sq_mask(nullptr),
+                _sq_array(nullptr),
+                _cq_head(nullptr),
+                _cq_tail(nullptr),
+                _cq_mask(nullptr),
+                _cqes(nullptr)
+#endif
+            {
+            }
+
+            ~w_async_file_reader_pimp()
+            {
+                release();
+            }
+
+            W_RESULT initialize(_In_opt_ w_thread_pool* pThreadPool, _In_ const uint32_t& pQueueDepth)
+            {
+                release();
+
+                this->_thread_pool = pThreadPool;
+                this->_queue_depth = pQueueDepth ? pQueueDepth : 1;
+
+#ifdef W_ASYNC_FILE_READER_USE_IO_URING
+                if (_setup_ring() == W_FAILED)
+                {
+                    logger.write("io_uring is not available, {} uses {}", this->_name,
+                        this->_thread_pool ? "thread pool" : "the calling thread");
+                }
+#endif
+                return W_PASSED;
+            }
+
+            W_RESULT read(_Inout_ std::vector<w_file_read_request>& pRequests)
+            {
+                std::lock_guard<std::mutex> _lock(this->_mutex);
+
+                for (auto& _request : pRequests)
+                {
+                    _request.data.clear();
+                    _request.result = W_FAILED;
+                    _request.error = 0;
+                }
+
+#ifdef W_ASYNC_FILE_READER_USE_IO_URING
+                if (this->_ring_fd != -1)
+                {
+                    _read_ring(pRequests);
+                }
+                else
+#endif
+                {
+                    _read_pool(pRequests);
+                }
+
+                auto _hr = W_PASSED;
+                for (auto& _request : pRequests)
+                {
+                    if (_request.result == W_FAILED)
+                    {
+                        W_V(W_FAILED, w_log_type::W_ERROR, "could not read file {}. error: {}. trace info: {}",
+                            _request.path, _request.error, "w_async_file_reader::read");
+                        _hr = W_FAILED;
+                    }
+                }
+                return _hr;
+            }
+
+            ULONG release()
+            {
+                std::lock_guard<std::mutex> _lock(this->_mutex);
+
+#ifdef W_ASYNC_FILE_READER_USE_IO_URING
+                if (this->_sqes)
+                {
+                    munmap(this->_sqes, this->_sqes_size);
+                    this->_sqes = nullptr;
+                }
+                if (this->_cq_ring && this->_cq_ring != this->_sq_ring)
+                {
+                    munmap(this->_cq_ring, this->_cq_ring_size);
+                }
+                this->_cq_ring = nullptr;
+                if (this->_sq_ring)
+                {
+                    munmap(this->_sq_ring, this->_sq_ring_size);
+                    this->_sq_ring = nullptr;
+                }
+                if (this->_ring_fd != -1)
+                {
+                    close(this->_ring_fd);
+                    this->_ring_fd = -1;
+                }
+                this->_orphaned_buffers.clear();
+                this->_orphaned_ops.clear();
+#endif
+                this->_thread_pool = nullptr;
+                return 0;
+            }
+
+#pragma region Getters
+            bool get_is_io_uring() const
+            {
+#ifdef W_ASYNC_FILE_READER_USE_IO_URING
+                return this->_ring_fd != -1;
+#else
+                return false;
+#endif
+            }
+#pragma endregion
+
+        private:
+            void _read_pool(_Inout_ std::vector<w_file_read_request>& pRequests)
+            {
+                auto _read = [&pRequests](const size_t& pBegin, const size_t& pEnd)
+                {
+                    for (auto i = pBegin; i < pEnd; ++i)
+                    {
+                        auto& _request = pRequests[i];
+                        _request.error = s_read_file(_request.path.c_str(), _request.data);
+                        _request.result = _request.error ? W_FAILED : W_PASSED;
+                    }
+                };
+
+                if (this->_thread_pool && this->_thread_pool->get_pool_size() && pRequests.size() > 1)
+                {
+                    this->_thread_pool->parallel_for(0, pRequests.size(), _read, 1);
+                }
+                else
+                {
+                    _read(0, pRequests.size());
+                }
+            }
+
+#ifdef W_ASYNC_FILE_READER_USE_IO_URING
+            //state of a file which is being read, only one read of each file is in flight
+            struct file_op
+            {
+                int             fd = -1;
+                size_t          offset = 0;
+                struct iovec    iov;
+            };
+
+            W_RESULT _setup_ring()
+            {
+                struct io_uring_params _params;
+                std::memset(&_params, 0, sizeof(_params));
+
+                auto _fd = static_cast<int>(syscall(__NR_io_uring_setup, this->_queue_depth, &_params));
+                if (_fd < 0) return W_FAILED;
+
+                this->_sq_ring_size = _params.sq_off.array + _params.sq_entries * sizeof(uint32_t);
+                this->_cq_ring_size = _params.cq_off.cqes + _params.cq_entries * sizeof(struct io_uring_cqe);
+                const bool _single_mmap = (_params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+                if (_single_mmap)
+                {
+                    this->_sq_ring_size = this->_cq_ring_size = std::max(this->_sq_ring_size, this->_cq_ring_size);
+                }
+
+                auto _sq_ring = mmap(nullptr, this->_sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _fd, IORING_OFF_SQ_RING);
+                if (_sq_ring == MAP_FAILED)
+                {
+                    close(_fd);
+                    return W_FAILED;
+                }
+                this->_ring_fd = _fd;
+                this->_sq_ring = static_cast<uint8_t*>(_sq_ring);
+
+                if (_single_mmap)
+                {
+                    this->_cq_ring = this->_sq_ring;
+                }
+                else
+                {
+                    auto _cq_ring = mmap(nullptr, this->_cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _fd, IORING_OFF_CQ_RING);
+                    if (_cq_ring == MAP_FAILED)
+                    {
+                        _release_ring();
+                        return W_FAILED;
+                    }
+                    this->_cq_ring = static_cast<uint8_t*>(_cq_ring);
+                }
+
+                this->_sqes_size = _params.sq_entries * sizeof(struct io_uring_sqe);
+                auto _sqes = mmap(nullptr, this->_sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _fd, IORING_OFF_SQES);
+                if (_sqes == MAP_FAILED)
+                {
+                    _release_ring();
+                    return W_FAILED;
+                }
+                this->_sqes = static_cast<struct io_uring_sqe*>(_sqes);
+
+                this->_sq_head = reinterpret_cast<uint32_t*>(this->_sq_ring + _params.sq_off.head);
+                this->_sq_tail = reinterpret_cast<uint32_t*>(this->_sq_ring + _params.sq_off.tail);
+                this->_sq_mask = reinterpret_cast<uint32_t*>(this->_sq_ring + _params.sq_off.ring_mask);
+                this->_sq_array = reinterpret_cast<uint32_t*>(this->_sq_ring + _params.sq_off.array);
+                this->_cq_head = reinterpret_cast<uint32_t*>(this->_cq_ring + _params.cq_off.head);
+                this->_cq_tail = reinterpret_cast<uint32_t*>(this->_cq_ring + _params.cq_off.tail);
+                this->_cq_mask = reinterpret_cast<uint32_t*>(this->_cq_ring + _params.cq_off.ring_mask);
+                this->_cqes = reinterpret_cast<struct io_uring_cqe*>(this->_cq_ring + _params.cq_off.cqes);
+
+                //the kernel may round the number of entries up
+                this->_queue_depth = std::min(this->_queue_depth, _params.sq_entries);
+
+                return W_PASSED;
+            }
+
+            void _release_ring()
+            {
+                if (this->_sqes) munmap(this->_sqes, this->_sqes_size);
+                if (this->_cq_ring && this->_cq_ring != this->_sq_ring) munmap(this->_cq_ring, this->_cq_ring_size);
+                if (this->_sq_ring) munmap(this->_sq_ring, this->_sq_ring_size);
+                if (this->_ring_fd != -1) close(this->_ring_fd);
+                this->_sqes = nullptr;
+                this->_cq_ring = nullptr;
+                this->_sq_ring = nullptr;
+                this->_ring_fd = -1;
+            }
+
+            //queue a read of the rest of file, the caller must not exceed the queue depth
+            void _queue_read(_In_ const size_t& pIndex, _Inout_ file_op& pOp, _Inout_ w_file_read_request& pRequest)
+            {
+                pOp.iov.iov_base = pRequest.data.data() + pOp.offset;
+                pOp.iov.iov_len = pRequest.data.size() - pOp.offset;
+
+                auto _tail = *this->_sq_tail;
+                auto _index = _tail & *this->_sq_mask;
+                auto _sqe = &this->_sqes[_index];
+                std::memset(_sqe, 0, sizeof(struct io_uring_sqe));
+                _sqe->opcode = IORING_OP_READV;
+                _sqe->fd = pOp.fd;
+                _sqe->addr = reinterpret_cast<uint64_t>(&pOp.iov);
+                _sqe->len = 1;
+                _sqe->off = pOp.offset;
+                _sqe->user_data = pIndex;
+
+                this->_sq_array[_index] = _index;
+                //the kernel must see the entry before the new tail
+                __atomic_store_n(this->_sq_tail, _tail + 1, __ATOMIC_RELEASE);
+            }
+
+            //wait for completions of submitted reads and drop their results, returns false if the ring could not be drained
+            bool _drain(_In_ uint32_t pSubmitted)
+            {
+                while (pSubmitted)
+                {
+                    auto _ret = syscall(__NR_io_uring_enter, this->_ring_fd, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+                    if (_ret < 0 && errno != EINTR && errno != EAGAIN && errno != EBUSY) return false;
+
+                    auto _head = *this->_cq_head;
+                    auto _tail = __atomic_load_n(this->_cq_tail, __ATOMIC_ACQUIRE);
+                    for (; _head != _tail && pSubmitted; ++_head)
+                    {
+                        pSubmitted--;
+                    }
+                    __atomic_store_n(this->_cq_head, _head, __ATOMIC_RELEASE);
+                }
+                return true;
+            }
+
+            void _read_ring(_Inout_ std::vector<w_file_read_request>& pRequests)
+            {
+                std::vector<file_op> _ops(pRequests.size());
+
+                auto _finish = [&](const size_t& pIndex, const int& pError)
+                {
+                    auto& _op = _ops[pIndex];
+                    if (_op.fd != -1)
+                    {
+                        close(_op.fd);
+                        _op.fd = -1;
+                    }
+                    pRequests[pIndex].error = pError;
+                    pRequests[pIndex].result = pError ? W_FAILED : W_PASSED;
+                    if (pError) pRequests[pIndex].data.resize(_op.offset);
+                };
+
+                size_t _next = 0;
+                uint32_t _in_flight = 0, _to_submit = 0;
+                while (_next < pRequests.size() || _in_flight)
+                {
+                    //open files till the queue is full, files are opened lazily so the number of descriptors is bounded by queue depth
+                    while (_next < pRequests.size() && _in_flight < this->_queue_depth)
+                    {
+                        auto _index = _next++;
+                        auto& _request = pRequests[_index];
+                        auto& _op = _ops[_index];
+
+                        _op.fd = open(_request.path.c_str(), O_RDONLY | O_CLOEXEC);
+                        if (_op.fd == -1)
+                        {
+                            _finish(_index, errno);
+                            continue;
+                        }
+
+                        struct stat _stat;
+                        if (fstat(_op.fd, &_stat) != 0)
+                        {
+                            _finish(_index, errno);
+                            continue;
+                        }
+                        _request.data.resize(static_cast<size_t>(_stat.st_size));
+                        if (_request.data.empty())
+                        {
+                            _finish(_index, 0);
+                            continue;
+                        }
+
+                        _queue_read(_index, _op, _request);
+                        _in_flight++;
+                        _to_submit++;
+                    }
+                    if (!_in_flight) break;
+
+                    auto _ret = syscall(__NR_io_uring_enter, this->_ring_fd, _to_submit, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+                    if (_ret < 0)
+                    {
+                        if (errno == EINTR) continue;
+                        if (errno == EAGAIN || errno == EBUSY)
+                        {
+                            //the kernel is short of resources or the completion queue is full, reap what completed and submit again
+                            if (_in_flight > _to_submit)
+                            {
+                                syscall(__NR_io_uring_enter, this->_ring_fd, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+                            }
+                            else
+                            {
+                                std::this_thread::yield();
+                            }
+                            _ret = 0;
+                        }
+                        else
+                        {
+                            //the ring is broken, wait for submitted reads before touching their buffers and read the rest of batch with the fallback
+                            auto _error = errno;
+                            logger.error("io_uring_enter failed with error {}, {} uses the fallback", _error, this->_name);
+
+                            const bool _drained = _drain(_in_flight - _to_submit);
+                            std::vector<size_t> _rest_indices;
+                            std::vector<w_file_read_request> _rest;
+                            for (size_t i = 0; i < pRequests.size(); ++i)
+                            {
+                                if (i < _next && _ops[i].fd == -1) continue;
+                                if (_ops[i].fd != -1)
+                                {
+                                    close(_ops[i].fd);
+                                    _ops[i].fd = -1;
+                                    if (!_drained)
+                                    {
+                                        //the kernel may still write into this buffer, keep it alive till release
+                                        this->_orphaned_buffers.push_back(std::move(pRequests[i].data));
+                                    }
+                                }
+                                w_file_read_request _request;
+                                _request.path = pRequests[i].path;
+                                _rest.push_back(std::move(_request));
+                                _rest_indices.push_back(i);
+                            }
+                            if (!_drained)
+                            {
+                                //keep the iovecs of those reads alive as well
+                                this->_orphaned_ops.push_back(std::move(_ops));
+                            }
+                            _release_ring();
+
+                            _read_pool(_rest);
+                            for (size_t i = 0; i < _rest.size(); ++i)
+                            {
+                                pRequests[_rest_indices[i]] = std::move(_rest[i]);
+                            }
+                            return;
+                        }
+                    }
+                    _to_submit -= static_cast<uint32_t>(_ret);
+
+                    auto _head = *this->_cq_head;
+                    auto _tail = __atomic_load_n(this->_cq_tail, __ATOMIC_ACQUIRE);
+                    for (; _head != _tail; ++_head)
+                    {
+                        auto _cqe = &this->_cqes[_head & *this->_cq_mask];
+                        auto _index = static_cast<size_t>(_cqe->user_data);
+                        auto _res = _cqe->res;
+
+                        auto& _op = _ops[_index];
+                        auto& _request = pRequests[_index];
+                        if (_res == -EINTR || _res == -EAGAIN)
+                        {
+                            _queue_read(_index, _op, _request);
+                            _to_submit++;
+                            continue;
+                        }
+
+                        _in_flight--;
+                        if (_res < 0)
+                        {
+                            _finish(_index, -_res);
+                        }
+                        else if (_res == 0)
+                        {
+                            //file was truncated while reading
+                            _finish(_index, EIO);
+                        }
+                        else
+                        {
+                            _op.offset += static_cast<size_t>(_res);
+                            if (_op.offset < _request.data.size())
+                            {
+                                //short read, queue the rest
+                                _queue_read(_index, _op, _request);
+                                _in_flight++;
+                                _to_submit++;
+                            }
+                            else
+                            {
+                                _finish(_index, 0);
+                            }
+                        }
+                    }
+                    __atomic_store_n(this->_cq_head, _head, __ATOMIC_RELEASE);
+                }
+            }
+#endif
+
+            std::string                             _name;
+            std::mutex                              _mutex;
+            w_thread_pool*                          _thread_pool;
+            uint32_t                                _queue_depth;
+#ifdef W_ASYNC_FILE_READER_USE_IO_URING
+            int                                     _ring_fd;
+            uint8_t*                                _sq_ring;
+            uint8_t*                                _cq_ring;
+            struct io_uring_sqe*                    _sqes;
+            size_t                                  _sq_ring_size;
+            size_t                                  _cq_ring_size;
+            size_t                                  _sqes_size;
+            uint32_t*                               _sq_head;
+            uint32_t*                               _sq_tail;
+            uint32_t*                               _sq_mask;
+            uint32_t*                               _sq_array;
+            uint32_t*                               _cq_head;
+            uint32_t*                               _cq_tail;
+            uint32_t*                               _cq_mask;
+            struct io_uring_cqe*                    _cqes;
+            //buffers of reads which were in flight when the ring broke
+            std::vector<std::vector<uint8_t>>       _orphaned_buffers;
+            std::vector<std::vector<file_op>>       _orphaned_ops;
+#endif
+        };
+    }
+}
+
+using namespace wolf::system;
+
+w_async_file_reader::w_async_file_reader() :
+    _pimp(new w_async_file_reader_pimp())
+{
+}
+
+w_async_file_reader::~w_async_file_reader()
+{
+    delete this->_pimp;
+    this->_pimp = nullptr;
+}
+
+W_RESULT w_async_file_reader::initialize(_In_opt_ w_thread_pool* pThreadPool, _In_ const uint32_t& pQueueDepth)
+{
+    if (!this->_pimp) return W_FAILED;
+    return this->_pimp->initialize(pThreadPool, pQueueDepth);
+}
+
+W_RESULT w_async_file_reader::read(_Inout_ std::vector<w_file_read_request>& pRequests)
+{
+    if (!this->_pimp) return W_FAILED;
+    return this->_pimp->read(pRequests);
+}
+
+ULONG w_async_file_reader::release()
+{
+    if (!this->_pimp) return 1;
+    return this->_pimp->release();
+}
+
+#pragma region Getters
+
+bool w_async_file_reader::get_is_io_uring() const
+{
+    if (!this->_pimp) return false;
+    return this->_pimp->get_is_io_uring();
+}
+
+#pragma endregion
@@ -0,0 +1,82 @@
+/*
+	Project			 : Wolf Engine. Copyright(c) Pooya Eimandar (http://PooyaEimandar.com) . All rights reserved.
+	Source			 : Please direct any bug to https://github.com/PooyaEimandar/Wolf.Engine/issues
+	Website			 : http://WolfSource.io
+	Name			 : w_async_file_reader.h
+	Description		 : Read a batch of files with many reads in flight, using io_uring on linux and w_thread_pool on other platforms
+	Comment          : if io_uring is not available, e.g. old kernels or blocked by seccomp, the thread pool will be used
+*/
+
+#if _MSC_VER > 1000
+#pragma once
+#endif
+
+#ifndef __W_ASYNC_FILE_READER_H__
+#define __W_ASYNC_FILE_READER_H__
+
+#include "w_system_export.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#if defined(__ANDROID) || defined(__linux) || defined(__APPLE__)
+#include "w_std.h"
+#endif
+
+namespace wolf
+{
+	namespace system
+	{
+        class w_thread_pool;
+
+        struct w_file_read_request
+        {
+            std::string             path;
+            //content of file
+            std::vector<uint8_t>    data;
+            //W_PASSED if the whole file was read
+            W_RESULT                result = W_FAILED;
+            //errno of the operation which failed
+            int                     error = 0;
+        };
+
+        class w_async_file_reader_pimp;
+        class w_async_file_reader
+        {
+        public:
+            WSYS_EXP w_async_file_reader();
+            WSYS_EXP ~w_async_file_reader();
+
+            /*
+                initialize reader
+                @param pThreadPool, the thread pool which reads files if io_uring is not available, nullptr means the calling thread
+                @param pQueueDepth, maximum number of reads in flight
+                @return W_PASSED on success
+            */
+            WSYS_EXP W_RESULT initialize(_In_opt_ w_thread_pool* pThreadPool = nullptr, _In_ const uint32_t& pQueueDepth = 64);
+
+            /*
+                read all files of batch and return once all of them were read, it is thread safe
+                @param pRequests, the requests, data, result and error of each request will be filled
+                @return W_FAILED if one of files could not be read
+            */
+            WSYS_EXP W_RESULT read(_Inout_ std::vector<w_file_read_request>& pRequests);
+
+            WSYS_EXP ULONG release();
+
+#pragma region Getters
+            //returns true if reads are submitted to io_uring
+            WSYS_EXP bool get_is_io_uring() const;
+#pragma endregion
+
+        private:
+            //Prevent copying
+            w_async_file_reader(w_async_file_reader const&);
+            w_async_file_reader& operator= (w_async_file_reader const&);
+
+            w_async_file_reader_pimp*               _pimp;
+        };
+	}
+}
+
+#endif //__W_ASYNC_FILE_READER_H__
@@ -2,6 +2,14 @@
 #include "w_bounding.h"
 #include <glm/glm.hpp>
 
+#if defined(__SSE__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define W_BOUNDING_SSE
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define W_BOUNDING_NEON
+#endif
+
 using namespace wolf::system;
 
 #pragma region bounding box
@@ -24,6 +32,84 @@ w_bounding_box w_bounding_box::create_from_bounding_sphere(_In_ const w_bounding
 	return _box;
 }
 
+w_bounding_box w_bounding_box::create_from_points(_In_ const float* pPositions, _In_ const size_t& pNumberOfPoints)
+{
+	w_bounding_box _box;
+	if (!pPositions || !pNumberOfPoints) return _box;
+
+	float _min[3] = { pPositions[0], pPositions[1], pPositions[2] };
+	float _max[3] = { pPositions[0], pPositions[1], pPositions[2] };
+
+	size_t i = 0;
+
+#if defined(W_BOUNDING_SSE) || defined(W_BOUNDING_NEON)
+	/*
+		four points are twelve floats, which are loaded to three registers as
+		x0 y0 z0 x1 | y1 z1 x2 y2 | z2 x3 y3 z3
+		so each lane always holds the same axis and lanes are merged at the end
+	*/
+	const size_t _simd_points = pNumberOfPoints & ~static_cast<size_t>(3);
+	if (_simd_points)
+	{
+		float _lanes_min[12], _lanes_max[12];
+#ifdef W_BOUNDING_SSE
+		__m128 _min0 = _mm_loadu_ps(pPositions), _max0 = _min0;
+		__m128 _min1 = _mm_loadu_ps(pPositions + 4), _max1 = _min1;
+		__m128 _min2 = _mm_loadu_ps(pPositions + 8), _max2 = _min2;
+		for (i = 4; i < _simd_points; i += 4)
+		{
+			auto _ptr = pPositions + i * 3;
+			auto _r0 = _mm_loadu_ps(_ptr);
+			auto _r1 = _mm_loadu_ps(_ptr + 4);
+			auto _r2 = _mm_loadu_ps(_ptr + 8);
+			_min0 = _mm_min_ps(_min0, _r0); _max0 = _mm_max_ps(_max0, _r0);
+			_min1 = _mm_min_ps(_min1, _r1); _max1 = _mm_max_ps(_max1, _r1);
+			_min2 = _mm_min_ps(_min2, _r2); _max2 = _mm_max_ps(_max2, _r2);
+		}
+		_mm_storeu_ps(_lanes_min, _min0); _mm_storeu_ps(_lanes_min + 4, _min1); _mm_storeu_ps(_lanes_min + 8, _min2);
+		_mm_storeu_ps(_lanes_max, _max0); _mm_storeu_ps(_lanes_max + 4, _max1); _mm_storeu_ps(_lanes_max + 8, _max2);
+#else
+		float32x4_t _min0 = vld1q_f32(pPositions), _max0 = _min0;
+		float32x4_t _min1 = vld1q_f32(pPositions + 4), _max1 = _min1;
+		float32x4_t _min2 = vld1q_f32(pPositions + 8), _max2 = _min2;
+		for (i = 4; i < _simd_points; i += 4)
+		{
+			auto _ptr = pPositions + i * 3;
+			auto _r0 = vld1q_f32(_ptr);
+			auto _r1 = vld1q_f32(_ptr + 4);
+			auto _r2 = vld1q_f32(_ptr + 8);
+			_min0 = vminq_f32(_min0, _r0); _max0 = vmaxq_f32(_max0, _r0);
+			_min1 = vminq_f32(_min1, _r1); _max1 = vmaxq_f32(_max1, _r1);
+			_min2 = vminq_f32(_min2, _r2); _max2 = vmaxq_f32(_max2, _r2);
+		}
+		vst1q_f32(_lanes_min, _min0); vst1q_f32(_lanes_min + 4, _min1); vst1q_f32(_lanes_min + 8, _min2);
+		vst1q_f32(_lanes_max, _max0); vst1q_f32(_lanes_max + 4, _max1); vst1q_f32(_lanes_max + 8, _max2);
+#endif
+		//lane j holds axis j % 3
+		for (size_t j = 0; j < 12; ++j)
+		{
+			_min[j % 3] = std::min(_min[j % 3], _lanes_min[j]);
+			_max[j % 3] = std::max(_max[j % 3], _lanes_max[j]);
+		}
+	}
+#endif
+
+	for (; i < pNumberOfPoints; ++i)
+	{
+		auto _ptr = pPositions + i * 3;
+		for (size_t j = 0; j < 3; ++j)
+		{
+			_min[j] = std::min(_min[j], _ptr[j]);
+			_max[j] = std::max(_max[j], _ptr[j]);
+		}
+	}
+
+	std::memcpy(&_box.min[0], &_min[0], sizeof(_min));
+	std::memcpy(&_box.max[0], &_max[0], sizeof(_max));
+
+	return _box;
+}
+
 void w_bounding_box::generate_vertices()
 {
 	vertices[0] = min[0]; vertices[1] = min[1]; vertices[2] = min[2];
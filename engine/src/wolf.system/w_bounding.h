@@ -39,6 +39,12 @@ namespace wolf
 
 			//create bounding box from bounding sphere
 			WSYS_EXP static w_bounding_box create_from_bounding_sphere(_In_ const w_bounding_sphere& pBoundingSphere);
+			/*
+				create bounding box from packed positions, min and max are computed with SSE or NEON if they are available
+				@param pPositions, x, y and z of each point next to each other
+				@param pNumberOfPoints, number of points, the box of zero points is empty at origin
+			*/
+			WSYS_EXP static w_bounding_box create_from_points(_In_ const float* pPositions, _In_ const size_t& pNumberOfPoints);
 
 			WSYS_EXP void generate_vertices();
 			WSYS_EXP void merge(_In_ const w_bounding_box& pAdditional);
@@ -2,9 +2,88 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdarg.h>
+#define LZ4_STATIC_LINKING_ONLY
 #include "lz4/lz4.h"
+#include "lz4/lz4hc.h"
+#include "lz4/lz4frame.h"
+#include "lz4/xxhash.h"
 
-#define IN_CHUNK_SIZE  (16 * 1024)
+#define IN_CHUNK_SIZE  (64 * 1024)
+
+//buffers which were compressed with dictionary start with uint32 id of dictionary and uint32 size of content
+#define DICT_HEADER_SIZE	8
+//length of k-mers and segments which are used by train_dict_c
+#define DICT_KMER_SIZE		8
+#define DICT_SEGMENT_SIZE	64
+#define DICT_SEGMENT_STEP	16
+#define DICT_HASH_LOG		16
+
+struct w_compress_stream_t
+{
+	LZ4F_cctx*			cctx;
+	LZ4F_dctx*			dctx;
+	LZ4F_preferences_t	preferences;
+};
+
+struct w_compress_dict_t
+{
+	char*				data;
+	int					size;
+	unsigned int		id;
+	//the dictionary is loaded once and attached to working streams of each compression
+	LZ4_stream_t		stream;
+};
+
+static void s_set_error(char* pErrorLog, const char* pFormat, ...)
+{
+	if (!pErrorLog) return;
+
+	va_list _args;
+	va_start(_args, pFormat);
+	vsnprintf(pErrorLog, W_COMPRESS_ERROR_LOG_SIZE, pFormat, _args);
+	va_end(_args);
+}
+
+//level of LZ4-HC from pAcceleration of W_HC mode
+static int s_get_hc_level(int pLevel)
+{
+	if (pLevel <= 0) return LZ4HC_CLEVEL_DEFAULT;
+	if (pLevel < LZ4HC_CLEVEL_MIN) return LZ4HC_CLEVEL_MIN;
+	if (pLevel > LZ4HC_CLEVEL_MAX) return LZ4HC_CLEVEL_MAX;
+	return pLevel;
+}
+
+static void s_set_preferences(
+	/*_Inout_*/	LZ4F_preferences_t* pPreferences,
+	/*_In_*/	w_compress_mode pMode,
+	/*_In_*/	int pAcceleration,
+	/*_In_*/	unsigned long long pContentSize)
+{
+	memset(pPreferences, 0, sizeof(LZ4F_preferences_t));
+	pPreferences->frameInfo.blockSizeID = LZ4F_max64KB;
+	pPreferences->frameInfo.blockMode = LZ4F_blockLinked;
+	pPreferences->frameInfo.contentChecksumFlag = LZ4F_contentChecksumEnabled;
+	pPreferences->frameInfo.contentSize = pContentSize;
+	//negative levels of frame api are acceleration of LZ4_compress_fast and levels from 3 use LZ4-HC
+	if (pMode == W_HC)
+	{
+		pPreferences->compressionLevel = s_get_hc_level(pAcceleration);
+	}
+	else
+	{
+		pPreferences->compressionLevel = (pMode == W_FAST && pAcceleration > 1) ? -(pAcceleration - 1) : 0;
+	}
+	//do not keep data inside context, so memory of caller is the only buffer
+	pPreferences->autoFlush = 1;
+}
+
+//returns 1 if buffer starts with magic number of LZ4 frame
+static int s_is_frame(const char* pBuffer, size_t pSize)
+{
+	const unsigned char _magic[4] = { 0x04, 0x22, 0x4D, 0x18 };
+	return pSize >= 4 && memcmp(pBuffer, _magic, 4) == 0;
+}
 
 int compress_buffer_c(
 	/*_In_*/	const char* pSrcBuffer,
@@ -14,83 +93,75 @@ int compress_buffer_c(
 	/*_Inout_*/ char* pErrorLog)
 {
 	if (!pCompressInfo || !pSrcBuffer || pCompressInfo->size_in == 0) return 1;
-	
+
+	//content size is stored in the header of frame, so decompressor allocates the exact size
+	LZ4F_preferences_t _preferences;
+	s_set_preferences(&_preferences, pMode, pAcceleration, (unsigned long long)pCompressInfo->size_in);
+
 	//allocate size for compressed data
-	const int _max_dst_size = LZ4_compressBound(pCompressInfo->size_in);
+	const size_t _max_dst_size = LZ4F_compressFrameBound(pCompressInfo->size_in, &_preferences);
 	pCompressInfo->data = malloc(_max_dst_size);
 	if (!pCompressInfo->data)
 	{
-		snprintf(
-			pErrorLog,
-			strlen(pErrorLog),
-			"allocating memory for compressed buffer. trace_info: w_compress::compress_buffer_c");
+		s_set_error(pErrorLog, "allocating memory for compressed buffer. trace_info: w_compress::compress_buffer_c");
 		return 1;
 	}
 
-	int _compressed_buffer_size = -1;
-	if (pMode == W_FAST)
-	{
-		_compressed_buffer_size = LZ4_compress_fast_force(pSrcBuffer, pCompressInfo->data, pCompressInfo->size_in, _max_dst_size, pAcceleration);
-	}
-	else
-	{
-		_compressed_buffer_size = LZ4_compress_default(pSrcBuffer, pCompressInfo->data, pCompressInfo->size_in, _max_dst_size);
-	}
+	size_t _compressed_buffer_size = LZ4F_compressFrame(
+		pCompressInfo->data,
+		_max_dst_size,
+		pSrcBuffer,
+		pCompressInfo->size_in,
+		&_preferences);
 
-	if (_compressed_buffer_size > 0)
+	if (!LZ4F_isError(_compressed_buffer_size))
 	{
 		//realloc compress_data to free up memory
-		pCompressInfo->size_out = (size_t)_compressed_buffer_size;
-		pCompressInfo->data = (char*)realloc(pCompressInfo->data, pCompressInfo->size_out);
-		if (!pCompressInfo->data)
-		{
-			snprintf(
-				pErrorLog,
-				strlen(pErrorLog),
-				"could not fit memory of compressed buffer. trace_info: w_compress::compress_buffer_c");
+		pCompressInfo->size_out = _compressed_buffer_size;
+		char* _data = (char*)realloc(pCompressInfo->data, pCompressInfo->size_out);
+		if (!_data)
+		{
+			s_set_error(pErrorLog, "could not fit memory of compressed buffer. trace_info: w_compress::compress_buffer_c");
 			return 1;
 		}
+		pCompressInfo->data = _data;
 		return 0;
 	}
 	else
 	{
-		snprintf(
-			pErrorLog,
-			strlen(pErrorLog),
-			"could not compress. trace_info: w_compress::compress_buffer_c");
+		s_set_error(pErrorLog, "could not compress because %s. trace_info: w_compress::compress_buffer_c", LZ4F_getErrorName(_compressed_buffer_size));
+		free(pCompressInfo->data);
+		pCompressInfo->data = NULL;
+		pCompressInfo->size_out = 0;
 		return 1;
 	}
 }
 
-int decompress_buffer_c(
+//decompress a buffer which was compressed with LZ4_compress_default by the older versions of wolf
+static int s_decompress_block_buffer(
 	/*_In_*/	const char* pCompressedBuffer,
 	/*_Inout_*/	w_compress_result* pDecompressInfo,
 	/*_Inout_*/ char* pErrorLog)
 {
-	if (!pCompressedBuffer || pDecompressInfo->size_in == 0) return 1;
-
 	//allocate memory for decompress
 	size_t _destination_capacity = pDecompressInfo->size_in * 2;
 	pDecompressInfo->data = (char*)malloc(_destination_capacity);
 	if (!pDecompressInfo->data)
 	{
-		snprintf(
-			pErrorLog,
-			strlen(pErrorLog),
-			"error on allocate buffer for decompressed buffer. trace_info: w_compress::decompress_buffer_c");
+		s_set_error(pErrorLog, "error on allocate buffer for decompressed buffer. trace_info: w_compress::decompress_buffer_c");
 		return 1;
 	}
 
 	int _decompressed_size = -1;
 	int _number_of_try = 10;
-	
+
 	while (_number_of_try > 0)
 	{
 		_decompressed_size = LZ4_decompress_safe(
 				pCompressedBuffer,
 				&pDecompressInfo->data[0],
 				(int)pDecompressInfo->size_in,
-				_destination_capacity);
+				(int)_destination_capacity);
 		if (_decompressed_size >= 0)
 		{
 			break;
@@ -98,15 +169,13 @@ int decompress_buffer_c(
 		else
 		{
 			_destination_capacity *= 2;
-			pDecompressInfo->data = (char*)realloc(pDecompressInfo->data, _destination_capacity);
-			if (!pDecompressInfo->data)
+			char* _data = (char*)realloc(pDecompressInfo->data, _destination_capacity);
+			if (!_data)
 			{
-				snprintf(
-					pErrorLog,
-					strlen(pErrorLog),
-					"could not re-allocate memory of de-compressed buffer. trace_info: w_compress::compress_buffer_c");
+				s_set_error(pErrorLog, "could not re-allocate memory of de-compressed buffer. trace_info: w_compress::compress_buffer_c");
 				break;
 			}
+			pDecompressInfo->data = _data;
 		}
 
 		_number_of_try--;
@@ -114,10 +183,7 @@ int decompress_buffer_c(
 
 	if (_decompressed_size <= 0)
 	{
-		snprintf(
-			pErrorLog,
-			strlen(pErrorLog),
-			"decompress size must be greater than zero. trace_info: w_compress::decompress_buffer_c");
+		s_set_error(pErrorLog, "decompress size must be greater than zero. trace_info: w_compress::decompress_buffer_c");
 		free(pDecompressInfo->data);
 		pDecompressInfo->data = NULL;
 		pDecompressInfo->size_out = 0;
@@ -126,15 +192,930 @@ int decompress_buffer_c(
 	else
 	{
 		pDecompressInfo->size_out = _decompressed_size;
-		pDecompressInfo->data = (char*)realloc(pDecompressInfo->data, pDecompressInfo->size_out);
-		if (!pDecompressInfo->data)
+		char* _data = (char*)realloc(pDecompressInfo->data, pDecompressInfo->size_out);
+		if (!_data)
 		{
-			snprintf(
-				pErrorLog,
-				strlen(pErrorLog),
-				"could not fit memory for de-compressed buffer. trace_info: w_compress::compress_buffer_c");
+			s_set_error(pErrorLog, "could not fit memory for de-compressed buffer. trace_info: w_compress::compress_buffer_c");
 			return 1;
 		}
+		pDecompressInfo->data = _data;
+	}
+	return 0;
+}
+
+int decompress_buffer_c(
+	/*_In_*/	const char* pCompressedBuffer,
+	/*_Inout_*/	w_compress_result* pDecompressInfo,
+	/*_Inout_*/ char* pErrorLog)
+{
+	if (!pCompressedBuffer || !pDecompressInfo || pDecompressInfo->size_in == 0) return 1;
+
+	pDecompressInfo->data = NULL;
+	pDecompressInfo->size_out = 0;
+
+	unsigned long long _content_size = 0;
+	if (!s_is_frame(pCompressedBuffer, pDecompressInfo->size_in) ||
+		get_frame_content_size_c(pCompressedBuffer, pDecompressInfo->size_in, &_content_size, NULL))
+	{
+		return s_decompress_block_buffer(pCompressedBuffer, pDecompressInfo, pErrorLog);
+	}
+
+	w_compress_stream _stream = NULL;
+	if (decompress_stream_begin_c(&_stream, pErrorLog)) return 1;
+
+	//the exact size is known for frames of wolf, the buffer only grows for frames without content size
+	size_t _capacity = _content_size ? (size_t)_content_size : pDecompressInfo->size_in * 2;
+	pDecompressInfo->data = (char*)malloc(_capacity ? _capacity : 1);
+	if (!pDecompressInfo->data)
+	{
+		s_set_error(pErrorLog, "error on allocate buffer for decompressed buffer. trace_info: w_compress::decompress_buffer_c");
+		decompress_stream_free_c(_stream);
+		return 1;
+	}
+
+	size_t _consumed = 0;
+	int _is_done = 0;
+	while (!_is_done)
+	{
+		if (pDecompressInfo->size_out == _capacity && !_content_size)
+		{
+			_capacity *= 2;
+			char* _data = (char*)realloc(pDecompressInfo->data, _capacity);
+			if (!_data)
+			{
+				s_set_error(pErrorLog, "could not re-allocate memory of de-compressed buffer. trace_info: w_compress::decompress_buffer_c");
+				break;
+			}
+			pDecompressInfo->data = _data;
+		}
+
+		size_t _src_size = pDecompressInfo->size_in - _consumed;
+		size_t _dst_size = _capacity - pDecompressInfo->size_out;
+		if (decompress_stream_update_c(
+			_stream,
+			pCompressedBuffer + _consumed,
+			&_src_size,
+			pDecompressInfo->data + pDecompressInfo->size_out,
+			&_dst_size,
+			&_is_done,
+			pErrorLog))
+		{
+			break;
+		}
+		_consumed += _src_size;
+		pDecompressInfo->size_out += _dst_size;
+
+		if (!_is_done && !_src_size && !_dst_size)
+		{
+			s_set_error(pErrorLog, _consumed == pDecompressInfo->size_in ?
+				"compressed buffer is truncated. trace_info: w_compress::decompress_buffer_c" :
+				"content is bigger than the size of frame header. trace_info: w_compress::decompress_buffer_c");
+			break;
+		}
+	}
+	decompress_stream_free_c(_stream);
+
+	if (!_is_done || pDecompressInfo->size_out == 0)
+	{
+		free(pDecompressInfo->data);
+		pDecompressInfo->data = NULL;
+		pDecompressInfo->size_out = 0;
+		return 1;
+	}
+
+	if (pDecompressInfo->size_out != _capacity)
+	{
+		char* _data = (char*)realloc(pDecompressInfo->data, pDecompressInfo->size_out);
+		if (_data)
+		{
+			pDecompressInfo->data = _data;
+		}
+	}
+	return 0;
+}
+
+int get_frame_content_size_c(
+	/*_In_*/	const char* pCompressedBuffer,
+	/*_In_*/	size_t pSize,
+	/*_Out_*/	unsigned long long* pContentSize,
+	/*_Inout_*/ char* pErrorLog)
+{
+	if (!pCompressedBuffer || !pContentSize) return 1;
+	*pContentSize = 0;
+
+	LZ4F_dctx* _dctx = NULL;
+	if (LZ4F_isError(LZ4F_createDecompressionContext(&_dctx, LZ4F_VERSION)))
+	{
+		s_set_error(pErrorLog, "could not create decompression context. trace_info: w_compress::get_frame_content_size_c");
+		return 1;
+	}
+
+	LZ4F_frameInfo_t _info;
+	size_t _size = pSize;
+	size_t _hr = LZ4F_getFrameInfo(_dctx, &_info, pCompressedBuffer, &_size);
+	LZ4F_freeDecompressionContext(_dctx);
+
+	if (LZ4F_isError(_hr))
+	{
+		s_set_error(pErrorLog, "could not read frame header because %s. trace_info: w_compress::get_frame_content_size_c", LZ4F_getErrorName(_hr));
+		return 1;
+	}
+	*pContentSize = _info.contentSize;
+	return 0;
+}
+
+int compress_stream_begin_c(
+	/*_Out_*/	w_compress_stream* pStream,
+	/*_In_*/	w_compress_mode pMode,
+	/*_In_*/	int pAcceleration,
+	/*_In_*/	unsigned long long pContentSize,
+	/*_Inout_*/	char* pDst,
+	/*_In_*/	size_t pDstCapacity,
+	/*_Out_*/	size_t* pDstSize,
+	/*_Inout_*/ char* pErrorLog)
+{
+	if (!pStream || !pDst || !pDstSize) return 1;
+	*pStream = NULL;
+	*pDstSize = 0;
+
+	struct w_compress_stream_t* _stream = (struct w_compress_stream_t*)calloc(1, sizeof(struct w_compress_stream_t));
+	if (!_stream)
+	{
+		s_set_error(pErrorLog, "allocating memory for compress stream. trace_info: w_compress::compress_stream_begin_c");
+		return 1;
+	}
+	if (LZ4F_isError(LZ4F_createCompressionContext(&_stream->cctx, LZ4F_VERSION)))
+	{
+		s_set_error(pErrorLog, "could not create compression context. trace_info: w_compress::compress_stream_begin_c");
+		free(_stream);
+		return 1;
+	}
+
+	s_set_preferences(&_stream->preferences, pMode, pAcceleration, pContentSize);
+
+	size_t _hr = LZ4F_compressBegin(_stream->cctx, pDst, pDstCapacity, &_stream->preferences);
+	if (LZ4F_isError(_hr))
+	{
+		s_set_error(pErrorLog, "could not write frame header because %s. trace_info: w_compress::compress_stream_begin_c", LZ4F_getErrorName(_hr));
+		compress_stream_free_c(_stream);
+		return 1;
+	}
+
+	*pDstSize = _hr;
+	*pStream = _stream;
+	return 0;
+}
+
+size_t compress_stream_bound_c(
+	/*_In_*/	w_compress_stream pStream,
+	/*_In_*/	size_t pSrcSize)
+{
+	return LZ4F_compressBound(pSrcSize, pStream ? &pStream->preferences : NULL);
+}
+
+int compress_stream_update_c(
+	/*_In_*/	w_compress_stream pStream,
+	/*_In_*/	const char* pSrc,
+	/*_In_*/	size_t pSrcSize,
+	/*_Inout_*/	char* pDst,
+	/*_In_*/	size_t pDstCapacity,
+	/*_Out_*/	size_t* pDstSize,
+	/*_Inout_*/ char* pErrorLog)
+{
+	if (!pStream || !pStream->cctx || !pDstSize || (!pSrc && pSrcSize)) return 1;
+
+	size_t _hr = LZ4F_compressUpdate(pStream->cctx, pDst, pDstCapacity, pSrc, pSrcSize, NULL);
+	if (LZ4F_isError(_hr))
+	{
+		s_set_error(pErrorLog, "could not compress because %s. trace_info: w_compress::compress_stream_update_c", LZ4F_getErrorName(_hr));
+		*pDstSize = 0;
+		return 1;
+	}
+	*pDstSize = _hr;
+	return 0;
+}
+
+int compress_stream_end_c(
+	/*_In_*/	w_compress_stream pStream,
+	/*_Inout_*/	char* pDst,
+	/*_In_*/	size_t pDstCapacity,
+	/*_Out_*/	size_t* pDstSize,
+	/*_Inout_*/ char* pErrorLog)
+{
+	if (!pStream || !pStream->cctx || !pDstSize) return 1;
+
+	size_t _hr = LZ4F_compressEnd(pStream->cctx, pDst, pDstCapacity, NULL);
+	if (LZ4F_isError(_hr))
+	{
+		s_set_error(pErrorLog, "could not finish frame because %s. trace_info: w_compress::compress_stream_end_c", LZ4F_getErrorName(_hr));
+		*pDstSize = 0;
+		return 1;
+	}
+	*pDstSize = _hr;
+	return 0;
+}
+
+void compress_stream_free_c(/*_In_*/ w_compress_stream pStream)
+{
+	if (!pStream) return;
+	if (pStream->cctx)
+	{
+		LZ4F_freeCompressionContext(pStream->cctx);
+	}
+	free(pStream);
+}
+
+int decompress_stream_begin_c(
+	/*_Out_*/	w_compress_stream* pStream,
+	/*_Inout_*/ char* pErrorLog)
+{
+	if (!pStream) return 1;
+	*pStream = NULL;
+
+	struct w_compress_stream_t* _stream = (struct w_compress_stream_t*)calloc(1, sizeof(struct w_compress_stream_t));
+	if (!_stream)
+	{
+		s_set_error(pErrorLog, "allocating memory for decompress stream. trace_info: w_compress::decompress_stream_begin_c");
+		return 1;
+	}
+	if (LZ4F_isError(LZ4F_createDecompressionContext(&_stream->dctx, LZ4F_VERSION)))
+	{
+		s_set_error(pErrorLog, "could not create decompression context. trace_info: w_compress::decompress_stream_begin_c");
+		free(_stream);
+		return 1;
+	}
+
+	*pStream = _stream;
+	return 0;
+}
+
+int decompress_stream_update_c(
+	/*_In_*/	w_compress_stream pStream,
+	/*_In_*/	const char* pSrc,
+	/*_Inout_*/	size_t* pSrcSize,
+	/*_Inout_*/	char* pDst,
+	/*_Inout_*/	size_t* pDstSize,
+	/*_Out_*/	int* pIsFrameDone,
+	/*_Inout_*/ char* pErrorLog)
+{
+	if (!pStream || !pStream->dctx || !pSrcSize || !pDstSize || !pIsFrameDone) return 1;
+
+	size_t _hr = LZ4F_decompress(pStream->dctx, pDst, pDstSize, pSrc, pSrcSize, NULL);
+	if (LZ4F_isError(_hr))
+	{
+		s_set_error(pErrorLog, "could not decompress because %s. trace_info: w_compress::decompress_stream_update_c", LZ4F_getErrorName(_hr));
+		*pSrcSize = 0;
+		*pDstSize = 0;
+		*pIsFrameDone = 0;
+		return 1;
+	}
+	//zero means the frame was decoded completely, the next call starts a new frame
+	*pIsFrameDone = _hr == 0;
+	return 0;
+}
+
+unsigned long long decompress_stream_get_content_size_c(/*_In_*/ w_compress_stream pStream)
+{
+	if (!pStream || !pStream->dctx) return 0;
+
+	LZ4F_frameInfo_t _info;
+	size_t _size = 0;
+	if (LZ4F_isError(LZ4F_getFrameInfo(pStream->dctx, &_info, NULL, &_size))) return 0;
+	return _info.contentSize;
+}
+
+void decompress_stream_free_c(/*_In_*/ w_compress_stream pStream)
+{
+	if (!pStream) return;
+	if (pStream->dctx)
+	{
+		LZ4F_freeDecompressionContext(pStream->dctx);
+	}
+	free(pStream);
+}
+
+int compress_stream_c(
+	/*_In_*/	w_compress_read_callback pRead,
+	/*_In_*/	void* pReader,
+	/*_In_*/	w_compress_write_callback pWrite,
+	/*_In_*/	void* pWriter,
+	/*_In_*/	unsigned long long pContentSize,
+	/*_In_*/	w_compress_mode pMode,
+	/*_In_*/	int pAcceleration,
+	/*_Inout_*/	w_compress_result* pCompressInfo,
+	/*_Inout_*/ char* pErrorLog)
+{
+	if (!pRead || !pWrite) return 1;
+	if (pCompressInfo)
+	{
+		pCompressInfo->size_in = 0;
+		pCompressInfo->size_out = 0;
+		pCompressInfo->data = NULL;
+	}
+
+	LZ4F_preferences_t _preferences;
+	s_set_preferences(&_preferences, pMode, pAcceleration, pContentSize);
+
+	//memory is bounded to one chunk of input and its compressed bound
+	size_t _out_capacity = LZ4F_compressBound(IN_CHUNK_SIZE, &_preferences);
+	if (_out_capacity < LZ4F_HEADER_SIZE_MAX) _out_capacity = LZ4F_HEADER_SIZE_MAX;
+	char* _in = (char*)malloc(IN_CHUNK_SIZE);
+	char* _out = (char*)malloc(_out_capacity);
+	if (!_in || !_out)
+	{
+		s_set_error(pErrorLog, "allocating memory for chunks of stream. trace_info: w_compress::compress_stream_c");
+		free(_in);
+		free(_out);
+		return 1;
+	}
+
+	int _result = 1;
+	w_compress_stream _stream = NULL;
+	size_t _size = 0, _total_in = 0, _total_out = 0;
+	if (compress_stream_begin_c(&_stream, pMode, pAcceleration, pContentSize, _out, _out_capacity, &_size, pErrorLog)) goto cleanup;
+	if (pWrite(pWriter, _out, _size) != _size)
+	{
+		s_set_error(pErrorLog, "could not write to output stream. trace_info: w_compress::compress_stream_c");
+		goto cleanup;
+	}
+	_total_out += _size;
+
+	for (;;)
+	{
+		size_t _read = pRead(pReader, _in, IN_CHUNK_SIZE);
+		if (_read == W_COMPRESS_STREAM_ERROR)
+		{
+			s_set_error(pErrorLog, "could not read from input stream. trace_info: w_compress::compress_stream_c");
+			goto cleanup;
+		}
+		if (_read == 0) break;
+		_total_in += _read;
+
+		if (compress_stream_update_c(_stream, _in, _read, _out, _out_capacity, &_size, pErrorLog)) goto cleanup;
+		if (_size && pWrite(pWriter, _out, _size) != _size)
+		{
+			s_set_error(pErrorLog, "could not write to output stream. trace_info: w_compress::compress_stream_c");
+			goto cleanup;
+		}
+		_total_out += _size;
+	}
+
+	if (pContentSize && pContentSize != _total_in)
+	{
+		s_set_error(pErrorLog, "read %llu bytes but content size is %llu. trace_info: w_compress::compress_stream_c",
+			(unsigned long long)_total_in, pContentSize);
+		goto cleanup;
 	}
+
+	if (compress_stream_end_c(_stream, _out, _out_capacity, &_size, pErrorLog)) goto cleanup;
+	if (pWrite(pWriter, _out, _size) != _size)
+	{
+		s_set_error(pErrorLog, "could not write to output stream. trace_info: w_compress::compress_stream_c");
+		goto cleanup;
+	}
+	_total_out += _size;
+	_result = 0;
+
+cleanup:
+	compress_stream_free_c(_stream);
+	free(_in);
+	free(_out);
+	if (pCompressInfo)
+	{
+		pCompressInfo->size_in = _total_in;
+		pCompressInfo->size_out = _total_out;
+	}
+	return _result;
+}
+
+int decompress_stream_c(
+	/*_In_*/	w_compress_read_callback pRead,
+	/*_In_*/	void* pReader,
+	/*_In_*/	w_compress_write_callback pWrite,
+	/*_In_*/	void* pWriter,
+	/*_Inout_*/	w_compress_result* pDecompressInfo,
+	/*_Inout_*/ char* pErrorLog)
+{
+	if (!pRead || !pWrite) return 1;
+	if (pDecompressInfo)
+	{
+		pDecompressInfo->size_in = 0;
+		pDecompressInfo->size_out = 0;
+		pDecompressInfo->data = NULL;
+	}
+
+	char* _in = (char*)malloc(IN_CHUNK_SIZE);
+	char* _out = (char*)malloc(IN_CHUNK_SIZE);
+	if (!_in || !_out)
+	{
+		s_set_error(pErrorLog, "allocating memory for chunks of stream. trace_info: w_compress::decompress_stream_c");
+		free(_in);
+		free(_out);
+		return 1;
+	}
+
+	int _result = 1;
+	int _is_done = 0;
+	size_t _total_in = 0, _total_out = 0;
+	w_compress_stream _stream = NULL;
+	if (decompress_stream_begin_c(&_stream, pErrorLog)) goto cleanup;
+
+	for (;;)
+	{
+		size_t _read = pRead(pReader, _in, IN_CHUNK_SIZE);
+		if (_read == W_COMPRESS_STREAM_ERROR)
+		{
+			s_set_error(pErrorLog, "could not read from input stream. trace_info: w_compress::decompress_stream_c");
+			goto cleanup;
+		}
+		if (_read == 0) break;
+		_total_in += _read;
+
+		//concatenated frames are decoded one after another
+		size_t _consumed = 0;
+		while (_consumed < _read)
+		{
+			size_t _src_size = _read - _consumed;
+			size_t _dst_size = IN_CHUNK_SIZE;
+			if (decompress_stream_update_c(_stream, _in + _consumed, &_src_size, _out, &_dst_size, &_is_done, pErrorLog)) goto cleanup;
+			_consumed += _src_size;
+
+			if (_dst_size && pWrite(pWriter, _out, _dst_size) != _dst_size)
+			{
+				s_set_error(pErrorLog, "could not write to output stream. trace_info: w_compress::decompress_stream_c");
+				goto cleanup;
+			}
+			_total_out += _dst_size;
+		}
+	}
+
+	//flush data which is buffered inside context
+	while (!_is_done && _total_in)
+	{
+		size_t _src_size = 0;
+		size_t _dst_size = IN_CHUNK_SIZE;
+		if (decompress_stream_update_c(_stream, _in, &_src_size, _out, &_dst_size, &_is_done, pErrorLog)) goto cleanup;
+		if (!_dst_size) break;
+		if (pWrite(pWriter, _out, _dst_size) != _dst_size)
+		{
+			s_set_error(pErrorLog, "could not write to output stream. trace_info: w_compress::decompress_stream_c");
+			goto cleanup;
+		}
+		_total_out += _dst_size;
+	}
+
+	if (!_is_done)
+	{
+		s_set_error(pErrorLog, "compressed stream is empty or truncated. trace_info: w_compress::decompress_stream_c");
+		goto cleanup;
+	}
+	_result = 0;
+
+cleanup:
+	decompress_stream_free_c(_stream);
+	free(_in);
+	free(_out);
+	if (pDecompressInfo)
+	{
+		pDecompressInfo->size_in = _total_in;
+		pDecompressInfo->size_out = _total_out;
+	}
+	return _result;
+}
+
+static size_t s_file_read(void* pFile, char* pBuffer, size_t pSize)
+{
+	size_t _read = fread(pBuffer, 1, pSize, (FILE*)pFile);
+	if (_read < pSize && ferror((FILE*)pFile)) return W_COMPRESS_STREAM_ERROR;
+	return _read;
+}
+
+static size_t s_file_write(void* pFile, const char* pBuffer, size_t pSize)
+{
+	return fwrite(pBuffer, 1, pSize, (FILE*)pFile);
+}
+
+int compress_file_c(
+	/*_In_*/	FILE* pFileStreamIn,
+	/*_Inout_*/	FILE* pCompressedFileOut,
+	/*_In_*/	w_compress_mode pMode,
+	/*_In_*/	int pAcceleration,
+	/*_Inout_*/	w_compress_result* pCompressInfo,
+	/*_Inout_*/ char* pErrorLog)
+{
+	if (!pFileStreamIn || !pCompressedFileOut) return 1;
+
+	//store the remaining size of file in the header if the file is seekable
+	unsigned long long _content_size = 0;
+	long _position = ftell(pFileStreamIn);
+	if (_position >= 0 && fseek(pFileStreamIn, 0, SEEK_END) == 0)
+	{
+		long _end = ftell(pFileStreamIn);
+		if (_end > _position)
+		{
+			_content_size = (unsigned long long)(_end - _position);
+		}
+		fseek(pFileStreamIn, _position, SEEK_SET);
+	}
+
+	return compress_stream_c(
+		s_file_read,
+		pFileStreamIn,
+		s_file_write,
+		pCompressedFileOut,
+		_content_size,
+		pMode,
+		pAcceleration,
+		pCompressInfo,
+		pErrorLog);
+}
+
+int decompress_file_c(
+	/*_In_*/	FILE* pCompressedFileIn,
+	/*_Inout_*/	FILE* pFileStreamOut,
+	/*_Inout_*/	w_compress_result* pDecompressInfo,
+	/*_Inout_*/ char* pErrorLog)
+{
+	if (!pCompressedFileIn || !pFileStreamOut) return 1;
+
+	return decompress_stream_c(
+		s_file_read,
+		pCompressedFileIn,
+		s_file_write,
+		pFileStreamOut,
+		pDecompressInfo,
+		pErrorLog);
+}
+
+static void s_write_u32(char* pDst, unsigned int pValue)
+{
+	pDst[0] = (char)(pValue & 0xFF);
+	pDst[1] = (char)((pValue >> 8) & 0xFF);
+	pDst[2] = (char)((pValue >> 16) & 0xFF);
+	pDst[3] = (char)((pValue >> 24) & 0xFF);
+}
+
+static unsigned int s_read_u32(const char* pSrc)
+{
+	const unsigned char* _src = (const unsigned char*)pSrc;
+	return (unsigned int)_src[0] | ((unsigned int)_src[1] << 8) | ((unsigned int)_src[2] << 16) | ((unsigned int)_src[3] << 24);
+}
+
+int create_dict_c(
+	/*_In_*/	const char* pDictionary,
+	/*_In_*/	size_t pDictionarySize,
+	/*_Out_*/	w_compress_dict* pDict,
+	/*_Inout_*/ char* pErrorLog)
+{
+	w_compress_dict _dict;
+
+	if (!pDict) return 1;
+	*pDict = NULL;
+	if (!pDictionary || !pDictionarySize)
+	{
+		s_set_error(pErrorLog, "dictionary is empty. trace_info: w_compress::create_dict_c");
+		return 1;
+	}
+
+	//LZ4 only refers to the last 64KB of dictionary
+	if (pDictionarySize > W_COMPRESS_DICT_MAX_SIZE)
+	{
+		pDictionary += pDictionarySize - W_COMPRESS_DICT_MAX_SIZE;
+		pDictionarySize = W_COMPRESS_DICT_MAX_SIZE;
+	}
+
+	_dict = (w_compress_dict)malloc(sizeof(struct w_compress_dict_t));
+	if (!_dict)
+	{
+		s_set_error(pErrorLog, "could not allocate dictionary. trace_info: w_compress::create_dict_c");
+		return 1;
+	}
+	_dict->data = (char*)malloc(pDictionarySize);
+	if (!_dict->data)
+	{
+		free(_dict);
+		s_set_error(pErrorLog, "could not allocate dictionary. trace_info: w_compress::create_dict_c");
+		return 1;
+	}
+	memcpy(_dict->data, pDictionary, pDictionarySize);
+	_dict->size = (int)pDictionarySize;
+	_dict->id = XXH32(_dict->data, pDictionarySize, 0);
+
+	LZ4_resetStream(&_dict->stream);
+	LZ4_loadDict(&_dict->stream, _dict->data, _dict->size);
+
+	*pDict = _dict;
+	return 0;
+}
+
+unsigned int get_dict_id_c(/*_In_*/ w_compress_dict pDict)
+{
+	return pDict ? pDict->id : 0;
+}
+
+void free_dict_c(/*_In_*/ w_compress_dict pDict)
+{
+	if (!pDict) return;
+	free(pDict->data);
+	free(pDict);
+}
+
+int compress_buffer_dict_c(
+	/*_In_*/	const char* pSrcBuffer,
+	/*_In_*/	w_compress_dict pDict,
+	/*_In_*/	w_compress_mode pMode,
+	/*_In_*/	int pAcceleration,
+	/*_Inout_*/	w_compress_result* pCompressInfo,
+	/*_Inout_*/ char* pErrorLog)
+{
+	int _bound, _size;
+
+	if (!pCompressInfo || !pSrcBuffer || !pDict || pCompressInfo->size_in == 0) return 1;
+	pCompressInfo->data = NULL;
+	pCompressInfo->size_out = 0;
+
+	if (pCompressInfo->size_in > LZ4_MAX_INPUT_SIZE)
+	{
+		s_set_error(pErrorLog, "buffer is too big for dictionary compression, use compress_buffer_c. trace_info: w_compress::compress_buffer_dict_c");
+		return 1;
+	}
+
+	_bound = LZ4_compressBound((int)pCompressInfo->size_in);
+	pCompressInfo->data = (char*)malloc(DICT_HEADER_SIZE + (size_t)_bound);
+	if (!pCompressInfo->data)
+	{
+		s_set_error(pErrorLog, "allocating memory for compressed buffer. trace_info: w_compress::compress_buffer_dict_c");
+		return 1;
+	}
+
+	if (pMode == W_HC)
+	{
+		//loading the dictionary costs less than compressing with LZ4-HC, so HC does not keep a loaded state
+		LZ4_streamHC_t* _stream = LZ4_createStreamHC();
+		if (!_stream)
+		{
+			free(pCompressInfo->data);
+			pCompressInfo->data = NULL;
+			s_set_error(pErrorLog, "could not create stream of LZ4-HC. trace_info: w_compress::compress_buffer_dict_c");
+			return 1;
+		}
+		LZ4_resetStreamHC(_stream, s_get_hc_level(pAcceleration));
+		LZ4_loadDictHC(_stream, pDict->data, pDict->size);
+		_size = LZ4_compress_HC_continue(
+			_stream,
+			pSrcBuffer,
+			pCompressInfo->data + DICT_HEADER_SIZE,
+			(int)pCompressInfo->size_in,
+			_bound);
+		LZ4_freeStreamHC(_stream);
+	}
+	else
+	{
+		LZ4_stream_t _stream;
+		LZ4_resetStream(&_stream);
+		LZ4_attach_dictionary(&_stream, &pDict->stream);
+		_size = LZ4_compress_fast_continue(
+			&_stream,
+			pSrcBuffer,
+			pCompressInfo->data + DICT_HEADER_SIZE,
+			(int)pCompressInfo->size_in,
+			_bound,
+			(pMode == W_FAST && pAcceleration > 1) ? pAcceleration : 1);
+	}
+
+	if (_size <= 0)
+	{
+		free(pCompressInfo->data);
+		pCompressInfo->data = NULL;
+		s_set_error(pErrorLog, "could not compress with dictionary. trace_info: w_compress::compress_buffer_dict_c");
+		return 1;
+	}
+
+	s_write_u32(pCompressInfo->data, pDict->id);
+	s_write_u32(pCompressInfo->data + 4, (unsigned int)pCompressInfo->size_in);
+	pCompressInfo->size_out = DICT_HEADER_SIZE + (size_t)_size;
+
+	{
+		char* _data = (char*)realloc(pCompressInfo->data, pCompressInfo->size_out);
+		if (_data) pCompressInfo->data = _data;
+	}
+
+	return 0;
+}
+
+int decompress_buffer_dict_c(
+	/*_In_*/	const char* pCompressedBuffer,
+	/*_In_*/	w_compress_dict pDict,
+	/*_Inout_*/	w_compress_result* pDecompressInfo,
+	/*_Inout_*/ char* pErrorLog)
+{
+	unsigned int _content_size;
+	int _size;
+
+	if (!pDecompressInfo || !pCompressedBuffer || !pDict) return 1;
+	pDecompressInfo->data = NULL;
+	pDecompressInfo->size_out = 0;
+
+	if (pDecompressInfo->size_in < DICT_HEADER_SIZE || pDecompressInfo->size_in - DICT_HEADER_SIZE > LZ4_MAX_INPUT_SIZE)
+	{
+		s_set_error(pErrorLog, "compressed buffer is truncated. trace_info: w_compress::decompress_buffer_dict_c");
+		return 1;
+	}
+	if (s_read_u32(pCompressedBuffer) != pDict->id)
+	{
+		s_set_error(pErrorLog, "buffer was compressed with another dictionary. trace_info: w_compress::decompress_buffer_dict_c");
+		return 1;
+	}
+
+	_content_size = s_read_u32(pCompressedBuffer + 4);
+	if (_content_size == 0 || _content_size > LZ4_MAX_INPUT_SIZE)
+	{
+		s_set_error(pErrorLog, "header of compressed buffer is corrupted. trace_info: w_compress::decompress_buffer_dict_c");
+		return 1;
+	}
+
+	pDecompressInfo->data = (char*)malloc(_content_size);
+	if (!pDecompressInfo->data)
+	{
+		s_set_error(pErrorLog, "error on allocate buffer for decompressed buffer. trace_info: w_compress::decompress_buffer_dict_c");
+		return 1;
+	}
+
+	_size = LZ4_decompress_safe_usingDict(
+		pCompressedBuffer + DICT_HEADER_SIZE,
+		pDecompressInfo->data,
+		(int)(pDecompressInfo->size_in - DICT_HEADER_SIZE),
+		(int)_content_size,
+		pDict->data,
+		pDict->size);
+	if (_size < 0 || (unsigned int)_size != _content_size)
+	{
+		free(pDecompressInfo->data);
+		pDecompressInfo->data = NULL;
+		s_set_error(pErrorLog, "compressed buffer is corrupted. trace_info: w_compress::decompress_buffer_dict_c");
+		return 1;
+	}
+
+	pDecompressInfo->size_out = _content_size;
+	return 0;
+}
+
+typedef struct
+{
+	size_t			offset;
+	unsigned int	size;
+	unsigned int	score;
+} s_dict_segment;
+
+static unsigned int s_hash_kmer(const char* pSrc)
+{
+	unsigned long long _value;
+	memcpy(&_value, pSrc, sizeof(_value));
+	return (unsigned int)((_value * 0x9E3779B185EBCA87ULL) >> (64 - DICT_HASH_LOG));
+}
+
+static int s_compare_segments(const void* pLeft, const void* pRight)
+{
+	const s_dict_segment* _left = (const s_dict_segment*)pLeft;
+	const s_dict_segment* _right = (const s_dict_segment*)pRight;
+	if (_left->score != _right->score) return _left->score > _right->score ? -1 : 1;
+	//keep the order deterministic
+	return _left->offset < _right->offset ? -1 : (_left->offset > _right->offset ? 1 : 0);
+}
+
+int train_dict_c(
+	/*_In_*/	const char* pSamples,
+	/*_In_*/	const size_t* pSampleSizes,
+	/*_In_*/	size_t pNumberOfSamples,
+	/*_Inout_*/	char* pDictionary,
+	/*_In_*/	size_t pDictionaryCapacity,
+	/*_Out_*/	size_t* pDictionarySize,
+	/*_Inout_*/ char* pErrorLog)
+{
+	const size_t _table_size = (size_t)1 << DICT_HASH_LOG;
+	unsigned int* _counts = NULL;
+	unsigned int* _stamps = NULL;
+	s_dict_segment* _segments = NULL;
+	s_dict_segment** _selected = NULL;
+	size_t _number_of_segments = 0, _number_of_selected = 0, _total_size = 0, _dict_size = 0;
+	size_t i, j, _offset;
+
+	if (!pSamples || !pSampleSizes || !pDictionary || !pDictionarySize) return 1;
+	*pDictionarySize = 0;
+
+	if (pDictionaryCapacity > W_COMPRESS_DICT_MAX_SIZE) pDictionaryCapacity = W_COMPRESS_DICT_MAX_SIZE;
+
+	for (i = 0; i < pNumberOfSamples; ++i)
+	{
+		_total_size += pSampleSizes[i];
+		if (pSampleSizes[i] >= DICT_KMER_SIZE)
+		{
+			_number_of_segments += (pSampleSizes[i] - DICT_KMER_SIZE) / DICT_SEGMENT_STEP + 1;
+		}
+	}
+	if (!_number_of_segments)
+	{
+		s_set_error(pErrorLog, "samples are too small for training dictionary. trace_info: w_compress::train_dict_c");
+		return 1;
+	}
+
+	_counts = (unsigned int*)calloc(_table_size, sizeof(unsigned int));
+	_stamps = (unsigned int*)calloc(_table_size, sizeof(unsigned int));
+	_segments = (s_dict_segment*)malloc(_number_of_segments * sizeof(s_dict_segment));
+	_selected = (s_dict_segment**)malloc(_number_of_segments * sizeof(s_dict_segment*));
+	if (!_counts || !_stamps || !_segments || !_selected)
+	{
+		free(_counts);
+		free(_stamps);
+		free(_segments);
+		free(_selected);
+		s_set_error(pErrorLog, "could not allocate memory for training dictionary. trace_info: w_compress::train_dict_c");
+		return 1;
+	}
+
+	//count the number of samples which contain each k-mer, content which repeats across samples is worth to be in dictionary
+	for (i = 0, _offset = 0; i < pNumberOfSamples; _offset += pSampleSizes[i], ++i)
+	{
+		for (j = 0; j + DICT_KMER_SIZE <= pSampleSizes[i]; ++j)
+		{
+			unsigned int _hash = s_hash_kmer(pSamples + _offset + j);
+			if (_stamps[_hash] != (unsigned int)(i + 1))
+			{
+				_stamps[_hash] = (unsigned int)(i + 1);
+				_counts[_hash]++;
+			}
+		}
+	}
+
+	//score overlapped segments of each sample by frequency of their k-mers
+	_number_of_segments = 0;
+	for (i = 0, _offset = 0; i < pNumberOfSamples; _offset += pSampleSizes[i], ++i)
+	{
+		for (j = 0; j + DICT_KMER_SIZE <= pSampleSizes[i]; j += DICT_SEGMENT_STEP)
+		{
+			s_dict_segment* _segment = &_segments[_number_of_segments++];
+			size_t k, _size = pSampleSizes[i] - j;
+			if (_size > DICT_SEGMENT_SIZE) _size = DICT_SEGMENT_SIZE;
+
+			_segment->offset = _offset + j;
+			_segment->size = (unsigned int)_size;
+			_segment->score = 0;
+			for (k = 0; k + DICT_KMER_SIZE <= _size; k += 4)
+			{
+				unsigned int _count = _counts[s_hash_kmer(pSamples + _segment->offset + k)];
+				if (_count > 1) _segment->score += _count - 1;
+			}
+		}
+	}
+	qsort(_segments, _number_of_segments, sizeof(s_dict_segment), s_compare_segments);
+
+	//pick the best segments, skip segments which are mostly covered by picked ones
+	memset(_stamps, 0, _table_size * sizeof(unsigned int));
+	for (i = 0; i < _number_of_segments && _dict_size < pDictionaryCapacity; ++i)
+	{
+		s_dict_segment* _segment = &_segments[i];
+		size_t k, _kmers = 0, _covered = 0;
+		if (!_segment->score) break;
+
+		for (k = 0; k + DICT_KMER_SIZE <= _segment->size; k += 4)
+		{
+			_kmers++;
+			if (_stamps[s_hash_kmer(pSamples + _segment->offset + k)]) _covered++;
+		}
+		if (_covered * 2 > _kmers) continue;
+
+		for (k = 0; k + DICT_KMER_SIZE <= _segment->size; ++k)
+		{
+			_stamps[s_hash_kmer(pSamples + _segment->offset + k)] = 1;
+		}
+		if (_dict_size + _segment->size > pDictionaryCapacity)
+		{
+			_segment->size = (unsigned int)(pDictionaryCapacity - _dict_size);
+		}
+		_dict_size += _segment->size;
+		_selected[_number_of_selected++] = _segment;
+	}
+
+	//LZ4 finds matches at the end of dictionary with smaller offsets, so the best segments are placed last
+	_dict_size = 0;
+	for (i = _number_of_selected; i > 0; --i)
+	{
+		memcpy(pDictionary + _dict_size, pSamples + _selected[i - 1]->offset, _selected[i - 1]->size);
+		_dict_size += _selected[i - 1]->size;
+	}
+
+	//samples do not have anything in common, use the tail of samples
+	if (!_dict_size)
+	{
+		_dict_size = _total_size < pDictionaryCapacity ? _total_size : pDictionaryCapacity;
+		memcpy(pDictionary, pSamples + _total_size - _dict_size, _dict_size);
+	}
+
+	free(_counts);
+	free(_stamps);
+	free(_segments);
+	free(_selected);
+
+	*pDictionarySize = _dict_size;
 	return 0;
 }
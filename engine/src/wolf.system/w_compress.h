@@ -4,7 +4,7 @@
 	Website			 : http://WolfSource.io
 	Name			 : w_compress.h
 	Description		 : compress stream based on https://github.com/lz4/lz4
-	Comment          :
+	Comment          : buffers and streams are LZ4 frames with content size, decompress_buffer_c also reads the old block format
 */
 
 #if _MSC_VER > 1000
@@ -20,11 +20,20 @@ extern "C" {
 
 #include "w_system_export.h"
 #include <stdio.h>
+
+//size of error log buffers which are given to the following functions
+#define W_COMPRESS_ERROR_LOG_SIZE 256
+//returned by w_compress_read_callback on error
+#define W_COMPRESS_STREAM_ERROR ((size_t)-1)
+//LZ4 only refers to the last 64KB of dictionary
+#define W_COMPRESS_DICT_MAX_SIZE (64 * 1024)
 	
 	typedef enum
 	{ 
 		W_DEFAULT, 
-		W_FAST
+		W_FAST,
+		//LZ4-HC for offline content, pAcceleration of functions is the level between 3 and 12, zero means 9
+		W_HC
 	}
 	w_compress_mode;
 
@@ -47,9 +56,170 @@ extern "C" {
 		/*_Inout_*/	w_compress_result* pDecompressInfo,
 		/*_Inout_*/ char* pErrorLog);
 
-	/*WSYS_EXP w_compress_result compress_file_c(FILE* pFileStreamIn, FILE* pCompressedFileOut, _Inout_ char* pErrorLog);
-	WSYS_EXP w_compress_result decompress_file_c(FILE* pCompressedFileIn, FILE* pFileStreamOut, _Inout_ char* pErrorLog);*/
+	/*
+		context of streaming compression or decompression, LZ4 frame format is used
+		and the content size, if known, is stored in the header of frame
+	*/
+	typedef struct w_compress_stream_t* w_compress_stream;
+
+	//read up to pSize bytes, returns 0 on end of stream and W_COMPRESS_STREAM_ERROR on error
+	typedef size_t (*w_compress_read_callback)(void* pUserData, char* pBuffer, size_t pSize);
+	//write pSize bytes, returns number of bytes which were written
+	typedef size_t (*w_compress_write_callback)(void* pUserData, const char* pBuffer, size_t pSize);
+
+	//read content size from the header of frame, zero means content size was not stored
+	WSYS_EXP int get_frame_content_size_c(
+		/*_In_*/	const char* pCompressedBuffer,
+		/*_In_*/	size_t pSize,
+		/*_Out_*/	unsigned long long* pContentSize,
+		/*_Inout_*/ char* pErrorLog);
+
+	/*
+		create compress stream and write the header of frame into pDst, pDstCapacity must be at least 19 bytes
+		pContentSize is the total size of data which will be given to compress_stream_update_c, zero means unknown
+	*/
+	WSYS_EXP int compress_stream_begin_c(
+		/*_Out_*/	w_compress_stream* pStream,
+		/*_In_*/	w_compress_mode pMode,
+		/*_In_*/	int pAcceleration,
+		/*_In_*/	unsigned long long pContentSize,
+		/*_Inout_*/	char* pDst,
+		/*_In_*/	size_t pDstCapacity,
+		/*_Out_*/	size_t* pDstSize,
+		/*_Inout_*/ char* pErrorLog);
+
+	//the minimum capacity of pDst for compressing pSrcSize bytes with update or end of stream
+	WSYS_EXP size_t compress_stream_bound_c(
+		/*_In_*/	w_compress_stream pStream,
+		/*_In_*/	size_t pSrcSize);
+
+	//compress a chunk, pDstCapacity must be at least compress_stream_bound_c(pSrcSize)
+	WSYS_EXP int compress_stream_update_c(
+		/*_In_*/	w_compress_stream pStream,
+		/*_In_*/	const char* pSrc,
+		/*_In_*/	size_t pSrcSize,
+		/*_Inout_*/	char* pDst,
+		/*_In_*/	size_t pDstCapacity,
+		/*_Out_*/	size_t* pDstSize,
+		/*_Inout_*/ char* pErrorLog);
+
+	//write the end mark and checksum of frame, pDstCapacity must be at least compress_stream_bound_c(0)
+	WSYS_EXP int compress_stream_end_c(
+		/*_In_*/	w_compress_stream pStream,
+		/*_Inout_*/	char* pDst,
+		/*_In_*/	size_t pDstCapacity,
+		/*_Out_*/	size_t* pDstSize,
+		/*_Inout_*/ char* pErrorLog);
+
+	WSYS_EXP void compress_stream_free_c(/*_In_*/ w_compress_stream pStream);
+
+	WSYS_EXP int decompress_stream_begin_c(
+		/*_Out_*/	w_compress_stream* pStream,
+		/*_Inout_*/ char* pErrorLog);
+
+	/*
+		decompress a chunk
+		pSrcSize, size of pSrc and it will be set to number of consumed bytes
+		pDstSize, capacity of pDst and it will be set to number of written bytes
+		pIsFrameDone, will be 1 once the frame was decoded and its checksum was verified
+	*/
+	WSYS_EXP int decompress_stream_update_c(
+		/*_In_*/	w_compress_stream pStream,
+		/*_In_*/	const char* pSrc,
+		/*_Inout_*/	size_t* pSrcSize,
+		/*_Inout_*/	char* pDst,
+		/*_Inout_*/	size_t* pDstSize,
+		/*_Out_*/	int* pIsFrameDone,
+		/*_Inout_*/ char* pErrorLog);
+
+	//content size of frame which is being decoded, zero means the header was not decoded yet or it does not have content size
+	WSYS_EXP unsigned long long decompress_stream_get_content_size_c(/*_In_*/ w_compress_stream pStream);
+
+	WSYS_EXP void decompress_stream_free_c(/*_In_*/ w_compress_stream pStream);
+
+	//compress from reader to writer in chunks of 64KB, size_in and size_out of pCompressInfo will be filled
+	WSYS_EXP int compress_stream_c(
+		/*_In_*/	w_compress_read_callback pRead,
+		/*_In_*/	void* pReader,
+		/*_In_*/	w_compress_write_callback pWrite,
+		/*_In_*/	void* pWriter,
+		/*_In_*/	unsigned long long pContentSize,
+		/*_In_*/	w_compress_mode pMode,
+		/*_In_*/	int pAcceleration,
+		/*_Inout_*/	w_compress_result* pCompressInfo,
+		/*_Inout_*/ char* pErrorLog);
+
+	//decompress from reader to writer in chunks of 64KB, size_in and size_out of pDecompressInfo will be filled
+	WSYS_EXP int decompress_stream_c(
+		/*_In_*/	w_compress_read_callback pRead,
+		/*_In_*/	void* pReader,
+		/*_In_*/	w_compress_write_callback pWrite,
+		/*_In_*/	void* pWriter,
+		/*_Inout_*/	w_compress_result* pDecompressInfo,
+		/*_Inout_*/ char* pErrorLog);
+
+	WSYS_EXP int compress_file_c(
+		/*_In_*/	FILE* pFileStreamIn,
+		/*_Inout_*/	FILE* pCompressedFileOut,
+		/*_In_*/	w_compress_mode pMode,
+		/*_In_*/	int pAcceleration,
+		/*_Inout_*/	w_compress_result* pCompressInfo,
+		/*_Inout_*/ char* pErrorLog);
+
+	WSYS_EXP int decompress_file_c(
+		/*_In_*/	FILE* pCompressedFileIn,
+		/*_Inout_*/	FILE* pFileStreamOut,
+		/*_Inout_*/	w_compress_result* pDecompressInfo,
+		/*_Inout_*/ char* pErrorLog);
 	
+	/*
+		dictionary of small payloads which have similar content, e.g. messages of network or records of cache
+		the same dictionary must be used for compression and decompression
+	*/
+	typedef struct w_compress_dict_t* w_compress_dict;
+
+	/*
+		build a dictionary from samples, the common content of samples will be copied into pDictionary
+		pSamples, samples which were concatenated
+		pSampleSizes, size of each sample
+		pDictionaryCapacity, capacity of pDictionary, values bigger than W_COMPRESS_DICT_MAX_SIZE are not useful
+	*/
+	WSYS_EXP int train_dict_c(
+		/*_In_*/	const char* pSamples,
+		/*_In_*/	const size_t* pSampleSizes,
+		/*_In_*/	size_t pNumberOfSamples,
+		/*_Inout_*/	char* pDictionary,
+		/*_In_*/	size_t pDictionaryCapacity,
+		/*_Out_*/	size_t* pDictionarySize,
+		/*_Inout_*/ char* pErrorLog);
+
+	//load a dictionary which was built by train_dict_c, it will be copied and loaded once, then it can be used by multiple threads
+	WSYS_EXP int create_dict_c(
+		/*_In_*/	const char* pDictionary,
+		/*_In_*/	size_t pDictionarySize,
+		/*_Out_*/	w_compress_dict* pDict,
+		/*_Inout_*/ char* pErrorLog);
+
+	//id of dictionary which is stored in each compressed buffer
+	WSYS_EXP unsigned int get_dict_id_c(/*_In_*/ w_compress_dict pDict);
+
+	WSYS_EXP void free_dict_c(/*_In_*/ w_compress_dict pDict);
+
+	//compress a buffer with dictionary, the buffer is a single LZ4 block without frame, so overhead is 8 bytes
+	WSYS_EXP int compress_buffer_dict_c(
+		/*_In_*/	const char* pSrcBuffer,
+		/*_In_*/	w_compress_dict pDict,
+		/*_In_*/	w_compress_mode pMode,
+		/*_In_*/	int pAcceleration,
+		/*_Inout_*/	w_compress_result* pCompressInfo,
+		/*_Inout_*/ char* pErrorLog);
+
+	WSYS_EXP int decompress_buffer_dict_c(
+		/*_In_*/	const char* pCompressedBuffer,
+		/*_In_*/	w_compress_dict pDict,
+		/*_Inout_*/	w_compress_result* pDecompressInfo,
+		/*_Inout_*/ char* pErrorLog);
+
 #if defined (__cplusplus)
 }
 #endif
@@ -17,6 +17,10 @@
 #include "w_compress.h"
 #include "w_system_export.h"
 #include "w_logger.h"
+#include <istream>
+#include <ostream>
+#include <vector>
+#include <string>
 
 namespace wolf
 {
@@ -24,17 +28,18 @@ namespace wolf
 	{
 		struct w_compress
 		{
+			//pAcceleration of zero is the default of mode, which is acceleration 1 for W_DEFAULT and W_FAST and level 9 for W_HC
 			static W_RESULT compress_buffer(
 				_In_		const char* pSrcBuffer,
 				_Inout_		w_compress_result* pCompressResult,
 				_In_		w_compress_mode pMode = w_compress_mode::W_DEFAULT,
-				_In_		int pAcceleration = 1.0)
+				_In_		int pAcceleration = 0)
 			{
 				if (!pCompressResult || !pSrcBuffer) return W_RESULT::W_INVALIDARG;
 
 				W_RESULT _result = W_PASSED;
 
-				auto _err_log = (char*)malloc(256 * sizeof(char));
+				auto _err_log = (char*)calloc(W_COMPRESS_ERROR_LOG_SIZE, sizeof(char));
 				if (compress_buffer_c(
 					pSrcBuffer,
 					pMode,
@@ -58,7 +63,7 @@ namespace wolf
 
 				W_RESULT _result = W_PASSED;
 
-				auto _err_log = (char*)malloc(256 * sizeof(char));
+				auto _err_log = (char*)calloc(W_COMPRESS_ERROR_LOG_SIZE, sizeof(char));
 				if (decompress_buffer_c(
 					pCompressedBuffer,
 					pDecompressInfo,
@@ -72,36 +77,349 @@ namespace wolf
 				return _result;
 			}
 
-			/*static w_compress_result compress_file(_In_ FILE* pFileStreamIn, _Inout_ FILE* pCompressedFileOut)
+			/*
+				build a dictionary from samples of small payloads, e.g. messages of network
+				@param pSamples, the samples
+				@param pDictionary, the dictionary
+				@param pCapacity, maximum size of dictionary
+				@return W_PASSED on success
+			*/
+			static W_RESULT train_dict(
+				_In_	const std::vector<std::string>& pSamples,
+				_Inout_	std::vector<char>& pDictionary,
+				_In_	const size_t& pCapacity = W_COMPRESS_DICT_MAX_SIZE)
 			{
-				auto _err_log = (char*)malloc(256 * sizeof(char));
-				auto _result = compress_file_c(pFileStreamIn, pCompressedFileOut, _err_log);
-				if (_result.error)
+				std::string _samples;
+				std::vector<size_t> _sizes;
+				_sizes.reserve(pSamples.size());
+				for (auto& _sample : pSamples)
+				{
+					_samples.append(_sample);
+					_sizes.push_back(_sample.size());
+				}
+
+				pDictionary.resize(pCapacity);
+
+				W_RESULT _result = W_PASSED;
+
+				size_t _size = 0;
+				auto _err_log = (char*)calloc(W_COMPRESS_ERROR_LOG_SIZE, sizeof(char));
+				if (train_dict_c(
+					_samples.data(),
+					_sizes.data(),
+					_sizes.size(),
+					pDictionary.data(),
+					pDictionary.size(),
+					&_size,
+					_err_log))
 				{
 					logger.error(_err_log);
+					_result = W_FAILED;
 				}
 				free(_err_log);
 
-				if (pFileStreamIn) fclose(pFileStreamIn);
-				if (pCompressedFileOut) fclose(pCompressedFileOut);
+				pDictionary.resize(_size);
+
+				return _result;
+			}
+
+			//create dictionary, it must be released by free_dict
+			static W_RESULT create_dict(
+				_In_	const char* pDictionary,
+				_In_	const size_t& pDictionarySize,
+				_Out_	w_compress_dict* pDict)
+			{
+				if (!pDict) return W_RESULT::W_INVALIDARG;
+
+				W_RESULT _result = W_PASSED;
+
+				auto _err_log = (char*)calloc(W_COMPRESS_ERROR_LOG_SIZE, sizeof(char));
+				if (create_dict_c(pDictionary, pDictionarySize, pDict, _err_log))
+				{
+					logger.error(_err_log);
+					_result = W_FAILED;
+				}
+				free(_err_log);
+
+				return _result;
+			}
+
+			static void free_dict(_In_ w_compress_dict pDict)
+			{
+				free_dict_c(pDict);
+			}
+
+			//compress small payload with dictionary
+			static W_RESULT compress_buffer(
+				_In_		const char* pSrcBuffer,
+				_In_		w_compress_dict pDict,
+				_Inout_		w_compress_result* pCompressResult,
+				_In_		w_compress_mode pMode = w_compress_mode::W_DEFAULT,
+				_In_		int pAcceleration = 0)
+			{
+				if (!pCompressResult || !pSrcBuffer || !pDict) return W_RESULT::W_INVALIDARG;
+
+				W_RESULT _result = W_PASSED;
+
+				auto _err_log = (char*)calloc(W_COMPRESS_ERROR_LOG_SIZE, sizeof(char));
+				if (compress_buffer_dict_c(
+					pSrcBuffer,
+					pDict,
+					pMode,
+					pAcceleration,
+					pCompressResult,
+					_err_log))
+				{
+					logger.error(_err_log);
+					_result = W_FAILED;
+				}
+				free(_err_log);
 
 				return _result;
 			}
-			static w_compress_result decompress_file(_In_ FILE* pCompressedFileIn, _Inout_ FILE* pFileStreamOut)
+
+			//decompress payload which was compressed with the same dictionary
+			static W_RESULT decompress_buffer(
+				_In_	const char* pCompressedBuffer,
+				_In_	w_compress_dict pDict,
+				_Inout_	w_compress_result* pDecompressInfo)
 			{
-				auto _err_log = (char*)malloc(256 * sizeof(char));
-				auto _result = decompress_file_c(pCompressedFileIn, pFileStreamOut, _err_log);
-				if (_result.error)
+				if (!pDecompressInfo || !pCompressedBuffer || !pDict) return W_RESULT::W_INVALIDARG;
+
+				W_RESULT _result = W_PASSED;
+
+				auto _err_log = (char*)calloc(W_COMPRESS_ERROR_LOG_SIZE, sizeof(char));
+				if (decompress_buffer_dict_c(
+					pCompressedBuffer,
+					pDict,
+					pDecompressInfo,
+					_err_log))
 				{
 					logger.error(_err_log);
+					_result = W_FAILED;
 				}
 				free(_err_log);
 
-				if (pCompressedFileIn) fclose(pCompressedFileIn);
-				if (pFileStreamOut) fclose(pFileStreamOut);
+				return _result;
+			}
+
+			/*
+				compress std::istream to std::ostream as an LZ4 frame in chunks of 64KB
+				the size of content will be stored in frame if pIn is seekable
+			*/
+			static W_RESULT compress_stream(
+				_In_	std::istream& pIn,
+				_Inout_	std::ostream& pOut,
+				_Inout_	w_compress_result* pCompressInfo,
+				_In_	w_compress_mode pMode = w_compress_mode::W_DEFAULT,
+				_In_	int pAcceleration = 0)
+			{
+				if (!pCompressInfo) return W_RESULT::W_INVALIDARG;
+
+				unsigned long long _content_size = 0;
+				auto _pos = pIn.tellg();
+				if (_pos != std::istream::pos_type(-1))
+				{
+					pIn.seekg(0, std::ios::end);
+					auto _end = pIn.tellg();
+					pIn.seekg(_pos);
+					if (_end != std::istream::pos_type(-1) && _end > _pos)
+					{
+						_content_size = static_cast<unsigned long long>(_end - _pos);
+					}
+				}
+				pIn.clear();
+
+				W_RESULT _result = W_PASSED;
+
+				auto _err_log = (char*)calloc(W_COMPRESS_ERROR_LOG_SIZE, sizeof(char));
+				if (compress_stream_c(
+					&_read_istream,
+					&pIn,
+					&_write_ostream,
+					&pOut,
+					_content_size,
+					pMode,
+					pAcceleration,
+					pCompressInfo,
+					_err_log))
+				{
+					logger.error(_err_log);
+					_result = W_FAILED;
+				}
+				free(_err_log);
 
 				return _result;
-			}*/
+			}
+
+			//decompress LZ4 frames of std::istream to std::ostream in chunks of 64KB
+			static W_RESULT decompress_stream(
+				_In_	std::istream& pIn,
+				_Inout_	std::ostream& pOut,
+				_Inout_	w_compress_result* pDecompressInfo)
+			{
+				if (!pDecompressInfo) return W_RESULT::W_INVALIDARG;
+
+				W_RESULT _result = W_PASSED;
+
+				auto _err_log = (char*)calloc(W_COMPRESS_ERROR_LOG_SIZE, sizeof(char));
+				if (decompress_stream_c(
+					&_read_istream,
+					&pIn,
+					&_write_ostream,
+					&pOut,
+					pDecompressInfo,
+					_err_log))
+				{
+					logger.error(_err_log);
+					_result = W_FAILED;
+				}
+				free(_err_log);
+
+				return _result;
+			}
+
+			//compress file, the caller owns both files
+			static W_RESULT compress_file(
+				_In_	FILE* pFileStreamIn,
+				_Inout_	FILE* pCompressedFileOut,
+				_Inout_	w_compress_result* pCompressInfo,
+				_In_	w_compress_mode pMode = w_compress_mode::W_DEFAULT,
+				_In_	int pAcceleration = 0)
+			{
+				if (!pFileStreamIn || !pCompressedFileOut || !pCompressInfo) return W_RESULT::W_INVALIDARG;
+
+				W_RESULT _result = W_PASSED;
+
+				auto _err_log = (char*)calloc(W_COMPRESS_ERROR_LOG_SIZE, sizeof(char));
+				if (compress_file_c(
+					pFileStreamIn,
+					pCompressedFileOut,
+					pMode,
+					pAcceleration,
+					pCompressInfo,
+					_err_log))
+				{
+					logger.error(_err_log);
+					_result = W_FAILED;
+				}
+				free(_err_log);
+
+				return _result;
+			}
+
+			//decompress file, the caller owns both files
+			static W_RESULT decompress_file(
+				_In_	FILE* pCompressedFileIn,
+				_Inout_	FILE* pFileStreamOut,
+				_Inout_	w_compress_result* pDecompressInfo)
+			{
+				if (!pCompressedFileIn || !pFileStreamOut || !pDecompressInfo) return W_RESULT::W_INVALIDARG;
+
+				W_RESULT _result = W_PASSED;
+
+				auto _err_log = (char*)calloc(W_COMPRESS_ERROR_LOG_SIZE, sizeof(char));
+				if (decompress_file_c(
+					pCompressedFileIn,
+					pFileStreamOut,
+					pDecompressInfo,
+					_err_log))
+				{
+					logger.error(_err_log);
+					_result = W_FAILED;
+				}
+				free(_err_log);
+
+				return _result;
+			}
+
+			static W_RESULT compress_file(
+				_In_z_	const char* pSrcPath,
+				_In_z_	const char* pDstPath,
+				_Inout_	w_compress_result* pCompressInfo,
+				_In_	w_compress_mode pMode = w_compress_mode::W_DEFAULT,
+				_In_	int pAcceleration = 0)
+			{
+				const char* _trace_info = "w_compress::compress_file";
+
+				FILE* _in = nullptr;
+				FILE* _out = nullptr;
+				if (_open_files(pSrcPath, pDstPath, &_in, &_out, _trace_info) == W_FAILED) return W_FAILED;
+
+				auto _result = compress_file(_in, _out, pCompressInfo, pMode, pAcceleration);
+				fclose(_in);
+				if (fclose(_out) != 0) _result = W_FAILED;
+
+				return _result;
+			}
+
+			static W_RESULT decompress_file(
+				_In_z_	const char* pSrcPath,
+				_In_z_	const char* pDstPath,
+				_Inout_	w_compress_result* pDecompressInfo)
+			{
+				const char* _trace_info = "w_compress::decompress_file";
+
+				FILE* _in = nullptr;
+				FILE* _out = nullptr;
+				if (_open_files(pSrcPath, pDstPath, &_in, &_out, _trace_info) == W_FAILED) return W_FAILED;
+
+				auto _result = decompress_file(_in, _out, pDecompressInfo);
+				fclose(_in);
+				if (fclose(_out) != 0) _result = W_FAILED;
+
+				return _result;
+			}
+
+		private:
+			static size_t _read_istream(void* pUserData, char* pBuffer, size_t pSize)
+			{
+				auto _in = static_cast<std::istream*>(pUserData);
+				_in->read(pBuffer, static_cast<std::streamsize>(pSize));
+				if (_in->bad()) return W_COMPRESS_STREAM_ERROR;
+				return static_cast<size_t>(_in->gcount());
+			}
+
+			static size_t _write_ostream(void* pUserData, const char* pBuffer, size_t pSize)
+			{
+				auto _out = static_cast<std::ostream*>(pUserData);
+				_out->write(pBuffer, static_cast<std::streamsize>(pSize));
+				return _out->good() ? pSize : 0;
+			}
+
+			static W_RESULT _open_files(
+				_In_z_	const char* pSrcPath,
+				_In_z_	const char* pDstPath,
+				_Out_	FILE** pIn,
+				_Out_	FILE** pOut,
+				_In_z_	const char* pTraceInfo)
+			{
+				if (!pSrcPath || !pDstPath) return W_RESULT::W_INVALIDARG;
+
+#ifdef __WIN32
+				if (fopen_s(pIn, pSrcPath, "rb") != 0) *pIn = nullptr;
+#else
+				*pIn = fopen(pSrcPath, "rb");
+#endif
+				if (!*pIn)
+				{
+					W_V(W_FAILED, w_log_type::W_ERROR, "could not open file {}. trace info: {}", pSrcPath, pTraceInfo);
+					return W_FAILED;
+				}
+#ifdef __WIN32
+				if (fopen_s(pOut, pDstPath, "wb") != 0) *pOut = nullptr;
+#else
+				*pOut = fopen(pDstPath, "wb");
+#endif
+				if (!*pOut)
+				{
+					fclose(*pIn);
+					*pIn = nullptr;
+					W_V(W_FAILED, w_log_type::W_ERROR, "could not create file {}. trace info: {}", pDstPath, pTraceInfo);
+					return W_FAILED;
+				}
+				return W_PASSED;
+			}
 		};
 	}
 }
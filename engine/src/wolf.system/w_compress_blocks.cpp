@@ -0,0 +1,477 @@
+#include "w_system_pch.h"
+#include "w_compress_blocks.h"
+#include "lz4/lz4.h"
+#include "lz4/lz4hc.h"
+#include "lz4/xxhash.h"
+#include <atomic>
+
+/*
+    layout of container, all values are little endian:
+    header, uint32 magic, uint16 version, uint16 flags, uint32 block size, uint32 number of blocks,
+            uint64 size of content, uint32 xxhash32 of index, uint32 reserved
+    index, for each block uint64 offset of block from the beginning of container, uint32 size of compressed block, uint32 xxhash32 of block
+    blocks, a block is stored without compression when its compressed size is equal to its size
+*/
+#define W_COMPRESS_BLOCKS_MAGIC             0x425A4C57 //WLZB
+#define W_COMPRESS_BLOCKS_VERSION           1
+#define W_COMPRESS_BLOCKS_FLAG_CHECKSUM     0x01
+#define W_COMPRESS_BLOCKS_HEADER_SIZE       32
+#define W_COMPRESS_BLOCKS_ENTRY_SIZE        16
+#define W_COMPRESS_BLOCKS_MIN_BLOCK_SIZE    (4 * 1024)
+#define W_COMPRESS_BLOCKS_MAX_BLOCK_SIZE    (256 * 1024 * 1024)
+//LZ4 can not decompress a block to more than 255 times of its compressed size
+#define W_COMPRESS_BLOCKS_MAX_RATIO         255
+
+namespace wolf
+{
+    namespace system
+    {
+        static inline void s_write_u16(_Inout_ char* pDst, _In_ const uint32_t& pValue)
+        {
+            pDst[0] = static_cast<char>(pValue & 0xFF);
+            pDst[1] = static_cast<char>((pValue >> 8) & 0xFF);
+        }
+
+        static inline void s_write_u32(_Inout_ char* pDst, _In_ const uint32_t& pValue)
+        {
+            s_write_u16(pDst, pValue & 0xFFFF);
+            s_write_u16(pDst + 2, pValue >> 16);
+        }
+
+        static inline void s_write_u64(_Inout_ char* pDst, _In_ const uint64_t& pValue)
+        {
+            s_write_u32(pDst, static_cast<uint32_t>(pValue & 0xFFFFFFFF));
+            s_write_u32(pDst + 4, static_cast<uint32_t>(pValue >> 32));
+        }
+
+        static inline uint32_t s_read_u16(_In_ const char* pSrc)
+        {
+            auto _src = reinterpret_cast<const uint8_t*>(pSrc);
+            return static_cast<uint32_t>(_src[0]) | (static_cast<uint32_t>(_src[1]) << 8);
+        }
+
+        static inline uint32_t s_read_u32(_In_ const char* pSrc)
+        {
+            return s_read_u16(pSrc) | (s_read_u16(pSrc + 2) << 16);
+        }
+
+        static inline uint64_t s_read_u64(_In_ const char* pSrc)
+        {
+            return static_cast<uint64_t>(s_read_u32(pSrc)) | (static_cast<uint64_t>(s_read_u32(pSrc + 4)) << 32);
+        }
+
+        //size of block before compression, only the last block may be smaller than block size
+        static inline size_t s_get_block_size(_In_ const w_compress_blocks_info& pInfo, _In_ const uint32_t& pBlockIndex)
+        {
+            auto _begin = static_cast<uint64_t>(pBlockIndex) * pInfo.block_size_in_bytes;
+            auto _size = pInfo.content_size - _begin;
+            return static_cast<size_t>(_size < pInfo.block_size_in_bytes ? _size : pInfo.block_size_in_bytes);
+        }
+
+        //run pFunc for each block on pool, or on the calling thread
+        static void s_for_each_block(
+            _In_opt_ w_thread_pool* pThreadPool,
+            _In_ const uint32_t& pBegin,
+            _In_ const uint32_t& pEnd,
+            _In_ const std::function<void(const uint32_t&)>& pFunc)
+        {
+            if (pThreadPool && pThreadPool->get_pool_size() && pEnd - pBegin > 1)
+            {
+                pThreadPool->parallel_for(pBegin, pEnd, [&pFunc](const size_t& pRangeBegin, const size_t& pRangeEnd)
+                {
+                    for (auto i = pRangeBegin; i < pRangeEnd; ++i)
+                    {
+                        pFunc(static_cast<uint32_t>(i));
+                    }
+                }, 1);
+            }
+            else
+            {
+                for (auto i = pBegin; i < pEnd; ++i)
+                {
+                    pFunc(i);
+                }
+            }
+        }
+
+        //read and validate header and index of container
+        static W_RESULT s_parse(
+            _In_ const char* pBuffer,
+            _In_ const size_t& pSize,
+            _Out_ w_compress_blocks_info& pInfo,
+            _In_z_ const char* pTraceInfo)
+        {
+            if (!pBuffer || pSize < W_COMPRESS_BLOCKS_HEADER_SIZE || s_read_u32(pBuffer) != W_COMPRESS_BLOCKS_MAGIC)
+            {
+                W_V(W_FAILED, w_log_type::W_ERROR, "buffer is not a block container. trace info: {}", pTraceInfo);
+                return W_FAILED;
+            }
+
+            auto _version = s_read_u16(pBuffer + 4);
+            if (_version != W_COMPRESS_BLOCKS_VERSION)
+            {
+                W_V(W_FAILED, w_log_type::W_ERROR, "version {} of block container is not supported. trace info: {}", _version, pTraceInfo);
+                return W_FAILED;
+            }
+
+            auto _flags = s_read_u16(pBuffer + 6);
+            pInfo.has_checksum = (_flags & W_COMPRESS_BLOCKS_FLAG_CHECKSUM) != 0;
+            pInfo.block_size_in_bytes = s_read_u32(pBuffer + 8);
+            pInfo.number_of_blocks = s_read_u32(pBuffer + 12);
+            pInfo.content_size = s_read_u64(pBuffer + 16);
+
+            auto _expected_blocks = pInfo.block_size_in_bytes ?
+                (pInfo.content_size + pInfo.block_size_in_bytes - 1) / pInfo.block_size_in_bytes : 0;
+            auto _index_size = static_cast<uint64_t>(pInfo.number_of_blocks) * W_COMPRESS_BLOCKS_ENTRY_SIZE;
+            if (pInfo.block_size_in_bytes < W_COMPRESS_BLOCKS_MIN_BLOCK_SIZE ||
+                pInfo.block_size_in_bytes > W_COMPRESS_BLOCKS_MAX_BLOCK_SIZE ||
+                _expected_blocks != pInfo.number_of_blocks ||
+                _index_size > pSize - W_COMPRESS_BLOCKS_HEADER_SIZE)
+            {
+                W_V(W_FAILED, w_log_type::W_ERROR, "header of block container is corrupted. trace info: {}", pTraceInfo);
+                return W_FAILED;
+            }
+
+            auto _index = pBuffer + W_COMPRESS_BLOCKS_HEADER_SIZE;
+            if (XXH32(_index, static_cast<size_t>(_index_size), 0) != s_read_u32(pBuffer + 24))
+            {
+                W_V(W_FAILED, w_log_type::W_ERROR, "index of block container is corrupted. trace info: {}", pTraceInfo);
+                return W_FAILED;
+            }
+
+            //blocks must be decompressible to their size from bytes of buffer, so content_size is bounded before it is allocated
+            auto _data_size = pSize - W_COMPRESS_BLOCKS_HEADER_SIZE - _index_size;
+            uint64_t _total_compressed_size = 0;
+            for (uint32_t i = 0; i < pInfo.number_of_blocks; ++i)
+            {
+                auto _compressed_size = s_read_u32(_index + static_cast<size_t>(i) * W_COMPRESS_BLOCKS_ENTRY_SIZE + 8);
+                auto _block_size = s_get_block_size(pInfo, i);
+                _total_compressed_size += _compressed_size;
+                if (!_compressed_size ||
+                    _compressed_size > _block_size ||
+                    _block_size > static_cast<uint64_t>(_compressed_size) * W_COMPRESS_BLOCKS_MAX_RATIO ||
+                    _total_compressed_size > _data_size)
+                {
+                    W_V(W_FAILED, w_log_type::W_ERROR, "entry of block {} is corrupted. trace info: {}", i, pTraceInfo);
+                    return W_FAILED;
+                }
+            }
+
+            return W_PASSED;
+        }
+
+        //decompress a block of container which was validated by s_parse
+        static W_RESULT s_decompress_block(
+            _In_ const char* pBuffer,
+            _In_ const size_t& pSize,
+            _In_ const w_compress_blocks_info& pInfo,
+            _In_ const uint32_t& pBlockIndex,
+            _Inout_ char* pDst,
+            _In_z_ const char* pTraceInfo)
+        {
+            auto _entry = pBuffer + W_COMPRESS_BLOCKS_HEADER_SIZE + static_cast<size_t>(pBlockIndex) * W_COMPRESS_BLOCKS_ENTRY_SIZE;
+            auto _offset = s_read_u64(_entry);
+            auto _compressed_size = s_read_u32(_entry + 8);
+            auto _block_size = s_get_block_size(pInfo, pBlockIndex);
+
+            auto _data_begin = W_COMPRESS_BLOCKS_HEADER_SIZE + static_cast<uint64_t>(pInfo.number_of_blocks) * W_COMPRESS_BLOCKS_ENTRY_SIZE;
+            if (_offset < _data_begin || _offset > pSize || _compressed_size > pSize - _offset || _compressed_size > _block_size)
+            {
+                W_V(W_FAILED, w_log_type::W_ERROR, "entry of block {} is corrupted. trace info: {}", pBlockIndex, pTraceInfo);
+                return W_FAILED;
+            }
+
+            auto _src = pBuffer + _offset;
+            if (_compressed_size == _block_size)
+            {
+                std::memcpy(pDst, _src, _block_size);
+            }
+            else
+            {
+                auto _size = LZ4_decompress_safe(
+                    _src,
+                    pDst,
+                    static_cast<int>(_compressed_size),
+                    static_cast<int>(_block_size));
+                if (_size < 0 || static_cast<size_t>(_size) != _block_size)
+                {
+                    W_V(W_FAILED, w_log_type::W_ERROR, "could not decompress block {}. trace info: {}", pBlockIndex, pTraceInfo);
+                    return W_FAILED;
+                }
+            }
+
+            if (pInfo.has_checksum && XXH32(pDst, _block_size, 0) != s_read_u32(_entry + 12))
+            {
+                W_V(W_FAILED, w_log_type::W_ERROR, "checksum of block {} does not match. trace info: {}", pBlockIndex, pTraceInfo);
+                return W_FAILED;
+            }
+
+            return W_PASSED;
+        }
+    }
+}
+
+using namespace wolf::system;
+
+W_RESULT w_compress_blocks::compress(
+    _In_        const char* pSrcBuffer,
+    _Inout_     w_compress_result* pCompressResult,
+    _In_        const w_compress_blocks_config& pConfig,
+    _In_opt_    w_thread_pool* pThreadPool)
+{
+    const char* _trace_info = "w_compress_blocks::compress";
+
+    if (!pCompressResult || (!pSrcBuffer && pCompressResult->size_in)) return W_RESULT::W_INVALIDARG;
+    if (pConfig.block_size_in_bytes < W_COMPRESS_BLOCKS_MIN_BLOCK_SIZE ||
+        pConfig.block_size_in_bytes > W_COMPRESS_BLOCKS_MAX_BLOCK_SIZE ||
+        pConfig.hc_level < 0)
+    {
+        W_V(W_FAILED, w_log_type::W_ERROR, "invalid configuration, block size must be between {} and {} bytes. trace info: {}",
+            W_COMPRESS_BLOCKS_MIN_BLOCK_SIZE, W_COMPRESS_BLOCKS_MAX_BLOCK_SIZE, _trace_info);
+        return W_RESULT::W_INVALIDARG;
+    }
+
+    pCompressResult->data = nullptr;
+    pCompressResult->size_out = 0;
+
+    w_compress_blocks_info _info;
+    _info.content_size = pCompressResult->size_in;
+    _info.block_size_in_bytes = pConfig.block_size_in_bytes;
+    _info.has_checksum = pConfig.checksum;
+
+    auto _number_of_blocks = (_info.content_size + _info.block_size_in_bytes - 1) / _info.block_size_in_bytes;
+    if (_number_of_blocks > UINT32_MAX)
+    {
+        W_V(W_FAILED, w_log_type::W_ERROR, "too many blocks, use bigger block size. trace info: {}", _trace_info);
+        return W_FAILED;
+    }
+    _info.number_of_blocks = static_cast<uint32_t>(_number_of_blocks);
+
+    //each block is compressed into its own slot, then slots are packed after the index
+    auto _slot_size = static_cast<size_t>(LZ4_compressBound(static_cast<int>(_info.block_size_in_bytes)));
+    auto _data_begin = W_COMPRESS_BLOCKS_HEADER_SIZE + static_cast<size_t>(_info.number_of_blocks) * W_COMPRESS_BLOCKS_ENTRY_SIZE;
+    auto _capacity = _data_begin + static_cast<size_t>(_info.number_of_blocks) * _slot_size;
+    auto _dst = static_cast<char*>(malloc(_capacity));
+    if (!_dst)
+    {
+        W_V(W_FAILED, w_log_type::W_ERROR, "could not allocate {} bytes. trace info: {}", _capacity, _trace_info);
+        return W_FAILED;
+    }
+
+    auto _acceleration = pConfig.mode == w_compress_mode::W_FAST && pConfig.acceleration > 1 ? pConfig.acceleration : 1;
+    std::vector<uint32_t> _compressed_sizes(_info.number_of_blocks);
+    std::vector<uint32_t> _checksums(_info.number_of_blocks, 0);
+
+    s_for_each_block(pThreadPool, 0, _info.number_of_blocks, [&](const uint32_t& pBlockIndex)
+    {
+        auto _src = pSrcBuffer + static_cast<size_t>(pBlockIndex) * _info.block_size_in_bytes;
+        auto _block_size = s_get_block_size(_info, pBlockIndex);
+        auto _slot = _dst + _data_begin + static_cast<size_t>(pBlockIndex) * _slot_size;
+
+        auto _size = pConfig.hc_level ?
+            LZ4_compress_HC(_src, _slot, static_cast<int>(_block_size), static_cast<int>(_slot_size), pConfig.hc_level) :
+            LZ4_compress_fast(_src, _slot, static_cast<int>(_block_size), static_cast<int>(_slot_size), _acceleration);
+        if (_size <= 0 || static_cast<size_t>(_size) >= _block_size)
+        {
+            //incompressible, store it
+            std::memcpy(_slot, _src, _block_size);
+            _size = static_cast<int>(_block_size);
+        }
+
+        _compressed_sizes[pBlockIndex] = static_cast<uint32_t>(_size);
+        if (pConfig.checksum)
+        {
+            _checksums[pBlockIndex] = XXH32(_src, _block_size, 0);
+        }
+    });
+
+    auto _offset = _data_begin;
+    auto _index = _dst + W_COMPRESS_BLOCKS_HEADER_SIZE;
+    for (uint32_t i = 0; i < _info.number_of_blocks; ++i)
+    {
+        auto _slot = _dst + _data_begin + static_cast<size_t>(i) * _slot_size;
+        if (_slot != _dst + _offset)
+        {
+            std::memmove(_dst + _offset, _slot, _compressed_sizes[i]);
+        }
+
+        auto _entry = _index + static_cast<size_t>(i) * W_COMPRESS_BLOCKS_ENTRY_SIZE;
+        s_write_u64(_entry, _offset);
+        s_write_u32(_entry + 8, _compressed_sizes[i]);
+        s_write_u32(_entry + 12, _checksums[i]);
+
+        _offset += _compressed_sizes[i];
+    }
+
+    s_write_u32(_dst, W_COMPRESS_BLOCKS_MAGIC);
+    s_write_u16(_dst + 4, W_COMPRESS_BLOCKS_VERSION);
+    s_write_u16(_dst + 6, pConfig.checksum ? W_COMPRESS_BLOCKS_FLAG_CHECKSUM : 0);
+    s_write_u32(_dst + 8, _info.block_size_in_bytes);
+    s_write_u32(_dst + 12, _info.number_of_blocks);
+    s_write_u64(_dst + 16, _info.content_size);
+    s_write_u32(_dst + 24, XXH32(_index, _data_begin - W_COMPRESS_BLOCKS_HEADER_SIZE, 0));
+    s_write_u32(_dst + 28, 0);
+
+    //give back the unused slots
+    auto _shrinked = static_cast<char*>(realloc(_dst, _offset));
+    pCompressResult->data = _shrinked ? _shrinked : _dst;
+    pCompressResult->size_out = _offset;
+
+    return W_PASSED;
+}
+
+W_RESULT w_compress_blocks::decompress(
+    _In_        const char* pCompressedBuffer,
+    _Inout_     w_compress_result* pDecompressInfo,
+    _In_opt_    w_thread_pool* pThreadPool)
+{
+    const char* _trace_info = "w_compress_blocks::decompress";
+
+    if (!pCompressedBuffer || !pDecompressInfo) return W_RESULT::W_INVALIDARG;
+
+    pDecompressInfo->data = nullptr;
+    pDecompressInfo->size_out = 0;
+
+    w_compress_blocks_info _info;
+    if (s_parse(pCompressedBuffer, pDecompressInfo->size_in, _info, _trace_info) == W_FAILED) return W_FAILED;
+
+    if (_info.content_size > SIZE_MAX)
+    {
+        W_V(W_FAILED, w_log_type::W_ERROR, "content of {} bytes does not fit in memory. trace info: {}", _info.content_size, _trace_info);
+        return W_FAILED;
+    }
+
+    auto _content_size = static_cast<size_t>(_info.content_size);
+    auto _dst = static_cast<char*>(malloc(_content_size ? _content_size : 1));
+    if (!_dst)
+    {
+        W_V(W_FAILED, w_log_type::W_ERROR, "could not allocate {} bytes. trace info: {}", _content_size, _trace_info);
+        return W_FAILED;
+    }
+
+    std::atomic<bool> _failed(false);
+    s_for_each_block(pThreadPool, 0, _info.number_of_blocks, [&](const uint32_t& pBlockIndex)
+    {
+        if (_failed.load(std::memory_order_relaxed)) return;
+        auto _block_dst = _dst + static_cast<size_t>(pBlockIndex) * _info.block_size_in_bytes;
+        if (s_decompress_block(pCompressedBuffer, pDecompressInfo->size_in, _info, pBlockIndex, _block_dst, _trace_info) == W_FAILED)
+        {
+            _failed.store(true, std::memory_order_relaxed);
+        }
+    });
+
+    if (_failed.load())
+    {
+        free(_dst);
+        return W_FAILED;
+    }
+
+    pDecompressInfo->data = _dst;
+    pDecompressInfo->size_out = _content_size;
+
+    return W_PASSED;
+}
+
+W_RESULT w_compress_blocks::decompress_block(
+    _In_    const char* pCompressedBuffer,
+    _In_    const size_t& pCompressedSize,
+    _In_    const uint32_t& pBlockIndex,
+    _Inout_ char* pDst,
+    _Out_   size_t& pDstSize)
+{
+    const char* _trace_info = "w_compress_blocks::decompress_block";
+
+    pDstSize = 0;
+    if (!pDst) return W_RESULT::W_INVALIDARG;
+
+    w_compress_blocks_info _info;
+    if (s_parse(pCompressedBuffer, pCompressedSize, _info, _trace_info) == W_FAILED) return W_FAILED;
+    if (pBlockIndex >= _info.number_of_blocks)
+    {
+        W_V(W_FAILED, w_log_type::W_ERROR, "block {} is out of range of {} blocks. trace info: {}", pBlockIndex, _info.number_of_blocks, _trace_info);
+        return W_RESULT::W_INVALIDARG;
+    }
+
+    if (s_decompress_block(pCompressedBuffer, pCompressedSize, _info, pBlockIndex, pDst, _trace_info) == W_FAILED) return W_FAILED;
+
+    pDstSize = s_get_block_size(_info, pBlockIndex);
+    return W_PASSED;
+}
+
+W_RESULT w_compress_blocks::read(
+    _In_        const char* pCompressedBuffer,
+    _In_        const size_t& pCompressedSize,
+    _In_        const uint64_t& pOffset,
+    _In_        const size_t& pSize,
+    _Inout_     char* pDst,
+    _In_opt_    w_thread_pool* pThreadPool)
+{
+    const char* _trace_info = "w_compress_blocks::read";
+
+    if (!pDst && pSize) return W_RESULT::W_INVALIDARG;
+
+    w_compress_blocks_info _info;
+    if (s_parse(pCompressedBuffer, pCompressedSize, _info, _trace_info) == W_FAILED) return W_FAILED;
+    if (pOffset > _info.content_size || pSize > _info.content_size - pOffset)
+    {
+        W_V(W_FAILED, w_log_type::W_ERROR, "range [{}, {}) is out of content of {} bytes. trace info: {}",
+            pOffset, pOffset + pSize, _info.content_size, _trace_info);
+        return W_RESULT::W_INVALIDARG;
+    }
+    if (!pSize) return W_PASSED;
+
+    auto _end = pOffset + pSize;
+    auto _first_block = static_cast<uint32_t>(pOffset / _info.block_size_in_bytes);
+    auto _last_block = static_cast<uint32_t>((_end - 1) / _info.block_size_in_bytes);
+
+    std::atomic<bool> _failed(false);
+    s_for_each_block(pThreadPool, _first_block, _last_block + 1, [&](const uint32_t& pBlockIndex)
+    {
+        if (_failed.load(std::memory_order_relaxed)) return;
+
+        auto _block_begin = static_cast<uint64_t>(pBlockIndex) * _info.block_size_in_bytes;
+        auto _block_end = _block_begin + s_get_block_size(_info, pBlockIndex);
+
+        W_RESULT _hr;
+        if (_block_begin >= pOffset && _block_end <= _end)
+        {
+            //the whole block is requested, decompress it in place
+            _hr = s_decompress_block(pCompressedBuffer, pCompressedSize, _info, pBlockIndex,
+                pDst + static_cast<size_t>(_block_begin - pOffset), _trace_info);
+        }
+        else
+        {
+            std::vector<char> _block(static_cast<size_t>(_block_end - _block_begin));
+            _hr = s_decompress_block(pCompressedBuffer, pCompressedSize, _info, pBlockIndex, _block.data(), _trace_info);
+            if (_hr == W_PASSED)
+            {
+                auto _begin = std::max(_block_begin, pOffset);
+                auto _stop = std::min(_block_end, _end);
+                std::memcpy(
+                    pDst + static_cast<size_t>(_begin - pOffset),
+                    _block.data() + static_cast<size_t>(_begin - _block_begin),
+                    static_cast<size_t>(_stop - _begin));
+            }
+        }
+        if (_hr == W_FAILED)
+        {
+            _failed.store(true, std::memory_order_relaxed);
+        }
+    });
+
+    return _failed.load() ? W_FAILED : W_PASSED;
+}
+
+bool w_compress_blocks::get_is_block_container(_In_ const char* pBuffer, _In_ const size_t& pSize)
+{
+    return pBuffer && pSize >= W_COMPRESS_BLOCKS_HEADER_SIZE && s_read_u32(pBuffer) == W_COMPRESS_BLOCKS_MAGIC;
+}
+
+W_RESULT w_compress_blocks::get_info(
+    _In_    const char* pCompressedBuffer,
+    _In_    const size_t& pCompressedSize,
+    _Out_   w_compress_blocks_info& pInfo)
+{
+    const char* _trace_info = "w_compress_blocks::get_info";
+    return s_parse(pCompressedBuffer, pCompressedSize, pInfo, _trace_info);
+}
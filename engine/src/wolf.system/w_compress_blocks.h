@@ -0,0 +1,121 @@
+/*
+	Project			 : Wolf Engine. Copyright(c) Pooya Eimandar (http://PooyaEimandar.com) . All rights reserved.
+	Source			 : Please direct any bug to https://github.com/PooyaEimandar/Wolf.Engine/issues
+	Website			 : http://WolfSource.io
+	Name			 : w_compress_blocks.h
+	Description		 : Split a buffer into independent LZ4 blocks and compress or decompress them on w_thread_pool
+	Comment          : the output is a seekable container with an index of blocks, so each block can be decompressed alone
+*/
+
+#if _MSC_VER > 1000
+#pragma once
+#endif
+
+#ifndef __W_COMPRESS_BLOCKS_H__
+#define __W_COMPRESS_BLOCKS_H__
+
+#include "w_compress.h"
+#include "w_thread_pool.h"
+
+namespace wolf
+{
+	namespace system
+	{
+        struct w_compress_blocks_config
+        {
+            //size of each block before compression, bigger blocks have better ratio and smaller blocks have more parallelism
+            uint32_t            block_size_in_bytes = 1024 * 1024;
+            //W_FAST uses acceleration, it is ignored if hc_level is not zero
+            w_compress_mode     mode = w_compress_mode::W_DEFAULT;
+            int                 acceleration = 1;
+            //level of LZ4-HC between 1 and 12 for offline content builds, zero means LZ4
+            int                 hc_level = 0;
+            //store xxhash32 of each block and verify it on decompression
+            bool                checksum = true;
+        };
+
+        struct w_compress_blocks_info
+        {
+            uint64_t            content_size = 0;
+            uint32_t            block_size_in_bytes = 0;
+            uint32_t            number_of_blocks = 0;
+            bool                has_checksum = false;
+        };
+
+        struct w_compress_blocks
+        {
+            /*
+                compress a buffer to block container
+                @param pSrcBuffer, the source buffer
+                @param pCompressResult, size_in is size of source, data will be allocated by malloc and must be released by free
+                @param pConfig, the configuration of blocks
+                @param pThreadPool, the thread pool which compresses blocks, nullptr means the calling thread
+                @return W_PASSED on success
+            */
+            WSYS_EXP static W_RESULT compress(
+                _In_        const char* pSrcBuffer,
+                _Inout_     w_compress_result* pCompressResult,
+                _In_        const w_compress_blocks_config& pConfig = w_compress_blocks_config(),
+                _In_opt_    w_thread_pool* pThreadPool = nullptr);
+
+            /*
+                decompress whole block container
+                @param pCompressedBuffer, the container
+                @param pDecompressInfo, size_in is size of container, data will be allocated by malloc and must be released by free
+                @param pThreadPool, the thread pool which decompresses blocks, nullptr means the calling thread
+                @return W_PASSED on success
+            */
+            WSYS_EXP static W_RESULT decompress(
+                _In_        const char* pCompressedBuffer,
+                _Inout_     w_compress_result* pDecompressInfo,
+                _In_opt_    w_thread_pool* pThreadPool = nullptr);
+
+            /*
+                decompress one block
+                @param pCompressedBuffer, the container
+                @param pCompressedSize, size of container
+                @param pBlockIndex, index of block
+                @param pDst, the destination which must have at least block_size_in_bytes capacity
+                @param pDstSize, size of block after decompression
+                @return W_PASSED on success
+            */
+            WSYS_EXP static W_RESULT decompress_block(
+                _In_    const char* pCompressedBuffer,
+                _In_    const size_t& pCompressedSize,
+                _In_    const uint32_t& pBlockIndex,
+                _Inout_ char* pDst,
+                _Out_   size_t& pDstSize);
+
+            /*
+                decompress [pOffset, pOffset + pSize) of content, only blocks which overlap the range will be decompressed
+                @param pCompressedBuffer, the container
+                @param pCompressedSize, size of container
+                @param pOffset, offset in content
+                @param pSize, size of range
+                @param pDst, the destination which must have at least pSize capacity
+                @param pThreadPool, the thread pool which decompresses blocks, nullptr means the calling thread
+                @return W_PASSED on success
+            */
+            WSYS_EXP static W_RESULT read(
+                _In_        const char* pCompressedBuffer,
+                _In_        const size_t& pCompressedSize,
+                _In_        const uint64_t& pOffset,
+                _In_        const size_t& pSize,
+                _Inout_     char* pDst,
+                _In_opt_    w_thread_pool* pThreadPool = nullptr);
+
+#pragma region Getters
+            //returns true if buffer starts with header of block container
+            WSYS_EXP static bool get_is_block_container(_In_ const char* pBuffer, _In_ const size_t& pSize);
+
+            //read header of container and validate its index
+            WSYS_EXP static W_RESULT get_info(
+                _In_    const char* pCompressedBuffer,
+                _In_    const size_t& pCompressedSize,
+                _Out_   w_compress_blocks_info& pInfo);
+#pragma endregion
+        };
+	}
+}
+
+#endif //__W_COMPRESS_BLOCKS_H__
@@ -0,0 +1,486 @@
+#include "w_system_pch.h"
+#include "w_fiber_scheduler.h"
+#include "w_thread.h"
+#include <boost/fiber/all.hpp>
+#include <boost/context/protected_fixedsize_stack.hpp>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//capacity of channel which passes jobs from threads outside of scheduler to workers, must be power of 2
+#ifndef W_FIBER_CHANNEL_CAPACITY
+#define W_FIBER_CHANNEL_CAPACITY 1024
+#endif
+
+//number of yields before a polling fiber starts sleeping between polls
+#ifndef W_FIBER_POLL_SPINS
+#define W_FIBER_POLL_SPINS 64
+#endif
+
+//sleep time in microseconds between two polls of yield_until
+#ifndef W_FIBER_POLL_INTERVAL_US
+#define W_FIBER_POLL_INTERVAL_US 50
+#endif
+
+namespace wolf
+{
+    namespace system
+    {
+        /*
+            a pool of fixed size fiber stacks, fibers may migrate and finish on another worker thread,
+            so unlike boost::fibers::pooled_fixedsize_stack the free list is guarded by a mutex.
+            Each stack has a guard page, so a stack overflow faults instead of silently corrupting the heap
+        */
+        class w_fiber_stack_pool
+        {
+        public:
+            w_fiber_stack_pool(_In_ const size_t& pStackSize, _In_ const size_t& pMaxPooledStacks) :
+                _allocator(pStackSize),
+                _max_pooled_stacks(pMaxPooledStacks),
+                _allocated_stacks(0)
+            {
+            }
+
+            ~w_fiber_stack_pool()
+            {
+                for (auto& _stack : this->_free_stacks)
+                {
+                    this->_allocator.deallocate(_stack);
+                }
+                this->_free_stacks.clear();
+            }
+
+            boost::context::stack_context allocate()
+            {
+                {
+                    std::lock_guard<std::mutex> _lock(this->_mutex);
+                    if (!this->_free_stacks.empty())
+                    {
+                        auto _stack = this->_free_stacks.back();
+                        this->_free_stacks.pop_back();
+                        return _stack;
+                    }
+                    this->_allocated_stacks++;
+                }
+                return this->_allocator.allocate();
+            }
+
+            void deallocate(_In_ boost::context::stack_context& pStack)
+            {
+                {
+                    std::lock_guard<std::mutex> _lock(this->_mutex);
+                    if (this->_free_stacks.size() < this->_max_pooled_stacks)
+                    {
+                        this->_free_stacks.push_back(pStack);
+                        return;
+                    }
+                    this->_allocated_stacks--;
+                }
+                this->_allocator.deallocate(pStack);
+            }
+
+            void get_stats(_Inout_ w_fiber_scheduler_stats& pStats)
+            {
+                std::lock_guard<std::mutex> _lock(this->_mutex);
+                pStats.allocated_stacks = this->_allocated_stacks;
+                pStats.pooled_stacks = this->_free_stacks.size();
+            }
+
+        private:
+            //Prevent copying
+            w_fiber_stack_pool(w_fiber_stack_pool const&);
+            w_fiber_stack_pool& operator= (w_fiber_stack_pool const&);
+
+            boost::context::protected_fixedsize_stack       _allocator;
+            size_t                                          _max_pooled_stacks;
+            size_t                                          _allocated_stacks;
+            std::mutex                                      _mutex;
+            std::vector<boost::context::stack_context>      _free_stacks;
+        };
+
+        //stack allocator of each fiber, it is copied into the fiber so it only refers to the shared pool
+        class w_pooled_stack_allocator
+        {
+        public:
+            explicit w_pooled_stack_allocator(_In_ w_fiber_stack_pool* pPool) : _pool(pPool)
+            {
+            }
+
+            boost::context::stack_context allocate()
+            {
+                return this->_pool->allocate();
+            }
+
+            void deallocate(_In_ boost::context::stack_context& pStack) noexcept
+            {
+                this->_pool->deallocate(pStack);
+            }
+
+        private:
+            w_fiber_stack_pool*                             _pool;
+        };
+
+        struct w_fiber_job
+        {
+            std::function<void()>                           work;
+            w_job_counter*                                  counter = nullptr;
+        };
+
+        class w_fiber_scheduler_pimp;
+        //scheduler of current worker thread, nullptr for threads outside of scheduler
+        static thread_local w_fiber_scheduler_pimp*         s_current_scheduler = nullptr;
+
+        class w_fiber_scheduler_pimp
+        {
+        public:
+            w_fiber_scheduler_pimp(
+                _In_ const size_t& pNumberOfThreads,
+                _In_ const size_t& pStackSize,
+                _In_ const size_t& pMaxPooledStacks) :
+                _stack_pool(pStackSize, pMaxPooledStacks),
+                _channel(W_FIBER_CHANNEL_CAPACITY),
+                _active_fibers(0),
+                _dispatchers(pNumberOfThreads),
+                _is_released(false)
+            {
+                for (size_t i = 0; i < pNumberOfThreads; ++i)
+                {
+                    this->_threads.push_back(std::thread(&w_fiber_scheduler_pimp::action, this));
+                }
+            }
+
+            ~w_fiber_scheduler_pimp()
+            {
+                release();
+            }
+
+            W_RESULT execute(_In_ const std::function<void()>& pJob, _In_opt_ w_job_counter* pCounter)
+            {
+                if (pCounter)
+                {
+                    pCounter->_increment();
+                }
+                this->_active_fibers.fetch_add(1, std::memory_order_relaxed);
+
+                if (s_current_scheduler == this)
+                {
+                    //we are inside one of our fibers, so launch it directly into the shared ready queue
+                    _launch(pJob, pCounter);
+                    return W_PASSED;
+                }
+
+                //let one of dispatcher fibers launch it, push fails once channel was closed by release
+                w_fiber_job _job;
+                _job.work = pJob;
+                _job.counter = pCounter;
+                if (this->_channel.push(std::move(_job)) == boost::fibers::channel_op_status::success)
+                {
+                    return W_PASSED;
+                }
+
+                //undo, so waiting on counter or releasing scheduler does not hang
+                if (pCounter)
+                {
+                    pCounter->_decrement();
+                }
+                if (this->_active_fibers.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                {
+                    _notify();
+                }
+                return W_FAILED;
+            }
+
+            void action()
+            {
+                s_current_scheduler = this;
+
+                //join the work sharing, idle workers will be suspended till a new fiber became ready
+                boost::fibers::use_scheduling_algorithm<boost::fibers::algo::shared_work>(true);
+
+                logger.write("fiber scheduler worker with id: {} started", w_thread::get_current_thread_id());
+
+                //each worker owns a dispatcher fiber which launches jobs submitted from outside of scheduler
+                boost::fibers::fiber(
+                    std::allocator_arg,
+                    w_pooled_stack_allocator(&this->_stack_pool),
+                    [this]()
+                {
+                    w_fiber_job _job;
+                    while (this->_channel.pop(_job) == boost::fibers::channel_op_status::success)
+                    {
+                        _launch(_job.work, _job.counter);
+                        _job.work = nullptr;
+                    }
+                    if (this->_dispatchers.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                    {
+                        _notify();
+                    }
+                }).detach();
+
+                //suspend the main fiber, meanwhile this thread executes other fibers
+                std::unique_lock<std::mutex> _lock(this->_mutex);
+                this->_condition_var.wait(_lock, [this]()
+                {
+                    return this->_is_released &&
+                        this->_dispatchers.load(std::memory_order_acquire) == 0 &&
+                        this->_active_fibers.load(std::memory_order_acquire) == 0;
+                });
+
+                s_current_scheduler = nullptr;
+            }
+
+            void release()
+            {
+                if (this->_threads.empty()) return;
+
+                {
+                    std::lock_guard<std::mutex> _lock(this->_mutex);
+                    this->_is_released = true;
+                }
+                //dispatchers will launch the remaining jobs of channel and then exit
+                this->_channel.close();
+                _notify();
+
+                for (auto& _thread : this->_threads)
+                {
+                    _thread.join();
+                }
+                this->_threads.clear();
+            }
+
+#pragma region Getters
+
+            size_t get_number_of_threads() const
+            {
+                return this->_threads.size();
+            }
+
+            w_fiber_scheduler_stats get_stats()
+            {
+                w_fiber_scheduler_stats _stats;
+                _stats.active_fibers = this->_active_fibers.load(std::memory_order_relaxed);
+                this->_stack_pool.get_stats(_stats);
+                return _stats;
+            }
+
+#pragma endregion
+
+        private:
+            void _launch(_In_ const std::function<void()>& pJob, _In_opt_ w_job_counter* pCounter)
+            {
+                boost::fibers::fiber(
+                    std::allocator_arg,
+                    w_pooled_stack_allocator(&this->_stack_pool),
+                    [this, pJob, pCounter]()
+                {
+                    //an exception of a detached fiber terminates the process
+                    try
+                    {
+                        if (pJob)
+                        {
+                            pJob();
+                        }
+                    }
+                    catch (std::exception& pException)
+                    {
+                        logger.error("unhandled exception in fiber: {}. trace info: w_fiber_scheduler::execute", pException.what());
+                    }
+                    catch (...)
+                    {
+                        logger.error("unhandled exception in fiber. trace info: w_fiber_scheduler::execute");
+                    }
+
+                    if (pCounter)
+                    {
+                        pCounter->_decrement();
+                    }
+                    if (this->_active_fibers.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                    {
+                        _notify();
+                    }
+                }).detach();
+            }
+
+            void _notify()
+            {
+                std::lock_guard<std::mutex> _lock(this->_mutex);
+                this->_condition_var.notify_all();
+            }
+
+            std::vector<std::thread>                                _threads;
+            w_fiber_stack_pool                                      _stack_pool;
+            boost::fibers::buffered_channel<w_fiber_job>            _channel;
+            std::atomic<size_t>                                     _active_fibers;
+            std::atomic<size_t>                                     _dispatchers;
+            bool                                                    _is_released;
+
+            //main fibers of workers wait on it till scheduler is released
+            std::mutex                                              _mutex;
+            boost::fibers::condition_variable_any                   _condition_var;
+        };
+
+        /*
+            ready queue of shared_work is shared by the whole process, so initialize and release are serialized and
+            two schedulers never run at the same time. Callers keep a reference while they use the scheduler,
+            so release does not delete it under them
+        */
+        static std::mutex                                           s_lifecycle_mutex;
+        static std::mutex                                           s_scheduler_mutex;
+        static std::shared_ptr<w_fiber_scheduler_pimp>              s_scheduler;
+
+        static std::shared_ptr<w_fiber_scheduler_pimp> s_get_scheduler()
+        {
+            std::lock_guard<std::mutex> _lock(s_scheduler_mutex);
+            return s_scheduler;
+        }
+    }
+}
+
+using namespace wolf::system;
+
+W_RESULT w_fiber_scheduler::initialize(
+    _In_ const size_t& pNumberOfThreads,
+    _In_ const size_t& pStackSize,
+    _In_ const size_t& pMaxPooledStacks)
+{
+    std::lock_guard<std::mutex> _lifecycle_lock(s_lifecycle_mutex);
+    if (s_get_scheduler()) return W_FAILED;
+
+    auto _number_of_threads = pNumberOfThreads;
+    if (_number_of_threads == 0)
+    {
+        _number_of_threads = std::max<size_t>(1, w_thread::get_number_of_hardware_thread_contexts());
+    }
+
+    auto _scheduler = new (std::nothrow) w_fiber_scheduler_pimp(_number_of_threads, pStackSize, pMaxPooledStacks);
+    if (!_scheduler)
+    {
+        logger.error("could not allocate memory for w_fiber_scheduler_pimp. trace info: w_fiber_scheduler::initialize");
+        return W_OUTOFMEMORY;
+    }
+    std::lock_guard<std::mutex> _lock(s_scheduler_mutex);
+    s_scheduler.reset(_scheduler);
+
+    return W_PASSED;
+}
+
+void w_fiber_scheduler::release()
+{
+    std::lock_guard<std::mutex> _lifecycle_lock(s_lifecycle_mutex);
+
+    std::shared_ptr<w_fiber_scheduler_pimp> _scheduler;
+    {
+        std::lock_guard<std::mutex> _lock(s_scheduler_mutex);
+        _scheduler.swap(s_scheduler);
+    }
+    if (!_scheduler) return;
+
+    //jobs which are submitted from now on are rejected, the last reference deletes the scheduler
+    _scheduler->release();
+}
+
+W_RESULT w_fiber_scheduler::execute(_In_ const std::function<void()>& pJob, _In_opt_ w_job_counter* pCounter)
+{
+    const char* _trace_info = "w_fiber_scheduler::execute";
+
+    //the scheduler of a running fiber is alive till the fiber finishes, even while it is being released
+    if (s_current_scheduler)
+    {
+        return s_current_scheduler->execute(pJob, pCounter);
+    }
+
+    auto _scheduler = s_get_scheduler();
+    if (!_scheduler)
+    {
+        initialize();
+        _scheduler = s_get_scheduler();
+        if (!_scheduler)
+        {
+            W_V(W_FAILED, w_log_type::W_ERROR, "could not initialize fiber scheduler. trace info: {}", _trace_info);
+            return W_FAILED;
+        }
+    }
+    if (_scheduler->execute(pJob, pCounter) == W_FAILED)
+    {
+        W_V(W_FAILED, w_log_type::W_ERROR, "fiber scheduler was released, job rejected. trace info: {}", _trace_info);
+        return W_FAILED;
+    }
+    return W_PASSED;
+}
+
+void w_fiber_scheduler::wait(_In_ w_job_counter& pCounter)
+{
+    if (!get_is_fiber())
+    {
+        pCounter.wait();
+        return;
+    }
+    yield_until([&pCounter]()
+    {
+        return pCounter.get_is_done();
+    });
+}
+
+void w_fiber_scheduler::yield()
+{
+    if (get_is_fiber())
+    {
+        boost::this_fiber::yield();
+    }
+    else
+    {
+        std::this_thread::yield();
+    }
+}
+
+void w_fiber_scheduler::yield_until(_In_ const std::function<bool()>& pIsReady)
+{
+    const auto _is_fiber = get_is_fiber();
+    const auto _interval = std::chrono::microseconds(W_FIBER_POLL_INTERVAL_US);
+
+    size_t _spins = 0;
+    while (!pIsReady())
+    {
+        if (_spins++ < W_FIBER_POLL_SPINS)
+        {
+            yield();
+        }
+        else if (_is_fiber)
+        {
+            //let the worker thread sleep if there is no other ready fiber
+            boost::this_fiber::sleep_for(_interval);
+        }
+        else
+        {
+            std::this_thread::sleep_for(_interval);
+        }
+    }
+}
+
+#pragma region Getters
+
+bool w_fiber_scheduler::get_is_initialized()
+{
+    return s_get_scheduler() != nullptr;
+}
+
+bool w_fiber_scheduler::get_is_fiber()
+{
+    return s_current_scheduler != nullptr;
+}
+
+size_t w_fiber_scheduler::get_number_of_threads()
+{
+    auto _scheduler = s_get_scheduler();
+    return _scheduler ? _scheduler->get_number_of_threads() : 0;
+}
+
+w_fiber_scheduler_stats w_fiber_scheduler::get_stats()
+{
+    auto _scheduler = s_get_scheduler();
+    return _scheduler ? _scheduler->get_stats() : w_fiber_scheduler_stats();
+}
+
+#pragma endregion
@@ -0,0 +1,105 @@
+/*
+	Project			 : Wolf Engine. Copyright(c) Pooya Eimandar (http://PooyaEimandar.com) . All rights reserved.
+	Source			 : Please direct any bug to https://github.com/PooyaEimandar/Wolf.Engine/issues
+	Website			 : http://WolfSource.io
+	Name			 : w_fiber_scheduler.h
+	Description		 : A fiber based task scheduler which runs on a fixed number of worker threads
+	Comment          : based on boost::fibers::algo::shared_work, the scheduler is shared by the whole process
+*/
+
+#if _MSC_VER > 1000
+#pragma once
+#endif
+
+#ifndef __W_FIBER_SCHEDULER_H__
+#define __W_FIBER_SCHEDULER_H__
+
+#include "w_system_export.h"
+#include "w_std.h"
+#include "w_job_counter.h"
+#include <functional>
+
+//default size of each fiber stack in bytes, a guard page is added below each stack
+#ifndef W_FIBER_STACK_SIZE
+#define W_FIBER_STACK_SIZE (256 * 1024)
+#endif
+
+//maximum number of released fiber stacks which will be kept for reusing
+#ifndef W_FIBER_MAX_POOLED_STACKS
+#define W_FIBER_MAX_POOLED_STACKS 256
+#endif
+
+namespace wolf
+{
+	namespace system
+	{
+        struct w_fiber_scheduler_stats
+        {
+            //number of fibers which are created and not finished yet
+            size_t      active_fibers = 0;
+            //number of stacks which were allocated from the operating system
+            size_t      allocated_stacks = 0;
+            //number of free stacks which are ready for reusing
+            size_t      pooled_stacks = 0;
+        };
+
+        /*
+            Runs jobs as fibers on a fixed number of worker threads, jobs may yield while they are
+            waiting for I/O or GPU fences, meanwhile the worker thread will execute other fibers.
+            Fibers must not block: a fiber which waits on std::mutex, std::condition_variable, tbb or sockets,
+            sleeps the thread or runs an endless loop pins its worker thread for good, use w_fiber_scheduler::wait,
+            yield_until or w_task::run_on_thread for such work. Stacks are fixed size with a guard page, an overflow
+            crashes instead of corrupting memory, so keep deep recursion and large locals out of fibers.
+            There is only one fiber scheduler per process, so all functions are static
+        */
+        class w_fiber_scheduler
+        {
+        public:
+            /*
+                start worker threads
+                @param pNumberOfThreads, number of worker threads, zero means number of hardware thread contexts
+                @param pStackSize, size of stack of each fiber in bytes
+                @param pMaxPooledStacks, maximum number of free stacks which will be kept for reusing
+                @return W_PASSED on success, W_FAILED if scheduler was already initialized
+            */
+            WSYS_EXP static W_RESULT initialize(
+                _In_ const size_t& pNumberOfThreads = 0,
+                _In_ const size_t& pStackSize = W_FIBER_STACK_SIZE,
+                _In_ const size_t& pMaxPooledStacks = W_FIBER_MAX_POOLED_STACKS);
+
+            //wait for all fibers and stop worker threads
+            WSYS_EXP static void release();
+
+            /*
+                execute a job as a new fiber, the scheduler will be initialized with default parameters if it was not
+                @param pJob, the job
+                @param pCounter, optional counter which will be decremented once the job is done
+                @return W_FAILED if scheduler is being released, in this case pCounter is not changed
+            */
+            WSYS_EXP static W_RESULT execute(_In_ const std::function<void()>& pJob, _In_opt_ w_job_counter* pCounter = nullptr);
+
+            //wait for pCounter, fibers yield while waiting and other threads block
+            WSYS_EXP static void wait(_In_ w_job_counter& pCounter);
+
+            //yield the current fiber, on threads outside of scheduler yields the thread
+            WSYS_EXP static void yield();
+
+            /*
+                call pIsReady till returns true, use it for polling I/O or GPU fences from a fiber.
+                The current fiber yields between each call, so the worker thread is not blocked
+            */
+            WSYS_EXP static void yield_until(_In_ const std::function<bool()>& pIsReady);
+
+#pragma region Getters
+            //returns true if scheduler was initialized
+            WSYS_EXP static bool get_is_initialized();
+            //returns true if the caller runs inside a fiber of scheduler
+            WSYS_EXP static bool get_is_fiber();
+            WSYS_EXP static size_t get_number_of_threads();
+            WSYS_EXP static w_fiber_scheduler_stats get_stats();
+#pragma endregion
+        };
+	}
+}
+
+#endif //__W_FIBER_SCHEDULER_H__
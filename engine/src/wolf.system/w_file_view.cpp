@@ -0,0 +1,282 @@
+#include "w_system_pch.h"
+#include "w_file_view.h"
+
+#ifdef __WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace wolf
+{
+    namespace system
+    {
+        class w_file_view_pimp
+        {
+        public:
+            w_file_view_pimp() :
+                _name("w_file_view"),
+                _data(nullptr),
+                _size(0),
+                _is_open(false),
+                _copy_on_write(false)
+#ifdef __WIN32
+                , _mapping(NULL)
+#endif
+            {
+            }
+
+            ~w_file_view_pimp()
+            {
+                release();
+            }
+
+#ifdef __WIN32
+            W_RESULT open(_In_z_ const wchar_t* pPath, _In_ const w_file_view_access& pAccess, _In_ const bool& pCopyOnWrite)
+            {
+                const char* _trace_info = "w_file_view::open";
+
+                release();
+
+                auto _file = CreateFileW(
+                    pPath,
+                    GENERIC_READ,
+                    FILE_SHARE_READ,
+                    nullptr,
+                    OPEN_EXISTING,
+                    pAccess == W_FILE_VIEW_RANDOM ? FILE_FLAG_RANDOM_ACCESS : FILE_FLAG_SEQUENTIAL_SCAN,
+                    nullptr);
+                if (_file == INVALID_HANDLE_VALUE)
+                {
+                    W_V(W_FAILED, w_log_type::W_ERROR, "could not open file {}. error: {}. trace info: {}", wolf::system::convert::wstring_to_string(pPath), GetLastError(), _trace_info);
+                    return W_FAILED;
+                }
+
+                LARGE_INTEGER _file_size = { 0 };
+                if (!GetFileSizeEx(_file, &_file_size))
+                {
+                    CloseHandle(_file);
+                    W_V(W_FAILED, w_log_type::W_ERROR, "could not get size of file {}. trace info: {}", wolf::system::convert::wstring_to_string(pPath), _trace_info);
+                    return W_FAILED;
+                }
+
+                this->_size = static_cast<size_t>(_file_size.QuadPart);
+                if (this->_size)
+                {
+                    //the mapping keeps the file open, so the handle of file is not needed anymore
+                    this->_mapping = CreateFileMappingW(_file, nullptr, pCopyOnWrite ? PAGE_WRITECOPY : PAGE_READONLY, 0, 0, nullptr);
+                    if (this->_mapping)
+                    {
+                        this->_data = static_cast<const uint8_t*>(MapViewOfFile(this->_mapping, pCopyOnWrite ? FILE_MAP_COPY : FILE_MAP_READ, 0, 0, 0));
+                    }
+                    if (!this->_data)
+                    {
+                        W_V(W_FAILED, w_log_type::W_ERROR, "could not map file {}. error: {}. trace info: {}", wolf::system::convert::wstring_to_string(pPath), GetLastError(), _trace_info);
+                        if (this->_mapping)
+                        {
+                            CloseHandle(this->_mapping);
+                            this->_mapping = NULL;
+                        }
+                        CloseHandle(_file);
+                        this->_size = 0;
+                        return W_FAILED;
+                    }
+                }
+                CloseHandle(_file);
+
+                this->_copy_on_write = pCopyOnWrite;
+                this->_is_open = true;
+                return W_PASSED;
+            }
+
+            W_RESULT open(_In_z_ const char* pPath, _In_ const w_file_view_access& pAccess, _In_ const bool& pCopyOnWrite)
+            {
+                auto _path = wolf::system::convert::string_to_wstring(pPath);
+                return open(_path.c_str(), pAccess, pCopyOnWrite);
+            }
+#else
+            W_RESULT open(_In_z_ const char* pPath, _In_ const w_file_view_access& pAccess, _In_ const bool& pCopyOnWrite)
+            {
+                const char* _trace_info = "w_file_view::open";
+
+                release();
+
+                auto _fd = ::open(pPath, O_RDONLY | O_CLOEXEC);
+                if (_fd == -1)
+                {
+                    W_V(W_FAILED, w_log_type::W_ERROR, "could not open file {}. error: {}. trace info: {}", pPath, errno, _trace_info);
+                    return W_FAILED;
+                }
+
+                struct stat _stat;
+                if (fstat(_fd, &_stat) != 0)
+                {
+                    close(_fd);
+                    W_V(W_FAILED, w_log_type::W_ERROR, "could not get size of file {}. error: {}. trace info: {}", pPath, errno, _trace_info);
+                    return W_FAILED;
+                }
+
+                this->_size = static_cast<size_t>(_stat.st_size);
+                if (this->_size)
+                {
+                    auto _data = mmap(nullptr, this->_size, pCopyOnWrite ? PROT_READ | PROT_WRITE : PROT_READ, MAP_PRIVATE, _fd, 0);
+                    if (_data == MAP_FAILED)
+                    {
+                        close(_fd);
+                        this->_size = 0;
+                        W_V(W_FAILED, w_log_type::W_ERROR, "could not map file {}. error: {}. trace info: {}", pPath, errno, _trace_info);
+                        return W_FAILED;
+                    }
+                    if (pAccess == W_FILE_VIEW_RANDOM)
+                    {
+                        madvise(_data, this->_size, MADV_RANDOM);
+                    }
+                    else
+                    {
+                        //ask the kernel to start paging in, so the first touches do not stall on the disk
+                        madvise(_data, this->_size, MADV_SEQUENTIAL);
+                        madvise(_data, this->_size, MADV_WILLNEED);
+                    }
+                    this->_data = static_cast<const uint8_t*>(_data);
+                }
+                //the mapping keeps the file open
+                close(_fd);
+
+                this->_copy_on_write = pCopyOnWrite;
+                this->_is_open = true;
+                return W_PASSED;
+            }
+#endif
+
+            ULONG release()
+            {
+                if (!this->_is_open && !this->_data) return 1;
+
+#ifdef __WIN32
+                if (this->_data)
+                {
+                    UnmapViewOfFile(this->_data);
+                }
+                if (this->_mapping)
+                {
+                    CloseHandle(this->_mapping);
+                    this->_mapping = NULL;
+                }
+#else
+                if (this->_data)
+                {
+                    munmap(const_cast<uint8_t*>(this->_data), this->_size);
+                }
+#endif
+                this->_data = nullptr;
+                this->_size = 0;
+                this->_is_open = false;
+                this->_copy_on_write = false;
+
+                return 0;
+            }
+
+#pragma region Getters
+            const uint8_t* get_data() const
+            {
+                return this->_data;
+            }
+
+            uint8_t* get_writable_data() const
+            {
+                return this->_copy_on_write ? const_cast<uint8_t*>(this->_data) : nullptr;
+            }
+
+            size_t get_size() const
+            {
+                return this->_size;
+            }
+
+            bool get_is_open() const
+            {
+                return this->_is_open;
+            }
+#pragma endregion
+
+        private:
+            std::string                         _name;
+            const uint8_t*                      _data;
+            size_t                              _size;
+            bool                                _is_open;
+            bool                                _copy_on_write;
+#ifdef __WIN32
+            HANDLE                              _mapping;
+#endif
+        };
+    }
+}
+
+using namespace wolf::system;
+
+w_file_view::w_file_view() :
+    _pimp(new w_file_view_pimp())
+{
+}
+
+w_file_view::~w_file_view()
+{
+    delete this->_pimp;
+    this->_pimp = nullptr;
+}
+
+W_RESULT w_file_view::open(
+    _In_z_  const char* pPath,
+    _In_    const w_file_view_access& pAccess,
+    _In_    const bool& pCopyOnWrite)
+{
+    if (!this->_pimp || !pPath) return W_FAILED;
+    return this->_pimp->open(pPath, pAccess, pCopyOnWrite);
+}
+
+#ifdef __WIN32
+W_RESULT w_file_view::open(
+    _In_z_  const wchar_t* pPath,
+    _In_    const w_file_view_access& pAccess,
+    _In_    const bool& pCopyOnWrite)
+{
+    if (!this->_pimp || !pPath) return W_FAILED;
+    return this->_pimp->open(pPath, pAccess, pCopyOnWrite);
+}
+#endif
+
+ULONG w_file_view::release()
+{
+    if (!this->_pimp) return 1;
+    return this->_pimp->release();
+}
+
+#pragma region Getters
+
+const uint8_t* w_file_view::get_data() const
+{
+    if (!this->_pimp) return nullptr;
+    return this->_pimp->get_data();
+}
+
+uint8_t* w_file_view::get_writable_data() const
+{
+    if (!this->_pimp) return nullptr;
+    return this->_pimp->get_writable_data();
+}
+
+size_t w_file_view::get_size() const
+{
+    if (!this->_pimp) return 0;
+    return this->_pimp->get_size();
+}
+
+bool w_file_view::get_is_open() const
+{
+    if (!this->_pimp) return false;
+    return this->_pimp->get_is_open();
+}
+
+#pragma endregion
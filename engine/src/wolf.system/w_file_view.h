@@ -0,0 +1,83 @@
+/*
+	Project			 : Wolf Engine. Copyright(c) Pooya Eimandar (http://PooyaEimandar.com) . All rights reserved.
+	Source			 : Please direct any bug to https://github.com/PooyaEimandar/Wolf.Engine/issues
+	Website			 : http://WolfSource.io
+	Name			 : w_file_view.h
+	Description		 : Read only memory mapped view of a file
+	Comment          : pages of file are loaded by the OS on first access, so content can be used in place without copying
+*/
+
+#if _MSC_VER > 1000
+#pragma once
+#endif
+
+#ifndef __W_FILE_VIEW_H__
+#define __W_FILE_VIEW_H__
+
+#include "w_system_export.h"
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__ANDROID) || defined(__linux) || defined(__APPLE__)
+#include "w_std.h"
+#endif
+
+namespace wolf
+{
+	namespace system
+	{
+        enum w_file_view_access
+        {
+            //the view will be read from the beginning to the end, the OS reads ahead
+            W_FILE_VIEW_SEQUENTIAL = 0,
+            //the view will be read at random offsets, the OS does not read ahead
+            W_FILE_VIEW_RANDOM
+        };
+
+        class w_file_view_pimp;
+        class w_file_view
+        {
+        public:
+            WSYS_EXP w_file_view();
+            WSYS_EXP ~w_file_view();
+
+            /*
+                map whole file as read only
+                @param pPath, path of file
+                @param pAccess, the access pattern which is given to OS as hint
+                @param pCopyOnWrite, map pages as copy on write, modified pages become private to process and never written to file
+                @return W_PASSED on success, an empty file is mapped with zero size and nullptr data
+            */
+            WSYS_EXP W_RESULT open(
+                _In_z_  const char* pPath,
+                _In_    const w_file_view_access& pAccess = W_FILE_VIEW_SEQUENTIAL,
+                _In_    const bool& pCopyOnWrite = false);
+#ifdef __WIN32
+            WSYS_EXP W_RESULT open(
+                _In_z_  const wchar_t* pPath,
+                _In_    const w_file_view_access& pAccess = W_FILE_VIEW_SEQUENTIAL,
+                _In_    const bool& pCopyOnWrite = false);
+#endif
+
+            //unmap the view
+            WSYS_EXP ULONG release();
+
+#pragma region Getters
+            WSYS_EXP const uint8_t* get_data() const;
+            //returns nullptr if view was not opened as copy on write
+            WSYS_EXP uint8_t* get_writable_data() const;
+            WSYS_EXP size_t get_size() const;
+            WSYS_EXP bool get_is_open() const;
+#pragma endregion
+
+        private:
+            //Prevent copying
+            w_file_view(w_file_view const&);
+            w_file_view& operator= (w_file_view const&);
+
+            w_file_view_pimp*                       _pimp;
+        };
+	}
+}
+
+#endif //__W_FILE_VIEW_H__
@@ -0,0 +1,346 @@
+#include "w_system_pch.h"
+#include "w_frame_arena.h"
+#include "w_thread.h"
+#include "w_memory_tracker.h"
+#include <atomic>
+#include <mutex>
+#include <memory>
+#include <algorithm>
+
+namespace wolf
+{
+    namespace system
+    {
+        class w_frame_arena_pimp;
+
+        //shared state of all frame arenas
+        struct w_frame_arena_registry
+        {
+            std::atomic<uint64_t>                   frame_index;
+            std::atomic<size_t>                     frame_high_water_mark;
+            std::atomic<size_t>                     thread_arena_size;
+            std::atomic<uint32_t>                   thread_arena_buffers;
+            std::mutex                              mutex;
+            std::vector<w_frame_arena_pimp*>        arenas;
+
+            w_frame_arena_registry() :
+                frame_index(0),
+                frame_high_water_mark(0),
+                thread_arena_size(W_FRAME_ARENA_DEFAULT_SIZE),
+                thread_arena_buffers(W_FRAME_ARENA_DEFAULT_BUFFERS)
+            {
+            }
+        };
+
+        static w_frame_arena_registry& get_registry()
+        {
+            static w_frame_arena_registry _registry;
+            return _registry;
+        }
+
+        class w_frame_arena_pimp
+        {
+        public:
+            w_frame_arena_pimp(_In_ const size_t& pSizeInBytes, _In_ const uint32_t& pNumberOfBuffers) :
+                _capacity(pSizeInBytes),
+                _number_of_buffers(std::max<uint32_t>(pNumberOfBuffers, 1)),
+                _current_buffer(0),
+                _thread_id(0),
+                _category(w_memory_tracker::get_thread_category()),
+                _is_overflow_logged(false),
+                _frame_index(get_registry().frame_index.load(std::memory_order_acquire)),
+                _offset(0),
+                _frame_overflow(0),
+                _last_frame_used(0),
+                _high_water_mark(0),
+                _total_overflows(0)
+            {
+                this->_buffers.resize(this->_number_of_buffers, nullptr);
+                this->_overflows.resize(this->_number_of_buffers);
+                for (auto& _buffer : this->_buffers)
+                {
+                    _buffer = new (std::nothrow) uint8_t[this->_capacity];
+                    if (!_buffer)
+                    {
+                        V(W_FAILED, w_log_type::W_ERROR, "allocating buffer of frame arena with size: {}. trace info: {}", this->_capacity, "w_frame_arena");
+                        //all buffers must have the same capacity, so every allocation falls back to heap
+                        _release_buffers();
+                        this->_capacity = 0;
+                        break;
+                    }
+                    w_memory_tracker::track_alloc(this->_category, this->_capacity);
+                }
+
+                auto& _registry = get_registry();
+                std::lock_guard<std::mutex> _lock(_registry.mutex);
+                _registry.arenas.push_back(this);
+            }
+
+            ~w_frame_arena_pimp()
+            {
+                {
+                    auto& _registry = get_registry();
+                    std::lock_guard<std::mutex> _lock(_registry.mutex);
+                    auto _iter = std::find(_registry.arenas.begin(), _registry.arenas.end(), this);
+                    if (_iter != _registry.arenas.end())
+                    {
+                        _registry.arenas.erase(_iter);
+                    }
+                }
+
+                _release_overflows();
+                _release_buffers();
+            }
+
+            void reset()
+            {
+                _release_overflows();
+                this->_current_buffer = 0;
+                this->_offset.store(0, std::memory_order_relaxed);
+                this->_frame_overflow.store(0, std::memory_order_relaxed);
+                this->_frame_index.store(get_registry().frame_index.load(std::memory_order_acquire), std::memory_order_relaxed);
+            }
+
+            void* allocate(_In_ const size_t& pSizeInBytes, _In_ size_t pAlignment)
+            {
+                auto _frame = get_registry().frame_index.load(std::memory_order_acquire);
+                if (_frame != this->_frame_index.load(std::memory_order_relaxed))
+                {
+                    _rotate(_frame);
+                }
+
+                if (pAlignment == 0) pAlignment = alignof(std::max_align_t);
+
+                auto _buffer = this->_buffers[this->_current_buffer];
+                if (_buffer)
+                {
+                    auto _base = reinterpret_cast<uintptr_t>(_buffer);
+                    auto _ptr = (_base + this->_offset.load(std::memory_order_relaxed) + pAlignment - 1) & ~(static_cast<uintptr_t>(pAlignment) - 1);
+                    if (_ptr + pSizeInBytes <= _base + this->_capacity)
+                    {
+                        this->_offset.store(_ptr + pSizeInBytes - _base, std::memory_order_relaxed);
+                        return reinterpret_cast<void*>(_ptr);
+                    }
+                }
+
+                //buffer is full, allocate from heap and release it once this buffer will be reused
+                auto _block = static_cast<uint8_t*>(malloc(pSizeInBytes + pAlignment));
+                if (!_block) return nullptr;
+
+                this->_overflows[this->_current_buffer].push_back(_block);
+                this->_frame_overflow.store(this->_frame_overflow.load(std::memory_order_relaxed) + pSizeInBytes, std::memory_order_relaxed);
+                this->_total_overflows.store(this->_total_overflows.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                if (!this->_is_overflow_logged)
+                {
+                    this->_is_overflow_logged = true;
+                    logger.warning("frame arena of thread {} with buffer size {} overflowed, falling back to heap", this->_thread_id.load(std::memory_order_relaxed), this->_capacity);
+                }
+
+                auto _ptr = (reinterpret_cast<uintptr_t>(_block) + pAlignment - 1) & ~(static_cast<uintptr_t>(pAlignment) - 1);
+                return reinterpret_cast<void*>(_ptr);
+            }
+
+            w_frame_arena_stats get_stats() const
+            {
+                w_frame_arena_stats _stats;
+                _stats.thread_id = this->_thread_id.load(std::memory_order_relaxed);
+                _stats.frame_index = this->_frame_index.load(std::memory_order_relaxed);
+                _stats.capacity = this->_capacity;
+                _stats.number_of_buffers = this->_number_of_buffers;
+                _stats.frame_overflow = this->_frame_overflow.load(std::memory_order_relaxed);
+                _stats.frame_used = this->_offset.load(std::memory_order_relaxed) + _stats.frame_overflow;
+                _stats.last_frame_used = this->_last_frame_used.load(std::memory_order_relaxed);
+                _stats.high_water_mark = std::max(this->_high_water_mark.load(std::memory_order_relaxed), _stats.frame_used);
+                _stats.total_overflows = this->_total_overflows.load(std::memory_order_relaxed);
+                return _stats;
+            }
+
+#pragma region Getters
+            size_t get_frame_used() const
+            {
+                return this->_offset.load(std::memory_order_relaxed) + this->_frame_overflow.load(std::memory_order_relaxed);
+            }
+            uint64_t get_frame_index() const
+            {
+                return this->_frame_index.load(std::memory_order_relaxed);
+            }
+#pragma endregion
+
+#pragma region Setters
+            void set_thread_id(_In_ const size_t& pThreadID)
+            {
+                this->_thread_id.store(pThreadID, std::memory_order_relaxed);
+            }
+#pragma endregion
+
+        private:
+            void _release_overflows()
+            {
+                for (auto& _blocks : this->_overflows)
+                {
+                    for (auto _block : _blocks) free(_block);
+                    _blocks.clear();
+                }
+            }
+
+            void _release_buffers()
+            {
+                for (auto& _buffer : this->_buffers)
+                {
+                    if (!_buffer) continue;
+                    w_memory_tracker::track_free(this->_category, this->_capacity);
+                    delete[] _buffer;
+                    _buffer = nullptr;
+                }
+            }
+
+            void _rotate(_In_ const uint64_t& pFrameIndex)
+            {
+                auto _used = get_frame_used();
+                this->_last_frame_used.store(_used, std::memory_order_relaxed);
+                if (_used > this->_high_water_mark.load(std::memory_order_relaxed))
+                {
+                    this->_high_water_mark.store(_used, std::memory_order_relaxed);
+                }
+
+                //the next buffer was used at least (number of buffers - 1) frames ago
+                this->_current_buffer = (this->_current_buffer + 1) % this->_number_of_buffers;
+                auto& _blocks = this->_overflows[this->_current_buffer];
+                for (auto _block : _blocks) free(_block);
+                _blocks.clear();
+
+                this->_offset.store(0, std::memory_order_relaxed);
+                this->_frame_overflow.store(0, std::memory_order_relaxed);
+                this->_frame_index.store(pFrameIndex, std::memory_order_relaxed);
+            }
+
+            size_t                                  _capacity;
+            uint32_t                                _number_of_buffers;
+            uint32_t                                _current_buffer;
+            std::atomic<size_t>                     _thread_id;
+            //memory category of the thread which created the arena
+            w_memory_category                       _category;
+            bool                                    _is_overflow_logged;
+            std::vector<uint8_t*>                   _buffers;
+            //heap blocks which were allocated because of full buffer, per buffer
+            std::vector<std::vector<uint8_t*>>      _overflows;
+
+            //only the owner thread writes these, other threads read them for statistics
+            std::atomic<uint64_t>                   _frame_index;
+            std::atomic<size_t>                     _offset;
+            std::atomic<size_t>                     _frame_overflow;
+            std::atomic<size_t>                     _last_frame_used;
+            std::atomic<size_t>                     _high_water_mark;
+            std::atomic<size_t>                     _total_overflows;
+        };
+    }
+}
+
+using namespace wolf::system;
+
+w_frame_arena::w_frame_arena(_In_ const size_t& pSizeInBytes, _In_ const uint32_t& pNumberOfBuffers) :
+    _pimp(new w_frame_arena_pimp(pSizeInBytes, pNumberOfBuffers))
+{
+}
+
+w_frame_arena::~w_frame_arena()
+{
+    delete this->_pimp;
+    this->_pimp = nullptr;
+}
+
+void* w_frame_arena::allocate(_In_ const size_t& pSizeInBytes, _In_ const size_t& pAlignment)
+{
+    if (!this->_pimp) return nullptr;
+    return this->_pimp->allocate(pSizeInBytes, pAlignment);
+}
+
+void w_frame_arena::reset()
+{
+    if (!this->_pimp) return;
+    this->_pimp->reset();
+}
+
+void w_frame_arena::begin_frame()
+{
+    auto& _registry = get_registry();
+    auto _frame = _registry.frame_index.load(std::memory_order_relaxed);
+
+    //record total bytes of the frame which is finishing
+    size_t _total = 0;
+    {
+        std::lock_guard<std::mutex> _lock(_registry.mutex);
+        for (auto _arena : _registry.arenas)
+        {
+            if (_arena->get_frame_index() == _frame)
+            {
+                _total += _arena->get_frame_used();
+            }
+        }
+    }
+    if (_total > _registry.frame_high_water_mark.load(std::memory_order_relaxed))
+    {
+        _registry.frame_high_water_mark.store(_total, std::memory_order_relaxed);
+    }
+
+    _registry.frame_index.fetch_add(1, std::memory_order_release);
+}
+
+w_frame_arena& w_frame_arena::get_thread_arena()
+{
+    static thread_local std::unique_ptr<w_frame_arena> _thread_arena;
+    if (!_thread_arena)
+    {
+        auto& _registry = get_registry();
+        _thread_arena.reset(new w_frame_arena(
+            _registry.thread_arena_size.load(std::memory_order_relaxed),
+            _registry.thread_arena_buffers.load(std::memory_order_relaxed)));
+        _thread_arena->_pimp->set_thread_id(static_cast<size_t>(w_thread::get_current_thread_id()));
+    }
+    return *_thread_arena;
+}
+
+#pragma region Getters
+
+w_frame_arena_stats w_frame_arena::get_stats() const
+{
+    if (!this->_pimp) return w_frame_arena_stats();
+    return this->_pimp->get_stats();
+}
+
+uint64_t w_frame_arena::get_frame_index()
+{
+    return get_registry().frame_index.load(std::memory_order_acquire);
+}
+
+std::vector<w_frame_arena_stats> w_frame_arena::get_all_stats()
+{
+    auto& _registry = get_registry();
+    std::vector<w_frame_arena_stats> _stats;
+
+    std::lock_guard<std::mutex> _lock(_registry.mutex);
+    _stats.reserve(_registry.arenas.size());
+    for (auto _arena : _registry.arenas)
+    {
+        _stats.push_back(_arena->get_stats());
+    }
+    return _stats;
+}
+
+size_t w_frame_arena::get_frame_high_water_mark()
+{
+    return get_registry().frame_high_water_mark.load(std::memory_order_relaxed);
+}
+
+#pragma endregion
+
+#pragma region Setters
+
+void w_frame_arena::set_thread_arena_config(_In_ const size_t& pSizeInBytes, _In_ const uint32_t& pNumberOfBuffers)
+{
+    auto& _registry = get_registry();
+    _registry.thread_arena_size.store(pSizeInBytes, std::memory_order_relaxed);
+    _registry.thread_arena_buffers.store(pNumberOfBuffers, std::memory_order_relaxed);
+}
+
+#pragma endregion
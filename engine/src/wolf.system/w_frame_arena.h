@@ -0,0 +1,178 @@
+/*
+	Project			 : Wolf Engine. Copyright(c) Pooya Eimandar (http://PooyaEimandar.com) . All rights reserved.
+	Source			 : Please direct any bug to https://github.com/PooyaEimandar/Wolf.Engine/issues
+	Website			 : http://WolfSource.io
+	Name			 : w_frame_arena.h
+	Description		 : A cross platform multi buffered bump allocator for per frame scratch memory
+	Comment          : memory allocated in frame N stays valid till frame N + number of buffers - 1.
+	                   w_frame_arena::begin_frame must be called once per frame, w_game::run does it
+*/
+
+#if _MSC_VER > 1000
+#pragma once
+#endif
+
+#ifndef __W_FRAME_ARENA_H__
+#define __W_FRAME_ARENA_H__
+
+#include "w_system_export.h"
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+#if defined(__ANDROID) || defined(__linux) || defined(__APPLE__)
+#include "w_std.h"
+#endif
+
+//default size of each buffer of frame arena in bytes
+#ifndef W_FRAME_ARENA_DEFAULT_SIZE
+#define W_FRAME_ARENA_DEFAULT_SIZE 1024 * 1024
+#endif
+
+//default number of buffers of frame arena, 2 for double buffering and 3 for triple buffering
+#ifndef W_FRAME_ARENA_DEFAULT_BUFFERS
+#define W_FRAME_ARENA_DEFAULT_BUFFERS 2
+#endif
+
+namespace wolf
+{
+	namespace system
+	{
+        struct w_frame_arena_stats
+        {
+            //id of thread which owns the arena, zero for arenas which are not thread local
+            size_t          thread_id = 0;
+            //global frame index which the current buffer belongs to
+            uint64_t        frame_index = 0;
+            //size of each buffer in bytes
+            size_t          capacity = 0;
+            size_t          number_of_buffers = 0;
+            //bytes which were allocated in current frame, including overflows
+            size_t          frame_used = 0;
+            //bytes which were allocated in previous frame of this arena
+            size_t          last_frame_used = 0;
+            //maximum bytes which were allocated in one frame
+            size_t          high_water_mark = 0;
+            //bytes of current frame which did not fit in the buffer and were allocated from heap
+            size_t          frame_overflow = 0;
+            //number of heap allocations because of full buffer since creation of arena
+            size_t          total_overflows = 0;
+        };
+
+        class w_frame_arena_pimp;
+        class w_frame_arena
+        {
+        public:
+            /*
+                @param pSizeInBytes, size of each buffer in bytes
+                @param pNumberOfBuffers, number of buffers, use 2 for double buffering and 3 for triple buffering
+            */
+            WSYS_EXP w_frame_arena(
+                _In_ const size_t& pSizeInBytes = W_FRAME_ARENA_DEFAULT_SIZE,
+                _In_ const uint32_t& pNumberOfBuffers = W_FRAME_ARENA_DEFAULT_BUFFERS);
+            WSYS_EXP ~w_frame_arena();
+
+            /*
+                allocate memory from the buffer of current frame, the memory must not be freed and
+                it will be reused once this arena returns to the same buffer. If the buffer is full
+                memory will be allocated from heap and released at the same time, or by reset
+            */
+            WSYS_EXP void* allocate(_In_ const size_t& pSizeInBytes, _In_ const size_t& pAlignment = alignof(std::max_align_t));
+
+            template<typename T>
+            T* allocate_array(_In_ const size_t& pCount)
+            {
+                return static_cast<T*>(allocate(pCount * sizeof(T), alignof(T)));
+            }
+
+            /*
+                release heap blocks of overflows and reuse all buffers from the start, all memory which was allocated
+                from this arena becomes invalid. Only the thread which allocates from this arena may call it.
+                Use it for arenas which outlive the frame loop, e.g. tools or jobs which run without begin_frame
+            */
+            WSYS_EXP void reset();
+
+            /*
+                start a new frame for all arenas, each arena switches to its next buffer on its next allocation.
+                Call it once per frame, without it buffers are never reused and heap blocks of overflows are kept
+                till reset or destruction of arena
+            */
+            WSYS_EXP static void begin_frame();
+
+            //get frame arena of calling thread, it will be created with default configuration on the first call
+            WSYS_EXP static w_frame_arena& get_thread_arena();
+
+#pragma region Getters
+            WSYS_EXP w_frame_arena_stats get_stats() const;
+            //get global frame index
+            WSYS_EXP static uint64_t get_frame_index();
+            //get statistics of all arenas which are alive
+            WSYS_EXP static std::vector<w_frame_arena_stats> get_all_stats();
+            //get maximum bytes which were allocated by all arenas in one frame
+            WSYS_EXP static size_t get_frame_high_water_mark();
+#pragma endregion
+
+#pragma region Setters
+            //set size and number of buffers for thread arenas which will be created after this call
+            WSYS_EXP static void set_thread_arena_config(_In_ const size_t& pSizeInBytes, _In_ const uint32_t& pNumberOfBuffers);
+#pragma endregion
+
+        private:
+            //Prevent copying
+            w_frame_arena(w_frame_arena const&);
+            w_frame_arena& operator= (w_frame_arena const&);
+
+            w_frame_arena_pimp*                     _pimp;
+        };
+
+        //STL allocator which allocates from frame arena of the calling thread, deallocation is a no-op
+        template<typename T>
+        class w_frame_allocator
+        {
+        public:
+            typedef T value_type;
+
+            w_frame_allocator() noexcept
+            {
+            }
+
+            template<typename U>
+            w_frame_allocator(_In_ const w_frame_allocator<U>&) noexcept
+            {
+            }
+
+            T* allocate(_In_ size_t pCount)
+            {
+                auto _ptr = w_frame_arena::get_thread_arena().allocate_array<T>(pCount);
+                if (!_ptr) throw std::bad_alloc();
+                return _ptr;
+            }
+
+            void deallocate(_In_ T* pPtr, _In_ size_t pCount) noexcept
+            {
+                //memory will be reused once the arena returns to the same buffer
+                (void)pPtr;
+                (void)pCount;
+            }
+
+            template<typename U>
+            bool operator==(_In_ const w_frame_allocator<U>&) const noexcept
+            {
+                return true;
+            }
+
+            template<typename U>
+            bool operator!=(_In_ const w_frame_allocator<U>&) const noexcept
+            {
+                return false;
+            }
+        };
+
+        //a vector for temporary data of one frame, reserve it up front because old storage is not reused while growing
+        template<typename T>
+        using w_frame_vector = std::vector<T, w_frame_allocator<T>>;
+	}
+}
+
+#endif //__W_FRAME_ARENA_H__
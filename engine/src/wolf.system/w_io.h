@@ -29,9 +29,8 @@
 
 #include  "w_std.h"
 
-#if defined(__linux) || defined(__APPLE__)
-#include <unistd.h>//for getcwd
-#endif
+#include <unistd.h>//for getcwd and pread
+#include <fcntl.h>
 
 #endif //__WIN32
 
@@ -245,10 +244,12 @@ namespace wolf
                 -1 means the file could not be found,
                 -2 means file is exist but could not open
                 -3 means file is to big to handle
+                pData will be empty on failure
 			*/
 			inline void read_binary_fileW(_In_z_ const wchar_t* pPath, _Inout_ std::vector<uint8_t>& pData,
 				_Out_ int& pFileState)
 			{
+				pData.clear();
 				if (get_is_fileW(pPath) == W_FAILED)
 				{
 					pFileState = -1;
@@ -291,26 +292,25 @@ namespace wolf
 					return;// E_FAIL;
 				}
 
-				// Read the data in.
+				// Read the data in, directly into the destination
 				DWORD _bytesRead = 0;
 
-				auto _file_data = static_cast<uint8_t*>(malloc(_file_size.LowPart * sizeof(uint8_t)));
-				if (!ReadFile(_hFile.get(), _file_data, _file_size.LowPart, &_bytesRead, nullptr))
+				pData.resize(_file_size.LowPart);
+				if (!ReadFile(_hFile.get(), pData.data(), _file_size.LowPart, &_bytesRead, nullptr))
 				{
+					pData.clear();
 					pFileState = -2;
 					return;// HRESULT_FROM_WIN32(GetLastError());
 				}
 
 				if (_bytesRead < _file_size.LowPart)
 				{
+					pData.clear();
 					pFileState = -2;
 					return;// E_FAIL;
 				}
 
-				// Create enough space for the file data.
-				pData.reserve(_file_size.LowPart);
-				std::copy(&_file_data[0], &_file_data[_file_size.LowPart], std::back_inserter(pData));
-				free(_file_data);
+				pFileState = 1;
 			}
 
             //Write text file
@@ -723,48 +723,69 @@ namespace wolf
 #endif
 
 			/*
-				Read binary file and return array of uint8_t
+				Read binary file and return array of uint8_t, the whole file is read with bulk reads
 				fileState indicates to state of file
 				1 means everything is ok
 				-1 means the file could not be found,
-				-2 means file is exist but could not open
+				-2 means file is exist but could not open or read
+				pData will be empty on failure
 			*/
 			inline void read_binary_file(_In_z_ const char* pPath, _Inout_ std::vector<uint8_t>& pData,
 				_Out_ int& pFileState)
 			{
 				pFileState = 1;
-				std::ifstream _file(pPath, std::ios::binary);
-				if (!_file)
+				pData.clear();
+#if defined(__linux) || defined(__APPLE__) || defined(__ANDROID)
+				auto _fd = open(pPath, O_RDONLY | O_CLOEXEC);
+				if (_fd == -1)
 				{
-					pFileState = -1;
+					pFileState = errno == ENOENT ? -1 : -2;
 					return;
 				}
 
-				if (_file.fail())
+				struct stat _stat;
+				if (fstat(_fd, &_stat) != 0)
 				{
+					close(_fd);
 					pFileState = -2;
 					return;
 				}
 
-				// Stop eating new lines in binary mode!!!
-				_file.unsetf(std::ios::skipws);
+				pData.resize(static_cast<size_t>(_stat.st_size));
 
-				// get its size:
-				//std::streampos _file_size;
-				size_t _data_size = 0;
-
-				_file.seekg(0, std::ios::end);
-				_data_size = static_cast<size_t>(_file.tellg());
-				_file.seekg(0, std::ios::beg);
+				size_t _read = 0;
+				while (_read < pData.size())
+				{
+					auto _size = pread(_fd, pData.data() + _read, pData.size() - _read, static_cast<off_t>(_read));
+					if (_size < 0 && errno == EINTR) continue;
+					if (_size <= 0) break;
+					_read += static_cast<size_t>(_size);
+				}
+				close(_fd);
 
-				// reserve capacity
-				pData.reserve(_data_size);
+				if (_read != pData.size())
+				{
+					pData.clear();
+					pFileState = -2;
+				}
+#else
+				std::ifstream _file(pPath, std::ios::binary | std::ios::ate);
+				if (!_file)
+				{
+					pFileState = -1;
+					return;
+				}
 
-				// read the data:
-				std::copy(std::istream_iterator<uint8_t>(_file),
-					std::istream_iterator<uint8_t>(),
-					std::back_inserter(pData));
+				auto _data_size = static_cast<size_t>(_file.tellg());
+				_file.seekg(0, std::ios::beg);
 
+				pData.resize(_data_size);
+				if (_data_size && !_file.read(reinterpret_cast<char*>(pData.data()), static_cast<std::streamsize>(_data_size)))
+				{
+					pData.clear();
+					pFileState = -2;
+				}
+#endif
 			}
 
 			
@@ -0,0 +1,79 @@
+#include "w_system_pch.h"
+#include "w_job_counter.h"
+
+using namespace wolf::system;
+
+w_job_counter::w_job_counter() : _value(0)
+{
+}
+
+w_job_counter::~w_job_counter()
+{
+    //wait also makes sure the last decrementer released the mutex
+    wait();
+}
+
+void w_job_counter::wait()
+{
+    //always check under the lock, because the last job may still be inside _decrement
+    std::unique_lock<std::mutex> _lock(this->_mutex);
+    this->_condition_var.wait(_lock, [this]()
+    {
+        return this->_value.load(std::memory_order_acquire) == 0;
+    });
+}
+
+bool w_job_counter::_wait_for(_In_ const std::chrono::microseconds& pTimeOut)
+{
+    std::unique_lock<std::mutex> _lock(this->_mutex);
+    return this->_condition_var.wait_for(_lock, pTimeOut, [this]()
+    {
+        return this->_value.load(std::memory_order_acquire) == 0;
+    });
+}
+
+uint32_t w_job_counter::get_value() const
+{
+    return this->_value.load(std::memory_order_acquire);
+}
+
+bool w_job_counter::get_is_done() const
+{
+    return get_value() == 0;
+}
+
+void w_job_counter::_increment()
+{
+    this->_value.fetch_add(1, std::memory_order_relaxed);
+}
+
+void w_job_counter::_decrement()
+{
+    //lock free path, while this is not the last job
+    auto _value = this->_value.load(std::memory_order_relaxed);
+    while (_value > 1)
+    {
+        if (this->_value.compare_exchange_weak(
+            _value,
+            _value - 1,
+            std::memory_order_acq_rel,
+            std::memory_order_relaxed))
+        {
+            return;
+        }
+    }
+
+    //probably the last job, reaching zero must be done under the lock, so waiters can not destroy this counter meanwhile
+    std::vector<std::function<void()>> _continuations;
+    {
+        std::lock_guard<std::mutex> _lock(this->_mutex);
+        if (this->_value.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+
+        _continuations.swap(this->_continuations);
+        this->_condition_var.notify_all();
+    }
+    for (auto& _continuation : _continuations)
+    {
+        _continuation();
+    }
+}
@@ -0,0 +1,81 @@
+/*
+	Project			 : Wolf Engine. Copyright(c) Pooya Eimandar (http://PooyaEimandar.com) . All rights reserved.
+	Source			 : Please direct any bug to https://github.com/PooyaEimandar/Wolf.Engine/issues
+	Website			 : http://WolfSource.io
+	Name			 : w_job_counter.h
+	Description		 : A counter which can be used as a fence for a group of jobs
+	Comment          : jobs submitted with a counter increment it and decrement it once they are done
+*/
+
+#if _MSC_VER > 1000
+#pragma once
+#endif
+
+#ifndef __W_JOB_COUNTER_H__
+#define __W_JOB_COUNTER_H__
+
+#include "w_system_export.h"
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <functional>
+#include <vector>
+
+#if defined(__ANDROID) || defined(__linux) || defined(__APPLE__)
+#include "w_std.h"
+#endif
+
+namespace wolf
+{
+	namespace system
+	{
+        class w_thread_pimp;
+        class w_thread_pool_pimp;
+        class w_fiber_scheduler_pimp;
+
+        /*
+            a counter which will be incremented on submitting and decremented on finishing of each job.
+            Use w_thread_pool::wait(counter) for waiting on pool jobs, so the calling thread executes pending
+            jobs instead of sleeping. w_job_counter::wait only blocks the calling thread
+        */
+        class w_job_counter
+        {
+        public:
+            WSYS_EXP w_job_counter();
+            WSYS_EXP ~w_job_counter();
+
+            //block the calling thread till all jobs related to this counter are done
+            WSYS_EXP void wait();
+
+#pragma region Getters
+            //get number of jobs which are not finished yet
+            WSYS_EXP uint32_t get_value() const;
+            //returns true if all jobs related to this counter are done
+            WSYS_EXP bool get_is_done() const;
+#pragma endregion
+
+        private:
+            friend class w_thread_pimp;
+            friend class w_thread_pool_pimp;
+            friend class w_fiber_scheduler_pimp;
+
+            //Prevent copying
+            w_job_counter(w_job_counter const&);
+            w_job_counter& operator= (w_job_counter const&);
+
+            void _increment();
+            void _decrement();
+            //block the calling thread till counter reached zero or timeout, returns true if counter is zero
+            bool _wait_for(_In_ const std::chrono::microseconds& pTimeOut);
+
+            std::atomic<uint32_t>                   _value;
+            std::mutex                              _mutex;
+            std::condition_variable                 _condition_var;
+            //jobs which must be submitted once this counter reached zero
+            std::vector<std::function<void()>>      _continuations;
+        };
+	}
+}
+
+#endif //__W_JOB_COUNTER_H__
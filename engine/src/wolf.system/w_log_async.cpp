@@ -0,0 +1,653 @@
+#include "w_system_pch.h"
+#include "w_logger.h"
+#include "w_log_binary.h"
+#include "w_ring_buffer.h"
+#include "w_memory_tracker.h"
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <chrono>
+#include <limits>
+#include <vector>
+
+namespace wolf
+{
+    namespace system
+    {
+        using namespace log_async;
+
+        //ring buffer of one thread, the owner thread is the producer and the writer thread is the consumer
+        struct w_log_thread_ring
+        {
+            w_ring_buffer                               buffer;
+            //serializes consumers, the producer takes it only for dropping oldest records
+            std::mutex                                  consumer_mutex;
+            //owner thread exited, the ring will be removed once it is empty
+            std::atomic<bool>                           is_orphan;
+
+            w_log_thread_ring() :
+                is_orphan(false)
+            {
+            }
+        };
+
+        //generation of backend, so a thread creates a new ring after re-initialization
+        static std::atomic<uint64_t> s_generation(0);
+
+        struct w_log_thread_state
+        {
+            uint64_t                                    generation = 0;
+            std::shared_ptr<w_log_thread_ring>          ring;
+
+            ~w_log_thread_state()
+            {
+                if (this->ring) this->ring->is_orphan.store(true, std::memory_order_release);
+            }
+        };
+        static thread_local w_log_thread_state s_thread_state;
+
+        //decode arguments of a record to values of fmt, returns packed types of arguments
+        static uint64_t s_decode_args(_In_ const w_log_record_header* pHeader, _Inout_ fmt::internal::Value* pValues)
+        {
+            typedef fmt::internal::Arg _arg_type;
+
+            auto _char_size = (pHeader->flags & W_LOG_RECORD_WIDE) ? sizeof(wchar_t) : sizeof(char);
+            auto _ptr = reinterpret_cast<const uint8_t*>(pHeader) + sizeof(w_log_record_header) + pad(pHeader->format_size + _char_size);
+
+            uint64_t _types = 0;
+            for (uint32_t i = 0; i < pHeader->number_of_args && i < W_LOG_ASYNC_MAX_ARGS; ++i)
+            {
+                auto _arg = reinterpret_cast<const w_log_record_arg*>(_ptr);
+                auto _data = _ptr + sizeof(w_log_record_arg);
+                auto& _value = pValues[i];
+
+                _arg_type::Type _type;
+                switch (_arg->type)
+                {
+                default:
+                case W_LOG_ARG_INT:
+                    _type = _arg_type::LONG_LONG;
+                    _value.long_long_value = _arg->int_value;
+                    break;
+                case W_LOG_ARG_UINT:
+                    _type = _arg_type::ULONG_LONG;
+                    _value.ulong_long_value = _arg->uint_value;
+                    break;
+                case W_LOG_ARG_DOUBLE:
+                    _type = _arg_type::DOUBLE;
+                    _value.double_value = _arg->double_value;
+                    break;
+                case W_LOG_ARG_BOOL:
+                    _type = _arg_type::BOOL;
+                    _value.int_value = static_cast<int>(_arg->int_value);
+                    break;
+                case W_LOG_ARG_CHAR:
+                    _type = _arg_type::CHAR;
+                    _value.int_value = static_cast<int>(_arg->int_value);
+                    break;
+                case W_LOG_ARG_POINTER:
+                    _type = _arg_type::POINTER;
+                    _value.pointer = _arg->pointer;
+                    break;
+                case W_LOG_ARG_STRING:
+                    _type = _arg_type::STRING;
+                    _value.string.value = reinterpret_cast<const char*>(_data);
+                    _value.string.size = _arg->size;
+                    break;
+                case W_LOG_ARG_WSTRING:
+                    _type = _arg_type::WSTRING;
+                    _value.wstring.value = reinterpret_cast<const wchar_t*>(_data);
+                    _value.wstring.size = _arg->size / sizeof(wchar_t);
+                    break;
+                }
+                _types |= static_cast<uint64_t>(_type) << (i * 4);
+                _ptr = _data + pad(_arg->size);
+            }
+            return _types;
+        }
+
+        class w_log_async_pimp
+        {
+        public:
+            w_log_async_pimp() :
+                _name("w_log_async"),
+                _is_text_enabled(false),
+                _generation(0),
+                _buffer_size(0),
+                _max_record_size(0),
+                _overflow_policy(W_LOG_OVERFLOW_BLOCK),
+                _flush_interval(10),
+                _is_running(false),
+                _is_stopping(false),
+                _is_writer_waiting(false),
+                _flush_requested(0),
+                _flush_done(0),
+                _blocked_producers(0),
+                _pending_records(0),
+                _reported_drops(0),
+                _written(0),
+                _dropped_oldest(0),
+                _dropped_newest(0),
+                _blocked(0),
+                _synchronous(0)
+            {
+            }
+
+            ~w_log_async_pimp()
+            {
+                release();
+            }
+
+            W_RESULT initialize(
+                _In_ const std::shared_ptr<w_spdlog_logger>& pLogger,
+                _In_ const std::shared_ptr<w_log_binary>& pBinary,
+                _In_ const size_t& pBufferSizeInBytes,
+                _In_ const w_log_overflow_policy& pOverflowPolicy,
+                _In_ const uint32_t& pFlushIntervalInMilliseconds)
+            {
+                if (!pLogger) return W_FAILED;
+
+                release();
+
+                this->_logger = pLogger;
+                this->_binary = pBinary;
+                //the logger may only have the binary log
+                this->_is_text_enabled = !pLogger->sinks().empty();
+                this->_generation = s_generation.fetch_add(1, std::memory_order_relaxed) + 1;
+                this->_buffer_size = pBufferSizeInBytes < 4096 ? 4096 : pBufferSizeInBytes;
+                //a quarter of ring buffer, so a record always fits once older records were consumed
+                this->_max_record_size = this->_buffer_size / 4;
+                this->_overflow_policy = pOverflowPolicy;
+                this->_flush_interval = std::chrono::milliseconds(pFlushIntervalInMilliseconds ? pFlushIntervalInMilliseconds : 1);
+                this->_is_stopping = false;
+
+                this->_writer = std::thread(&w_log_async_pimp::_run, this);
+                this->_writer_id = this->_writer.get_id();
+                this->_is_running.store(true, std::memory_order_release);
+
+                return W_PASSED;
+            }
+
+            uint8_t* reserve(_In_ const size_t& pSizeInBytes, _Out_ bool& pIsDropped)
+            {
+                //release waits till reserved records are committed, so they are drained instead of being lost
+                this->_pending_records.fetch_add(1);
+                auto _ptr = _reserve(pSizeInBytes, pIsDropped);
+                if (!_ptr)
+                {
+                    this->_pending_records.fetch_sub(1);
+                }
+                return _ptr;
+            }
+
+            void commit(_In_ const size_t& pSizeInBytes)
+            {
+                s_thread_state.ring->buffer.commit(pSizeInBytes);
+                this->_pending_records.fetch_sub(1);
+                if (this->_is_writer_waiting.load(std::memory_order_relaxed))
+                {
+                    _wake_writer();
+                }
+            }
+
+            void flush()
+            {
+                if (!this->_is_running.load(std::memory_order_acquire) || std::this_thread::get_id() == this->_writer_id)
+                {
+                    if (this->_logger) this->_logger->flush();
+                    if (this->_binary) this->_binary->flush();
+                    return;
+                }
+
+                std::unique_lock<std::mutex> _lock(this->_mutex);
+                auto _request = ++this->_flush_requested;
+                this->_cv.notify_one();
+                this->_flush_cv.wait(_lock, [&]()
+                {
+                    return this->_flush_done >= _request || this->_is_stopping;
+                });
+            }
+
+            ULONG release()
+            {
+                if (!this->_writer.joinable()) return 1;
+
+                //new records will be written synchronously by the callers
+                this->_is_running.store(false);
+                {
+                    //wake producers which are blocked on a full ring
+                    std::lock_guard<std::mutex> _lock(this->_space_mutex);
+                    this->_space_cv.notify_all();
+                }
+                //records which were reserved before stopping are committed soon, the final drain of writer writes them
+                while (this->_pending_records.load())
+                {
+                    std::this_thread::yield();
+                }
+                {
+                    std::lock_guard<std::mutex> _lock(this->_mutex);
+                    this->_is_stopping = true;
+                }
+                this->_cv.notify_one();
+                this->_flush_cv.notify_all();
+                this->_writer.join();
+
+                if (this->_logger) this->_logger->flush();
+                if (this->_binary) this->_binary->flush();
+                {
+                    std::lock_guard<std::mutex> _lock(this->_rings_mutex);
+                    this->_rings.clear();
+                }
+                this->_logger.reset();
+                this->_binary.reset();
+
+                return 0;
+            }
+
+#pragma region Getters
+            bool get_is_running() const
+            {
+                return this->_is_running.load(std::memory_order_acquire);
+            }
+
+            w_log_async_stats get_stats() const
+            {
+                w_log_async_stats _stats;
+                _stats.written = this->_written.load(std::memory_order_relaxed);
+                _stats.dropped_oldest = this->_dropped_oldest.load(std::memory_order_relaxed);
+                _stats.dropped_newest = this->_dropped_newest.load(std::memory_order_relaxed);
+                _stats.blocked = this->_blocked.load(std::memory_order_relaxed);
+                _stats.synchronous = this->_synchronous.load(std::memory_order_relaxed);
+                return _stats;
+            }
+#pragma endregion
+
+        private:
+            uint8_t* _reserve(_In_ const size_t& pSizeInBytes, _Out_ bool& pIsDropped)
+            {
+                pIsDropped = false;
+
+                if (!this->_is_running.load()) return nullptr;
+                //the writer thread must not wait for itself
+                if (std::this_thread::get_id() == this->_writer_id) return nullptr;
+                if (pSizeInBytes > this->_max_record_size)
+                {
+                    this->_synchronous.fetch_add(1, std::memory_order_relaxed);
+                    return nullptr;
+                }
+
+                auto _ring = _get_thread_ring();
+                if (!_ring) return nullptr;
+
+                auto _ptr = _ring->buffer.reserve_write(pSizeInBytes);
+                if (_ptr) return _ptr;
+
+                switch (this->_overflow_policy)
+                {
+                case W_LOG_OVERFLOW_DROP_NEWEST:
+                    this->_dropped_newest.fetch_add(1, std::memory_order_relaxed);
+                    pIsDropped = true;
+                    return nullptr;
+                case W_LOG_OVERFLOW_DROP_OLDEST:
+                {
+                    //act as consumer and discard records from the head of ring
+                    std::lock_guard<std::mutex> _lock(_ring->consumer_mutex);
+                    while (!(_ptr = _ring->buffer.reserve_write(pSizeInBytes)))
+                    {
+                        size_t _available = 0;
+                        auto _head = _ring->buffer.peek_read(_available);
+                        if (!_head) break;
+
+                        _ring->buffer.release(reinterpret_cast<const w_log_record_header*>(_head)->size);
+                        this->_dropped_oldest.fetch_add(1, std::memory_order_relaxed);
+                    }
+                    return _ptr;
+                }
+                default:
+                case W_LOG_OVERFLOW_BLOCK:
+                {
+                    //sleep till writer releases space of a ring, space is checked under the mutex, so no wake up is lost
+                    this->_blocked.fetch_add(1, std::memory_order_relaxed);
+                    std::unique_lock<std::mutex> _lock(this->_space_mutex);
+                    this->_blocked_producers.fetch_add(1);
+                    while (!(_ptr = _ring->buffer.reserve_write(pSizeInBytes)) && this->_is_running.load())
+                    {
+                        _wake_writer();
+                        this->_space_cv.wait(_lock);
+                    }
+                    this->_blocked_producers.fetch_sub(1);
+                    return _ptr;
+                }
+                }
+            }
+
+            w_log_thread_ring* _get_thread_ring()
+            {
+                auto& _state = s_thread_state;
+                if (_state.ring && _state.generation == this->_generation) return _state.ring.get();
+
+                //the ring of previous backend will be removed by its writer
+                if (_state.ring) _state.ring->is_orphan.store(true, std::memory_order_release);
+                _state.ring.reset();
+
+                auto _ring = std::make_shared<w_log_thread_ring>();
+                {
+                    w_memory_tag_scope _memory_tag(W_MEMORY_CATEGORY_LOGGER);
+                    if (_ring->buffer.initialize(this->_buffer_size) == W_FAILED) return nullptr;
+                }
+                {
+                    std::lock_guard<std::mutex> _lock(this->_rings_mutex);
+                    this->_rings.push_back(_ring);
+                }
+
+                _state.ring = _ring;
+                _state.generation = this->_generation;
+                return _ring.get();
+            }
+
+            void _wake_writer()
+            {
+                this->_cv.notify_one();
+            }
+
+            void _run()
+            {
+                for (;;)
+                {
+                    uint64_t _flush_request;
+                    bool _is_stopping;
+                    {
+                        std::lock_guard<std::mutex> _lock(this->_mutex);
+                        _flush_request = this->_flush_requested;
+                        _is_stopping = this->_is_stopping;
+                    }
+
+                    //records which were committed before the flush request or stop are written here
+                    auto _count = _drain();
+                    _report_drops();
+
+                    if (_flush_request != this->_flush_done)
+                    {
+                        this->_logger->flush();
+                        if (this->_binary) this->_binary->flush();
+                        {
+                            std::lock_guard<std::mutex> _lock(this->_mutex);
+                            this->_flush_done = _flush_request;
+                        }
+                        this->_flush_cv.notify_all();
+                    }
+
+                    if (_is_stopping) break;
+                    if (_count) continue;
+
+                    std::unique_lock<std::mutex> _lock(this->_mutex);
+                    this->_is_writer_waiting.store(true, std::memory_order_relaxed);
+                    this->_cv.wait_for(_lock, this->_flush_interval, [&]()
+                    {
+                        return this->_is_stopping || this->_flush_requested != _flush_request;
+                    });
+                    this->_is_writer_waiting.store(false, std::memory_order_relaxed);
+                }
+            }
+
+            //write records of all rings in order of their time
+            size_t _drain()
+            {
+                {
+                    std::lock_guard<std::mutex> _lock(this->_rings_mutex);
+                    this->_snapshot = this->_rings;
+                }
+
+                size_t _count = 0;
+                for (;;)
+                {
+                    w_log_thread_ring* _oldest = nullptr;
+                    auto _oldest_time = std::numeric_limits<int64_t>::max();
+                    for (auto& _ring : this->_snapshot)
+                    {
+                        std::lock_guard<std::mutex> _lock(_ring->consumer_mutex);
+                        size_t _available = 0;
+                        auto _head = _ring->buffer.peek_read(_available);
+                        if (!_head) continue;
+
+                        auto _time = reinterpret_cast<const w_log_record_header*>(_head)->time;
+                        if (!_oldest || _time < _oldest_time)
+                        {
+                            _oldest = _ring.get();
+                            _oldest_time = _time;
+                        }
+                    }
+                    if (!_oldest) break;
+
+                    //copy the record out, so producers which drop oldest records never wait for I/O of sinks
+                    {
+                        std::lock_guard<std::mutex> _lock(_oldest->consumer_mutex);
+                        size_t _available = 0;
+                        auto _head = _oldest->buffer.peek_read(_available);
+                        if (!_head) continue;
+
+                        auto _size = reinterpret_cast<const w_log_record_header*>(_head)->size;
+                        this->_record.resize(pad(_size) / sizeof(uint64_t));
+                        std::memcpy(this->_record.data(), _head, _size);
+                        _oldest->buffer.release(_size);
+                    }
+                    if (this->_blocked_producers.load())
+                    {
+                        std::lock_guard<std::mutex> _lock(this->_space_mutex);
+                        this->_space_cv.notify_all();
+                    }
+
+                    _write_record(reinterpret_cast<const w_log_record_header*>(this->_record.data()));
+                    _count++;
+                }
+                this->_snapshot.clear();
+
+                //remove rings of threads which exited
+                std::lock_guard<std::mutex> _lock(this->_rings_mutex);
+                for (auto _iter = this->_rings.begin(); _iter != this->_rings.end();)
+                {
+                    if ((*_iter)->is_orphan.load(std::memory_order_acquire) && (*_iter)->buffer.get_is_empty())
+                    {
+                        _iter = this->_rings.erase(_iter);
+                    }
+                    else
+                    {
+                        ++_iter;
+                    }
+                }
+
+                return _count;
+            }
+
+            void _write_record(_In_ const w_log_record_header* pHeader)
+            {
+                if (this->_binary) this->_binary->write(pHeader);
+                if (this->_is_text_enabled)
+                {
+                    auto _level = format_record(pHeader, this->_text) == W_PASSED ?
+                        static_cast<spdlog::level::level_enum>(pHeader->level) : spdlog::level::err;
+                    this->_logger->write_record(
+                        _level,
+                        spdlog::log_clock::time_point(spdlog::log_clock::duration(pHeader->time)),
+                        static_cast<size_t>(pHeader->thread_id),
+                        this->_text.c_str(),
+                        this->_text.size());
+                }
+                this->_written.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            void _report_drops()
+            {
+                auto _dropped = this->_dropped_oldest.load(std::memory_order_relaxed) + this->_dropped_newest.load(std::memory_order_relaxed);
+                if (_dropped == this->_reported_drops) return;
+
+                auto _msg = std::to_string(_dropped - this->_reported_drops) + " log records were dropped because ring buffer of thread was full";
+                this->_reported_drops = _dropped;
+                if (this->_binary) this->_binary->write(spdlog::level::warn, _msg.c_str());
+                if (this->_is_text_enabled)
+                {
+                    this->_logger->write_record(spdlog::level::warn, spdlog::details::os::now(), spdlog::details::os::thread_id(), _msg.c_str(), _msg.size());
+                }
+            }
+
+            std::string                                         _name;
+            std::shared_ptr<w_spdlog_logger>                    _logger;
+            std::shared_ptr<w_log_binary>                       _binary;
+            bool                                                _is_text_enabled;
+            uint64_t                                            _generation;
+            size_t                                              _buffer_size;
+            size_t                                              _max_record_size;
+            w_log_overflow_policy                               _overflow_policy;
+            std::chrono::milliseconds                           _flush_interval;
+
+            std::thread                                         _writer;
+            std::thread::id                                     _writer_id;
+            std::atomic<bool>                                   _is_running;
+
+            //guards stopping and flush requests
+            std::mutex                                          _mutex;
+            std::condition_variable                             _cv;
+            std::condition_variable                             _flush_cv;
+            bool                                                _is_stopping;
+            std::atomic<bool>                                   _is_writer_waiting;
+            uint64_t                                            _flush_requested;
+            uint64_t                                            _flush_done;
+
+            std::mutex                                          _rings_mutex;
+            std::vector<std::shared_ptr<w_log_thread_ring>>     _rings;
+            //only used by writer thread
+            std::vector<std::shared_ptr<w_log_thread_ring>>     _snapshot;
+            //formatted text and copy of current record, only used by writer thread
+            std::string                                         _text;
+            std::vector<uint64_t>                               _record;
+
+            //producers of BLOCK policy wait on it till writer releases space of rings
+            std::mutex                                          _space_mutex;
+            std::condition_variable                             _space_cv;
+            std::atomic<uint32_t>                               _blocked_producers;
+            //records which were reserved and not committed yet
+            std::atomic<uint32_t>                               _pending_records;
+            uint64_t                                            _reported_drops;
+
+            std::atomic<uint64_t>                               _written;
+            std::atomic<uint64_t>                               _dropped_oldest;
+            std::atomic<uint64_t>                               _dropped_newest;
+            std::atomic<uint64_t>                               _blocked;
+            std::atomic<uint64_t>                               _synchronous;
+        };
+    }
+}
+
+using namespace wolf::system;
+
+w_log_async::w_log_async() :
+    _pimp(new w_log_async_pimp())
+{
+}
+
+w_log_async::~w_log_async()
+{
+    delete this->_pimp;
+    this->_pimp = nullptr;
+}
+
+W_RESULT w_log_async::initialize(
+    _In_ const std::shared_ptr<w_spdlog_logger>& pLogger,
+    _In_ const std::shared_ptr<w_log_binary>& pBinary,
+    _In_ const size_t& pBufferSizeInBytes,
+    _In_ const w_log_overflow_policy& pOverflowPolicy,
+    _In_ const uint32_t& pFlushIntervalInMilliseconds)
+{
+    if (!this->_pimp) return W_FAILED;
+    return this->_pimp->initialize(pLogger, pBinary, pBufferSizeInBytes, pOverflowPolicy, pFlushIntervalInMilliseconds);
+}
+
+void w_log_async::flush()
+{
+    if (!this->_pimp) return;
+    this->_pimp->flush();
+}
+
+ULONG w_log_async::release()
+{
+    if (!this->_pimp) return 1;
+    return this->_pimp->release();
+}
+
+uint8_t* w_log_async::_reserve(_In_ const size_t& pSizeInBytes, _Out_ bool& pIsDropped)
+{
+    pIsDropped = false;
+    if (!this->_pimp) return nullptr;
+    return this->_pimp->reserve(pSizeInBytes, pIsDropped);
+}
+
+void w_log_async::_commit(_In_ const size_t& pSizeInBytes)
+{
+    if (!this->_pimp) return;
+    this->_pimp->commit(pSizeInBytes);
+}
+
+#pragma region Getters
+
+bool w_log_async::get_is_running() const
+{
+    return this->_pimp && this->_pimp->get_is_running();
+}
+
+w_log_async_stats w_log_async::get_stats() const
+{
+    if (!this->_pimp) return w_log_async_stats();
+    return this->_pimp->get_stats();
+}
+
+#pragma endregion
+
+W_RESULT log_async::format_record(_In_ const w_log_record_header* pRecord, _Out_ std::string& pText)
+{
+    pText.clear();
+    if (!pRecord) return W_FAILED;
+
+    auto _is_wide = (pRecord->flags & W_LOG_RECORD_WIDE) != 0;
+    auto _text = reinterpret_cast<const uint8_t*>(pRecord) + sizeof(w_log_record_header);
+
+    try
+    {
+        if (pRecord->flags & W_LOG_RECORD_RAW)
+        {
+            if (_is_wide)
+            {
+                pText = wolf::system::convert::to_utf8(
+                    std::wstring(reinterpret_cast<const wchar_t*>(_text), pRecord->format_size / sizeof(wchar_t)));
+            }
+            else
+            {
+                pText.assign(reinterpret_cast<const char*>(_text), pRecord->format_size);
+            }
+            return W_PASSED;
+        }
+
+        fmt::internal::Value _values[fmt::ArgList::MAX_PACKED_ARGS];
+        auto _types = s_decode_args(pRecord, _values);
+        fmt::ArgList _args(_types, _values);
+
+        if (_is_wide)
+        {
+            fmt::WMemoryWriter _writer;
+            _writer.write(reinterpret_cast<const wchar_t*>(_text), _args);
+            pText = wolf::system::convert::to_utf8(_writer.str());
+        }
+        else
+        {
+            fmt::MemoryWriter _writer;
+            _writer.write(reinterpret_cast<const char*>(_text), _args);
+            pText.assign(_writer.data(), _writer.size());
+        }
+    }
+    catch (const std::exception& pException)
+    {
+        pText = std::string("could not format log record: ") + pException.what();
+        return W_FAILED;
+    }
+    return W_PASSED;
+}
@@ -0,0 +1,529 @@
+/*
+	Project			 : Wolf Engine. Copyright(c) Pooya Eimandar (http://PooyaEimandar.com) . All rights reserved.
+	Source			 : Please direct any bug to https://github.com/PooyaEimandar/Wolf.Engine/issues
+	Website			 : http://WolfSource.io
+	Name			 : w_log_async.h
+	Description		 : Asynchronous backend of w_logger, each thread writes serialized records to its own lock-free ring buffer
+	Comment          : records are formatted and written to the sinks by a background writer thread
+*/
+
+#if _MSC_VER > 1000
+#pragma once
+#endif
+
+#ifndef __W_LOG_ASYNC_H__
+#define __W_LOG_ASYNC_H__
+
+#include "w_system_export.h"
+#include "w_std.h"
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <memory>
+#include <type_traits>
+
+#ifndef SPDLOG_WCHAR_TO_UTF8_SUPPORT
+#define SPDLOG_WCHAR_TO_UTF8_SUPPORT
+#endif
+#ifndef SPDLOG_WCHAR_FILENAMES
+#define SPDLOG_WCHAR_FILENAMES
+#endif
+#include "spdlog/spdlog.h"
+
+//default size of ring buffer of each thread in bytes
+#ifndef W_LOG_ASYNC_DEFAULT_BUFFER_SIZE
+#define W_LOG_ASYNC_DEFAULT_BUFFER_SIZE 256 * 1024
+#endif
+
+//maximum number of arguments which can be formatted on the writer thread, calls with more arguments are formatted by the caller
+#ifndef W_LOG_ASYNC_MAX_ARGS
+#define W_LOG_ASYNC_MAX_ARGS 15
+#endif
+
+namespace wolf
+{
+	namespace system
+	{
+        //what a thread does when its ring buffer of log records is full
+        enum w_log_overflow_policy : uint8_t
+        {
+            //wait till the writer thread frees enough space, no record will be lost
+            W_LOG_OVERFLOW_BLOCK = 0,
+            //discard oldest records of the calling thread
+            W_LOG_OVERFLOW_DROP_OLDEST,
+            //discard the new record
+            W_LOG_OVERFLOW_DROP_NEWEST
+        };
+
+        struct w_log_async_stats
+        {
+            //records which were written to the sinks
+            uint64_t            written = 0;
+            //records which were discarded by W_LOG_OVERFLOW_DROP_OLDEST
+            uint64_t            dropped_oldest = 0;
+            //records which were discarded by W_LOG_OVERFLOW_DROP_NEWEST
+            uint64_t            dropped_newest = 0;
+            //records which had to wait for free space because of W_LOG_OVERFLOW_BLOCK
+            uint64_t            blocked = 0;
+            //records which were larger than the ring buffer and were written synchronously
+            uint64_t            synchronous = 0;
+        };
+
+        //spdlog logger which can write a record with time and thread of the original call
+        class w_spdlog_logger : public spdlog::logger
+        {
+        public:
+            template<class It>
+            w_spdlog_logger(_In_ const std::string& pName, _In_ const It& pBegin, _In_ const It& pEnd) :
+                spdlog::logger(pName, pBegin, pEnd)
+            {
+            }
+
+            void write_record(
+                _In_ const spdlog::level::level_enum& pLevel,
+                _In_ const spdlog::log_clock::time_point& pTime,
+                _In_ const size_t& pThreadID,
+                _In_ const char* pText,
+                _In_ const size_t& pSize)
+            {
+                if (!should_log(pLevel)) return;
+                try
+                {
+                    spdlog::details::log_msg _msg(&_name, pLevel);
+                    _msg.time = pTime;
+                    _msg.thread_id = pThreadID;
+                    _msg.raw << fmt::StringRef(pText, pSize);
+                    _sink_it(_msg);
+                }
+                SPDLOG_CATCH_AND_HANDLE
+            }
+        };
+
+        namespace log_async
+        {
+            enum w_log_arg_type : uint8_t
+            {
+                W_LOG_ARG_INT = 0,
+                W_LOG_ARG_UINT,
+                W_LOG_ARG_DOUBLE,
+                W_LOG_ARG_BOOL,
+                W_LOG_ARG_CHAR,
+                W_LOG_ARG_POINTER,
+                W_LOG_ARG_STRING,
+                W_LOG_ARG_WSTRING
+            };
+
+            enum w_log_record_flags : uint8_t
+            {
+                //format string and string arguments are wchar_t
+                W_LOG_RECORD_WIDE = 1 << 0,
+                //the record holds the final text and must not be formatted
+                W_LOG_RECORD_RAW = 1 << 1
+            };
+
+            /*
+                layout of a record:
+                [w_log_record_header][null terminated format string, padded to 8 bytes][w_log_record_arg][string data, padded to 8 bytes]...
+            */
+            struct w_log_record_header
+            {
+                //size of record in bytes, including header and padding
+                uint32_t        size;
+                //size of format string in bytes without null terminator
+                uint32_t        format_size;
+                uint8_t         level;
+                uint8_t         flags;
+                uint8_t         number_of_args;
+                uint8_t         reserved[5];
+                //ticks of spdlog::log_clock since epoch
+                int64_t         time;
+                uint64_t        thread_id;
+            };
+
+            struct w_log_record_arg
+            {
+                uint8_t         type;
+                uint8_t         reserved[3];
+                //size of string data in bytes which follows this argument
+                uint32_t        size;
+                union
+                {
+                    int64_t     int_value;
+                    uint64_t    uint_value;
+                    double      double_value;
+                    const void* pointer;
+                };
+            };
+
+            inline size_t pad(_In_ const size_t& pSize)
+            {
+                return (pSize + 7) & ~static_cast<size_t>(7);
+            }
+
+            //serialization of an argument, types which are not specialized are formatted by the caller
+            template<typename T, typename Enable = void>
+            struct w_log_arg_traits
+            {
+                static const bool is_deferred = false;
+            };
+
+            template<typename T>
+            struct w_log_arg_traits<T, typename std::enable_if<
+                std::is_integral<T>::value && std::is_signed<T>::value &&
+                !std::is_same<T, char>::value && !std::is_same<T, wchar_t>::value>::type>
+            {
+                static const bool is_deferred = true;
+                static size_t get_size(_In_ const T&) { return 0; }
+                static void write(_Inout_ w_log_record_arg* pArg, _Inout_ uint8_t*, _In_ const T& pValue)
+                {
+                    pArg->type = W_LOG_ARG_INT;
+                    pArg->int_value = static_cast<int64_t>(pValue);
+                }
+            };
+
+            template<typename T>
+            struct w_log_arg_traits<T, typename std::enable_if<
+                std::is_integral<T>::value && std::is_unsigned<T>::value && !std::is_same<T, bool>::value &&
+                !std::is_same<T, char>::value && !std::is_same<T, wchar_t>::value>::type>
+            {
+                static const bool is_deferred = true;
+                static size_t get_size(_In_ const T&) { return 0; }
+                static void write(_Inout_ w_log_record_arg* pArg, _Inout_ uint8_t*, _In_ const T& pValue)
+                {
+                    pArg->type = W_LOG_ARG_UINT;
+                    pArg->uint_value = static_cast<uint64_t>(pValue);
+                }
+            };
+
+            template<typename T>
+            struct w_log_arg_traits<T, typename std::enable_if<
+                std::is_same<T, float>::value || std::is_same<T, double>::value>::type>
+            {
+                static const bool is_deferred = true;
+                static size_t get_size(_In_ const T&) { return 0; }
+                static void write(_Inout_ w_log_record_arg* pArg, _Inout_ uint8_t*, _In_ const T& pValue)
+                {
+                    pArg->type = W_LOG_ARG_DOUBLE;
+                    pArg->double_value = static_cast<double>(pValue);
+                }
+            };
+
+            template<>
+            struct w_log_arg_traits<bool>
+            {
+                static const bool is_deferred = true;
+                static size_t get_size(_In_ const bool&) { return 0; }
+                static void write(_Inout_ w_log_record_arg* pArg, _Inout_ uint8_t*, _In_ const bool& pValue)
+                {
+                    pArg->type = W_LOG_ARG_BOOL;
+                    pArg->int_value = pValue ? 1 : 0;
+                }
+            };
+
+            template<typename T>
+            struct w_log_arg_traits<T, typename std::enable_if<
+                std::is_same<T, char>::value || std::is_same<T, wchar_t>::value>::type>
+            {
+                static const bool is_deferred = true;
+                static size_t get_size(_In_ const T&) { return 0; }
+                static void write(_Inout_ w_log_record_arg* pArg, _Inout_ uint8_t*, _In_ const T& pValue)
+                {
+                    pArg->type = W_LOG_ARG_CHAR;
+                    pArg->int_value = static_cast<int64_t>(pValue);
+                }
+            };
+
+            template<typename T>
+            struct w_log_arg_traits<T, typename std::enable_if<
+                std::is_same<T, void*>::value || std::is_same<T, const void*>::value>::type>
+            {
+                static const bool is_deferred = true;
+                static size_t get_size(_In_ const T&) { return 0; }
+                static void write(_Inout_ w_log_record_arg* pArg, _Inout_ uint8_t*, _In_ const T& pValue)
+                {
+                    pArg->type = W_LOG_ARG_POINTER;
+                    pArg->pointer = pValue;
+                }
+            };
+
+            //strings are copied to the record, so they may be destroyed right after the call
+            template<typename Char>
+            struct w_log_string_arg
+            {
+                static const bool is_deferred = true;
+                static size_t get_size(_In_ const Char*, _In_ const size_t& pLength)
+                {
+                    return pad(pLength * sizeof(Char));
+                }
+                static void write(
+                    _Inout_ w_log_record_arg* pArg,
+                    _Inout_ uint8_t* pData,
+                    _In_ const Char* pValue,
+                    _In_ const size_t& pLength)
+                {
+                    pArg->type = std::is_same<Char, wchar_t>::value ? W_LOG_ARG_WSTRING : W_LOG_ARG_STRING;
+                    pArg->size = static_cast<uint32_t>(pLength * sizeof(Char));
+                    if (pLength) std::memcpy(pData, pValue, pLength * sizeof(Char));
+                }
+                static size_t get_length(_In_ const Char* pValue)
+                {
+                    return pValue ? std::char_traits<Char>::length(pValue) : 0;
+                }
+            };
+
+            template<typename T>
+            struct w_log_arg_traits<T, typename std::enable_if<
+                std::is_same<typename std::decay<T>::type, const char*>::value ||
+                std::is_same<typename std::decay<T>::type, char*>::value ||
+                std::is_same<typename std::decay<T>::type, const wchar_t*>::value ||
+                std::is_same<typename std::decay<T>::type, wchar_t*>::value>::type>
+            {
+                typedef typename std::remove_const<typename std::remove_pointer<typename std::decay<T>::type>::type>::type char_type;
+                typedef w_log_string_arg<char_type> string_arg;
+
+                static const bool is_deferred = true;
+                static size_t get_size(_In_ const T& pValue)
+                {
+                    return string_arg::get_size(pValue, string_arg::get_length(pValue));
+                }
+                static void write(_Inout_ w_log_record_arg* pArg, _Inout_ uint8_t* pData, _In_ const T& pValue)
+                {
+                    string_arg::write(pArg, pData, pValue, string_arg::get_length(pValue));
+                }
+            };
+
+            template<typename Char>
+            struct w_log_arg_traits<std::basic_string<Char>, typename std::enable_if<
+                std::is_same<Char, char>::value || std::is_same<Char, wchar_t>::value>::type>
+            {
+                typedef w_log_string_arg<Char> string_arg;
+
+                static const bool is_deferred = true;
+                static size_t get_size(_In_ const std::basic_string<Char>& pValue)
+                {
+                    return string_arg::get_size(pValue.c_str(), pValue.size());
+                }
+                static void write(_Inout_ w_log_record_arg* pArg, _Inout_ uint8_t* pData, _In_ const std::basic_string<Char>& pValue)
+                {
+                    string_arg::write(pArg, pData, pValue.c_str(), pValue.size());
+                }
+            };
+
+            template<typename... w_args>
+            struct w_log_is_deferred;
+
+            template<>
+            struct w_log_is_deferred<>
+            {
+                static const bool value = true;
+            };
+
+            template<typename T, typename... w_args>
+            struct w_log_is_deferred<T, w_args...>
+            {
+                static const bool value = w_log_arg_traits<T>::is_deferred && w_log_is_deferred<w_args...>::value;
+            };
+
+            inline size_t get_args_size()
+            {
+                return 0;
+            }
+
+            template<typename T, typename... w_args>
+            inline size_t get_args_size(_In_ const T& pArg, _In_ const w_args&... pArgs)
+            {
+                return sizeof(w_log_record_arg) + w_log_arg_traits<T>::get_size(pArg) + get_args_size(pArgs...);
+            }
+
+            inline void write_args(_Inout_ uint8_t*)
+            {
+            }
+
+            template<typename T, typename... w_args>
+            inline void write_args(_Inout_ uint8_t* pPtr, _In_ const T& pArg, _In_ const w_args&... pArgs)
+            {
+                auto _arg = reinterpret_cast<w_log_record_arg*>(pPtr);
+                std::memset(_arg, 0, sizeof(w_log_record_arg));
+                auto _data = pPtr + sizeof(w_log_record_arg);
+                w_log_arg_traits<T>::write(_arg, _data, pArg);
+                write_args(_data + pad(_arg->size), pArgs...);
+            }
+
+            //write header and format string of a record, pFormatBlockSize includes null terminator and padding
+            inline w_log_record_header* write_header(
+                _Inout_ uint8_t* pPtr,
+                _In_ const size_t& pSize,
+                _In_ const spdlog::level::level_enum& pLevel,
+                _In_ const uint8_t& pFlags,
+                _In_ const void* pFormat,
+                _In_ const size_t& pFormatSize,
+                _In_ const size_t& pFormatBlockSize)
+            {
+                auto _header = reinterpret_cast<w_log_record_header*>(pPtr);
+                std::memset(_header, 0, sizeof(w_log_record_header));
+                //format string is null terminated
+                std::memset(pPtr + sizeof(w_log_record_header) + pFormatSize, 0, pFormatBlockSize - pFormatSize);
+                _header->size = static_cast<uint32_t>(pSize);
+                _header->format_size = static_cast<uint32_t>(pFormatSize);
+                _header->level = static_cast<uint8_t>(pLevel);
+                _header->flags = pFlags;
+                _header->time = static_cast<int64_t>(spdlog::details::os::now().time_since_epoch().count());
+                _header->thread_id = static_cast<uint64_t>(spdlog::details::os::thread_id());
+                if (pFormatSize) std::memcpy(pPtr + sizeof(w_log_record_header), pFormat, pFormatSize);
+                return _header;
+            }
+
+            /*
+                format a record to UTF-8 text
+                @param pRecord, the record
+                @param pText, formatted text or the error of formatting
+                @return W_FAILED if format string and arguments of record do not match
+            */
+            WSYS_EXP W_RESULT format_record(_In_ const w_log_record_header* pRecord, _Out_ std::string& pText);
+        }
+
+        class w_log_binary;
+        class w_log_async_pimp;
+        class w_log_async
+        {
+        public:
+            WSYS_EXP w_log_async();
+            WSYS_EXP ~w_log_async();
+
+            /*
+                start the writer thread
+                @param pLogger, logger which owns the sinks
+                @param pBinary, binary log which records are written to, may be nullptr
+                @param pBufferSizeInBytes, size of ring buffer of each thread which logs
+                @param pOverflowPolicy, what a thread does when its ring buffer is full
+                @param pFlushIntervalInMilliseconds, maximum time which the writer thread sleeps when there is nothing to write
+            */
+            WSYS_EXP W_RESULT initialize(
+                _In_ const std::shared_ptr<w_spdlog_logger>& pLogger,
+                _In_ const std::shared_ptr<w_log_binary>& pBinary,
+                _In_ const size_t& pBufferSizeInBytes = W_LOG_ASYNC_DEFAULT_BUFFER_SIZE,
+                _In_ const w_log_overflow_policy& pOverflowPolicy = W_LOG_OVERFLOW_BLOCK,
+                _In_ const uint32_t& pFlushIntervalInMilliseconds = 10);
+
+            /*
+                queue a record, arguments are copied and formatted later on the writer thread
+                @return false if the record could not be queued and must be written synchronously
+            */
+            template<typename Char, typename... w_args>
+            bool log(_In_ const spdlog::level::level_enum& pLevel, _In_z_ const Char* pFormat, _In_ const w_args&... pArgs)
+            {
+                return _log(
+                    std::integral_constant<bool,
+                        log_async::w_log_is_deferred<w_args...>::value && sizeof...(w_args) <= W_LOG_ASYNC_MAX_ARGS>(),
+                    pLevel,
+                    pFormat,
+                    pArgs...);
+            }
+
+            //queue a message which must not be formatted
+            template<typename Char>
+            bool log(_In_ const spdlog::level::level_enum& pLevel, _In_z_ const Char* pMessage)
+            {
+                return _queue(pLevel, log_async::W_LOG_RECORD_RAW, pMessage, pMessage ? std::char_traits<Char>::length(pMessage) : 0);
+            }
+
+            //wait till the writer thread writes all records which were queued before this call, then flush the sinks
+            WSYS_EXP void flush();
+
+            //write all queued records and stop the writer thread
+            WSYS_EXP ULONG release();
+
+#pragma region Getters
+            WSYS_EXP bool get_is_running() const;
+            WSYS_EXP w_log_async_stats get_stats() const;
+#pragma endregion
+
+        private:
+            //Prevent copying
+            w_log_async(w_log_async const&);
+            w_log_async& operator= (w_log_async const&);
+
+            template<typename Char, typename... w_args>
+            bool _log(
+                _In_ std::true_type,
+                _In_ const spdlog::level::level_enum& pLevel,
+                _In_z_ const Char* pFormat,
+                _In_ const w_args&... pArgs)
+            {
+                using namespace log_async;
+
+                auto _format_size = pFormat ? std::char_traits<Char>::length(pFormat) * sizeof(Char) : 0;
+                auto _format_block_size = pad(_format_size + sizeof(Char));
+                auto _size = sizeof(w_log_record_header) + _format_block_size + get_args_size(pArgs...);
+
+                bool _is_dropped = false;
+                auto _ptr = _reserve(_size, _is_dropped);
+                if (!_ptr) return _is_dropped;
+
+                auto _header = write_header(_ptr, _size, pLevel, std::is_same<Char, wchar_t>::value ? W_LOG_RECORD_WIDE : 0,
+                    pFormat, _format_size, _format_block_size);
+                _header->number_of_args = static_cast<uint8_t>(sizeof...(w_args));
+                write_args(_ptr + sizeof(w_log_record_header) + _format_block_size, pArgs...);
+
+                _commit(_size);
+                return true;
+            }
+
+            //arguments which can not be copied are formatted by the caller
+            template<typename Char, typename... w_args>
+            bool _log(
+                _In_ std::false_type,
+                _In_ const spdlog::level::level_enum& pLevel,
+                _In_z_ const Char* pFormat,
+                _In_ const w_args&... pArgs)
+            {
+                fmt::BasicMemoryWriter<Char> _writer;
+                try
+                {
+                    _writer.write(pFormat, pArgs...);
+                }
+                catch (...)
+                {
+                    return false;
+                }
+                return _queue(pLevel, log_async::W_LOG_RECORD_RAW, _writer.data(), _writer.size());
+            }
+
+            template<typename Char>
+            bool _queue(
+                _In_ const spdlog::level::level_enum& pLevel,
+                _In_ const uint8_t& pFlags,
+                _In_ const Char* pText,
+                _In_ const size_t& pLength)
+            {
+                using namespace log_async;
+
+                auto _text_size = pLength * sizeof(Char);
+                auto _text_block_size = pad(_text_size + sizeof(Char));
+                auto _size = sizeof(w_log_record_header) + _text_block_size;
+
+                bool _is_dropped = false;
+                auto _ptr = _reserve(_size, _is_dropped);
+                if (!_ptr) return _is_dropped;
+
+                write_header(_ptr, _size, pLevel, pFlags | (std::is_same<Char, wchar_t>::value ? W_LOG_RECORD_WIDE : 0),
+                    pText, _text_size, _text_block_size);
+
+                _commit(_size);
+                return true;
+            }
+
+            /*
+                reserve a record in the ring buffer of calling thread and apply overflow policy if it is full
+                @param pIsDropped, true if the record was discarded by overflow policy
+                @return nullptr if the record was dropped or it must be written synchronously
+            */
+            WSYS_EXP uint8_t* _reserve(_In_ const size_t& pSizeInBytes, _Out_ bool& pIsDropped);
+            WSYS_EXP void _commit(_In_ const size_t& pSizeInBytes);
+
+            w_log_async_pimp*                       _pimp;
+        };
+	}
+}
+
+#endif //__W_LOG_ASYNC_H__
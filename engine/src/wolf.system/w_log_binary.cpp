@@ -0,0 +1,1052 @@
+#include "w_system_pch.h"
+#include "w_log_binary.h"
+#include "w_convert.h"
+#include "w_compress.h"
+#include <msgpack.hpp>
+#include <rapidjson/writer.h>
+#include <rapidjson/stringbuffer.h>
+#include <fstream>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include <cmath>
+
+#define W_LOG_BINARY_VERSION 2
+
+namespace wolf
+{
+    namespace system
+    {
+        using namespace log_async;
+
+        static const char s_magic[8] = { 'W', 'L', 'O', 'G', 'B', 'I', 'N', '\0' };
+        //magic number of LZ4 frame, the file is compressed if it follows the magic of binary log
+        static const uint32_t s_lz4_frame_magic = 0x184D2204;
+
+        //FNV-1a hash of a format string
+        static uint64_t s_hash(_In_ const uint8_t* pData, _In_ const size_t& pSize, _In_ const bool& pIsWide)
+        {
+            uint64_t _hash = 14695981039346656037ULL;
+            for (size_t i = 0; i < pSize; ++i)
+            {
+                _hash ^= pData[i];
+                _hash *= 1099511628211ULL;
+            }
+            return pIsWide ? ~_hash : _hash;
+        }
+
+        static void s_pack_ext(
+            _Inout_ msgpack::packer<msgpack::sbuffer>& pPacker,
+            _In_ const w_log_binary_ext& pType,
+            _In_ const uint64_t& pValue,
+            _In_ const size_t& pSize)
+        {
+            //little endian on all platforms
+            char _bytes[8];
+            for (size_t i = 0; i < pSize; ++i)
+            {
+                _bytes[i] = static_cast<char>((pValue >> (i * 8)) & 0xff);
+            }
+            pPacker.pack_ext(pSize, pType);
+            pPacker.pack_ext_body(_bytes, static_cast<uint32_t>(pSize));
+        }
+
+        static uint64_t s_unpack_ext(_In_ const msgpack::object_ext& pExt)
+        {
+            uint64_t _value = 0;
+            for (uint32_t i = 0; i < pExt.size && i < 8; ++i)
+            {
+                _value |= static_cast<uint64_t>(static_cast<uint8_t>(pExt.data()[i])) << (i * 8);
+            }
+            return _value;
+        }
+
+        static void s_pack_string(_Inout_ msgpack::packer<msgpack::sbuffer>& pPacker, _In_ const char* pData, _In_ const size_t& pSize)
+        {
+            pPacker.pack_str(static_cast<uint32_t>(pSize));
+            pPacker.pack_str_body(pData, static_cast<uint32_t>(pSize));
+        }
+
+        class w_log_binary_pimp
+        {
+        public:
+            w_log_binary_pimp() :
+                _name("w_log_binary"),
+                _packer(&_buffer),
+                _stream(nullptr),
+                _last_time(0),
+                _size_in_bytes(0),
+                _file_size_in_bytes(0),
+                _flush_level(spdlog::level::off)
+            {
+            }
+
+            ~w_log_binary_pimp()
+            {
+                release();
+            }
+
+            W_RESULT initialize(
+                _In_z_ const std::string& pPath,
+                _In_z_ const std::string& pAppName,
+                _In_ const bool& pCompress)
+            {
+                release();
+
+                std::lock_guard<std::mutex> _lock(this->_mutex);
+
+                this->_file.open(pPath, std::ios::out | std::ios::binary | std::ios::trunc);
+                if (!this->_file.is_open())
+                {
+                    return W_FAILED;
+                }
+
+                this->_buffer.clear();
+                this->_format_ids.clear();
+                this->_formats.clear();
+                this->_last_time = 0;
+
+                this->_file.write(s_magic, sizeof(s_magic));
+                this->_file_size_in_bytes = sizeof(s_magic);
+
+                if (pCompress)
+                {
+                    //linked blocks of a single frame refer to previous 64KB, so repeated format ids and arguments of records are cheap
+                    char _error_log[W_COMPRESS_ERROR_LOG_SIZE] = { 0 };
+                    size_t _size = 0;
+                    this->_compressed.resize(W_LOG_BINARY_BUFFER_SIZE);
+                    if (compress_stream_begin_c(
+                        &this->_stream,
+                        W_DEFAULT,
+                        1,
+                        0,
+                        this->_compressed.data(),
+                        this->_compressed.size(),
+                        &_size,
+                        _error_log))
+                    {
+                        this->_stream = nullptr;
+                        this->_file.close();
+                        return W_FAILED;
+                    }
+                    _write_file(this->_compressed.data(), _size);
+                }
+
+                auto _version = std::to_string(WOLF_MAJOR_VERSION) + "." + std::to_string(WOLF_MINOR_VERSION) + "." +
+                    std::to_string(WOLF_PATCH_VERSION) + "." + std::to_string(WOLF_DEBUG_VERSION);
+
+                this->_packer.pack_map(5);
+                this->_packer.pack(std::string("version"));
+                this->_packer.pack(W_LOG_BINARY_VERSION);
+                this->_packer.pack(std::string("app"));
+                this->_packer.pack(pAppName);
+                this->_packer.pack(std::string("wolf_version"));
+                this->_packer.pack(_version);
+                //period of log clock, so the decoder converts ticks of any platform
+                this->_packer.pack(std::string("clock_num"));
+                this->_packer.pack(static_cast<int64_t>(spdlog::log_clock::period::num));
+                this->_packer.pack(std::string("clock_den"));
+                this->_packer.pack(static_cast<int64_t>(spdlog::log_clock::period::den));
+
+                this->_size_in_bytes = sizeof(s_magic) + this->_buffer.size();
+                _write_buffer();
+
+                return W_PASSED;
+            }
+
+            void write(_In_ const w_log_record_header* pRecord)
+            {
+                if (!pRecord) return;
+
+                std::lock_guard<std::mutex> _lock(this->_mutex);
+                if (!this->_file.is_open()) return;
+
+                auto _start = this->_buffer.size();
+                auto _text = reinterpret_cast<const uint8_t*>(pRecord) + sizeof(w_log_record_header);
+                auto _is_wide = (pRecord->flags & W_LOG_RECORD_WIDE) != 0;
+                auto _time_delta = pRecord->time - this->_last_time;
+                this->_last_time = pRecord->time;
+
+                if (pRecord->flags & W_LOG_RECORD_RAW)
+                {
+                    this->_packer.pack_array(5);
+                    this->_packer.pack(static_cast<uint8_t>(W_LOG_BINARY_TEXT));
+                    this->_packer.pack(pRecord->level);
+                    this->_packer.pack(_time_delta);
+                    this->_packer.pack(pRecord->thread_id);
+                    _pack_text(_text, pRecord->format_size, _is_wide);
+                }
+                else
+                {
+                    auto _id = _get_format_id(_text, pRecord->format_size, _is_wide);
+                    auto _number_of_args = static_cast<uint32_t>(
+                        pRecord->number_of_args < W_LOG_ASYNC_MAX_ARGS ? pRecord->number_of_args : W_LOG_ASYNC_MAX_ARGS);
+
+                    this->_packer.pack_array(5 + _number_of_args);
+                    this->_packer.pack(static_cast<uint8_t>(W_LOG_BINARY_EVENT));
+                    this->_packer.pack(_id);
+                    this->_packer.pack(pRecord->level);
+                    this->_packer.pack(_time_delta);
+                    this->_packer.pack(pRecord->thread_id);
+
+                    auto _char_size = _is_wide ? sizeof(wchar_t) : sizeof(char);
+                    auto _ptr = _text + pad(pRecord->format_size + _char_size);
+                    for (uint32_t i = 0; i < _number_of_args; ++i)
+                    {
+                        auto _arg = reinterpret_cast<const w_log_record_arg*>(_ptr);
+                        auto _data = _ptr + sizeof(w_log_record_arg);
+                        _pack_arg(_arg, _data);
+                        _ptr = _data + pad(_arg->size);
+                    }
+                }
+
+                this->_size_in_bytes += this->_buffer.size() - _start;
+
+                auto _is_flush_level = pRecord->level >= this->_flush_level && this->_flush_level != spdlog::level::off;
+                if (this->_buffer.size() >= W_LOG_BINARY_BUFFER_SIZE || _is_flush_level)
+                {
+                    _write_buffer();
+                    if (_is_flush_level) this->_file.flush();
+                }
+            }
+
+            void flush()
+            {
+                std::lock_guard<std::mutex> _lock(this->_mutex);
+                if (!this->_file.is_open()) return;
+
+                _write_buffer();
+                this->_file.flush();
+            }
+
+            ULONG release()
+            {
+                std::lock_guard<std::mutex> _lock(this->_mutex);
+                if (!this->_file.is_open()) return 1;
+
+                _write_buffer();
+                if (this->_stream)
+                {
+                    //end mark and checksum of frame, a file without them is still decoded till its last block
+                    char _error_log[W_COMPRESS_ERROR_LOG_SIZE] = { 0 };
+                    size_t _size = 0;
+                    this->_compressed.resize(compress_stream_bound_c(this->_stream, 0));
+                    if (compress_stream_end_c(this->_stream, this->_compressed.data(), this->_compressed.size(), &_size, _error_log) == 0)
+                    {
+                        _write_file(this->_compressed.data(), _size);
+                    }
+                    compress_stream_free_c(this->_stream);
+                    this->_stream = nullptr;
+                }
+                this->_file.close();
+
+                return 0;
+            }
+
+            static W_RESULT decode(
+                _In_z_ const std::string& pPath,
+                _Inout_ std::ostream& pOutput,
+                _In_ const w_log_decode_format& pFormat);
+
+#pragma region Getters
+            bool get_is_open()
+            {
+                std::lock_guard<std::mutex> _lock(this->_mutex);
+                return this->_file.is_open();
+            }
+
+            uint64_t get_size_in_bytes()
+            {
+                std::lock_guard<std::mutex> _lock(this->_mutex);
+                return this->_size_in_bytes;
+            }
+
+            uint64_t get_file_size_in_bytes()
+            {
+                std::lock_guard<std::mutex> _lock(this->_mutex);
+                return this->_file_size_in_bytes;
+            }
+
+            uint32_t get_number_of_formats()
+            {
+                std::lock_guard<std::mutex> _lock(this->_mutex);
+                return static_cast<uint32_t>(this->_formats.size());
+            }
+#pragma endregion
+
+#pragma region Setters
+            void set_flush_level(_In_ const spdlog::level::level_enum& pLevel)
+            {
+                std::lock_guard<std::mutex> _lock(this->_mutex);
+                this->_flush_level = pLevel;
+            }
+#pragma endregion
+
+        private:
+            //get id of a format string, a new format string is registered and written before its first record
+            uint32_t _get_format_id(_In_ const uint8_t* pFormat, _In_ const size_t& pSize, _In_ const bool& pIsWide)
+            {
+                //probe the next hashes on collision
+                for (auto _hash = s_hash(pFormat, pSize, pIsWide);; ++_hash)
+                {
+                    auto _iter = this->_format_ids.find(_hash);
+                    if (_iter == this->_format_ids.end()) break;
+
+                    auto& _format = this->_formats[_iter->second];
+                    if (_format.is_wide == pIsWide && _format.bytes.size() == pSize &&
+                        std::memcmp(_format.bytes.data(), pFormat, pSize) == 0)
+                    {
+                        return _iter->second;
+                    }
+                }
+
+                w_log_binary_format _format;
+                _format.is_wide = pIsWide;
+                _format.bytes.assign(reinterpret_cast<const char*>(pFormat), pSize);
+
+                auto _id = static_cast<uint32_t>(this->_formats.size());
+                auto _hash = s_hash(pFormat, pSize, pIsWide);
+                while (this->_format_ids.find(_hash) != this->_format_ids.end()) ++_hash;
+
+                this->_packer.pack_array(4);
+                this->_packer.pack(static_cast<uint8_t>(W_LOG_BINARY_FORMAT));
+                this->_packer.pack(_id);
+                this->_packer.pack(pIsWide);
+                _pack_text(pFormat, pSize, pIsWide);
+
+                this->_format_ids[_hash] = _id;
+                this->_formats.push_back(std::move(_format));
+
+                return _id;
+            }
+
+            void _pack_text(_In_ const uint8_t* pText, _In_ const size_t& pSize, _In_ const bool& pIsWide)
+            {
+                if (pIsWide)
+                {
+                    std::wstring _wide(reinterpret_cast<const wchar_t*>(pText), pSize / sizeof(wchar_t));
+                    std::string _utf8;
+                    try
+                    {
+                        _utf8 = wolf::system::convert::to_utf8(_wide);
+                    }
+                    catch (...)
+                    {
+                        //invalid code points, keep what fits in a byte
+                        _utf8.assign(_wide.begin(), _wide.end());
+                    }
+                    s_pack_string(this->_packer, _utf8.data(), _utf8.size());
+                }
+                else
+                {
+                    s_pack_string(this->_packer, reinterpret_cast<const char*>(pText), pSize);
+                }
+            }
+
+            void _pack_arg(_In_ const w_log_record_arg* pArg, _In_ const uint8_t* pData)
+            {
+                switch (pArg->type)
+                {
+                default:
+                case W_LOG_ARG_INT:
+                    this->_packer.pack(pArg->int_value);
+                    break;
+                case W_LOG_ARG_UINT:
+                    this->_packer.pack(pArg->uint_value);
+                    break;
+                case W_LOG_ARG_DOUBLE:
+                    //use 4 bytes when the value does not lose precision
+                    if (static_cast<double>(static_cast<float>(pArg->double_value)) == pArg->double_value)
+                    {
+                        this->_packer.pack_float(static_cast<float>(pArg->double_value));
+                    }
+                    else
+                    {
+                        this->_packer.pack_double(pArg->double_value);
+                    }
+                    break;
+                case W_LOG_ARG_BOOL:
+                    if (pArg->int_value) this->_packer.pack_true();
+                    else this->_packer.pack_false();
+                    break;
+                case W_LOG_ARG_CHAR:
+                    s_pack_ext(this->_packer, W_LOG_BINARY_EXT_CHAR, static_cast<uint64_t>(pArg->int_value), 4);
+                    break;
+                case W_LOG_ARG_POINTER:
+                    s_pack_ext(this->_packer, W_LOG_BINARY_EXT_POINTER, static_cast<uint64_t>(reinterpret_cast<uintptr_t>(pArg->pointer)), 8);
+                    break;
+                case W_LOG_ARG_STRING:
+                    _pack_text(pData, pArg->size, false);
+                    break;
+                case W_LOG_ARG_WSTRING:
+                    _pack_text(pData, pArg->size, true);
+                    break;
+                }
+            }
+
+            void _write_buffer()
+            {
+                if (!this->_buffer.size()) return;
+                if (this->_stream)
+                {
+                    //blocks are flushed on each update, so a crash loses nothing which was written
+                    char _error_log[W_COMPRESS_ERROR_LOG_SIZE] = { 0 };
+                    size_t _size = 0;
+                    this->_compressed.resize(compress_stream_bound_c(this->_stream, this->_buffer.size()));
+                    if (compress_stream_update_c(
+                        this->_stream,
+                        this->_buffer.data(),
+                        this->_buffer.size(),
+                        this->_compressed.data(),
+                        this->_compressed.size(),
+                        &_size,
+                        _error_log) == 0)
+                    {
+                        _write_file(this->_compressed.data(), _size);
+                    }
+                }
+                else
+                {
+                    _write_file(this->_buffer.data(), this->_buffer.size());
+                }
+                this->_buffer.clear();
+            }
+
+            void _write_file(_In_ const char* pData, _In_ const size_t& pSize)
+            {
+                this->_file.write(pData, static_cast<std::streamsize>(pSize));
+                this->_file_size_in_bytes += pSize;
+            }
+
+            struct w_log_binary_format
+            {
+                bool                                    is_wide = false;
+                //format string as it was logged
+                std::string                             bytes;
+            };
+
+            std::string                                 _name;
+            std::mutex                                  _mutex;
+            std::ofstream                               _file;
+            msgpack::sbuffer                            _buffer;
+            msgpack::packer<msgpack::sbuffer>           _packer;
+            //LZ4 frame of file, nullptr if the log is not compressed
+            w_compress_stream                           _stream;
+            std::vector<char>                           _compressed;
+            //hash of format string to its id
+            std::unordered_map<uint64_t, uint32_t>      _format_ids;
+            std::vector<w_log_binary_format>            _formats;
+            int64_t                                     _last_time;
+            uint64_t                                    _size_in_bytes;
+            uint64_t                                    _file_size_in_bytes;
+            spdlog::level::level_enum                   _flush_level;
+        };
+
+#pragma region decoder
+
+        struct w_log_decoder_format
+        {
+            bool                                        is_wide = false;
+            std::string                                 utf8;
+            //format string in the encoding of original call
+            std::string                                 bytes;
+        };
+
+        class w_log_decoder
+        {
+        public:
+            w_log_decoder(_Inout_ std::ostream& pOutput, _In_ const w_log_decode_format& pFormat) :
+                _output(pOutput),
+                _format(pFormat),
+                _is_header_read(false),
+                _app_name("wolf"),
+                _clock_num(1),
+                _clock_den(1000000000),
+                _time(0)
+            {
+            }
+
+            W_RESULT decode(_In_ const msgpack::object& pObject)
+            {
+                if (!this->_is_header_read)
+                {
+                    this->_is_header_read = true;
+                    return _read_header(pObject);
+                }
+
+                if (pObject.type != msgpack::type::ARRAY || pObject.via.array.size == 0) return W_FAILED;
+
+                auto& _array = pObject.via.array;
+                switch (_get_uint(_array.ptr[0]))
+                {
+                case W_LOG_BINARY_FORMAT:
+                    return _read_format(_array);
+                case W_LOG_BINARY_EVENT:
+                    return _read_event(_array);
+                case W_LOG_BINARY_TEXT:
+                    return _read_text(_array);
+                default:
+                    return W_FAILED;
+                }
+            }
+
+        private:
+            W_RESULT _read_header(_In_ const msgpack::object& pObject)
+            {
+                if (pObject.type != msgpack::type::MAP) return W_FAILED;
+
+                auto& _map = pObject.via.map;
+                for (uint32_t i = 0; i < _map.size; ++i)
+                {
+                    auto _key = _get_string(_map.ptr[i].key);
+                    auto& _value = _map.ptr[i].val;
+                    if (_key == "app")
+                    {
+                        this->_app_name = _get_string(_value);
+                    }
+                    else if (_key == "clock_num")
+                    {
+                        this->_clock_num = static_cast<int64_t>(_get_uint(_value));
+                    }
+                    else if (_key == "clock_den")
+                    {
+                        this->_clock_den = static_cast<int64_t>(_get_uint(_value));
+                    }
+                    else if (_key == "version" && _get_uint(_value) > W_LOG_BINARY_VERSION)
+                    {
+                        return W_FAILED;
+                    }
+                }
+                if (this->_clock_num <= 0 || this->_clock_den <= 0) return W_FAILED;
+                return W_PASSED;
+            }
+
+            W_RESULT _read_format(_In_ const msgpack::object_array& pArray)
+            {
+                if (pArray.size < 4) return W_FAILED;
+
+                auto _id = _get_uint(pArray.ptr[1]);
+                if (_id > this->_formats.size() + 1024 * 1024) return W_FAILED;
+                if (_id >= this->_formats.size()) this->_formats.resize(static_cast<size_t>(_id) + 1);
+
+                auto& _format = this->_formats[static_cast<size_t>(_id)];
+                _format.is_wide = pArray.ptr[2].type == msgpack::type::BOOLEAN && pArray.ptr[2].via.boolean;
+                _format.utf8 = _get_string(pArray.ptr[3]);
+                _format.bytes = _to_bytes(_format.utf8, _format.is_wide);
+
+                return W_PASSED;
+            }
+
+            W_RESULT _read_event(_In_ const msgpack::object_array& pArray)
+            {
+                if (pArray.size < 5) return W_FAILED;
+
+                auto _id = _get_uint(pArray.ptr[1]);
+                auto _level = static_cast<uint8_t>(_get_uint(pArray.ptr[2]));
+                this->_time += _get_int(pArray.ptr[3]);
+                auto _thread_id = _get_uint(pArray.ptr[4]);
+
+                if (_id >= this->_formats.size())
+                {
+                    _write_line(_level, _thread_id, nullptr, nullptr, 0, "unknown format id " + std::to_string(_id));
+                    return W_PASSED;
+                }
+                auto& _format = this->_formats[static_cast<size_t>(_id)];
+
+                //rebuild the record which was logged, so it is formatted like the text log
+                auto _char_size = _format.is_wide ? sizeof(wchar_t) : sizeof(char);
+                auto _format_block_size = pad(_format.bytes.size() + _char_size);
+                auto _number_of_args = pArray.size - 5 < W_LOG_ASYNC_MAX_ARGS ? pArray.size - 5 : W_LOG_ASYNC_MAX_ARGS;
+
+                this->_strings.resize(_number_of_args);
+                auto _size = sizeof(w_log_record_header) + _format_block_size;
+                for (uint32_t i = 0; i < _number_of_args; ++i)
+                {
+                    auto& _object = pArray.ptr[5 + i];
+                    this->_strings[i].clear();
+                    if (_object.type == msgpack::type::STR)
+                    {
+                        this->_strings[i] = _to_bytes(std::string(_object.via.str.ptr, _object.via.str.size), _format.is_wide);
+                    }
+                    _size += sizeof(w_log_record_arg) + pad(this->_strings[i].size());
+                }
+
+                this->_record.assign(_size / sizeof(uint64_t), 0);
+                auto _ptr = reinterpret_cast<uint8_t*>(this->_record.data());
+                auto _header = write_header(
+                    _ptr,
+                    _size,
+                    static_cast<spdlog::level::level_enum>(_level),
+                    _format.is_wide ? W_LOG_RECORD_WIDE : 0,
+                    _format.bytes.data(),
+                    _format.bytes.size(),
+                    _format_block_size);
+                _header->time = this->_time;
+                _header->thread_id = _thread_id;
+                _header->number_of_args = static_cast<uint8_t>(_number_of_args);
+
+                _ptr += sizeof(w_log_record_header) + _format_block_size;
+                for (uint32_t i = 0; i < _number_of_args; ++i)
+                {
+                    auto _arg = reinterpret_cast<w_log_record_arg*>(_ptr);
+                    auto _data = _ptr + sizeof(w_log_record_arg);
+                    _unpack_arg(pArray.ptr[5 + i], this->_strings[i], _format.is_wide, _arg, _data);
+                    _ptr = _data + pad(_arg->size);
+                }
+
+                std::string _text;
+                if (format_record(_header, _text) == W_FAILED) _level = spdlog::level::err;
+                _write_line(_level, _thread_id, &_format, pArray.ptr + 5, _number_of_args, _text);
+
+                return W_PASSED;
+            }
+
+            W_RESULT _read_text(_In_ const msgpack::object_array& pArray)
+            {
+                if (pArray.size < 5) return W_FAILED;
+
+                auto _level = static_cast<uint8_t>(_get_uint(pArray.ptr[1]));
+                this->_time += _get_int(pArray.ptr[2]);
+                auto _thread_id = _get_uint(pArray.ptr[3]);
+                _write_line(_level, _thread_id, nullptr, nullptr, 0, _get_string(pArray.ptr[4]));
+
+                return W_PASSED;
+            }
+
+            void _unpack_arg(
+                _In_ const msgpack::object& pObject,
+                _In_ const std::string& pString,
+                _In_ const bool& pIsWide,
+                _Inout_ w_log_record_arg* pArg,
+                _Inout_ uint8_t* pData)
+            {
+                switch (pObject.type)
+                {
+                default:
+                    pArg->type = W_LOG_ARG_INT;
+                    pArg->int_value = 0;
+                    break;
+                case msgpack::type::POSITIVE_INTEGER:
+                    //signedness is not stored, values which fit are signed so sign flags of format specs work
+                    if (pObject.via.u64 > static_cast<uint64_t>(std::numeric_limits<int64_t>::max()))
+                    {
+                        pArg->type = W_LOG_ARG_UINT;
+                        pArg->uint_value = pObject.via.u64;
+                    }
+                    else
+                    {
+                        pArg->type = W_LOG_ARG_INT;
+                        pArg->int_value = static_cast<int64_t>(pObject.via.u64);
+                    }
+                    break;
+                case msgpack::type::NEGATIVE_INTEGER:
+                    pArg->type = W_LOG_ARG_INT;
+                    pArg->int_value = pObject.via.i64;
+                    break;
+                case msgpack::type::FLOAT32:
+                case msgpack::type::FLOAT64:
+                    pArg->type = W_LOG_ARG_DOUBLE;
+                    pArg->double_value = pObject.via.f64;
+                    break;
+                case msgpack::type::BOOLEAN:
+                    pArg->type = W_LOG_ARG_BOOL;
+                    pArg->int_value = pObject.via.boolean ? 1 : 0;
+                    break;
+                case msgpack::type::STR:
+                    pArg->type = pIsWide ? W_LOG_ARG_WSTRING : W_LOG_ARG_STRING;
+                    pArg->size = static_cast<uint32_t>(pString.size());
+                    if (!pString.empty()) std::memcpy(pData, pString.data(), pString.size());
+                    break;
+                case msgpack::type::EXT:
+                    if (pObject.via.ext.type() == W_LOG_BINARY_EXT_POINTER)
+                    {
+                        pArg->type = W_LOG_ARG_POINTER;
+                        pArg->pointer = reinterpret_cast<const void*>(static_cast<uintptr_t>(s_unpack_ext(pObject.via.ext)));
+                    }
+                    else
+                    {
+                        pArg->type = W_LOG_ARG_CHAR;
+                        pArg->int_value = static_cast<int64_t>(s_unpack_ext(pObject.via.ext));
+                    }
+                    break;
+                }
+            }
+
+            void _write_line(
+                _In_ const uint8_t& pLevel,
+                _In_ const uint64_t& pThreadID,
+                _In_ const w_log_decoder_format* pFormat,
+                _In_ const msgpack::object* pArgs,
+                _In_ const uint32_t& pNumberOfArgs,
+                _In_ const std::string& pText)
+            {
+                auto _level_name = pLevel <= spdlog::level::off ? spdlog::level::to_str(static_cast<spdlog::level::level_enum>(pLevel)) : "unknown";
+
+                //ticks of log clock of the logging machine to nanoseconds
+                auto _nanoseconds = static_cast<int64_t>(
+                    static_cast<long double>(this->_time) * this->_clock_num * 1000000000 / this->_clock_den);
+                auto _seconds = static_cast<time_t>(_nanoseconds / 1000000000);
+                auto _millis = static_cast<unsigned int>((_nanoseconds / 1000000) % 1000);
+                auto _tm = spdlog::details::os::localtime(_seconds);
+
+                fmt::MemoryWriter _time;
+                _time << static_cast<unsigned int>(_tm.tm_year + 1900) << '-'
+                    << fmt::pad(static_cast<unsigned int>(_tm.tm_mon + 1), 2, '0') << '-'
+                    << fmt::pad(static_cast<unsigned int>(_tm.tm_mday), 2, '0') << ' '
+                    << fmt::pad(static_cast<unsigned int>(_tm.tm_hour), 2, '0') << ':'
+                    << fmt::pad(static_cast<unsigned int>(_tm.tm_min), 2, '0') << ':'
+                    << fmt::pad(static_cast<unsigned int>(_tm.tm_sec), 2, '0') << '.'
+                    << fmt::pad(_millis, 3, '0');
+
+                if (this->_format == W_LOG_DECODE_TEXT)
+                {
+                    //the same pattern which spdlog writes to the text log
+                    this->_output << '[' << _time.c_str() << "] [" << this->_app_name << "] [" << _level_name << "] " << pText << '\n';
+                    return;
+                }
+
+                rapidjson::StringBuffer _buffer;
+                rapidjson::Writer<rapidjson::StringBuffer> _writer(_buffer);
+                _writer.StartObject();
+                _writer.Key("time");
+                _writer.String(_time.c_str());
+                _writer.Key("timestamp_ns");
+                _writer.Int64(_nanoseconds);
+                _writer.Key("app");
+                _writer.String(this->_app_name.c_str(), static_cast<rapidjson::SizeType>(this->_app_name.size()));
+                _writer.Key("level");
+                _writer.String(_level_name);
+                _writer.Key("thread");
+                _writer.Uint64(pThreadID);
+                if (pFormat)
+                {
+                    _writer.Key("format");
+                    _writer.String(pFormat->utf8.c_str(), static_cast<rapidjson::SizeType>(pFormat->utf8.size()));
+                    _writer.Key("args");
+                    _writer.StartArray();
+                    for (uint32_t i = 0; i < pNumberOfArgs; ++i)
+                    {
+                        _write_json_arg(_writer, pArgs[i]);
+                    }
+                    _writer.EndArray();
+                }
+                _writer.Key("message");
+                _writer.String(pText.c_str(), static_cast<rapidjson::SizeType>(pText.size()));
+                _writer.EndObject();
+
+                this->_output << _buffer.GetString() << '\n';
+            }
+
+            static void _write_json_arg(_Inout_ rapidjson::Writer<rapidjson::StringBuffer>& pWriter, _In_ const msgpack::object& pObject)
+            {
+                switch (pObject.type)
+                {
+                default:
+                    pWriter.Null();
+                    break;
+                case msgpack::type::POSITIVE_INTEGER:
+                    pWriter.Uint64(pObject.via.u64);
+                    break;
+                case msgpack::type::NEGATIVE_INTEGER:
+                    pWriter.Int64(pObject.via.i64);
+                    break;
+                case msgpack::type::FLOAT32:
+                case msgpack::type::FLOAT64:
+                    //JSON has no NaN and infinity
+                    if (std::isfinite(pObject.via.f64)) pWriter.Double(pObject.via.f64);
+                    else pWriter.String(std::isnan(pObject.via.f64) ? "nan" : (pObject.via.f64 > 0 ? "inf" : "-inf"));
+                    break;
+                case msgpack::type::BOOLEAN:
+                    pWriter.Bool(pObject.via.boolean);
+                    break;
+                case msgpack::type::STR:
+                    pWriter.String(pObject.via.str.ptr, pObject.via.str.size);
+                    break;
+                case msgpack::type::EXT:
+                {
+                    auto _value = s_unpack_ext(pObject.via.ext);
+                    if (pObject.via.ext.type() == W_LOG_BINARY_EXT_POINTER)
+                    {
+                        auto _hex = fmt::format("0x{:x}", _value);
+                        pWriter.String(_hex.c_str(), static_cast<rapidjson::SizeType>(_hex.size()));
+                    }
+                    else
+                    {
+                        std::string _char;
+                        try
+                        {
+                            _char = wolf::system::convert::to_utf8(std::wstring(1, static_cast<wchar_t>(_value)));
+                        }
+                        catch (...)
+                        {
+                        }
+                        pWriter.String(_char.c_str(), static_cast<rapidjson::SizeType>(_char.size()));
+                    }
+                    break;
+                }
+                }
+            }
+
+            //convert UTF-8 text of file to the encoding of original call
+            static std::string _to_bytes(_In_ const std::string& pUTF8, _In_ const bool& pIsWide)
+            {
+                if (!pIsWide) return pUTF8;
+
+                std::wstring _wide;
+                try
+                {
+                    _wide = wolf::system::convert::from_utf8(pUTF8);
+                }
+                catch (...)
+                {
+                    _wide.assign(pUTF8.begin(), pUTF8.end());
+                }
+                return std::string(reinterpret_cast<const char*>(_wide.data()), _wide.size() * sizeof(wchar_t));
+            }
+
+            static uint64_t _get_uint(_In_ const msgpack::object& pObject)
+            {
+                if (pObject.type == msgpack::type::POSITIVE_INTEGER) return pObject.via.u64;
+                return 0;
+            }
+
+            static int64_t _get_int(_In_ const msgpack::object& pObject)
+            {
+                if (pObject.type == msgpack::type::POSITIVE_INTEGER) return static_cast<int64_t>(pObject.via.u64);
+                if (pObject.type == msgpack::type::NEGATIVE_INTEGER) return pObject.via.i64;
+                return 0;
+            }
+
+            static std::string _get_string(_In_ const msgpack::object& pObject)
+            {
+                if (pObject.type != msgpack::type::STR) return std::string();
+                return std::string(pObject.via.str.ptr, pObject.via.str.size);
+            }
+
+            //Prevent copying
+            w_log_decoder(w_log_decoder const&);
+            w_log_decoder& operator= (w_log_decoder const&);
+
+            std::ostream&                               _output;
+            w_log_decode_format                         _format;
+            bool                                        _is_header_read;
+            std::string                                 _app_name;
+            int64_t                                     _clock_num;
+            int64_t                                     _clock_den;
+            int64_t                                     _time;
+            std::vector<w_log_decoder_format>           _formats;
+            std::vector<std::string>                    _strings;
+            std::vector<uint64_t>                       _record;
+        };
+
+        W_RESULT w_log_binary_pimp::decode(
+            _In_z_ const std::string& pPath,
+            _Inout_ std::ostream& pOutput,
+            _In_ const w_log_decode_format& pFormat)
+        {
+            std::ifstream _file(pPath, std::ios::in | std::ios::binary);
+            if (!_file.is_open()) return W_FAILED;
+
+            char _magic[sizeof(s_magic)];
+            if (!_file.read(_magic, sizeof(_magic)) || std::memcmp(_magic, s_magic, sizeof(s_magic)) != 0)
+            {
+                return W_FAILED;
+            }
+
+            w_log_decoder _decoder(pOutput, pFormat);
+            msgpack::unpacker _unpacker;
+            msgpack::object_handle _handle;
+            bool _is_first = true;
+
+            //decode entries which were added to unpacker, returns false if the file is not a binary log
+            auto _decode_entries = [&]() -> bool
+            {
+                try
+                {
+                    while (_unpacker.next(_handle))
+                    {
+                        //a file without header is not a binary log, other broken entries are skipped
+                        if (_decoder.decode(_handle.get()) == W_FAILED && _is_first) return false;
+                        _is_first = false;
+                    }
+                }
+                catch (const std::exception&)
+                {
+                    return false;
+                }
+                return true;
+            };
+
+            std::vector<char> _compressed(W_LOG_BINARY_BUFFER_SIZE);
+            _file.read(_compressed.data(), sizeof(s_lz4_frame_magic));
+            auto _read = static_cast<size_t>(_file.gcount());
+            uint32_t _frame_magic = 0;
+            for (size_t i = 0; i < _read; ++i)
+            {
+                _frame_magic |= static_cast<uint32_t>(static_cast<uint8_t>(_compressed[i])) << (i * 8);
+            }
+
+            if (_read == sizeof(s_lz4_frame_magic) && _frame_magic == s_lz4_frame_magic)
+            {
+                char _error_log[W_COMPRESS_ERROR_LOG_SIZE] = { 0 };
+                w_compress_stream _stream = nullptr;
+                if (decompress_stream_begin_c(&_stream, _error_log)) return W_FAILED;
+
+                auto _hr = W_PASSED;
+                size_t _pending = _read;
+                while (_pending && _hr == W_PASSED)
+                {
+                    size_t _consumed = 0;
+                    for (;;)
+                    {
+                        //decompress straight into buffer of unpacker
+                        _unpacker.reserve_buffer(W_LOG_BINARY_BUFFER_SIZE);
+                        size_t _src_size = _pending - _consumed;
+                        const size_t _capacity = _unpacker.buffer_capacity();
+                        size_t _dst_size = _capacity;
+                        int _is_done = 0;
+                        if (decompress_stream_update_c(
+                            _stream,
+                            _compressed.data() + _consumed,
+                            &_src_size,
+                            _unpacker.buffer(),
+                            &_dst_size,
+                            &_is_done,
+                            _error_log))
+                        {
+                            //corrupted block, keep the entries which were decoded before it
+                            _pending = 0;
+                            break;
+                        }
+                        _consumed += _src_size;
+                        _unpacker.buffer_consumed(_dst_size);
+                        if (!_decode_entries())
+                        {
+                            _hr = W_FAILED;
+                            break;
+                        }
+                        //all of input was used and output was not limited by buffer of unpacker
+                        if ((_consumed == _pending && _dst_size < _capacity) || (!_src_size && !_dst_size)) break;
+                    }
+                    if (!_pending || _hr == W_FAILED) break;
+
+                    _file.read(_compressed.data(), static_cast<std::streamsize>(_compressed.size()));
+                    _pending = static_cast<size_t>(_file.gcount());
+                }
+                decompress_stream_free_c(_stream);
+
+                if (_hr == W_FAILED) return W_FAILED;
+            }
+            else
+            {
+                //entries of version 1 are not compressed
+                if (_read)
+                {
+                    _unpacker.reserve_buffer(_read);
+                    std::memcpy(_unpacker.buffer(), _compressed.data(), _read);
+                    _unpacker.buffer_consumed(_read);
+                    if (!_decode_entries()) return W_FAILED;
+                }
+                while (_file)
+                {
+                    _unpacker.reserve_buffer(W_LOG_BINARY_BUFFER_SIZE);
+                    _file.read(_unpacker.buffer(), W_LOG_BINARY_BUFFER_SIZE);
+                    _read = static_cast<size_t>(_file.gcount());
+                    if (!_read) break;
+                    _unpacker.buffer_consumed(_read);
+                    if (!_decode_entries()) return W_FAILED;
+                }
+            }
+
+            return _is_first ? W_FAILED : W_PASSED;
+        }
+
+#pragma endregion
+    }
+}
+
+using namespace wolf::system;
+
+w_log_binary::w_log_binary() :
+    _pimp(new w_log_binary_pimp())
+{
+}
+
+w_log_binary::~w_log_binary()
+{
+    release();
+    delete this->_pimp;
+    this->_pimp = nullptr;
+}
+
+W_RESULT w_log_binary::initialize(
+    _In_z_ const std::string& pPath,
+    _In_z_ const std::string& pAppName,
+    _In_ const bool& pCompress)
+{
+    if (!this->_pimp) return W_FAILED;
+    return this->_pimp->initialize(pPath, pAppName, pCompress);
+}
+
+void w_log_binary::write(_In_ const w_log_record_header* pRecord)
+{
+    if (!this->_pimp) return;
+    this->_pimp->write(pRecord);
+}
+
+void w_log_binary::flush()
+{
+    if (!this->_pimp) return;
+    this->_pimp->flush();
+}
+
+ULONG w_log_binary::release()
+{
+    if (!this->_pimp) return 1;
+    return this->_pimp->release();
+}
+
+W_RESULT w_log_binary::decode(
+    _In_z_ const std::string& pPath,
+    _Inout_ std::ostream& pOutput,
+    _In_ const w_log_decode_format& pFormat)
+{
+    return w_log_binary_pimp::decode(pPath, pOutput, pFormat);
+}
+
+#pragma region Getters
+
+bool w_log_binary::get_is_open() const
+{
+    return this->_pimp && this->_pimp->get_is_open();
+}
+
+uint64_t w_log_binary::get_size_in_bytes() const
+{
+    if (!this->_pimp) return 0;
+    return this->_pimp->get_size_in_bytes();
+}
+
+uint64_t w_log_binary::get_file_size_in_bytes() const
+{
+    if (!this->_pimp) return 0;
+    return this->_pimp->get_file_size_in_bytes();
+}
+
+uint32_t w_log_binary::get_number_of_formats() const
+{
+    if (!this->_pimp) return 0;
+    return this->_pimp->get_number_of_formats();
+}
+
+#pragma endregion
+
+#pragma region Setters
+
+void w_log_binary::set_flush_level(_In_ const spdlog::level::level_enum& pLevel)
+{
+    if (!this->_pimp) return;
+    this->_pimp->set_flush_level(pLevel);
+}
+
+#pragma endregion
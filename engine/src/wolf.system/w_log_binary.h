@@ -0,0 +1,217 @@
+/*
+	Project			 : Wolf Engine. Copyright(c) Pooya Eimandar (http://PooyaEimandar.com) . All rights reserved.
+	Source			 : Please direct any bug to https://github.com/PooyaEimandar/Wolf.Engine/issues
+	Website			 : http://WolfSource.io
+	Name			 : w_log_binary.h
+	Description		 : Compact binary log of w_logger, format strings are registered once and arguments are stored raw in msgpack
+	Comment          : use decode to regenerate the text log or export it as JSON lines
+*/
+
+#if _MSC_VER > 1000
+#pragma once
+#endif
+
+#ifndef __W_LOG_BINARY_H__
+#define __W_LOG_BINARY_H__
+
+#include "w_log_async.h"
+#include <ostream>
+
+//extension of binary log files
+#ifndef W_LOG_BINARY_EXTENSION
+#define W_LOG_BINARY_EXTENSION ".wBinLog"
+#endif
+
+//encoded entries are kept in memory and written to the file once they reach this size
+#ifndef W_LOG_BINARY_BUFFER_SIZE
+#define W_LOG_BINARY_BUFFER_SIZE 64 * 1024
+#endif
+
+namespace wolf
+{
+	namespace system
+	{
+        /*
+            layout of a binary log file:
+            "WLOGBIN\0", then a msgpack map of file information, then a stream of msgpack arrays.
+            If the log is compressed, everything after "WLOGBIN\0" is a LZ4 frame of linked blocks, each write of buffer is one or more blocks:
+            [W_LOG_BINARY_FORMAT, id, is_wide, format]                          registers a format string
+            [W_LOG_BINARY_EVENT, format id, level, time delta, thread id, args...] a record of a registered format
+            [W_LOG_BINARY_TEXT, level, time delta, thread id, text]                a record which was formatted before logging
+            strings are UTF-8, time delta is the difference with time of previous entry in ticks of log clock,
+            chars and pointers are stored as msgpack extensions
+        */
+        enum w_log_binary_entry : uint8_t
+        {
+            W_LOG_BINARY_FORMAT = 0,
+            W_LOG_BINARY_EVENT,
+            W_LOG_BINARY_TEXT
+        };
+
+        enum w_log_binary_ext : int8_t
+        {
+            //code point of a char in 4 bytes
+            W_LOG_BINARY_EXT_CHAR = 1,
+            //address in 8 bytes
+            W_LOG_BINARY_EXT_POINTER
+        };
+
+        enum w_log_decode_format : uint8_t
+        {
+            //the same lines which the text log has
+            W_LOG_DECODE_TEXT = 0,
+            //one JSON object per line, with format string and arguments of each record
+            W_LOG_DECODE_JSON_LINES
+        };
+
+        class w_log_binary_pimp;
+        class w_log_binary
+        {
+        public:
+            WSYS_EXP w_log_binary();
+            WSYS_EXP ~w_log_binary();
+
+            /*
+                create the binary log file
+                @param pPath, path of file
+                @param pAppName, name of application which is written as logger name of each line by decoder
+                @param pCompress, compress entries with LZ4 before writing them to the file
+                @return W_PASSED on success
+            */
+            WSYS_EXP W_RESULT initialize(
+                _In_z_ const std::string& pPath,
+                _In_z_ const std::string& pAppName,
+                _In_ const bool& pCompress = true);
+
+            //serialize a record, it is thread safe
+            WSYS_EXP void write(_In_ const log_async::w_log_record_header* pRecord);
+
+            //serialize a format string and its arguments, arguments of unsupported types are formatted by the caller
+            template<typename Char, typename... w_args>
+            void write(_In_ const spdlog::level::level_enum& pLevel, _In_z_ const Char* pFormat, _In_ const w_args&... pArgs)
+            {
+                _write(
+                    std::integral_constant<bool,
+                        log_async::w_log_is_deferred<w_args...>::value && sizeof...(w_args) <= W_LOG_ASYNC_MAX_ARGS>(),
+                    pLevel,
+                    pFormat,
+                    pArgs...);
+            }
+
+            //serialize a message which must not be formatted
+            template<typename Char>
+            void write(_In_ const spdlog::level::level_enum& pLevel, _In_z_ const Char* pMessage)
+            {
+                _write_text(pLevel, pMessage, pMessage ? std::char_traits<Char>::length(pMessage) : 0);
+            }
+
+            //write buffered entries to the file
+            WSYS_EXP void flush();
+
+            //flush and close the file
+            WSYS_EXP ULONG release();
+
+            /*
+                decode a binary log file
+                @param pPath, path of binary log file
+                @param pOutput, stream which receives the decoded lines
+                @param pFormat, text lines or JSON lines
+                @return W_FAILED if the file could not be opened or it is not a binary log, a truncated file is decoded till the last complete entry
+            */
+            WSYS_EXP static W_RESULT decode(
+                _In_z_ const std::string& pPath,
+                _Inout_ std::ostream& pOutput,
+                _In_ const w_log_decode_format& pFormat = W_LOG_DECODE_TEXT);
+
+#pragma region Getters
+            WSYS_EXP bool get_is_open() const;
+            //get number of encoded bytes, including buffered entries
+            WSYS_EXP uint64_t get_size_in_bytes() const;
+            //get number of bytes which were written to the file, entries are counted after compression
+            WSYS_EXP uint64_t get_file_size_in_bytes() const;
+            //get number of registered format strings
+            WSYS_EXP uint32_t get_number_of_formats() const;
+#pragma endregion
+
+#pragma region Setters
+            //entries with this level or higher are written to the file right away
+            WSYS_EXP void set_flush_level(_In_ const spdlog::level::level_enum& pLevel);
+#pragma endregion
+
+        private:
+            //Prevent copying
+            w_log_binary(w_log_binary const&);
+            w_log_binary& operator= (w_log_binary const&);
+
+            //records are built on the stack, memory is only allocated for large records
+            typedef fmt::internal::MemoryBuffer<uint64_t, 64> w_record_buffer;
+
+            template<typename Char, typename... w_args>
+            void _write(
+                _In_ std::true_type,
+                _In_ const spdlog::level::level_enum& pLevel,
+                _In_z_ const Char* pFormat,
+                _In_ const w_args&... pArgs)
+            {
+                using namespace log_async;
+
+                auto _format_size = pFormat ? std::char_traits<Char>::length(pFormat) * sizeof(Char) : 0;
+                auto _format_block_size = pad(_format_size + sizeof(Char));
+                auto _size = sizeof(w_log_record_header) + _format_block_size + get_args_size(pArgs...);
+
+                w_record_buffer _buffer;
+                _buffer.resize(pad(_size) / sizeof(uint64_t));
+                auto _ptr = reinterpret_cast<uint8_t*>(&_buffer[0]);
+
+                auto _header = write_header(_ptr, _size, pLevel, std::is_same<Char, wchar_t>::value ? W_LOG_RECORD_WIDE : 0,
+                    pFormat, _format_size, _format_block_size);
+                _header->number_of_args = static_cast<uint8_t>(sizeof...(w_args));
+                write_args(_ptr + sizeof(w_log_record_header) + _format_block_size, pArgs...);
+
+                write(_header);
+            }
+
+            //arguments which can not be serialized are formatted by the caller
+            template<typename Char, typename... w_args>
+            void _write(
+                _In_ std::false_type,
+                _In_ const spdlog::level::level_enum& pLevel,
+                _In_z_ const Char* pFormat,
+                _In_ const w_args&... pArgs)
+            {
+                fmt::BasicMemoryWriter<Char> _writer;
+                try
+                {
+                    _writer.write(pFormat, pArgs...);
+                }
+                catch (const std::exception& pException)
+                {
+                    write(spdlog::level::err, (std::string("could not format log record: ") + pException.what()).c_str());
+                    return;
+                }
+                _write_text(pLevel, _writer.data(), _writer.size());
+            }
+
+            template<typename Char>
+            void _write_text(_In_ const spdlog::level::level_enum& pLevel, _In_ const Char* pText, _In_ const size_t& pLength)
+            {
+                using namespace log_async;
+
+                auto _text_size = pLength * sizeof(Char);
+                auto _text_block_size = pad(_text_size + sizeof(Char));
+                auto _size = sizeof(w_log_record_header) + _text_block_size;
+
+                w_record_buffer _buffer;
+                _buffer.resize(_size / sizeof(uint64_t));
+                auto _ptr = reinterpret_cast<uint8_t*>(&_buffer[0]);
+
+                write(write_header(_ptr, _size, pLevel, W_LOG_RECORD_RAW | (std::is_same<Char, wchar_t>::value ? W_LOG_RECORD_WIDE : 0),
+                    pText, _text_size, _text_block_size));
+            }
+
+            w_log_binary_pimp*                      _pimp;
+        };
+	}
+}
+
+#endif //__W_LOG_BINARY_H__
@@ -38,9 +38,14 @@
 
 #endif
 
+#ifndef SPDLOG_WCHAR_TO_UTF8_SUPPORT
 #define SPDLOG_WCHAR_TO_UTF8_SUPPORT
+#endif
+#ifndef SPDLOG_WCHAR_FILENAMES
 #define SPDLOG_WCHAR_FILENAMES
+#endif
 #include "spdlog/spdlog.h"
+#include "w_log_binary.h"
 
 #ifndef MinSizeRel
 #ifdef _MSC_VER
@@ -59,11 +64,23 @@ namespace wolf
 			//false means flush will be called always, true means flush level is warn
             bool flush_level = false;
             bool log_to_std_out = true;
+            //queue logs in a lock-free ring buffer of each thread and write them on a background thread
+            bool async_mode = false;
+            //size of ring buffer of each thread in bytes, used in async mode
+            size_t async_buffer_size = W_LOG_ASYNC_DEFAULT_BUFFER_SIZE;
+            //what a thread does when its ring buffer is full, used in async mode
+            w_log_overflow_policy async_overflow_policy = W_LOG_OVERFLOW_BLOCK;
+            //maximum time which the writer thread sleeps when there is nothing to write, used in async mode
+            uint32_t async_flush_interval_in_ms = 10;
+            //write a compact binary log (.wBinLog) instead of the text log file, decode it with w_log_binary::decode
+            bool binary_mode = false;
+            //compress the binary log with LZ4, used in binary mode
+            bool binary_compress = true;
         };
         class w_logger
         {
         public:
-			w_logger() : _is_released(false), _opened(false) {}
+			w_logger() : _is_released(false), _opened(false), _has_text_sinks(true) {}
 			virtual ~w_logger() { release(); }
 
             //Initialize the logger and create a log file inside a Log folder into output directory
@@ -139,7 +156,9 @@ namespace wolf
 					//Create the directory of log inside the root directory
 					io::create_directoryW(_log_directory_cstr);
 				}
-				auto _log_file_path = _log_directory + io::get_unique_nameW() + L".wLog";
+				auto _log_file_name = _log_directory + io::get_unique_nameW();
+				auto _log_file_path = _log_file_name + L".wLog";
+				auto _binary_file_path = wolf::system::convert::wstring_to_string(_log_file_name) + W_LOG_BINARY_EXTENSION;
 #else
 				auto _log_directory = wolf::system::convert::wstring_to_string(pConfig.log_path) + "/Log/";
 				auto _log_directory_cstr = _log_directory.c_str();
@@ -149,11 +168,29 @@ namespace wolf
 					//Create the directory of log inside the root directory
 					io::create_directory(_log_directory_cstr);
 				}
-				auto _log_file_path = _log_directory + io::get_unique_name() + ".wLog";
+				auto _log_file_name = _log_directory + io::get_unique_name();
+				auto _log_file_path = _log_file_name + ".wLog";
+				auto _binary_file_path = _log_file_name + W_LOG_BINARY_EXTENSION;
 #endif
 				std::vector<spdlog::sink_ptr> sinks;
 
-				sinks.push_back(std::make_shared<spdlog::sinks::simple_file_sink_mt>(_log_file_path));
+				auto _binary_failed = false;
+				if (pConfig.binary_mode)
+				{
+					this->_log_binary = std::make_shared<w_log_binary>();
+					if (this->_log_binary->initialize(
+						_binary_file_path,
+						wolf::system::convert::wstring_to_string(pConfig.app_name),
+						pConfig.binary_compress) == W_FAILED)
+					{
+						this->_log_binary.reset();
+						_binary_failed = true;
+					}
+				}
+				if (!this->_log_binary)
+				{
+					sinks.push_back(std::make_shared<spdlog::sinks::simple_file_sink_mt>(_log_file_path));
+				}
 #if defined(_MSC_VER) && !defined(MinSizeRel)
 				sinks.push_back(std::make_shared<spdlog::sinks::msvc_sink_mt>());
 #endif
@@ -162,14 +199,15 @@ namespace wolf
 					sinks.push_back(std::make_shared<spdlog::sinks::stdout_sink_mt>());
 				}
 
-				this->_log_file = std::make_shared<spdlog::logger>(
+				this->_log_file = std::make_shared<w_spdlog_logger>(
 					wolf::system::convert::wstring_to_string(pConfig.app_name), begin(sinks), end(sinks));
 				if (!this->_log_file)
 				{
 					return false;
 				}
+				this->_has_text_sinks = !sinks.empty();
 
-				this->_log_file->info(
+				_log(spdlog::level::info,
 					"Project: \"Wolf Engine(http://WolfSource.io). "\
 					"Copyright(c) Pooya Eimandar(http://PooyaEimandar.com). All rights reserved.\". "\
 					"Contact: \"Contact@WolfSource.io\" "\
@@ -179,11 +217,28 @@ namespace wolf
 				{
 					this->_log_file->set_level(spdlog::level::level_enum::warn);
 					this->_log_file->flush_on(spdlog::level::level_enum::warn);
+					if (this->_log_binary) this->_log_binary->set_flush_level(spdlog::level::level_enum::warn);
 				}
 				else
 				{
 					this->_log_file->flush_on(spdlog::level::level_enum::off);
 				}
+
+				if (_binary_failed)
+				{
+					_log(spdlog::level::warn, "could not create binary log file, logs will be written as text");
+				}
+
+				if (pConfig.async_mode &&
+					this->_async.initialize(
+						this->_log_file,
+						this->_log_binary,
+						pConfig.async_buffer_size,
+						pConfig.async_overflow_policy,
+						pConfig.async_flush_interval_in_ms) == W_FAILED)
+				{
+					_log(spdlog::level::warn, "could not start asynchronous logging, logs will be written synchronously");
+				}
 				
 				this->_opened = true;
 				return true;
@@ -191,37 +246,43 @@ namespace wolf
 
 #endif //__UWP
 
-            //Flush the output stream
+            //Flush the output stream, in async mode it waits till all queued logs are written
 			void flush()
 			{
+				if (this->_async.get_is_running())
+				{
+					this->_async.flush();
+					return;
+				}
 				this->_log_file->flush();
+				if (this->_log_binary) this->_log_binary->flush();
 			}
 
 #pragma region write
             //Write an output message
 			void write(_In_z_ const char* fmt)
 			{
-				this->_log_file->info(fmt);
+				_log(spdlog::level::info, fmt);
 			}
 
 			//Write an output message
 			void write(_In_z_ const wchar_t* fmt)
 			{
-				this->_log_file->info(fmt);
+				_log(spdlog::level::info, fmt);
 			}
 
 			//Write an output message
 			template<typename... w_args>
 			void write(_In_z_ const char* fmt, _In_ const w_args&... args)
 			{
-				this->_log_file->info(fmt, args...);
+				_log(spdlog::level::info, fmt, args...);
 			}
 
 			//Write an output message
 			template<typename... w_args>
 			void write(_In_z_ const wchar_t* fmt, _In_ const w_args&... args)
 			{
-				this->_log_file->info(fmt, args...);
+				_log(spdlog::level::info, fmt, args...);
 			}
 #pragma endregion
 
@@ -229,27 +290,27 @@ namespace wolf
 			//Write a warning message
 			void warning(_In_z_ const char* fmt)
 			{
-				this->_log_file->warn(fmt);
+				_log(spdlog::level::warn, fmt);
 			}
 
 			//Write a warning message
 			void warning(_In_z_ const wchar_t* fmt)
 			{
-				this->_log_file->warn(fmt);
+				_log(spdlog::level::warn, fmt);
 			}
 
 			//Write a warning message
 			template<typename... w_args>
 			void warning(_In_z_ const char* fmt, _In_ const w_args&... args)
 			{
-				this->_log_file->warn(fmt, args...);
+				_log(spdlog::level::warn, fmt, args...);
 			}
 
 			//Write a warning message
 			template<typename... w_args>
 			void warning(_In_z_ const wchar_t* fmt, _In_ const w_args&... args)
 			{
-				this->_log_file->warn(fmt, args...);
+				_log(spdlog::level::warn, fmt, args...);
 			}
 #pragma endregion
 
@@ -257,27 +318,27 @@ namespace wolf
 			//Write an error message
 			void error(_In_z_ const char* fmt)
 			{
-				this->_log_file->error(fmt);
+				_log(spdlog::level::err, fmt);
 			}
 
 			//Write an error message
 			void error(_In_z_ const wchar_t* fmt)
 			{
-				this->_log_file->error(fmt);
+				_log(spdlog::level::err, fmt);
 			}
 
 			//Write an error message
 			template<typename... w_args>
 			void error(_In_z_ const char* fmt, _In_ const w_args&... args)
 			{
-				this->_log_file->error(fmt, args...);
+				_log(spdlog::level::err, fmt, args...);
 			}
 
 			//Write an error message
 			template<typename... w_args>
 			void error(_In_z_ const wchar_t* fmt, _In_ const w_args&... args)
 			{
-				this->_log_file->error(fmt, args...);
+				_log(spdlog::level::err, fmt, args...);
 			}
 #pragma endregion
             
@@ -287,9 +348,13 @@ namespace wolf
 				if (this->_is_released) return 1;
 
 				this->_is_released = true;
+				//logger was not initialized
+				if (!this->_log_file) return 1;
 
 				write("wolf shutting down");
+				this->_async.release();
 				this->_log_file->flush();
+				if (this->_log_binary) this->_log_binary->release();
 
 				return 0;
 			}
@@ -297,6 +362,11 @@ namespace wolf
 #pragma region Getters
 			bool get_is_open() const { return this->_opened; }
 			bool get_is_released() const { return _is_released; }
+			bool get_is_async() const { return this->_async.get_is_running(); }
+			bool get_is_binary() const { return this->_log_binary != nullptr; }
+			//get whether a log of this level will be written, so callers can skip building its arguments
+			bool get_should_log(_In_ const spdlog::level::level_enum& pLevel) const { return this->_log_file && this->_log_file->should_log(pLevel); }
+			w_log_async_stats get_async_stats() const { return this->_async.get_stats(); }
 #pragma endregion
 
         private:
@@ -304,11 +374,33 @@ namespace wolf
             w_logger(w_logger const&);
             w_logger& operator= (w_logger const&);
 
+			template<typename Char>
+			void _log(_In_ const spdlog::level::level_enum& pLevel, _In_z_ const Char* pMessage)
+			{
+				if (!this->_log_file->should_log(pLevel)) return;
+				if (this->_async.get_is_running() && this->_async.log(pLevel, pMessage)) return;
+				if (this->_log_binary) this->_log_binary->write(pLevel, pMessage);
+				if (this->_has_text_sinks) this->_log_file->log(pLevel, pMessage);
+			}
+
+			template<typename Char, typename... w_args>
+			void _log(_In_ const spdlog::level::level_enum& pLevel, _In_z_ const Char* pFormat, _In_ const w_args&... pArgs)
+			{
+				if (!this->_log_file->should_log(pLevel)) return;
+				if (this->_async.get_is_running() && this->_async.log(pLevel, pFormat, pArgs...)) return;
+				if (this->_log_binary) this->_log_binary->write(pLevel, pFormat, pArgs...);
+				if (this->_has_text_sinks) this->_log_file->log(pLevel, pFormat, pArgs...);
+			}
+
 			bool							_is_released;
 			bool							_opened;
+			//false when the binary log is the only output
+			bool							_has_text_sinks;
 			std::mutex						_mutex;
 
-			std::shared_ptr<spdlog::logger> _log_file;
+			std::shared_ptr<w_spdlog_logger> _log_file;
+			std::shared_ptr<w_log_binary>	_log_binary;
+			w_log_async						_async;
         };
     }
 
@@ -613,4 +705,89 @@ inline void V(
 
 #pragma endregion
 
+#pragma region W_LOG and W_V
+
+//levels of W_LOG_MIN_LEVEL, in the same order as w_log_type
+#define W_LOG_LEVEL_INFO		0
+#define W_LOG_LEVEL_WARNING		1
+#define W_LOG_LEVEL_ERROR		2
+#define W_LOG_LEVEL_OFF			3
+
+//W_LOG and W_V sites below this level are removed at compile time, e.g. define it as W_LOG_LEVEL_WARNING for shipping builds
+#ifndef W_LOG_MIN_LEVEL
+#define W_LOG_MIN_LEVEL W_LOG_LEVEL_INFO
+#endif
+
+//a log site of a level which is stripped, it compiles to nothing
+template<w_log_type pLogType, bool pIsCompiled = (static_cast<int>(pLogType) >= W_LOG_MIN_LEVEL)>
+struct w_log_site
+{
+	static const bool is_compiled = false;
+
+	static bool should_log() { return false; }
+
+	template<typename Char, typename... w_args>
+	static void write(_In_z_ const Char*, _In_ const w_args&...) {}
+};
+
+template<w_log_type pLogType>
+struct w_log_site<pLogType, true>
+{
+	static const bool is_compiled = true;
+
+	static bool should_log()
+	{
+		return wolf::logger.get_should_log(
+			pLogType == w_log_type::W_ERROR ? spdlog::level::err :
+			pLogType == w_log_type::W_WARNING ? spdlog::level::warn : spdlog::level::info);
+	}
+
+	template<typename Char, typename... w_args>
+	static void write(_In_z_ const Char* pFormat, _In_ const w_args&... pArgs)
+	{
+		switch (pLogType)
+		{
+		default:
+		case w_log_type::W_INFO:
+			wolf::logger.write(pFormat, pArgs...);
+			break;
+		case w_log_type::W_WARNING:
+			wolf::logger.warning(pFormat, pArgs...);
+			break;
+		case w_log_type::W_ERROR:
+			wolf::logger.error(pFormat, pArgs...);
+			break;
+		}
+	}
+};
+
+/*
+	Write a log, e.g. W_LOG(w_log_type::W_INFO, "loaded {} in {} ms", _path, _time)
+	Arguments are only evaluated when the level was compiled and the logger writes this level
+*/
+#define W_LOG(pLogType, ...)																\
+	do																						\
+	{																						\
+		if (w_log_site<pLogType>::is_compiled && w_log_site<pLogType>::should_log())		\
+		{																					\
+			w_log_site<pLogType>::write(__VA_ARGS__);										\
+		}																					\
+	} while (false)
+
+/*
+	Validate W_RESULT and write a log if it is not W_PASSED, e.g. W_V(_hr, w_log_type::W_ERROR, "could not map. trace info: {}", _trace_info)
+	Unlike V, arguments are not evaluated when pResult is W_PASSED, the level was stripped or the logger does not write this level
+*/
+#define W_V(pResult, pLogType, ...)															\
+	do																						\
+	{																						\
+		if ((pResult) != W_PASSED &&														\
+			w_log_site<pLogType>::is_compiled && w_log_site<pLogType>::should_log())		\
+		{																					\
+			w_log_site<pLogType>::write(__VA_ARGS__);										\
+		}																					\
+	} while (false)
+
+#pragma endregion
+
 #endif //__W_LOGGER_H__
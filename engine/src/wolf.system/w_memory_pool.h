@@ -17,6 +17,9 @@
 #include "w_system_export.h"
 #include "w_std.h"
 #include <w_aligned_malloc.h>
+#include "w_page_allocator.h"
+#include "w_memory_tracker.h"
+#include <cstring>
 
 #define __1KB__ 1024
 #define __1MB__ 1024 * __1KB__
@@ -41,45 +44,102 @@ namespace wolf
                 release();
             }
 
-            //Allocate block of memory (in bytes)
-            void* alloc(_In_ size_t pSizeInBytes, _In_ size_t pAlignment = 16)
+            /*
+                Allocate block of memory (in bytes)
+                @param pSizeInBytes, size of memory in bytes
+                @param pAlignment, alignment of memory
+                @param pPolicy, use huge pages or NUMA placement for large blocks, see w_page_allocator.h
+                the block is accounted to the memory category of calling thread, see w_memory_tag_scope
+            */
+            void* alloc(
+                _In_ size_t pSizeInBytes,
+                _In_ size_t pAlignment = 16,
+                _In_ w_memory_policy pPolicy = W_MEMORY_POLICY_DEFAULT)
             {
+                //free the previous block
+                release();
+
                 this->_size_in_bytes = pSizeInBytes;
 				this->_alignment = pAlignment;
-
+				this->_policy = pPolicy;
+				this->_category = w_memory_tracker::get_thread_category();
+				this->_is_released = false;
+
+				if (pPolicy != W_MEMORY_POLICY_DEFAULT)
+				{
+					this->_ptr = page_allocator::allocate(pSizeInBytes, pPolicy, pAlignment);
+				}
+				else
+				{
 #if defined(__WIN32) || defined(_MSC_VER) 
-                this->_ptr = _aligned_malloc(pSizeInBytes, pAlignment);
+					this->_ptr = _aligned_malloc(pSizeInBytes, pAlignment);
 #else
-				this->_ptr = aligned_malloc(pSizeInBytes, pAlignment);
+					this->_ptr = aligned_malloc(pSizeInBytes, pAlignment);
 #endif
+				}
+				if (this->_ptr) w_memory_tracker::track_alloc(this->_category, pSizeInBytes);
                 return this->_ptr;
             }
 
-            //Re-allocate block of memory (in bytes)
+            //Re-allocate block of memory (in bytes), the content will be preserved up to the minimum of old and new sizes
 			void* re_alloc(_In_ size_t pSizeInBytes, _In_ size_t pAlignment = 16)
 			{
-				this->_size_in_bytes = pSizeInBytes;
-				this->_alignment = pAlignment;
-
+				if (!this->_ptr) return alloc(pSizeInBytes, pAlignment, this->_policy);
+
+				void* _ptr = nullptr;
+				if (this->_policy != W_MEMORY_POLICY_DEFAULT)
+				{
+					_ptr = page_allocator::allocate(pSizeInBytes, this->_policy, pAlignment);
+					if (_ptr)
+					{
+						std::memcpy(_ptr, this->_ptr, this->_size_in_bytes < pSizeInBytes ? this->_size_in_bytes : pSizeInBytes);
+						page_allocator::free(this->_ptr);
+					}
+				}
+				else
+				{
 #if defined(__WIN32) || defined(_MSC_VER) 
-				this->_ptr = _aligned_realloc(this->_ptr, pSizeInBytes, pAlignment);
+					_ptr = _aligned_realloc(this->_ptr, pSizeInBytes, pAlignment);
 #else
-				aligned_free(this->_ptr);
-				this->_ptr = aligned_malloc(pSizeInBytes, pAlignment);
+					_ptr = aligned_malloc(pSizeInBytes, pAlignment);
+					if (_ptr)
+					{
+						std::memcpy(_ptr, this->_ptr, this->_size_in_bytes < pSizeInBytes ? this->_size_in_bytes : pSizeInBytes);
+						aligned_free(this->_ptr);
+					}
 #endif
+				}
+				//on failure the old block is still valid
+				if (!_ptr) return nullptr;
+
+				w_memory_tracker::track_free(this->_category, this->_size_in_bytes);
+				w_memory_tracker::track_alloc(this->_category, pSizeInBytes);
+
+				this->_ptr = _ptr;
+				this->_size_in_bytes = pSizeInBytes;
+				this->_alignment = pAlignment;
 				return this->_ptr;
 			}
             
             //Discard all allocated memory
             ULONG release()
             {
-                if (this->_is_released) return 1;
-
+                if (this->_is_released || !this->_ptr) return 1;
+
+				if (this->_policy != W_MEMORY_POLICY_DEFAULT)
+				{
+					page_allocator::free(this->_ptr);
+				}
+				else
+				{
 #if defined(__WIN32) || defined(_MSC_VER) 
-				_aligned_free(this->_ptr);
+					_aligned_free(this->_ptr);
 #else
-				aligned_free(this->_ptr);
+					aligned_free(this->_ptr);
 #endif
+				}
+				w_memory_tracker::track_free(this->_category, this->_size_in_bytes);
+
 				this->_ptr = nullptr;
 				this->_size_in_bytes = 0;
 				this->_alignment = 0;
@@ -106,8 +166,18 @@ namespace wolf
 				return this->_alignment;
 			}
 
-			size_t											write_index = 0;
-			size_t											read_index = 0;
+			//Get memory category which this block is accounted to
+			w_memory_category get_category() const
+			{
+				return this->_category;
+			}
+
+			//Get requested allocation policy of memory, use page_allocator::get_applied_policy for the applied one
+			w_memory_policy get_policy() const
+			{
+				return this->_policy;
+			}
+
         private:
             //Prevent copying
             w_memory_pool(w_memory_pool const&);
@@ -116,6 +186,8 @@ namespace wolf
             void*                                           _ptr = nullptr;
             size_t                                          _size_in_bytes = 0;
 			size_t                                          _alignment = 0;
+			w_memory_policy                                 _policy = W_MEMORY_POLICY_DEFAULT;
+			w_memory_category                               _category = W_MEMORY_CATEGORY_SYSTEM;
             bool                                            _is_released = false;
 		};
 	}
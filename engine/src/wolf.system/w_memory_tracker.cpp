@@ -0,0 +1,361 @@
+#include "w_system_pch.h"
+#include "w_memory_tracker.h"
+#include "w_page_allocator.h"
+#include "w_frame_arena.h"
+#include <atomic>
+#include <fstream>
+#include <cstring>
+#include <rapidjson/writer.h>
+#include <rapidjson/prettywriter.h>
+#include <rapidjson/stringbuffer.h>
+
+namespace wolf
+{
+    namespace system
+    {
+        //shared counters of one category, padded to avoid false sharing between categories
+        struct w_memory_category_counters
+        {
+            std::atomic<int64_t>                    current_bytes;
+            std::atomic<int64_t>                    peak_bytes;
+            std::atomic<uint64_t>                   allocations;
+            std::atomic<uint64_t>                   frees;
+            std::atomic<int64_t>                    budget_bytes;
+            std::atomic<bool>                       is_budget_reported;
+            uint8_t                                 padding[16];
+        };
+
+        //zero initialized before any dynamic initialization, so it is safe to use from static destructors
+        static w_memory_category_counters s_counters[W_MEMORY_CATEGORY_MAX];
+
+        static const char* s_category_names[W_MEMORY_CATEGORY_MAX] =
+        {
+            "system",
+            "content_pipeline",
+            "render_cpu",
+            "render_gpu",
+            "media",
+            "logger",
+            "network"
+        };
+
+        //counters which were not published yet
+        struct w_memory_tracker_counts
+        {
+            int64_t                                 bytes[W_MEMORY_CATEGORY_MAX];
+            uint64_t                                allocations[W_MEMORY_CATEGORY_MAX];
+            uint64_t                                frees[W_MEMORY_CATEGORY_MAX];
+        };
+
+        static void publish_counts(_In_ const w_memory_tracker_counts& pCounts)
+        {
+            for (uint32_t i = 0; i < W_MEMORY_CATEGORY_MAX; ++i)
+            {
+                auto& _counters = s_counters[i];
+                if (pCounts.allocations[i]) _counters.allocations.fetch_add(pCounts.allocations[i], std::memory_order_relaxed);
+                if (pCounts.frees[i]) _counters.frees.fetch_add(pCounts.frees[i], std::memory_order_relaxed);
+                if (!pCounts.bytes[i]) continue;
+
+                auto _current = _counters.current_bytes.fetch_add(pCounts.bytes[i], std::memory_order_relaxed) + pCounts.bytes[i];
+                auto _peak = _counters.peak_bytes.load(std::memory_order_relaxed);
+                while (_current > _peak &&
+                    !_counters.peak_bytes.compare_exchange_weak(_peak, _current, std::memory_order_relaxed))
+                {
+                }
+
+                auto _budget = _counters.budget_bytes.load(std::memory_order_relaxed);
+                if (_budget && _current > _budget && !_counters.is_budget_reported.exchange(true, std::memory_order_relaxed))
+                {
+                    logger.warning("memory budget of category {} exceeded. current: {} bytes, budget: {} bytes",
+                        s_category_names[i], _current, _budget);
+                }
+            }
+        }
+
+        //thread local objects which are destroyed after the batch may still free memory, they publish directly
+        static thread_local bool s_is_thread_batch_destroyed = false;
+
+        struct w_memory_tracker_batch
+        {
+            w_memory_tracker_counts                 counts;
+            uint32_t                                events;
+
+            w_memory_tracker_batch() :
+                events(0)
+            {
+                std::memset(&this->counts, 0, sizeof(this->counts));
+            }
+
+            ~w_memory_tracker_batch()
+            {
+                s_is_thread_batch_destroyed = true;
+                publish();
+            }
+
+            void publish()
+            {
+                //copy and reset first, logging may allocate and track again on this thread
+                auto _counts = this->counts;
+                std::memset(&this->counts, 0, sizeof(this->counts));
+                this->events = 0;
+                publish_counts(_counts);
+            }
+        };
+
+        static w_memory_tracker_batch& get_thread_batch()
+        {
+            static thread_local w_memory_tracker_batch _batch;
+            return _batch;
+        }
+
+        static void publish_now(_In_ const w_memory_category& pCategory, _In_ const int64_t& pBytes, _In_ const bool& pIsAllocation)
+        {
+            w_memory_tracker_counts _counts;
+            std::memset(&_counts, 0, sizeof(_counts));
+            _counts.bytes[pCategory] = pBytes;
+            if (pIsAllocation)
+            {
+                _counts.allocations[pCategory] = 1;
+            }
+            else
+            {
+                _counts.frees[pCategory] = 1;
+            }
+            publish_counts(_counts);
+        }
+
+        static thread_local w_memory_category s_thread_category = W_MEMORY_CATEGORY_SYSTEM;
+
+        template<typename W>
+        static void write_json(_Inout_ W& pWriter)
+        {
+            auto _all_stats = w_memory_tracker::get_all_stats();
+
+            pWriter.StartObject();
+            pWriter.Key("total_bytes");
+            pWriter.Int64(w_memory_tracker::get_total_bytes());
+
+            pWriter.Key("categories");
+            pWriter.StartObject();
+            for (auto& _stats : _all_stats)
+            {
+                pWriter.Key(w_memory_tracker::get_category_name(_stats.category));
+                pWriter.StartObject();
+                pWriter.Key("current_bytes");
+                pWriter.Int64(_stats.current_bytes);
+                pWriter.Key("peak_bytes");
+                pWriter.Int64(_stats.peak_bytes);
+                pWriter.Key("allocations");
+                pWriter.Uint64(_stats.allocations);
+                pWriter.Key("frees");
+                pWriter.Uint64(_stats.frees);
+                pWriter.Key("budget_bytes");
+                pWriter.Int64(_stats.budget_bytes);
+                pWriter.Key("over_budget");
+                pWriter.Bool(_stats.budget_bytes && _stats.current_bytes > _stats.budget_bytes);
+                pWriter.EndObject();
+            }
+            pWriter.EndObject();
+
+            auto _page_stats = page_allocator::get_stats();
+            pWriter.Key("page_allocator");
+            pWriter.StartObject();
+            pWriter.Key("allocations");
+            pWriter.Uint64(_page_stats.allocations);
+            pWriter.Key("allocated_bytes");
+            pWriter.Uint64(_page_stats.allocated_bytes);
+            pWriter.Key("peak_allocated_bytes");
+            pWriter.Uint64(_page_stats.peak_allocated_bytes);
+            pWriter.Key("huge_page_bytes");
+            pWriter.Uint64(_page_stats.huge_page_bytes);
+            pWriter.Key("transparent_huge_page_bytes");
+            pWriter.Uint64(_page_stats.transparent_huge_page_bytes);
+            pWriter.Key("numa_local_bytes");
+            pWriter.Uint64(_page_stats.numa_local_bytes);
+            pWriter.Key("fallbacks");
+            pWriter.Uint64(_page_stats.fallbacks);
+            pWriter.EndObject();
+
+            pWriter.Key("frame_arenas");
+            pWriter.StartObject();
+            pWriter.Key("frame_index");
+            pWriter.Uint64(w_frame_arena::get_frame_index());
+            pWriter.Key("frame_high_water_mark");
+            pWriter.Uint64(w_frame_arena::get_frame_high_water_mark());
+            pWriter.Key("arenas");
+            pWriter.StartArray();
+            for (auto& _arena : w_frame_arena::get_all_stats())
+            {
+                pWriter.StartObject();
+                pWriter.Key("thread_id");
+                pWriter.Uint64(_arena.thread_id);
+                pWriter.Key("capacity");
+                pWriter.Uint64(_arena.capacity);
+                pWriter.Key("number_of_buffers");
+                pWriter.Uint64(_arena.number_of_buffers);
+                pWriter.Key("last_frame_used");
+                pWriter.Uint64(_arena.last_frame_used);
+                pWriter.Key("high_water_mark");
+                pWriter.Uint64(_arena.high_water_mark);
+                pWriter.Key("total_overflows");
+                pWriter.Uint64(_arena.total_overflows);
+                pWriter.EndObject();
+            }
+            pWriter.EndArray();
+            pWriter.EndObject();
+
+            pWriter.EndObject();
+        }
+    }
+}
+
+using namespace wolf::system;
+
+void w_memory_tracker::track_alloc(_In_ const w_memory_category& pCategory, _In_ const size_t& pSizeInBytes)
+{
+    if (pCategory >= W_MEMORY_CATEGORY_MAX) return;
+    if (s_is_thread_batch_destroyed)
+    {
+        publish_now(pCategory, static_cast<int64_t>(pSizeInBytes), true);
+        return;
+    }
+
+    auto& _batch = get_thread_batch();
+    _batch.counts.bytes[pCategory] += static_cast<int64_t>(pSizeInBytes);
+    _batch.counts.allocations[pCategory]++;
+    if (++_batch.events >= W_MEMORY_TRACKER_BATCH_EVENTS || _batch.counts.bytes[pCategory] >= W_MEMORY_TRACKER_BATCH_BYTES)
+    {
+        _batch.publish();
+    }
+}
+
+void w_memory_tracker::track_free(_In_ const w_memory_category& pCategory, _In_ const size_t& pSizeInBytes)
+{
+    if (pCategory >= W_MEMORY_CATEGORY_MAX) return;
+    if (s_is_thread_batch_destroyed)
+    {
+        publish_now(pCategory, -static_cast<int64_t>(pSizeInBytes), false);
+        return;
+    }
+
+    auto& _batch = get_thread_batch();
+    _batch.counts.bytes[pCategory] -= static_cast<int64_t>(pSizeInBytes);
+    _batch.counts.frees[pCategory]++;
+    if (++_batch.events >= W_MEMORY_TRACKER_BATCH_EVENTS || _batch.counts.bytes[pCategory] <= -(W_MEMORY_TRACKER_BATCH_BYTES))
+    {
+        _batch.publish();
+    }
+}
+
+void w_memory_tracker::flush()
+{
+    if (s_is_thread_batch_destroyed) return;
+    get_thread_batch().publish();
+}
+
+std::string w_memory_tracker::to_json(_In_ const bool& pPretty)
+{
+    flush();
+
+    rapidjson::StringBuffer _buffer;
+    if (pPretty)
+    {
+        rapidjson::PrettyWriter<rapidjson::StringBuffer> _writer(_buffer);
+        write_json(_writer);
+    }
+    else
+    {
+        rapidjson::Writer<rapidjson::StringBuffer> _writer(_buffer);
+        write_json(_writer);
+    }
+    return std::string(_buffer.GetString(), _buffer.GetSize());
+}
+
+W_RESULT w_memory_tracker::dump_json(_In_z_ const std::string& pPath, _In_ const bool& pPretty)
+{
+    auto _json = to_json(pPretty);
+
+    std::ofstream _file(pPath, std::ios::out | std::ios::trunc);
+    if (!_file || _file.bad())
+    {
+        V(W_FAILED, w_log_type::W_ERROR, "creating memory statistics file on following path: {}. trace info: {}", pPath, "w_memory_tracker::dump_json");
+        return W_FAILED;
+    }
+    _file << _json;
+    _file.close();
+
+    return W_PASSED;
+}
+
+#pragma region Getters
+
+w_memory_category_stats w_memory_tracker::get_stats(_In_ const w_memory_category& pCategory)
+{
+    w_memory_category_stats _stats;
+    if (pCategory >= W_MEMORY_CATEGORY_MAX) return _stats;
+
+    //make the counters of calling thread visible
+    flush();
+
+    auto& _counters = s_counters[pCategory];
+    _stats.category = pCategory;
+    _stats.current_bytes = _counters.current_bytes.load(std::memory_order_relaxed);
+    _stats.peak_bytes = _counters.peak_bytes.load(std::memory_order_relaxed);
+    _stats.allocations = _counters.allocations.load(std::memory_order_relaxed);
+    _stats.frees = _counters.frees.load(std::memory_order_relaxed);
+    _stats.budget_bytes = _counters.budget_bytes.load(std::memory_order_relaxed);
+    return _stats;
+}
+
+std::vector<w_memory_category_stats> w_memory_tracker::get_all_stats()
+{
+    std::vector<w_memory_category_stats> _stats;
+    _stats.reserve(W_MEMORY_CATEGORY_MAX);
+    for (uint32_t i = 0; i < W_MEMORY_CATEGORY_MAX; ++i)
+    {
+        _stats.push_back(get_stats(static_cast<w_memory_category>(i)));
+    }
+    return _stats;
+}
+
+int64_t w_memory_tracker::get_total_bytes()
+{
+    flush();
+
+    int64_t _total = 0;
+    for (auto& _counters : s_counters)
+    {
+        _total += _counters.current_bytes.load(std::memory_order_relaxed);
+    }
+    return _total;
+}
+
+const char* w_memory_tracker::get_category_name(_In_ const w_memory_category& pCategory)
+{
+    return pCategory < W_MEMORY_CATEGORY_MAX ? s_category_names[pCategory] : "unknown";
+}
+
+w_memory_category w_memory_tracker::get_thread_category()
+{
+    return s_thread_category;
+}
+
+#pragma endregion
+
+#pragma region Setters
+
+void w_memory_tracker::set_budget(_In_ const w_memory_category& pCategory, _In_ const int64_t& pBudgetInBytes)
+{
+    if (pCategory >= W_MEMORY_CATEGORY_MAX) return;
+
+    auto& _counters = s_counters[pCategory];
+    _counters.budget_bytes.store(pBudgetInBytes, std::memory_order_relaxed);
+    _counters.is_budget_reported.store(false, std::memory_order_relaxed);
+}
+
+void w_memory_tracker::set_thread_category(_In_ const w_memory_category& pCategory)
+{
+    s_thread_category = pCategory < W_MEMORY_CATEGORY_MAX ? pCategory : W_MEMORY_CATEGORY_SYSTEM;
+}
+
+#pragma endregion
@@ -0,0 +1,129 @@
+/*
+	Project			 : Wolf Engine. Copyright(c) Pooya Eimandar (http://PooyaEimandar.com) . All rights reserved.
+	Source			 : Please direct any bug to https://github.com/PooyaEimandar/Wolf.Engine/issues
+	Website			 : http://WolfSource.io
+	Name			 : w_memory_tracker.h
+	Description		 : Engine wide memory accounting, allocations are tagged by category and counted per category
+	Comment          : each thread batches its counters and publishes them to the shared counters once the batch is large enough
+*/
+
+#if _MSC_VER > 1000
+#pragma once
+#endif
+
+#ifndef __W_MEMORY_TRACKER_H__
+#define __W_MEMORY_TRACKER_H__
+
+#include "w_system_export.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "w_std.h"
+
+//a thread publishes its batched counters once the sum of its byte changes of one category reaches this size
+#ifndef W_MEMORY_TRACKER_BATCH_BYTES
+#define W_MEMORY_TRACKER_BATCH_BYTES (64 * 1024)
+#endif
+
+//a thread publishes its batched counters after this number of allocations and frees
+#ifndef W_MEMORY_TRACKER_BATCH_EVENTS
+#define W_MEMORY_TRACKER_BATCH_EVENTS 256
+#endif
+
+namespace wolf
+{
+	namespace system
+	{
+        enum w_memory_category : uint32_t
+        {
+            W_MEMORY_CATEGORY_SYSTEM = 0,
+            W_MEMORY_CATEGORY_CONTENT_PIPELINE,
+            //cpu side memory of renderer, including host allocations of vulkan memory allocator
+            W_MEMORY_CATEGORY_RENDER_CPU,
+            //device memory which was allocated by vulkan memory allocator
+            W_MEMORY_CATEGORY_RENDER_GPU,
+            W_MEMORY_CATEGORY_MEDIA,
+            W_MEMORY_CATEGORY_LOGGER,
+            W_MEMORY_CATEGORY_NETWORK,
+            //number of categories, not a category
+            W_MEMORY_CATEGORY_MAX
+        };
+
+        struct w_memory_category_stats
+        {
+            w_memory_category   category = W_MEMORY_CATEGORY_SYSTEM;
+            //bytes which are alive
+            int64_t             current_bytes = 0;
+            //maximum of current bytes, it is sampled when threads publish their batches
+            int64_t             peak_bytes = 0;
+            //total number of allocations and frees
+            uint64_t            allocations = 0;
+            uint64_t            frees = 0;
+            //zero means no budget
+            int64_t             budget_bytes = 0;
+        };
+
+        /*
+            Counters of each thread are published to the shared counters when a batch is full, when a
+            thread exits or when flush is called, so current values of other threads may lag behind by
+            at most one batch per thread
+        */
+        class w_memory_tracker
+        {
+        public:
+            //account pSizeInBytes bytes which were allocated for pCategory
+            WSYS_EXP static void track_alloc(_In_ const w_memory_category& pCategory, _In_ const size_t& pSizeInBytes);
+            //account pSizeInBytes bytes of pCategory which were freed
+            WSYS_EXP static void track_free(_In_ const w_memory_category& pCategory, _In_ const size_t& pSizeInBytes);
+            //publish batched counters of calling thread
+            WSYS_EXP static void flush();
+
+            //get statistics as JSON, statistics of page allocator and frame arenas are included
+            WSYS_EXP static std::string to_json(_In_ const bool& pPretty = false);
+            //write JSON statistics to a file
+            WSYS_EXP static W_RESULT dump_json(_In_z_ const std::string& pPath, _In_ const bool& pPretty = true);
+
+#pragma region Getters
+            WSYS_EXP static w_memory_category_stats get_stats(_In_ const w_memory_category& pCategory);
+            WSYS_EXP static std::vector<w_memory_category_stats> get_all_stats();
+            //get sum of current bytes of all categories
+            WSYS_EXP static int64_t get_total_bytes();
+            WSYS_EXP static const char* get_category_name(_In_ const w_memory_category& pCategory);
+            //get category of calling thread which is used by allocators that are not tagged explicitly
+            WSYS_EXP static w_memory_category get_thread_category();
+#pragma endregion
+
+#pragma region Setters
+            //set budget of a category in bytes, zero disables it. Exceeding a budget is reported once by logger
+            WSYS_EXP static void set_budget(_In_ const w_memory_category& pCategory, _In_ const int64_t& pBudgetInBytes);
+            WSYS_EXP static void set_thread_category(_In_ const w_memory_category& pCategory);
+#pragma endregion
+        };
+
+        //tag allocations of calling thread with a category till end of scope
+        class w_memory_tag_scope
+        {
+        public:
+            explicit w_memory_tag_scope(_In_ const w_memory_category& pCategory) :
+                _previous(w_memory_tracker::get_thread_category())
+            {
+                w_memory_tracker::set_thread_category(pCategory);
+            }
+
+            ~w_memory_tag_scope()
+            {
+                w_memory_tracker::set_thread_category(this->_previous);
+            }
+
+        private:
+            //Prevent copying
+            w_memory_tag_scope(w_memory_tag_scope const&);
+            w_memory_tag_scope& operator= (w_memory_tag_scope const&);
+
+            w_memory_category                       _previous;
+        };
+	}
+}
+
+#endif //__W_MEMORY_TRACKER_H__
@@ -0,0 +1,308 @@
+/*
+	Project			 : Wolf Engine. Copyright(c) Pooya Eimandar (http://PooyaEimandar.com) . All rights reserved.
+	Source			 : Please direct any bug to https://github.com/PooyaEimandar/Wolf.Engine/issues
+	Website			 : http://WolfSource.io
+	Name			 : w_mpsc_queue.h
+	Description		 : A bounded lock-free multi producer single consumer queue and a move only job with small buffer storage
+	Comment          : the queue is based on Dmitry Vyukov's bounded queue, each cell owns a sequence number
+*/
+
+#if _MSC_VER > 1000
+#pragma once
+#endif
+
+#ifndef __W_MPSC_QUEUE_H__
+#define __W_MPSC_QUEUE_H__
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#if defined(__ANDROID) || defined(__linux) || defined(__APPLE__)
+#include "w_std.h"
+#endif
+
+namespace wolf
+{
+	namespace system
+	{
+        //size of cache line which is used for padding of shared atomics
+#ifndef W_CACHE_LINE_SIZE
+#define W_CACHE_LINE_SIZE 64
+#endif
+
+        /*
+            a move only callable of void(), captures which fit in inline_size bytes are stored
+            inside the job, so submitting them does not allocate. Bigger captures fall back to the heap
+        */
+        class w_job
+        {
+        public:
+            static const size_t inline_size = 64;
+
+            w_job() noexcept : _vtable(nullptr)
+            {
+            }
+
+            template<typename F, typename = typename std::enable_if<
+                !std::is_same<typename std::decay<F>::type, w_job>::value>::type>
+            w_job(_In_ F&& pFunc) : _vtable(nullptr)
+            {
+                typedef typename std::decay<F>::type _func_type;
+                _construct<_func_type>(std::forward<F>(pFunc), std::integral_constant<bool, _fits_inline<_func_type>()>());
+            }
+
+            w_job(_In_ w_job&& pOther) noexcept : _vtable(pOther._vtable)
+            {
+                if (this->_vtable)
+                {
+                    this->_vtable->move(&this->_storage, &pOther._storage);
+                    pOther._vtable = nullptr;
+                }
+            }
+
+            w_job& operator= (_In_ w_job&& pOther) noexcept
+            {
+                if (this != &pOther)
+                {
+                    reset();
+                    if (pOther._vtable)
+                    {
+                        pOther._vtable->move(&this->_storage, &pOther._storage);
+                        this->_vtable = pOther._vtable;
+                        pOther._vtable = nullptr;
+                    }
+                }
+                return *this;
+            }
+
+            ~w_job()
+            {
+                reset();
+            }
+
+            void operator()()
+            {
+                this->_vtable->invoke(&this->_storage);
+            }
+
+            //destroy the stored callable
+            void reset() noexcept
+            {
+                if (this->_vtable)
+                {
+                    this->_vtable->destroy(&this->_storage);
+                    this->_vtable = nullptr;
+                }
+            }
+
+            explicit operator bool() const noexcept
+            {
+                return this->_vtable != nullptr;
+            }
+
+#pragma region Getters
+            //returns true if the callable stored inside the job without heap allocation
+            bool get_is_inline() const noexcept
+            {
+                return this->_vtable && this->_vtable->is_inline;
+            }
+#pragma endregion
+
+        private:
+            //Prevent copying
+            w_job(w_job const&);
+            w_job& operator= (w_job const&);
+
+            typedef typename std::aligned_storage<inline_size, alignof(std::max_align_t)>::type _storage_type;
+
+            struct w_job_vtable
+            {
+                void(*invoke)(void* pStorage);
+                void(*move)(void* pDestination, void* pSource);
+                void(*destroy)(void* pStorage);
+                bool is_inline;
+            };
+
+            template<typename F>
+            static constexpr bool _fits_inline()
+            {
+                return sizeof(F) <= sizeof(_storage_type) &&
+                    alignof(std::max_align_t) % alignof(F) == 0 &&
+                    std::is_nothrow_move_constructible<F>::value;
+            }
+
+            template<typename F>
+            struct w_inline_ops
+            {
+                static void invoke(void* pStorage)
+                {
+                    (*static_cast<F*>(pStorage))();
+                }
+                static void move(void* pDestination, void* pSource)
+                {
+                    auto _src = static_cast<F*>(pSource);
+                    ::new (pDestination) F(std::move(*_src));
+                    _src->~F();
+                }
+                static void destroy(void* pStorage)
+                {
+                    static_cast<F*>(pStorage)->~F();
+                }
+                static const w_job_vtable* get()
+                {
+                    static const w_job_vtable _vtable = { &invoke, &move, &destroy, true };
+                    return &_vtable;
+                }
+            };
+
+            template<typename F>
+            struct w_heap_ops
+            {
+                static void invoke(void* pStorage)
+                {
+                    (**static_cast<F**>(pStorage))();
+                }
+                static void move(void* pDestination, void* pSource)
+                {
+                    *static_cast<F**>(pDestination) = *static_cast<F**>(pSource);
+                }
+                static void destroy(void* pStorage)
+                {
+                    delete *static_cast<F**>(pStorage);
+                }
+                static const w_job_vtable* get()
+                {
+                    static const w_job_vtable _vtable = { &invoke, &move, &destroy, false };
+                    return &_vtable;
+                }
+            };
+
+            template<typename F, typename T>
+            void _construct(_In_ T&& pFunc, std::true_type)
+            {
+                ::new (&this->_storage) F(std::forward<T>(pFunc));
+                this->_vtable = w_inline_ops<F>::get();
+            }
+
+            template<typename F, typename T>
+            void _construct(_In_ T&& pFunc, std::false_type)
+            {
+                *reinterpret_cast<F**>(&this->_storage) = new F(std::forward<T>(pFunc));
+                this->_vtable = w_heap_ops<F>::get();
+            }
+
+            _storage_type                               _storage;
+            const w_job_vtable*                         _vtable;
+        };
+
+        /*
+            bounded lock-free queue, any number of threads may call try_enqueue
+            but only one thread is allowed to call try_dequeue at a time
+        */
+        template<typename T>
+        class w_mpsc_queue
+        {
+        public:
+            //pCapacity will be rounded up to the next power of two
+            explicit w_mpsc_queue(_In_ size_t pCapacity) :
+                _enqueue_pos(0),
+                _dequeue_pos(0)
+            {
+                size_t _capacity = 2;
+                while (_capacity < pCapacity) _capacity <<= 1;
+
+                this->_mask = _capacity - 1;
+                this->_cells = new w_cell[_capacity];
+                for (size_t i = 0; i < _capacity; ++i)
+                {
+                    this->_cells[i].sequence.store(i, std::memory_order_relaxed);
+                }
+            }
+
+            ~w_mpsc_queue()
+            {
+                delete[] this->_cells;
+            }
+
+            /*
+                try to push an item, returns false if the queue is full
+                pItem will not be moved from unless this function returns true
+            */
+            bool try_enqueue(_In_ T&& pItem)
+            {
+                w_cell* _cell;
+                auto _pos = this->_enqueue_pos.load(std::memory_order_relaxed);
+                for (;;)
+                {
+                    _cell = &this->_cells[_pos & this->_mask];
+                    auto _seq = _cell->sequence.load(std::memory_order_acquire);
+                    auto _diff = static_cast<intptr_t>(_seq) - static_cast<intptr_t>(_pos);
+                    if (_diff == 0)
+                    {
+                        if (this->_enqueue_pos.compare_exchange_weak(_pos, _pos + 1, std::memory_order_relaxed)) break;
+                    }
+                    else if (_diff < 0)
+                    {
+                        //queue is full
+                        return false;
+                    }
+                    else
+                    {
+                        _pos = this->_enqueue_pos.load(std::memory_order_relaxed);
+                    }
+                }
+
+                _cell->data = std::move(pItem);
+                _cell->sequence.store(_pos + 1, std::memory_order_release);
+                return true;
+            }
+
+            //try to pop an item, must only be called from the consumer thread
+            bool try_dequeue(_Inout_ T& pItem)
+            {
+                auto _cell = &this->_cells[this->_dequeue_pos & this->_mask];
+                auto _seq = _cell->sequence.load(std::memory_order_acquire);
+                if (static_cast<intptr_t>(_seq) - static_cast<intptr_t>(this->_dequeue_pos + 1) < 0)
+                {
+                    //queue is empty or producer did not finish writing yet
+                    return false;
+                }
+
+                pItem = std::move(_cell->data);
+                _cell->sequence.store(this->_dequeue_pos + this->_mask + 1, std::memory_order_release);
+                this->_dequeue_pos++;
+                return true;
+            }
+
+#pragma region Getters
+            size_t get_capacity() const
+            {
+                return this->_mask + 1;
+            }
+#pragma endregion
+
+        private:
+            //Prevent copying
+            w_mpsc_queue(w_mpsc_queue const&);
+            w_mpsc_queue& operator= (w_mpsc_queue const&);
+
+            struct w_cell
+            {
+                std::atomic<size_t>                     sequence;
+                T                                       data;
+            };
+
+            w_cell*                                     _cells;
+            size_t                                      _mask;
+            //producers and consumer positions live in different cache lines
+            alignas(W_CACHE_LINE_SIZE) std::atomic<size_t>  _enqueue_pos;
+            alignas(W_CACHE_LINE_SIZE) size_t               _dequeue_pos;
+        };
+	}
+}
+
+#endif //__W_MPSC_QUEUE_H__
@@ -1,5 +1,6 @@
 #include "w_system_pch.h"
 #include "w_network.h"
+#include "w_network_message.h"
 
 #include <nanomsg/nn.h>
 #include <nanomsg/reqrep.h>
@@ -47,12 +48,12 @@ namespace wolf
 				_In_ w_socket_options* pSocketRecieveOption = nullptr,
 				_In_ std::initializer_list<const char*> pConnectURLs = {})
             {
-				const std::string _trace_info = this->_name + "::initialize";
+				const char* _trace_info = "w_network::initialize";
 
 				this->_socket = nn_socket(pDomain, pProtocol);
 				if (this->_socket < 0)
 				{
-					V(W_FAILED, w_log_type::W_ERROR, "creating socket. error: {}, trace info: {}", w_network::get_last_error(), _trace_info);
+					W_V(W_FAILED, w_log_type::W_ERROR, "creating socket. error: {}, trace info: {}", w_network::get_last_error(), _trace_info);
 					return W_FAILED;
 				}
                 
@@ -72,7 +73,7 @@ namespace wolf
 					//on bind, which used for server
 					if (nn_bind(this->_socket, pURL) < 0)
 					{
-						V(W_FAILED, w_log_type::W_ERROR, "binding to {}. error: {}, trace info: {}", pURL, w_network::get_last_error(), _trace_info);
+						W_V(W_FAILED, w_log_type::W_ERROR, "binding to {}. error: {}, trace info: {}", pURL, w_network::get_last_error(), _trace_info);
 						return W_FAILED;
 					}
 					break;
@@ -80,7 +81,7 @@ namespace wolf
 					//on connect, which used for client
 					if (nn_connect(this->_socket, pURL) < 0)
 					{
-						V(W_FAILED, w_log_type::W_ERROR, "connecting to {}. error: {}, trace info: {}", pURL, w_network::get_last_error(), _trace_info);
+						W_V(W_FAILED, w_log_type::W_ERROR, "connecting to {}. error: {}, trace info: {}", pURL, w_network::get_last_error(), _trace_info);
 						return W_FAILED;
 					}
 					break;
@@ -92,7 +93,7 @@ namespace wolf
 				{
 					if (nn_connect(this->_socket, con) < 0)
 					{
-						V(W_FAILED, w_log_type::W_ERROR, "connecting to {}. error: {}, trace info: {}", con, w_network::get_last_error(), _trace_info);
+						W_V(W_FAILED, w_log_type::W_ERROR, "connecting to {}. error: {}, trace info: {}", con, w_network::get_last_error(), _trace_info);
 						return W_FAILED;
 					}
 				}
@@ -107,7 +108,7 @@ namespace wolf
 			{
 				if (!pSocketOption) return W_FAILED;
 
-				const std::string _trace_info = this->_name + "::set_socket_option";
+				const char* _trace_info = "w_network::set_socket_option";
 				if (nn_setsockopt(
 					this->_socket,
 					pSocketOption->socket_level,
@@ -115,7 +116,7 @@ namespace wolf
 					pSocketOption->option_value,
 					pSocketOption->option_value_length) < 0)
 				{
-					V(W_FAILED, w_log_type::W_ERROR, "setting socket option. level: {} option: {} . error: {}, trace info: {}",
+					W_V(W_FAILED, w_log_type::W_ERROR, "setting socket option. level: {} option: {} . error: {}, trace info: {}",
 						pSocketOption->socket_level, pSocketOption->option, w_network::get_last_error(), _trace_info);
 					return W_FAILED;
 				}
@@ -165,7 +166,7 @@ W_RESULT w_network::setup_request_reply_server(
 {
 	if (!this->_pimp) return W_FAILED;
 
-	const std::string _trace_info = "w_network::setup_request_reply_server";
+	const char* _trace_info = "w_network::setup_request_reply_server";
 
 	w_network_pimp::w_socket_options* _socket_options = nullptr;
 	if (pReceiveTimeOut)
@@ -180,7 +181,7 @@ W_RESULT w_network::setup_request_reply_server(
 		}
 		else
 		{
-			V(W_FAILED, w_log_type::W_ERROR, "allocating memory for socket option. trace info: {}", _trace_info);
+			W_V(W_FAILED, w_log_type::W_ERROR, "allocating memory for socket option. trace info: {}", _trace_info);
 		}
 	}
 	
@@ -206,7 +207,7 @@ W_RESULT w_network::setup_one_way_pusher(
 {
 	if (!this->_pimp) return W_FAILED;
 
-	const std::string _trace_info = "w_network::setup_one_way_pusher";
+	const char* _trace_info = "w_network::setup_one_way_pusher";
 
 	w_network_pimp::w_socket_options* _socket_send_options = nullptr;
 	if (pSendTimeOut)
@@ -221,7 +222,7 @@ W_RESULT w_network::setup_one_way_pusher(
 		}
 		else
 		{
-			V(W_FAILED, w_log_type::W_ERROR, "allocating memory for socket option. trace info: {}", _trace_info);
+			W_V(W_FAILED, w_log_type::W_ERROR, "allocating memory for socket option. trace info: {}", _trace_info);
 		}
 	}
 
@@ -248,7 +249,7 @@ W_RESULT w_network::setup_one_way_puller(
 {
     if (!this->_pimp) return W_FAILED;
 
-	const std::string _trace_info = "w_network::setup_one_way_puller";
+	const char* _trace_info = "w_network::setup_one_way_puller";
 
 	w_network_pimp::w_socket_options* _socket_receive_options = nullptr;
 	if (pReceiveTimeOut)
@@ -263,7 +264,7 @@ W_RESULT w_network::setup_one_way_puller(
 		}
 		else
 		{
-			V(W_FAILED, w_log_type::W_ERROR, "allocating memory for socket option. trace info: {}", _trace_info);
+			W_V(W_FAILED, w_log_type::W_ERROR, "allocating memory for socket option. trace info: {}", _trace_info);
 		}
 	}
 
@@ -292,7 +293,7 @@ W_RESULT w_network::setup_two_way_server(
 {
     if (!this->_pimp) return W_FAILED;
 	
-	const std::string _trace_info = "w_network::setup_two_way_server";
+	const char* _trace_info = "w_network::setup_two_way_server";
 
 	w_network_pimp::w_socket_options* _socket_send_options = nullptr;
 	w_network_pimp::w_socket_options* _socket_receive_options = nullptr;
@@ -308,7 +309,7 @@ W_RESULT w_network::setup_two_way_server(
 		}
 		else
 		{
-			V(W_FAILED, w_log_type::W_ERROR, "allocating memory for socket option. trace_info: {}", _trace_info);
+			W_V(W_FAILED, w_log_type::W_ERROR, "allocating memory for socket option. trace_info: {}", _trace_info);
 		}
 	}
 	if (pReceiveTimeOut)
@@ -323,7 +324,7 @@ W_RESULT w_network::setup_two_way_server(
 		}
 		else
 		{
-			V(W_FAILED, w_log_type::W_ERROR, "allocating memory for socket option. trace_info: {}", _trace_info);
+			W_V(W_FAILED, w_log_type::W_ERROR, "allocating memory for socket option. trace_info: {}", _trace_info);
 		}
 	}
 
@@ -355,7 +356,7 @@ W_RESULT w_network::setup_two_way_client(
 {
     if (!this->_pimp) return W_FAILED;
 
-	const std::string _trace_info = "w_network::setup_two_way_client";
+	const char* _trace_info = "w_network::setup_two_way_client";
     
 	w_network_pimp::w_socket_options* _socket_send_options = nullptr;
 	w_network_pimp::w_socket_options* _socket_receive_options = nullptr;
@@ -371,7 +372,7 @@ W_RESULT w_network::setup_two_way_client(
 		}
 		else
 		{
-			V(W_FAILED, w_log_type::W_ERROR, "allocating memory for socket option. trace_info: {}", _trace_info);
+			W_V(W_FAILED, w_log_type::W_ERROR, "allocating memory for socket option. trace_info: {}", _trace_info);
 		}
 	}
 	if (pReceiveTimeOut)
@@ -386,7 +387,7 @@ W_RESULT w_network::setup_two_way_client(
 		}
 		else
 		{
-			V(W_FAILED, w_log_type::W_ERROR, "allocating memory for socket option. trace_info: {}", _trace_info);
+			W_V(W_FAILED, w_log_type::W_ERROR, "allocating memory for socket option. trace_info: {}", _trace_info);
 		}
 	}
 
@@ -488,10 +489,10 @@ W_RESULT w_network::setup_bus_node(
 W_RESULT w_network::free_buffer(_In_z_ char* pBuffer)
 {
 	if (!pBuffer) return W_PASSED;
-	const std::string _trace_info = "w_network::free_buffer";
+	const char* _trace_info = "w_network::free_buffer";
 	if (nn_freemsg(pBuffer) < 0)
 	{
-		V(W_FAILED, w_log_type::W_ERROR, "free buffer. trace info: {}", _trace_info);
+		W_V(W_FAILED, w_log_type::W_ERROR, "free buffer. trace info: {}", _trace_info);
 		return W_FAILED;
 	}
 	return W_PASSED;
@@ -511,13 +512,49 @@ ULONG w_network::release()
     return _super::release();
 }
 
-int w_network::send(_In_ const int& pSocketID, _In_z_ const char* pMessage, _In_ const size_t& pMessageSize)
+int w_network::send(
+	_In_ const int& pSocketID,
+	_In_z_ const char* pMessage,
+	_In_ const size_t& pMessageSize,
+	_In_ const bool& pDontWait)
 {
-    return nn_send(pSocketID, pMessage, pMessageSize, 0);
+    return nn_send(pSocketID, pMessage, pMessageSize, pDontWait ? NN_DONTWAIT : 0);
 }
 
-int w_network::receive(_In_ const int& pSocketID, _In_opt_z_ char** pBuffer)
+int w_network::receive(_In_ const int& pSocketID, _In_opt_z_ char** pBuffer, _In_ const bool& pDontWait)
 {
-    return nn_recv(pSocketID, pBuffer, NN_MSG, 0);
+    return nn_recv(pSocketID, pBuffer, NN_MSG, pDontWait ? NN_DONTWAIT : 0);
 }
 
+
+int w_network::send(_In_ const int& pSocketID, _Inout_ w_network_message& pMessage, _In_ const bool& pDontWait)
+{
+	auto _flags = pDontWait ? NN_DONTWAIT : 0;
+	if (pMessage.get_is_empty())
+	{
+		return nn_send(pSocketID, "", 0, _flags);
+	}
+
+	auto _size = pMessage.get_size();
+	auto _buffer = pMessage._detach();
+	if (!_buffer) return -1;
+
+	auto _hr = nn_send(pSocketID, &_buffer, NN_MSG, _flags);
+	if (_hr < 0)
+	{
+		//nanomsg did not take the buffer
+		pMessage._attach(_buffer, _size);
+	}
+	return _hr;
+}
+
+int w_network::receive(_In_ const int& pSocketID, _Inout_ w_network_message& pMessage, _In_ const bool& pDontWait)
+{
+	char* _buffer = nullptr;
+	auto _hr = nn_recv(pSocketID, &_buffer, NN_MSG, pDontWait ? NN_DONTWAIT : 0);
+	if (_hr >= 0)
+	{
+		pMessage._attach(_buffer, static_cast<size_t>(_hr));
+	}
+	return _hr;
+}
@@ -106,6 +106,7 @@ namespace wolf
 			W_EWOULDBLOCK		= 140
 		};
 
+        class w_network_message;
         class w_network_pimp;
 		class w_network : w_object
 		{
@@ -172,17 +173,41 @@ namespace wolf
                 send message via socket
                 @param pSocketID, the id of socket object
                 @param pMessage, the message you want to send
+                @param pDontWait, do not block, returns -1 with W_EAGAIN if message could not be sent right away
                 @return, number of bytes sent
             */
-            WSYS_EXP static int send(_In_ const int& pSocketID, _In_z_ const char* pMessage, _In_ const size_t& pMessageSize);
+            WSYS_EXP static int send(
+                _In_ const int& pSocketID,
+                _In_z_ const char* pMessage,
+                _In_ const size_t& pMessageSize,
+                _In_ const bool& pDontWait = false);
 
             /*
                 receive buffer via socket
                 @param pSocketID, the id of socket object
                 @param pBuffer, the buffer which will be received 
+                @param pDontWait, do not block, returns -1 with W_EAGAIN if there is no message
                 @return, number of bytes received 
             */
-            WSYS_EXP static int receive(_In_ const int& pSocketID, _Inout_z_ char** pBuffer);
+            WSYS_EXP static int receive(_In_ const int& pSocketID, _Inout_z_ char** pBuffer, _In_ const bool& pDontWait = false);
+
+            /*
+                send message via socket without copying, buffer of message will be given to nanomsg
+                @param pSocketID, the id of socket object
+                @param pMessage, the message, it will be empty if it was sent, otherwise it keeps its buffer
+                @param pDontWait, do not block, returns -1 with W_EAGAIN if message could not be sent right away
+                @return, number of bytes sent
+            */
+            WSYS_EXP static int send(_In_ const int& pSocketID, _Inout_ w_network_message& pMessage, _In_ const bool& pDontWait = false);
+
+            /*
+                receive message via socket without copying, the message owns the buffer of nanomsg
+                @param pSocketID, the id of socket object
+                @param pMessage, the message, the previous buffer of message will be freed
+                @param pDontWait, do not block, returns -1 with W_EAGAIN if there is no message
+                @return, number of bytes received
+            */
+            WSYS_EXP static int receive(_In_ const int& pSocketID, _Inout_ w_network_message& pMessage, _In_ const bool& pDontWait = false);
 
 			//free message buffer
 			WSYS_EXP static W_RESULT free_buffer(_In_z_ char* pBuffer);
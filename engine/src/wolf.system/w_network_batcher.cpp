@@ -0,0 +1,572 @@
+#include "w_system_pch.h"
+#include "w_network_batcher.h"
+#include "w_network_message.h"
+#include "lz4/lz4.h"
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <chrono>
+#include <unordered_map>
+#include <vector>
+#include <memory>
+
+/*
+    layout of a batch:
+    uint8 magic, uint8 flags, uint16 number of messages, uint32 size of payload before compression, payload
+    payload is a sequence of messages, each one starts with its size as LEB128 varint
+*/
+#define W_NETWORK_BATCH_MAGIC           0xB7
+#define W_NETWORK_BATCH_FLAG_LZ4        0x01
+#define W_NETWORK_BATCH_HEADER_SIZE     8
+#define W_NETWORK_BATCH_MAX_MESSAGES    0xFFFF
+
+namespace wolf
+{
+    namespace system
+    {
+        //buffer of decompressed batches, each receiving thread has its own
+        static thread_local std::vector<char> s_decompress_buffer;
+
+        static inline void s_write_u16(_Inout_ char* pDst, _In_ const uint32_t& pValue)
+        {
+            pDst[0] = static_cast<char>(pValue & 0xFF);
+            pDst[1] = static_cast<char>((pValue >> 8) & 0xFF);
+        }
+
+        static inline void s_write_u32(_Inout_ char* pDst, _In_ const uint32_t& pValue)
+        {
+            s_write_u16(pDst, pValue & 0xFFFF);
+            s_write_u16(pDst + 2, pValue >> 16);
+        }
+
+        static inline uint32_t s_read_u16(_In_ const char* pSrc)
+        {
+            auto _src = reinterpret_cast<const uint8_t*>(pSrc);
+            return static_cast<uint32_t>(_src[0]) | (static_cast<uint32_t>(_src[1]) << 8);
+        }
+
+        static inline uint32_t s_read_u32(_In_ const char* pSrc)
+        {
+            return s_read_u16(pSrc) | (s_read_u16(pSrc + 2) << 16);
+        }
+
+        class w_network_batcher_pimp
+        {
+        public:
+            w_network_batcher_pimp() :
+                _name("w_network_batcher"),
+                _is_running(false),
+                _max_batch_size(w_network_batcher_config().max_batch_size_in_bytes),
+                _messages_received(0),
+                _batches_received(0),
+                _wire_bytes_received(0),
+                _invalid_batches_received(0)
+            {
+            }
+
+            ~w_network_batcher_pimp()
+            {
+                release();
+            }
+
+            W_RESULT initialize(_In_ const w_network_batcher_config& pConfig)
+            {
+                const char* _trace_info = "w_network_batcher::initialize";
+
+                if (pConfig.max_batch_size_in_bytes <= W_NETWORK_BATCH_HEADER_SIZE)
+                {
+                    W_V(W_FAILED, w_log_type::W_ERROR, "max_batch_size_in_bytes must be greater than {}. trace info: {}", W_NETWORK_BATCH_HEADER_SIZE, _trace_info);
+                    return W_FAILED;
+                }
+
+                release();
+
+                {
+                    std::lock_guard<std::mutex> _lock(this->_mutex);
+                    this->_config = pConfig;
+                    if (this->_config.acceleration < 1) this->_config.acceleration = 1;
+                }
+                this->_max_batch_size.store(pConfig.max_batch_size_in_bytes, std::memory_order_relaxed);
+
+                if (this->_config.max_latency_in_milliseconds)
+                {
+                    this->_is_running = true;
+                    this->_timer = std::thread(&w_network_batcher_pimp::_run, this);
+                }
+                return W_PASSED;
+            }
+
+            W_RESULT send(_In_ const int& pSocketID, _In_ const char* pMessage, _In_ const size_t& pMessageSize)
+            {
+                if (pMessageSize > UINT32_MAX || (!pMessage && pMessageSize)) return W_INVALIDARG;
+
+                //size of message as varint
+                char _varint[5];
+                size_t _varint_size = 0;
+                auto _size = static_cast<uint32_t>(pMessageSize);
+                do
+                {
+                    auto _byte = static_cast<uint8_t>(_size & 0x7F);
+                    _size >>= 7;
+                    _varint[_varint_size++] = static_cast<char>(_size ? (_byte | 0x80) : _byte);
+                } while (_size);
+
+                for (;;)
+                {
+                    bool _is_appended = false;
+                    bool _is_full = false;
+                    {
+                        std::lock_guard<std::mutex> _lock(this->_mutex);
+
+                        //receivers reject batches which are bigger than max_batch_size_in_bytes
+                        const size_t _max_size = this->_config.max_batch_size_in_bytes;
+                        if (W_NETWORK_BATCH_HEADER_SIZE + _varint_size + pMessageSize > _max_size) return W_INVALIDARG;
+
+                        auto& _batch = this->_batches[pSocketID];
+                        if (!_batch.send_mutex)
+                        {
+                            _batch.send_mutex = std::make_shared<std::mutex>();
+                        }
+                        auto& _message = _batch.message;
+                        if (_message.get_is_empty())
+                        {
+                            if (_message.reserve(_max_size) == W_FAILED) return W_FAILED;
+                            _message.resize(W_NETWORK_BATCH_HEADER_SIZE);
+                            _batch.time = std::chrono::steady_clock::now();
+                        }
+
+                        if (_message.get_size() + _varint_size + pMessageSize <= _max_size)
+                        {
+                            try
+                            {
+                                _message.write(_varint, _varint_size);
+                                _message.write(pMessage, pMessageSize);
+                            }
+                            catch (const std::bad_alloc&)
+                            {
+                                return W_FAILED;
+                            }
+                            _batch.number_of_messages++;
+                            this->_stats.messages_sent++;
+
+                            _is_appended = true;
+                            _is_full = _message.get_size() >= _max_size || _batch.number_of_messages == W_NETWORK_BATCH_MAX_MESSAGES;
+                        }
+                    }
+
+                    if (_is_appended) return _is_full ? flush(pSocketID) : W_PASSED;
+
+                    //message does not fit in the pending batch, so send it and append the message to the next one
+                    if (flush(pSocketID) == W_FAILED) return W_FAILED;
+                }
+            }
+
+            W_RESULT flush(_In_ const int& pSocketID)
+            {
+                std::shared_ptr<std::mutex> _send_mutex;
+                {
+                    std::lock_guard<std::mutex> _lock(this->_mutex);
+                    auto _iter = this->_batches.find(pSocketID);
+                    if (_iter == this->_batches.end() || !_iter->second.number_of_messages) return W_PASSED;
+                    _send_mutex = _iter->second.send_mutex;
+                }
+
+                //batches of a socket are sent in order, while other threads append to the next batch
+                std::lock_guard<std::mutex> _send_lock(*_send_mutex);
+
+                w_network_message _message;
+                uint32_t _number_of_messages = 0;
+                w_network_batcher_config _config;
+                {
+                    std::lock_guard<std::mutex> _lock(this->_mutex);
+                    auto _iter = this->_batches.find(pSocketID);
+                    if (_iter == this->_batches.end() || !_iter->second.number_of_messages) return W_PASSED;
+
+                    auto& _batch = _iter->second;
+                    _message = std::move(_batch.message);
+                    _number_of_messages = _batch.number_of_messages;
+                    _batch.number_of_messages = 0;
+                    _config = this->_config;
+                }
+                return _send_batch(pSocketID, _message, _number_of_messages, _config);
+            }
+
+            W_RESULT flush_all()
+            {
+                std::vector<int> _socket_ids;
+                {
+                    std::lock_guard<std::mutex> _lock(this->_mutex);
+                    for (auto& _iter : this->_batches)
+                    {
+                        if (_iter.second.number_of_messages)
+                        {
+                            _socket_ids.push_back(_iter.first);
+                        }
+                    }
+                }
+
+                W_RESULT _hr = W_PASSED;
+                for (auto _socket_id : _socket_ids)
+                {
+                    if (flush(_socket_id) == W_FAILED)
+                    {
+                        _hr = W_FAILED;
+                    }
+                }
+                return _hr;
+            }
+
+            W_RESULT unpack(
+                _In_ const char* pBatch,
+                _In_ const size_t& pBatchSize,
+                _In_ const std::function<void(const char*, const size_t&)>& pOnMessage)
+            {
+                const char* _trace_info = "w_network_batcher::unpack";
+
+                this->_batches_received.fetch_add(1, std::memory_order_relaxed);
+                this->_wire_bytes_received.fetch_add(pBatchSize, std::memory_order_relaxed);
+
+                if (!pBatch || pBatchSize < W_NETWORK_BATCH_HEADER_SIZE ||
+                    static_cast<uint8_t>(pBatch[0]) != W_NETWORK_BATCH_MAGIC)
+                {
+                    return _invalid_batch("batch does not have a valid header", _trace_info);
+                }
+
+                auto _flags = static_cast<uint8_t>(pBatch[1]);
+                auto _number_of_messages = s_read_u16(pBatch + 2);
+                auto _payload_size = static_cast<size_t>(s_read_u32(pBatch + 4));
+
+                const char* _payload = pBatch + W_NETWORK_BATCH_HEADER_SIZE;
+                auto _wire_size = pBatchSize - W_NETWORK_BATCH_HEADER_SIZE;
+                //senders never build batches bigger than max_batch_size_in_bytes, so bigger sizes are not allocated
+                if (_payload_size > this->_max_batch_size.load(std::memory_order_relaxed) - W_NETWORK_BATCH_HEADER_SIZE)
+                {
+                    return _invalid_batch("size of batch is bigger than max_batch_size_in_bytes", _trace_info);
+                }
+                if (_flags & W_NETWORK_BATCH_FLAG_LZ4)
+                {
+                    //each message needs at least one byte for its size
+                    if (_payload_size < _number_of_messages || _payload_size > LZ4_MAX_INPUT_SIZE || _wire_size > LZ4_MAX_INPUT_SIZE)
+                    {
+                        return _invalid_batch("size of compressed batch is not valid", _trace_info);
+                    }
+                    if (s_decompress_buffer.size() < _payload_size)
+                    {
+                        s_decompress_buffer.resize(_payload_size);
+                    }
+                    auto _size = LZ4_decompress_safe(
+                        _payload,
+                        s_decompress_buffer.data(),
+                        static_cast<int>(_wire_size),
+                        static_cast<int>(_payload_size));
+                    if (_size < 0 || static_cast<size_t>(_size) != _payload_size)
+                    {
+                        return _invalid_batch("could not decompress batch", _trace_info);
+                    }
+                    _payload = s_decompress_buffer.data();
+                }
+                else if (_wire_size != _payload_size)
+                {
+                    return _invalid_batch("size of batch is not valid", _trace_info);
+                }
+
+                size_t _offset = 0;
+                for (uint32_t i = 0; i < _number_of_messages; ++i)
+                {
+                    //read the varint
+                    uint64_t _size = 0;
+                    uint32_t _shift = 0;
+                    uint8_t _byte = 0x80;
+                    while ((_byte & 0x80) && _offset < _payload_size && _shift < 35)
+                    {
+                        _byte = static_cast<uint8_t>(_payload[_offset++]);
+                        _size |= static_cast<uint64_t>(_byte & 0x7F) << _shift;
+                        _shift += 7;
+                    }
+                    if ((_byte & 0x80) || _size > _payload_size - _offset)
+                    {
+                        return _invalid_batch("message of batch is truncated", _trace_info);
+                    }
+
+                    this->_messages_received.fetch_add(1, std::memory_order_relaxed);
+                    pOnMessage(_payload + _offset, static_cast<size_t>(_size));
+                    _offset += static_cast<size_t>(_size);
+                }
+                return W_PASSED;
+            }
+
+            ULONG release()
+            {
+                if (this->_is_running)
+                {
+                    {
+                        std::lock_guard<std::mutex> _lock(this->_mutex);
+                        this->_is_running = false;
+                    }
+                    this->_cv.notify_all();
+                    if (this->_timer.joinable())
+                    {
+                        this->_timer.join();
+                    }
+                }
+
+                flush_all();
+
+                std::lock_guard<std::mutex> _lock(this->_mutex);
+                this->_batches.clear();
+                return 0;
+            }
+
+#pragma region Getters
+
+            w_network_batcher_config get_config()
+            {
+                std::lock_guard<std::mutex> _lock(this->_mutex);
+                return this->_config;
+            }
+
+            w_network_batcher_stats get_stats()
+            {
+                w_network_batcher_stats _stats;
+                {
+                    std::lock_guard<std::mutex> _lock(this->_mutex);
+                    _stats = this->_stats;
+                }
+                _stats.messages_received = this->_messages_received.load(std::memory_order_relaxed);
+                _stats.batches_received = this->_batches_received.load(std::memory_order_relaxed);
+                _stats.wire_bytes_received = this->_wire_bytes_received.load(std::memory_order_relaxed);
+                _stats.invalid_batches_received = this->_invalid_batches_received.load(std::memory_order_relaxed);
+                return _stats;
+            }
+
+#pragma endregion
+
+        private:
+            struct w_batch
+            {
+                //header and messages, it will be given to nanomsg without copying if it is not compressed
+                w_network_message                           message;
+                uint32_t                                    number_of_messages = 0;
+                //time of the first message
+                std::chrono::steady_clock::time_point       time;
+                //held while a batch of socket is being sent
+                std::shared_ptr<std::mutex>                 send_mutex;
+            };
+
+            //compress and send a batch which was taken from its socket, the mutex must not be held
+            W_RESULT _send_batch(
+                _In_ const int& pSocketID,
+                _Inout_ w_network_message& pMessage,
+                _In_ const uint32_t& pNumberOfMessages,
+                _In_ const w_network_batcher_config& pConfig)
+            {
+                const char* _trace_info = "w_network_batcher::_send_batch";
+
+                auto _data = pMessage.get_data();
+                auto _raw_size = pMessage.get_size();
+                auto _payload_size = _raw_size - W_NETWORK_BATCH_HEADER_SIZE;
+
+                _data[0] = static_cast<char>(W_NETWORK_BATCH_MAGIC);
+                _data[1] = 0;
+                s_write_u16(_data + 2, pNumberOfMessages);
+                s_write_u32(_data + 4, static_cast<uint32_t>(_payload_size));
+
+                w_network_message _compressed;
+                auto _to_send = &pMessage;
+                if (pConfig.compress &&
+                    _payload_size >= pConfig.min_compress_size_in_bytes &&
+                    _payload_size <= LZ4_MAX_INPUT_SIZE)
+                {
+                    auto _bound = LZ4_compressBound(static_cast<int>(_payload_size));
+                    if (_compressed.allocate(W_NETWORK_BATCH_HEADER_SIZE + _bound) == W_PASSED)
+                    {
+                        auto _size = LZ4_compress_fast(
+                            _data + W_NETWORK_BATCH_HEADER_SIZE,
+                            _compressed.get_data() + W_NETWORK_BATCH_HEADER_SIZE,
+                            static_cast<int>(_payload_size),
+                            _bound,
+                            pConfig.acceleration);
+                        //send it compressed only if it saves space
+                        if (_size > 0 && static_cast<size_t>(_size) < _payload_size)
+                        {
+                            std::memcpy(_compressed.get_data(), _data, W_NETWORK_BATCH_HEADER_SIZE);
+                            _compressed.get_data()[1] = static_cast<char>(W_NETWORK_BATCH_FLAG_LZ4);
+                            _compressed.resize(W_NETWORK_BATCH_HEADER_SIZE + _size);
+                            _to_send = &_compressed;
+                        }
+                    }
+                }
+
+                auto _wire_size = _to_send->get_size();
+                auto _sent = w_network::send(pSocketID, *_to_send, pConfig.dont_wait);
+
+                std::lock_guard<std::mutex> _lock(this->_mutex);
+                if (_sent < 0)
+                {
+                    this->_stats.batches_dropped++;
+                    W_V(W_FAILED, w_log_type::W_WARNING, "sending batch of {} bytes via socket {}. error: {}, trace info: {}",
+                        _wire_size, pSocketID, w_network::get_last_error(), _trace_info);
+                    return W_FAILED;
+                }
+
+                this->_stats.batches_sent++;
+                this->_stats.raw_bytes_sent += _raw_size;
+                this->_stats.wire_bytes_sent += _wire_size;
+                if (_to_send == &_compressed)
+                {
+                    this->_stats.compressed_batches_sent++;
+                    this->_stats.bytes_saved += _raw_size - _wire_size;
+                }
+                return W_PASSED;
+            }
+
+            W_RESULT _invalid_batch(_In_z_ const char* pReason, _In_z_ const char* pTraceInfo)
+            {
+                this->_invalid_batches_received.fetch_add(1, std::memory_order_relaxed);
+                W_V(W_FAILED, w_log_type::W_WARNING, "{}. trace info: {}", pReason, pTraceInfo);
+                return W_FAILED;
+            }
+
+            //send batches which reached the latency budget
+            void _run()
+            {
+                auto _latency = std::chrono::milliseconds(this->_config.max_latency_in_milliseconds);
+
+                std::unique_lock<std::mutex> _lock(this->_mutex);
+                while (this->_is_running)
+                {
+                    auto _now = std::chrono::steady_clock::now();
+                    auto _next = _now + _latency;
+                    std::vector<int> _expired;
+                    for (auto& _iter : this->_batches)
+                    {
+                        auto& _batch = _iter.second;
+                        if (!_batch.number_of_messages) continue;
+
+                        auto _deadline = _batch.time + _latency;
+                        if (_deadline <= _now)
+                        {
+                            _expired.push_back(_iter.first);
+                        }
+                        else if (_deadline < _next)
+                        {
+                            _next = _deadline;
+                        }
+                    }
+                    if (!_expired.empty())
+                    {
+                        //send them without the mutex, so senders are not blocked by nanomsg
+                        _lock.unlock();
+                        for (auto _socket_id : _expired)
+                        {
+                            flush(_socket_id);
+                        }
+                        _lock.lock();
+                        continue;
+                    }
+                    this->_cv.wait_until(_lock, _next);
+                }
+            }
+
+            std::string                                         _name;
+            w_network_batcher_config                            _config;
+            w_network_batcher_stats                             _stats;
+            std::mutex                                          _mutex;
+            std::condition_variable                             _cv;
+            std::thread                                         _timer;
+            bool                                                _is_running;
+            std::unordered_map<int, w_batch>                    _batches;
+            //copy of max_batch_size_in_bytes for unpacking without the mutex
+            std::atomic<uint32_t>                               _max_batch_size;
+
+            std::atomic<uint64_t>                               _messages_received;
+            std::atomic<uint64_t>                               _batches_received;
+            std::atomic<uint64_t>                               _wire_bytes_received;
+            std::atomic<uint64_t>                               _invalid_batches_received;
+        };
+    }
+}
+
+using namespace wolf::system;
+
+w_network_batcher::w_network_batcher() :
+    _pimp(new w_network_batcher_pimp())
+{
+}
+
+w_network_batcher::~w_network_batcher()
+{
+    delete this->_pimp;
+    this->_pimp = nullptr;
+}
+
+W_RESULT w_network_batcher::initialize(_In_ const w_network_batcher_config& pConfig)
+{
+    if (!this->_pimp) return W_FAILED;
+    return this->_pimp->initialize(pConfig);
+}
+
+W_RESULT w_network_batcher::send(_In_ const int& pSocketID, _In_ const char* pMessage, _In_ const size_t& pMessageSize)
+{
+    if (!this->_pimp) return W_FAILED;
+    return this->_pimp->send(pSocketID, pMessage, pMessageSize);
+}
+
+W_RESULT w_network_batcher::flush(_In_ const int& pSocketID)
+{
+    if (!this->_pimp) return W_FAILED;
+    return this->_pimp->flush(pSocketID);
+}
+
+W_RESULT w_network_batcher::flush_all()
+{
+    if (!this->_pimp) return W_FAILED;
+    return this->_pimp->flush_all();
+}
+
+int w_network_batcher::receive(
+    _In_ const int& pSocketID,
+    _In_ const std::function<void(const char* pMessage, const size_t& pMessageSize)>& pOnMessage,
+    _In_ const bool& pDontWait)
+{
+    if (!this->_pimp || !pOnMessage) return -1;
+
+    w_network_message _batch;
+    auto _size = w_network::receive(pSocketID, _batch, pDontWait);
+    if (_size < 0) return _size;
+
+    if (this->_pimp->unpack(_batch.get_data(), _batch.get_size(), pOnMessage) == W_FAILED) return -1;
+    return _size;
+}
+
+W_RESULT w_network_batcher::unpack(
+    _In_ const char* pBatch,
+    _In_ const size_t& pBatchSize,
+    _In_ const std::function<void(const char* pMessage, const size_t& pMessageSize)>& pOnMessage)
+{
+    if (!this->_pimp || !pOnMessage) return W_FAILED;
+    return this->_pimp->unpack(pBatch, pBatchSize, pOnMessage);
+}
+
+ULONG w_network_batcher::release()
+{
+    if (!this->_pimp) return 1;
+    return this->_pimp->release();
+}
+
+#pragma region Getters
+
+w_network_batcher_config w_network_batcher::get_config() const
+{
+    if (!this->_pimp) return w_network_batcher_config();
+    return this->_pimp->get_config();
+}
+
+w_network_batcher_stats w_network_batcher::get_stats() const
+{
+    if (!this->_pimp) return w_network_batcher_stats();
+    return this->_pimp->get_stats();
+}
+
+#pragma endregion
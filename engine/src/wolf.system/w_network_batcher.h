@@ -0,0 +1,132 @@
+/*
+	Project			 : Wolf Engine. Copyright(c) Pooya Eimandar (http://PooyaEimandar.com) . All rights reserved.
+	Source			 : Please direct any bug to https://github.com/PooyaEimandar/Wolf.Engine/issues
+	Website			 : http://WolfSource.io
+	Name			 : w_network_batcher.h
+	Description		 : Coalesce small messages of each socket of w_network in one batch and optionally compress it with LZ4
+	Comment          : the receiver must use w_network_batcher::unpack or receive for sockets which receive batches
+*/
+
+#if _MSC_VER > 1000
+#pragma once
+#endif
+
+#ifndef __W_NETWORK_BATCHER_H__
+#define __W_NETWORK_BATCHER_H__
+
+#include "w_network.h"
+#include <functional>
+
+namespace wolf
+{
+	namespace system
+	{
+        struct w_network_batcher_config
+        {
+            //no batch is bigger than this value, receivers reject bigger batches, so both sides must use the same value
+            uint32_t        max_batch_size_in_bytes = 16 * 1024;
+            //a batch will be sent once its first message is older than this value, zero means only size and flush send batches
+            uint32_t        max_latency_in_milliseconds = 2;
+            //compress each batch with LZ4, the batch will be sent uncompressed if compression does not save space
+            bool            compress = false;
+            //batches smaller than this value will not be compressed
+            uint32_t        min_compress_size_in_bytes = 256;
+            //acceleration of LZ4, higher value is faster with lower ratio
+            int             acceleration = 1;
+            //do not block while sending batches, batches which could not be sent will be dropped
+            bool            dont_wait = false;
+        };
+
+        struct w_network_batcher_stats
+        {
+            //messages which were given to send
+            uint64_t        messages_sent = 0;
+            uint64_t        batches_sent = 0;
+            uint64_t        compressed_batches_sent = 0;
+            uint64_t        batches_dropped = 0;
+            //size of messages and their frames before compression
+            uint64_t        raw_bytes_sent = 0;
+            //bytes which were given to nanomsg
+            uint64_t        wire_bytes_sent = 0;
+            //raw_bytes_sent - wire_bytes_sent of compressed batches
+            uint64_t        bytes_saved = 0;
+
+            uint64_t        messages_received = 0;
+            uint64_t        batches_received = 0;
+            uint64_t        wire_bytes_received = 0;
+            //batches which were truncated or corrupted
+            uint64_t        invalid_batches_received = 0;
+        };
+
+        class w_network_batcher_pimp;
+        class w_network_batcher
+        {
+        public:
+            WSYS_EXP w_network_batcher();
+            WSYS_EXP ~w_network_batcher();
+
+            /*
+                initialize batcher, if max_latency_in_milliseconds is not zero a timer thread sends old batches
+                @param pConfig, the configuration of batcher
+                @return W_PASSED on success
+            */
+            WSYS_EXP W_RESULT initialize(_In_ const w_network_batcher_config& pConfig);
+
+            /*
+                append a message to batch of socket, it is thread safe
+                @param pSocketID, the id of socket object
+                @param pMessage, the message
+                @param pMessageSize, size of message
+                @return W_INVALIDARG if the message does not fit in an empty batch, W_FAILED if sending the full batch failed
+            */
+            WSYS_EXP W_RESULT send(_In_ const int& pSocketID, _In_ const char* pMessage, _In_ const size_t& pMessageSize);
+
+            //send pending batch of socket
+            WSYS_EXP W_RESULT flush(_In_ const int& pSocketID);
+
+            //send pending batches of all sockets
+            WSYS_EXP W_RESULT flush_all();
+
+            /*
+                receive a batch via socket and call pOnMessage for each message of it in order
+                @param pSocketID, the id of socket object
+                @param pOnMessage, the handler of each message, the buffer is valid till the handler returns
+                @param pDontWait, do not block, returns -1 with W_EAGAIN if there is no batch
+                @return, number of bytes received or -1 on error
+            */
+            WSYS_EXP int receive(
+                _In_ const int& pSocketID,
+                _In_ const std::function<void(const char* pMessage, const size_t& pMessageSize)>& pOnMessage,
+                _In_ const bool& pDontWait = false);
+
+            /*
+                split a batch which was received by w_network or w_network_reactor into messages, it is thread safe
+                @param pBatch, the batch
+                @param pBatchSize, size of batch
+                @param pOnMessage, the handler of each message, the buffer is valid till the handler returns
+                @return W_FAILED if batch is corrupted or bigger than max_batch_size_in_bytes, messages before the corrupted one were given to pOnMessage
+            */
+            WSYS_EXP W_RESULT unpack(
+                _In_ const char* pBatch,
+                _In_ const size_t& pBatchSize,
+                _In_ const std::function<void(const char* pMessage, const size_t& pMessageSize)>& pOnMessage);
+
+            //send pending batches and stop the timer
+            WSYS_EXP ULONG release();
+
+#pragma region Getters
+            WSYS_EXP w_network_batcher_config get_config() const;
+            WSYS_EXP w_network_batcher_stats get_stats() const;
+#pragma endregion
+
+        private:
+            //Prevent copying
+            w_network_batcher(w_network_batcher const&);
+            w_network_batcher& operator= (w_network_batcher const&);
+
+            w_network_batcher_pimp*                 _pimp;
+        };
+	}
+}
+
+#endif //__W_NETWORK_BATCHER_H__
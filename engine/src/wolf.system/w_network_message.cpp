@@ -0,0 +1,138 @@
+#include "w_system_pch.h"
+#include "w_network_message.h"
+#include <nanomsg/nn.h>
+
+using namespace wolf::system;
+
+w_network_message::w_network_message() :
+    _data(nullptr),
+    _size(0),
+    _capacity(0)
+{
+}
+
+w_network_message::w_network_message(_Inout_ w_network_message&& pOther) :
+    _data(pOther._data),
+    _size(pOther._size),
+    _capacity(pOther._capacity)
+{
+    pOther._data = nullptr;
+    pOther._size = 0;
+    pOther._capacity = 0;
+}
+
+w_network_message& w_network_message::operator= (_Inout_ w_network_message&& pOther)
+{
+    if (this != &pOther)
+    {
+        release();
+        std::swap(this->_data, pOther._data);
+        std::swap(this->_size, pOther._size);
+        std::swap(this->_capacity, pOther._capacity);
+    }
+    return *this;
+}
+
+w_network_message::~w_network_message()
+{
+    release();
+}
+
+W_RESULT w_network_message::allocate(_In_ const size_t& pSizeInBytes)
+{
+    if (reserve(pSizeInBytes) == W_FAILED) return W_FAILED;
+    this->_size = pSizeInBytes;
+    return W_PASSED;
+}
+
+W_RESULT w_network_message::reserve(_In_ const size_t& pCapacityInBytes)
+{
+    const char* _trace_info = "w_network_message::reserve";
+
+    if (pCapacityInBytes <= this->_capacity) return W_PASSED;
+
+    //nn_reallocmsg keeps the content, so the buffer never has to be copied by us
+    auto _data = static_cast<char*>(this->_data ?
+        nn_reallocmsg(this->_data, pCapacityInBytes) :
+        nn_allocmsg(pCapacityInBytes, 0));
+    if (!_data)
+    {
+        W_V(W_FAILED, w_log_type::W_ERROR, "allocating {} bytes for message. error: {}, trace info: {}", pCapacityInBytes, nn_errno(), _trace_info);
+        return W_FAILED;
+    }
+
+    this->_data = _data;
+    this->_capacity = pCapacityInBytes;
+    return W_PASSED;
+}
+
+W_RESULT w_network_message::resize(_In_ const size_t& pSizeInBytes)
+{
+    if (pSizeInBytes > this->_capacity && reserve(pSizeInBytes) == W_FAILED) return W_FAILED;
+    this->_size = pSizeInBytes;
+    return W_PASSED;
+}
+
+void w_network_message::write(_In_ const char* pData, _In_ const size_t& pSizeInBytes)
+{
+    if (!pSizeInBytes) return;
+
+    auto _new_size = this->_size + pSizeInBytes;
+    if (_new_size > this->_capacity)
+    {
+        auto _capacity = this->_capacity ? this->_capacity * 2 : 256;
+        while (_capacity < _new_size) _capacity *= 2;
+        if (reserve(_capacity) == W_FAILED)
+        {
+            //packer of msgpack reports errors by exception
+            throw std::bad_alloc();
+        }
+    }
+
+    std::memcpy(this->_data + this->_size, pData, pSizeInBytes);
+    this->_size = _new_size;
+}
+
+void w_network_message::clear()
+{
+    this->_size = 0;
+}
+
+void w_network_message::release()
+{
+    if (this->_data)
+    {
+        nn_freemsg(this->_data);
+        this->_data = nullptr;
+    }
+    this->_size = 0;
+    this->_capacity = 0;
+}
+
+void w_network_message::_attach(_In_ char* pBuffer, _In_ const size_t& pSizeInBytes)
+{
+    release();
+    this->_data = pBuffer;
+    this->_size = pSizeInBytes;
+    this->_capacity = pSizeInBytes;
+}
+
+char* w_network_message::_detach()
+{
+    if (!this->_data) return nullptr;
+
+    //nanomsg sends the whole chunk, so shrink it to size of message. Shrinking does not move the buffer in practice
+    if (this->_size != this->_capacity)
+    {
+        auto _data = static_cast<char*>(nn_reallocmsg(this->_data, this->_size));
+        if (!_data) return nullptr;
+        this->_data = _data;
+        this->_capacity = this->_size;
+    }
+
+    auto _data = this->_data;
+    this->_data = nullptr;
+    this->_size = 0;
+    this->_capacity = 0;
+    return _data;
+}
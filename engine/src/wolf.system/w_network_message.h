@@ -0,0 +1,108 @@
+/*
+	Project			 : Wolf Engine. Copyright(c) Pooya Eimandar (http://PooyaEimandar.com) . All rights reserved.
+	Source			 : Please direct any bug to https://github.com/PooyaEimandar/Wolf.Engine/issues
+	Website			 : http://WolfSource.io
+	Name			 : w_network_message.h
+	Description		 : A message of w_network which owns the buffer of nanomsg, so it can be sent and received without copying
+	Comment          : it is a stream of msgpack, use msgpack::packer<w_network_message> for packing in place
+*/
+
+#if _MSC_VER > 1000
+#pragma once
+#endif
+
+#ifndef __W_NETWORK_MESSAGE_H__
+#define __W_NETWORK_MESSAGE_H__
+
+#include "w_system_export.h"
+#include "w_std.h"
+#include <msgpack.hpp>
+
+namespace wolf
+{
+	namespace system
+	{
+        class w_network_message
+        {
+        public:
+            WSYS_EXP w_network_message();
+            WSYS_EXP w_network_message(_Inout_ w_network_message&& pOther);
+            WSYS_EXP w_network_message& operator= (_Inout_ w_network_message&& pOther);
+            WSYS_EXP ~w_network_message();
+
+            /*
+                allocate a buffer of nanomsg, content of buffer will not be initialized
+                @param pSizeInBytes, size of message
+                @return W_FAILED if memory could not be allocated
+            */
+            WSYS_EXP W_RESULT allocate(_In_ const size_t& pSizeInBytes);
+
+            //grow capacity of buffer, the content will be kept
+            WSYS_EXP W_RESULT reserve(_In_ const size_t& pCapacityInBytes);
+
+            //change size of message, the content will be kept and buffer grows if needed
+            WSYS_EXP W_RESULT resize(_In_ const size_t& pSizeInBytes);
+
+            //append data to the end of message, buffer grows geometrically. It is the stream interface of msgpack::packer
+            WSYS_EXP void write(_In_ const char* pData, _In_ const size_t& pSizeInBytes);
+
+            //set size to zero and keep the buffer for reuse
+            WSYS_EXP void clear();
+
+            //free the buffer
+            WSYS_EXP void release();
+
+            /*
+                unpack the next msgpack object from message, strings and binaries will not be copied and
+                they refer to buffer of message, so the message must outlive the returned handle
+                @param pHandle, the unpacked object
+                @param pOffset, offset of object in message, it will be moved to the end of object
+                @return W_FAILED if the rest of message is not a complete msgpack object
+            */
+            W_RESULT unpack(_Inout_ msgpack::object_handle& pHandle, _Inout_ size_t& pOffset) const
+            {
+                if (!this->_data || pOffset >= this->_size) return W_FAILED;
+                try
+                {
+                    msgpack::unpack(pHandle, this->_data, this->_size, pOffset, &w_network_message::_unpack_by_reference);
+                }
+                catch (...)
+                {
+                    return W_FAILED;
+                }
+                return W_PASSED;
+            }
+
+#pragma region Getters
+            char* get_data()                        { return this->_data; }
+            const char* get_data() const            { return this->_data; }
+            size_t get_size() const                 { return this->_size; }
+            size_t get_capacity() const             { return this->_capacity; }
+            bool get_is_empty() const               { return this->_size == 0; }
+#pragma endregion
+
+        private:
+            friend class w_network;
+
+            //Prevent copying, the buffer has one owner
+            w_network_message(w_network_message const&);
+            w_network_message& operator= (w_network_message const&);
+
+            static bool _unpack_by_reference(msgpack::type::object_type, std::size_t, void*)
+            {
+                return true;
+            }
+
+            //take ownership of a buffer which was received from nanomsg
+            void _attach(_In_ char* pBuffer, _In_ const size_t& pSizeInBytes);
+            //give the buffer to nanomsg, the message must not be empty
+            char* _detach();
+
+            char*                                   _data;
+            size_t                                  _size;
+            size_t                                  _capacity;
+        };
+	}
+}
+
+#endif //__W_NETWORK_MESSAGE_H__
@@ -0,0 +1,472 @@
+#include "w_system_pch.h"
+#include "w_network_reactor.h"
+#include <nanomsg/nn.h>
+#include <nanomsg/pair.h>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <unordered_map>
+
+//maximum time in milliseconds which event loop waits in nn_poll, changes of sockets wake it up sooner
+#ifndef W_NETWORK_REACTOR_POLL_TIMEOUT
+#define W_NETWORK_REACTOR_POLL_TIMEOUT 1000
+#endif
+
+namespace wolf
+{
+    namespace system
+    {
+        //socket which its handler is running on the current thread, -1 outside of handlers
+        static thread_local int s_current_socket = -1;
+
+        class w_network_reactor_pimp
+        {
+        public:
+            w_network_reactor_pimp() :
+                _name("w_network_reactor"),
+                _pool(nullptr),
+                _is_running(false),
+                _is_wake_pending(false),
+                _wake_receiver(-1),
+                _wake_sender(-1),
+                _dispatches(0)
+            {
+            }
+
+            ~w_network_reactor_pimp()
+            {
+                release();
+            }
+
+            W_RESULT initialize(_In_opt_ w_thread_pool* pThreadPool, _In_ const size_t& pNumberOfWorkers)
+            {
+                const char* _trace_info = "w_network_reactor::initialize";
+
+                if (this->_is_running.load(std::memory_order_acquire) || this->_loop.joinable())
+                {
+                    W_V(W_FAILED, w_log_type::W_WARNING, "reactor is already running or was not released. trace info: {}", _trace_info);
+                    return W_FAILED;
+                }
+
+                //inproc pair which wakes up event loop when sockets were changed
+                auto _url = "inproc://w_network_reactor_" + std::to_string(reinterpret_cast<uintptr_t>(this));
+                this->_wake_receiver = nn_socket(AF_SP, NN_PAIR);
+                this->_wake_sender = nn_socket(AF_SP, NN_PAIR);
+                if (this->_wake_receiver < 0 || this->_wake_sender < 0 ||
+                    nn_bind(this->_wake_receiver, _url.c_str()) < 0 ||
+                    nn_connect(this->_wake_sender, _url.c_str()) < 0)
+                {
+                    W_V(W_FAILED, w_log_type::W_ERROR, "creating wake up sockets. error: {}, trace info: {}", w_network::get_last_error(), _trace_info);
+                    _close_wake_sockets();
+                    return W_FAILED;
+                }
+
+                if (pThreadPool)
+                {
+                    this->_pool = pThreadPool;
+                }
+                else
+                {
+                    auto _size = pNumberOfWorkers ? pNumberOfWorkers : w_thread::get_number_of_hardware_thread_contexts();
+                    this->_own_pool.allocate(_size ? _size : 1);
+                    this->_pool = &this->_own_pool;
+                }
+
+                this->_is_running.store(true, std::memory_order_release);
+                this->_loop = std::thread(&w_network_reactor_pimp::_run, this);
+
+                return W_PASSED;
+            }
+
+            W_RESULT add_socket(
+                _In_ const int& pSocketID,
+                _In_ const uint8_t& pEvents,
+                _In_ const std::function<void(const int&, const uint8_t&)>& pOnEvent)
+            {
+                const char* _trace_info = "w_network_reactor::add_socket";
+
+                if (!this->_is_running.load(std::memory_order_acquire) || pSocketID < 0 || !pOnEvent) return W_FAILED;
+
+                auto _socket = std::make_shared<w_socket>();
+                _socket->id = pSocketID;
+                _socket->events = pEvents & (W_NETWORK_REACTOR_READ | W_NETWORK_REACTOR_WRITE);
+                _socket->on_event = pOnEvent;
+                {
+                    std::lock_guard<std::mutex> _lock(this->_mutex);
+                    if (!this->_sockets.emplace(pSocketID, _socket).second)
+                    {
+                        W_V(W_FAILED, w_log_type::W_WARNING, "socket {} was already added. trace info: {}", pSocketID, _trace_info);
+                        return W_FAILED;
+                    }
+                }
+                _wake();
+
+                return W_PASSED;
+            }
+
+            W_RESULT remove_socket(_In_ const int& pSocketID)
+            {
+                std::unique_lock<std::mutex> _lock(this->_mutex);
+
+                auto _iter = this->_sockets.find(pSocketID);
+                if (_iter == this->_sockets.end()) return W_FAILED;
+
+                auto _socket = _iter->second;
+                _socket->is_removed = true;
+                this->_sockets.erase(_iter);
+
+                /*
+                    wait for the handler, unless we are inside a handler or any other job of the pool. The pending handler
+                    of this socket may be queued behind the current job on the same worker, or wait for a free worker, so
+                    on workers the removal is deferred and _dispatch skips the handler of removed socket
+                */
+                if (s_current_socket < 0 && !(this->_pool && this->_pool->get_is_worker_thread()))
+                {
+                    this->_cv.wait(_lock, [&_socket]() { return !_socket->is_in_flight; });
+                }
+                _lock.unlock();
+
+                _wake();
+                return W_PASSED;
+            }
+
+            W_RESULT set_socket_events(_In_ const int& pSocketID, _In_ const uint8_t& pEvents)
+            {
+                {
+                    std::lock_guard<std::mutex> _lock(this->_mutex);
+
+                    auto _iter = this->_sockets.find(pSocketID);
+                    if (_iter == this->_sockets.end()) return W_FAILED;
+                    _iter->second->events = pEvents & (W_NETWORK_REACTOR_READ | W_NETWORK_REACTOR_WRITE);
+                }
+                _wake();
+                return W_PASSED;
+            }
+
+            ULONG release()
+            {
+                //event loop may already have stopped itself on termination of nanomsg
+                auto _was_running = this->_is_running.exchange(false, std::memory_order_acq_rel);
+                if (!_was_running && !this->_loop.joinable()) return 1;
+
+                _wake();
+                if (this->_loop.joinable())
+                {
+                    this->_loop.join();
+                }
+
+                //wait for running handlers
+                this->_pool->wait(this->_counter);
+                this->_own_pool.release();
+                this->_pool = nullptr;
+
+                {
+                    std::lock_guard<std::mutex> _lock(this->_mutex);
+                    this->_sockets.clear();
+                }
+                _close_wake_sockets();
+
+                return 0;
+            }
+
+#pragma region Getters
+
+            bool get_is_running() const
+            {
+                return this->_is_running.load(std::memory_order_acquire);
+            }
+
+            size_t get_number_of_sockets()
+            {
+                std::lock_guard<std::mutex> _lock(this->_mutex);
+                return this->_sockets.size();
+            }
+
+            uint64_t get_number_of_dispatches() const
+            {
+                return this->_dispatches.load(std::memory_order_relaxed);
+            }
+
+#pragma endregion
+
+        private:
+            struct w_socket
+            {
+                int                                                 id = -1;
+                uint8_t                                             events = 0;
+                //false while the handler is pending or running
+                bool                                                is_armed = true;
+                bool                                                is_in_flight = false;
+                bool                                                is_removed = false;
+                std::function<void(const int&, const uint8_t&)>     on_event;
+            };
+
+            void _run()
+            {
+                const char* _trace_info = "w_network_reactor::_run";
+
+                std::vector<nn_pollfd> _fds;
+                std::vector<std::shared_ptr<w_socket>> _polled;
+
+                while (this->_is_running.load(std::memory_order_acquire))
+                {
+                    _fds.clear();
+                    _polled.clear();
+
+                    nn_pollfd _wake_fd;
+                    _wake_fd.fd = this->_wake_receiver;
+                    _wake_fd.events = NN_POLLIN;
+                    _wake_fd.revents = 0;
+                    _fds.push_back(_wake_fd);
+
+                    {
+                        std::lock_guard<std::mutex> _lock(this->_mutex);
+                        for (auto& _iter : this->_sockets)
+                        {
+                            auto& _socket = _iter.second;
+                            if (!_socket->is_armed || !_socket->events) continue;
+
+                            nn_pollfd _fd;
+                            _fd.fd = _socket->id;
+                            _fd.events = static_cast<short>(_socket->events);
+                            _fd.revents = 0;
+                            _fds.push_back(_fd);
+                            _polled.push_back(_socket);
+                        }
+                    }
+
+                    auto _hr = nn_poll(_fds.data(), static_cast<int>(_fds.size()), W_NETWORK_REACTOR_POLL_TIMEOUT);
+                    if (_hr < 0)
+                    {
+                        auto _error = nn_errno();
+                        if (_error == EINTR) continue;
+                        if (_error == ETERM)
+                        {
+                            //nanomsg was terminated, sockets can not be polled anymore
+                            W_V(W_FAILED, w_log_type::W_WARNING, "nanomsg was terminated, stopping event loop. trace info: {}", _trace_info);
+                            this->_is_running.store(false, std::memory_order_release);
+                            break;
+                        }
+                        if (_error == EBADF)
+                        {
+                            //one of sockets was closed without removing it from reactor
+                            _remove_closed_sockets(_polled);
+                            continue;
+                        }
+                        W_V(W_FAILED, w_log_type::W_ERROR, "polling sockets. error: {}, trace info: {}", _error, _trace_info);
+                        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                        continue;
+                    }
+
+                    if (_fds[0].revents & NN_POLLIN)
+                    {
+                        //clear the flag before draining, so a later wake up sends a new message
+                        this->_is_wake_pending.store(false, std::memory_order_release);
+                        char* _buffer = nullptr;
+                        while (nn_recv(this->_wake_receiver, &_buffer, NN_MSG, NN_DONTWAIT) >= 0)
+                        {
+                            nn_freemsg(_buffer);
+                            _buffer = nullptr;
+                        }
+                    }
+                    if (_hr == 0) continue;
+
+                    for (size_t i = 0; i < _polled.size(); ++i)
+                    {
+                        auto _events = static_cast<uint8_t>(_fds[i + 1].revents & _fds[i + 1].events);
+                        if (!_events) continue;
+
+                        auto& _socket = _polled[i];
+                        {
+                            std::lock_guard<std::mutex> _lock(this->_mutex);
+                            if (_socket->is_removed) continue;
+                            _socket->is_armed = false;
+                            _socket->is_in_flight = true;
+                        }
+
+                        this->_dispatches.fetch_add(1, std::memory_order_relaxed);
+                        this->_pool->submit([this, _socket, _events]()
+                        {
+                            _dispatch(_socket, _events);
+                        }, &this->_counter);
+                    }
+                }
+            }
+
+            void _dispatch(_In_ const std::shared_ptr<w_socket>& pSocket, _In_ const uint8_t& pEvents)
+            {
+                bool _is_removed;
+                {
+                    std::lock_guard<std::mutex> _lock(this->_mutex);
+                    _is_removed = pSocket->is_removed;
+                }
+                //socket was removed from handler context after this handler was dispatched
+                if (!_is_removed)
+                {
+                    s_current_socket = pSocket->id;
+                    pSocket->on_event(pSocket->id, pEvents);
+                    s_current_socket = -1;
+                }
+
+                {
+                    std::lock_guard<std::mutex> _lock(this->_mutex);
+                    pSocket->is_in_flight = false;
+                    pSocket->is_armed = !pSocket->is_removed;
+                }
+                this->_cv.notify_all();
+                _wake();
+            }
+
+            void _remove_closed_sockets(_In_ const std::vector<std::shared_ptr<w_socket>>& pPolled)
+            {
+                const char* _trace_info = "w_network_reactor::_remove_closed_sockets";
+
+                std::lock_guard<std::mutex> _lock(this->_mutex);
+                for (auto& _socket : pPolled)
+                {
+                    int _domain = 0;
+                    size_t _size = sizeof(_domain);
+                    if (nn_getsockopt(_socket->id, NN_SOL_SOCKET, NN_DOMAIN, &_domain, &_size) >= 0) continue;
+
+                    W_V(W_FAILED, w_log_type::W_WARNING, "socket {} was closed before removing it from reactor. trace info: {}", _socket->id, _trace_info);
+                    _socket->is_removed = true;
+                    this->_sockets.erase(_socket->id);
+                }
+            }
+
+            void _wake()
+            {
+                //coalesce wake ups, event loop needs one message per iteration
+                if (this->_is_wake_pending.exchange(true, std::memory_order_acq_rel)) return;
+                if (this->_wake_sender >= 0)
+                {
+                    nn_send(this->_wake_sender, "", 0, NN_DONTWAIT);
+                }
+            }
+
+            void _close_wake_sockets()
+            {
+                if (this->_wake_sender >= 0)
+                {
+                    nn_close(this->_wake_sender);
+                    this->_wake_sender = -1;
+                }
+                if (this->_wake_receiver >= 0)
+                {
+                    nn_close(this->_wake_receiver);
+                    this->_wake_receiver = -1;
+                }
+                this->_is_wake_pending.store(false, std::memory_order_release);
+            }
+
+            std::string                                                 _name;
+            w_thread_pool*                                              _pool;
+            w_thread_pool                                               _own_pool;
+            w_job_counter                                               _counter;
+            std::thread                                                 _loop;
+            std::atomic<bool>                                           _is_running;
+            std::atomic<bool>                                           _is_wake_pending;
+            int                                                         _wake_receiver;
+            int                                                         _wake_sender;
+            std::atomic<uint64_t>                                       _dispatches;
+            std::mutex                                                  _mutex;
+            std::condition_variable                                     _cv;
+            std::unordered_map<int, std::shared_ptr<w_socket>>          _sockets;
+        };
+    }
+}
+
+using namespace wolf::system;
+
+w_network_reactor::w_network_reactor() :
+    _pimp(new w_network_reactor_pimp())
+{
+}
+
+w_network_reactor::~w_network_reactor()
+{
+    delete this->_pimp;
+    this->_pimp = nullptr;
+}
+
+W_RESULT w_network_reactor::initialize(
+    _In_opt_ w_thread_pool* pThreadPool,
+    _In_ const size_t& pNumberOfWorkers)
+{
+    if (!this->_pimp) return W_FAILED;
+    return this->_pimp->initialize(pThreadPool, pNumberOfWorkers);
+}
+
+W_RESULT w_network_reactor::add_socket(
+    _In_ const int& pSocketID,
+    _In_ const uint8_t& pEvents,
+    _In_ const std::function<void(const int& pSocketID, const uint8_t& pEvents)>& pOnEvent)
+{
+    if (!this->_pimp) return W_FAILED;
+    return this->_pimp->add_socket(pSocketID, pEvents, pOnEvent);
+}
+
+W_RESULT w_network_reactor::add_receiver(
+    _In_ const int& pSocketID,
+    _In_ const std::function<void(const int& pSocketID, const char* pBuffer, const size_t& pLength)>& pOnMessage)
+{
+    if (!this->_pimp || !pOnMessage) return W_FAILED;
+
+    return this->_pimp->add_socket(pSocketID, W_NETWORK_REACTOR_READ, [pOnMessage](const int& pID, const uint8_t& pEvents)
+    {
+        (void)pEvents;
+        for (int i = 0; i < W_NETWORK_REACTOR_MAX_BATCH; ++i)
+        {
+            char* _buffer = nullptr;
+            auto _size = w_network::receive(pID, &_buffer, true);
+            if (_size < 0) break;
+
+            pOnMessage(pID, _buffer, static_cast<size_t>(_size));
+            w_network::free_buffer(_buffer);
+        }
+    });
+}
+
+W_RESULT w_network_reactor::remove_socket(_In_ const int& pSocketID)
+{
+    if (!this->_pimp) return W_FAILED;
+    return this->_pimp->remove_socket(pSocketID);
+}
+
+ULONG w_network_reactor::release()
+{
+    if (!this->_pimp) return 1;
+    return this->_pimp->release();
+}
+
+#pragma region Getters
+
+bool w_network_reactor::get_is_running() const
+{
+    return this->_pimp && this->_pimp->get_is_running();
+}
+
+size_t w_network_reactor::get_number_of_sockets() const
+{
+    if (!this->_pimp) return 0;
+    return this->_pimp->get_number_of_sockets();
+}
+
+uint64_t w_network_reactor::get_number_of_dispatches() const
+{
+    if (!this->_pimp) return 0;
+    return this->_pimp->get_number_of_dispatches();
+}
+
+#pragma endregion
+
+#pragma region Setters
+
+W_RESULT w_network_reactor::set_socket_events(_In_ const int& pSocketID, _In_ const uint8_t& pEvents)
+{
+    if (!this->_pimp) return W_FAILED;
+    return this->_pimp->set_socket_events(pSocketID, pEvents);
+}
+
+#pragma endregion
@@ -0,0 +1,117 @@
+/*
+	Project			 : Wolf Engine. Copyright(c) Pooya Eimandar (http://PooyaEimandar.com) . All rights reserved.
+	Source			 : Please direct any bug to https://github.com/PooyaEimandar/Wolf.Engine/issues
+	Website			 : http://WolfSource.io
+	Name			 : w_network_reactor.h
+	Description		 : Event loop which multiplexes sockets of w_network with one nn_poll thread and dispatches them to w_thread_pool
+	Comment          : number of threads does not depend on number of sockets
+*/
+
+#if _MSC_VER > 1000
+#pragma once
+#endif
+
+#ifndef __W_NETWORK_REACTOR_H__
+#define __W_NETWORK_REACTOR_H__
+
+#include "w_network.h"
+#include "w_thread_pool.h"
+
+//maximum number of messages which will be received for a socket in one dispatch, the rest will be received in the next one
+#ifndef W_NETWORK_REACTOR_MAX_BATCH
+#define W_NETWORK_REACTOR_MAX_BATCH 64
+#endif
+
+namespace wolf
+{
+	namespace system
+	{
+        //same values as NN_POLLIN and NN_POLLOUT
+        enum w_network_reactor_event : uint8_t
+        {
+            W_NETWORK_REACTOR_READ = 1,
+            W_NETWORK_REACTOR_WRITE = 2
+        };
+
+        /*
+            each socket is armed once it was added, when it becomes ready the reactor disarms it and calls its handler
+            on one of workers of thread pool. The socket will be polled again after the handler returned, so handlers of
+            a socket never run concurrently and messages of a socket are handled in the order which they were received.
+            The handler must consume all ready messages (see w_network::receive with pDontWait) or they will be reported
+            again in the next iteration of event loop
+        */
+        class w_network_reactor_pimp;
+        class w_network_reactor
+        {
+        public:
+            WSYS_EXP w_network_reactor();
+            WSYS_EXP ~w_network_reactor();
+
+            /*
+                start the event loop
+                @param pThreadPool, the pool which runs handlers, it must outlive the reactor, nullptr means reactor allocates its own pool
+                @param pNumberOfWorkers, number of workers of own pool, zero means number of hardware threads
+                @return W_PASSED on success
+            */
+            WSYS_EXP W_RESULT initialize(
+                _In_opt_ w_thread_pool* pThreadPool = nullptr,
+                _In_ const size_t& pNumberOfWorkers = 0);
+
+            /*
+                add a socket to the event loop
+                @param pSocketID, the id of socket which was given by w_network
+                @param pEvents, combination of w_network_reactor_event
+                @param pOnEvent, the handler which will be called with ready events of socket
+                @return W_FAILED if the socket was already added or reactor is not initialized
+            */
+            WSYS_EXP W_RESULT add_socket(
+                _In_ const int& pSocketID,
+                _In_ const uint8_t& pEvents,
+                _In_ const std::function<void(const int& pSocketID, const uint8_t& pEvents)>& pOnEvent);
+
+            /*
+                add a socket which the reactor receives from, pOnMessage will be called for each message in order
+                @param pSocketID, the id of socket which was given by w_network
+                @param pOnMessage, the handler of message, the buffer will be freed after handler returned
+                @return W_FAILED if the socket was already added or reactor is not initialized
+            */
+            WSYS_EXP W_RESULT add_receiver(
+                _In_ const int& pSocketID,
+                _In_ const std::function<void(const int& pSocketID, const char* pBuffer, const size_t& pLength)>& pOnMessage);
+
+            /*
+                remove a socket from the event loop, if handler of socket is running on another thread,
+                this function waits for it. When it is called from a handler or any job of the thread pool it does not
+                wait, the socket is removed immediately and its pending handler will not be called, but a handler which
+                is already running on another worker may still be in progress after return
+                @param pSocketID, the id of socket
+                @return W_FAILED if socket was not found
+            */
+            WSYS_EXP W_RESULT remove_socket(_In_ const int& pSocketID);
+
+            //stop the event loop and wait for running handlers, sockets will not be closed. It must be called before initializing again, even if event loop stopped on termination of nanomsg
+            WSYS_EXP ULONG release();
+
+#pragma region Getters
+            WSYS_EXP bool get_is_running() const;
+            WSYS_EXP size_t get_number_of_sockets() const;
+            //get number of handlers which were dispatched to thread pool
+            WSYS_EXP uint64_t get_number_of_dispatches() const;
+#pragma endregion
+
+#pragma region Setters
+            //change the events of socket, it will be applied on the next iteration of event loop
+            WSYS_EXP W_RESULT set_socket_events(_In_ const int& pSocketID, _In_ const uint8_t& pEvents);
+#pragma endregion
+
+        private:
+            //Prevent copying
+            w_network_reactor(w_network_reactor const&);
+            w_network_reactor& operator= (w_network_reactor const&);
+
+            w_network_reactor_pimp*                 _pimp;
+        };
+	}
+}
+
+#endif //__W_NETWORK_REACTOR_H__
@@ -0,0 +1,318 @@
+#include "w_system_pch.h"
+#include "w_page_allocator.h"
+#include "w_thread_pool.h"
+#include <mutex>
+#include <unordered_map>
+#include <cstring>
+#include <cstdlib>
+
+#if defined(__linux) || defined(__ANDROID)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define W_PAGE_ALLOCATOR_USE_MMAP
+#endif
+
+//size of huge pages which are used for explicit and transparent huge pages
+#ifndef W_HUGE_PAGE_SIZE
+#define W_HUGE_PAGE_SIZE (2 * 1024 * 1024)
+#endif
+
+//values of linux/mempolicy.h, so libnuma is not required
+#define W_MPOL_PREFERRED 1
+
+namespace wolf
+{
+    namespace system
+    {
+        namespace page_allocator
+        {
+            struct w_page_allocation
+            {
+                //start of malloc block or mapping
+                void*               base = nullptr;
+                //size of mapping or accounted size of malloc block
+                size_t              size = 0;
+                bool                is_mapped = false;
+                w_memory_policy     applied_policy = W_MEMORY_POLICY_DEFAULT;
+            };
+
+            struct w_page_allocator_registry
+            {
+                std::mutex                                              mutex;
+                std::unordered_map<const void*, w_page_allocation>      allocations;
+                w_page_allocator_stats                                  stats;
+            };
+
+            static w_page_allocator_registry& get_registry()
+            {
+                static w_page_allocator_registry _registry;
+                return _registry;
+            }
+
+            static size_t _round_up(_In_ const size_t& pValue, _In_ const size_t& pAlignment)
+            {
+                return (pValue + pAlignment - 1) / pAlignment * pAlignment;
+            }
+
+            static size_t _get_page_size()
+            {
+#ifdef W_PAGE_ALLOCATOR_USE_MMAP
+                static const size_t _page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+                return _page_size;
+#else
+                return 4096;
+#endif
+            }
+
+#ifdef W_PAGE_ALLOCATOR_USE_MMAP
+            //map pSizeInBytes bytes with start aligned to pAlignment, the unused head and tail are unmapped
+            static void* _map_aligned(_In_ const size_t& pSizeInBytes, _In_ const size_t& pAlignment)
+            {
+                auto _page_size = _get_page_size();
+                if (pAlignment <= _page_size)
+                {
+                    auto _ptr = mmap(nullptr, pSizeInBytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+                    return _ptr == MAP_FAILED ? nullptr : _ptr;
+                }
+
+                auto _mapped_size = pSizeInBytes + pAlignment;
+                auto _ptr = mmap(nullptr, _mapped_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+                if (_ptr == MAP_FAILED) return nullptr;
+
+                auto _start = reinterpret_cast<uintptr_t>(_ptr);
+                auto _aligned = _round_up(_start, pAlignment);
+                auto _head = _aligned - _start;
+                auto _tail = _mapped_size - _head - pSizeInBytes;
+                if (_head) munmap(_ptr, _head);
+                if (_tail) munmap(reinterpret_cast<void*>(_aligned + pSizeInBytes), _tail);
+
+                return reinterpret_cast<void*>(_aligned);
+            }
+
+            static bool _bind_to_node(_In_ void* pPtr, _In_ const size_t& pSizeInBytes, _In_ const uint32_t& pNode)
+            {
+#ifdef SYS_mbind
+                unsigned long _node_mask[4] = { 0, 0, 0, 0 };
+                const size_t _bits = sizeof(unsigned long) * 8;
+                if (pNode >= _bits * 4) return false;
+                _node_mask[pNode / _bits] = 1UL << (pNode % _bits);
+
+                return syscall(SYS_mbind, pPtr, pSizeInBytes, W_MPOL_PREFERRED, _node_mask, _bits * 4, 0) == 0;
+#else
+                return false;
+#endif
+            }
+#endif
+        }
+    }
+}
+
+using namespace wolf::system;
+using namespace wolf::system::page_allocator;
+
+void* page_allocator::allocate(
+    _In_ const size_t& pSizeInBytes,
+    _In_ const w_memory_policy& pPolicy,
+    _In_ const size_t& pAlignment)
+{
+    if (pSizeInBytes == 0) return nullptr;
+
+    //alignment must be power of two
+    size_t _alignment = 16;
+    while (_alignment < pAlignment) _alignment <<= 1;
+
+    w_page_allocation _allocation;
+    void* _ptr = nullptr;
+    bool _fallback = false;
+
+#ifdef W_PAGE_ALLOCATOR_USE_MMAP
+    if (pPolicy != W_MEMORY_POLICY_DEFAULT)
+    {
+        const size_t _huge_page_size = W_HUGE_PAGE_SIZE;
+        uint32_t _applied = W_MEMORY_POLICY_DEFAULT;
+
+#ifdef MAP_HUGETLB
+        if ((pPolicy & W_MEMORY_POLICY_HUGE_PAGES) && _alignment <= _huge_page_size)
+        {
+            auto _size = _round_up(pSizeInBytes, _huge_page_size);
+            auto _mapped = mmap(nullptr, _size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            if (_mapped != MAP_FAILED)
+            {
+                _ptr = _mapped;
+                _allocation.size = _size;
+                _applied |= W_MEMORY_POLICY_HUGE_PAGES;
+            }
+        }
+#endif
+        if (!_ptr && (pPolicy & (W_MEMORY_POLICY_HUGE_PAGES | W_MEMORY_POLICY_TRANSPARENT_HUGE_PAGES)))
+        {
+            //explicit huge pages are not reserved, so ask kernel to back the mapping by transparent huge pages
+            if (pPolicy & W_MEMORY_POLICY_HUGE_PAGES) _fallback = true;
+
+            auto _size = _round_up(pSizeInBytes, _huge_page_size);
+            _ptr = _map_aligned(_size, _alignment > _huge_page_size ? _alignment : _huge_page_size);
+            if (_ptr)
+            {
+                _allocation.size = _size;
+#ifdef MADV_HUGEPAGE
+                if (madvise(_ptr, _size, MADV_HUGEPAGE) == 0)
+                {
+                    _applied |= W_MEMORY_POLICY_TRANSPARENT_HUGE_PAGES;
+                }
+                else
+                {
+                    _fallback = true;
+                }
+#else
+                _fallback = true;
+#endif
+            }
+        }
+        if (!_ptr)
+        {
+            auto _size = _round_up(pSizeInBytes, _get_page_size());
+            _ptr = _map_aligned(_size, _alignment);
+            if (_ptr) _allocation.size = _size;
+        }
+
+        if (_ptr && (pPolicy & W_MEMORY_POLICY_NUMA_LOCAL))
+        {
+            //must be done before the first touch of pages
+            if (_bind_to_node(_ptr, _allocation.size, get_current_numa_node()))
+            {
+                _applied |= W_MEMORY_POLICY_NUMA_LOCAL;
+            }
+            else
+            {
+                _fallback = true;
+            }
+        }
+
+        if (_ptr)
+        {
+            _allocation.base = _ptr;
+            _allocation.is_mapped = true;
+            _allocation.applied_policy = static_cast<w_memory_policy>(_applied);
+        }
+    }
+#else
+    //huge pages and NUMA placement are not supported on this platform
+    _fallback = pPolicy != W_MEMORY_POLICY_DEFAULT;
+#endif
+
+    if (!_ptr)
+    {
+        auto _base = malloc(pSizeInBytes + _alignment);
+        if (!_base)
+        {
+            V(W_FAILED, w_log_type::W_ERROR, "allocating {} bytes. trace info: {}", pSizeInBytes, "page_allocator::allocate");
+            return nullptr;
+        }
+        _ptr = reinterpret_cast<void*>(_round_up(reinterpret_cast<uintptr_t>(_base), _alignment));
+        _allocation.base = _base;
+        _allocation.size = pSizeInBytes;
+        _allocation.is_mapped = false;
+        _allocation.applied_policy = W_MEMORY_POLICY_DEFAULT;
+    }
+
+    auto& _registry = get_registry();
+    std::lock_guard<std::mutex> _lock(_registry.mutex);
+    _registry.allocations[_ptr] = _allocation;
+
+    auto& _stats = _registry.stats;
+    _stats.allocations++;
+    _stats.allocated_bytes += _allocation.size;
+    if (_stats.allocated_bytes > _stats.peak_allocated_bytes)
+    {
+        _stats.peak_allocated_bytes = _stats.allocated_bytes;
+    }
+    if (_allocation.applied_policy & W_MEMORY_POLICY_HUGE_PAGES) _stats.huge_page_bytes += _allocation.size;
+    if (_allocation.applied_policy & W_MEMORY_POLICY_TRANSPARENT_HUGE_PAGES) _stats.transparent_huge_page_bytes += _allocation.size;
+    if (_allocation.applied_policy & W_MEMORY_POLICY_NUMA_LOCAL) _stats.numa_local_bytes += _allocation.size;
+    if (_fallback) _stats.fallbacks++;
+
+    return _ptr;
+}
+
+void page_allocator::free(_In_ void* pPtr)
+{
+    if (!pPtr) return;
+
+    w_page_allocation _allocation;
+    {
+        auto& _registry = get_registry();
+        std::lock_guard<std::mutex> _lock(_registry.mutex);
+
+        auto _iter = _registry.allocations.find(pPtr);
+        if (_iter == _registry.allocations.end())
+        {
+            V(W_FAILED, w_log_type::W_ERROR, "freeing unknown pointer {}. trace info: {}", pPtr, "page_allocator::free");
+            return;
+        }
+        _allocation = _iter->second;
+        _registry.allocations.erase(_iter);
+
+        auto& _stats = _registry.stats;
+        _stats.allocations--;
+        _stats.allocated_bytes -= _allocation.size;
+        if (_allocation.applied_policy & W_MEMORY_POLICY_HUGE_PAGES) _stats.huge_page_bytes -= _allocation.size;
+        if (_allocation.applied_policy & W_MEMORY_POLICY_TRANSPARENT_HUGE_PAGES) _stats.transparent_huge_page_bytes -= _allocation.size;
+        if (_allocation.applied_policy & W_MEMORY_POLICY_NUMA_LOCAL) _stats.numa_local_bytes -= _allocation.size;
+    }
+
+#ifdef W_PAGE_ALLOCATOR_USE_MMAP
+    if (_allocation.is_mapped)
+    {
+        munmap(_allocation.base, _allocation.size);
+        return;
+    }
+#endif
+    ::free(_allocation.base);
+}
+
+void page_allocator::first_touch(_In_ void* pPtr, _In_ const size_t& pSizeInBytes, _In_ w_thread_pool& pThreadPool)
+{
+    if (!pPtr || !pSizeInBytes) return;
+
+    auto _page_size = _get_page_size();
+    auto _number_of_pages = (pSizeInBytes + _page_size - 1) / _page_size;
+    auto _ptr = static_cast<uint8_t*>(pPtr);
+
+    pThreadPool.parallel_for(0, _number_of_pages, [&](_In_ const size_t& pBegin, _In_ const size_t& pEnd)
+    {
+        auto _begin = pBegin * _page_size;
+        auto _end = pEnd * _page_size;
+        if (_end > pSizeInBytes) _end = pSizeInBytes;
+        std::memset(_ptr + _begin, 0, _end - _begin);
+    });
+}
+
+#pragma region Getters
+
+w_memory_policy page_allocator::get_applied_policy(_In_ const void* pPtr)
+{
+    auto& _registry = get_registry();
+    std::lock_guard<std::mutex> _lock(_registry.mutex);
+
+    auto _iter = _registry.allocations.find(pPtr);
+    return _iter == _registry.allocations.end() ? W_MEMORY_POLICY_DEFAULT : _iter->second.applied_policy;
+}
+
+uint32_t page_allocator::get_current_numa_node()
+{
+#if defined(W_PAGE_ALLOCATOR_USE_MMAP) && defined(SYS_getcpu)
+    unsigned _cpu = 0, _node = 0;
+    if (syscall(SYS_getcpu, &_cpu, &_node, nullptr) == 0) return _node;
+#endif
+    return 0;
+}
+
+w_page_allocator_stats page_allocator::get_stats()
+{
+    auto& _registry = get_registry();
+    std::lock_guard<std::mutex> _lock(_registry.mutex);
+    return _registry.stats;
+}
+
+#pragma endregion
@@ -0,0 +1,101 @@
+/*
+	Project			 : Wolf Engine. Copyright(c) Pooya Eimandar (http://PooyaEimandar.com) . All rights reserved.
+	Source			 : Please direct any bug to https://github.com/PooyaEimandar/Wolf.Engine/issues
+	Website			 : http://WolfSource.io
+	Name			 : w_page_allocator.h
+	Description		 : Page based allocations for large buffers with optional huge pages and NUMA placement
+	Comment          : huge pages and NUMA placement are only supported on Linux, other platforms fall back to aligned_malloc
+*/
+
+#if _MSC_VER > 1000
+#pragma once
+#endif
+
+#ifndef __W_PAGE_ALLOCATOR_H__
+#define __W_PAGE_ALLOCATOR_H__
+
+#include "w_system_export.h"
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__ANDROID) || defined(__linux) || defined(__APPLE__)
+#include "w_std.h"
+#endif
+
+namespace wolf
+{
+	namespace system
+	{
+        class w_thread_pool;
+
+        //policy of a large allocation, flags can be combined
+        enum w_memory_policy : uint32_t
+        {
+            //aligned_malloc
+            W_MEMORY_POLICY_DEFAULT = 0,
+            //explicit huge pages (MAP_HUGETLB), falls back to transparent huge pages if no huge page is reserved
+            W_MEMORY_POLICY_HUGE_PAGES = 1 << 0,
+            //page aligned mapping which is advised to use transparent huge pages (MADV_HUGEPAGE)
+            W_MEMORY_POLICY_TRANSPARENT_HUGE_PAGES = 1 << 1,
+            //prefer the NUMA node of the calling thread for all pages (mbind)
+            W_MEMORY_POLICY_NUMA_LOCAL = 1 << 2,
+        };
+
+        inline w_memory_policy operator|(_In_ const w_memory_policy& pLeft, _In_ const w_memory_policy& pRight)
+        {
+            return static_cast<w_memory_policy>(static_cast<uint32_t>(pLeft) | static_cast<uint32_t>(pRight));
+        }
+
+        struct w_page_allocator_stats
+        {
+            //number of allocations which are alive
+            size_t      allocations = 0;
+            //bytes which are alive, including rounding up to page size
+            size_t      allocated_bytes = 0;
+            //maximum of allocated bytes
+            size_t      peak_allocated_bytes = 0;
+            //bytes which are backed by explicit huge pages
+            size_t      huge_page_bytes = 0;
+            //bytes which are advised to use transparent huge pages
+            size_t      transparent_huge_page_bytes = 0;
+            //bytes which are bound to a NUMA node
+            size_t      numa_local_bytes = 0;
+            //number of allocations which could not get the requested policy and used a weaker one
+            size_t      fallbacks = 0;
+        };
+
+        namespace page_allocator
+        {
+            /*
+                allocate a large block of memory
+                @param pSizeInBytes, size of memory in bytes
+                @param pPolicy, allocation policy, it is only a hint and weaker policies will be used if it is not available
+                @param pAlignment, alignment of memory, mapped memory is always page aligned
+                @return pointer to memory or nullptr, the memory must be freed with page_allocator::free
+            */
+            WSYS_EXP void* allocate(
+                _In_ const size_t& pSizeInBytes,
+                _In_ const w_memory_policy& pPolicy = W_MEMORY_POLICY_DEFAULT,
+                _In_ const size_t& pAlignment = 16);
+
+            //free memory which was allocated by page_allocator::allocate
+            WSYS_EXP void free(_In_ void* pPtr);
+
+            /*
+                zero the memory in page sized chunks on workers of pool, so on first touch NUMA policy of Linux
+                each page will be placed on the node of the worker which will use it. Do not combine it with W_MEMORY_POLICY_NUMA_LOCAL
+            */
+            WSYS_EXP void first_touch(_In_ void* pPtr, _In_ const size_t& pSizeInBytes, _In_ w_thread_pool& pThreadPool);
+
+#pragma region Getters
+            //get policy which was actually applied to an allocation
+            WSYS_EXP w_memory_policy get_applied_policy(_In_ const void* pPtr);
+            //get NUMA node of calling thread, returns 0 if it is unknown
+            WSYS_EXP uint32_t get_current_numa_node();
+            WSYS_EXP w_page_allocator_stats get_stats();
+#pragma endregion
+        }
+	}
+}
+
+#endif //__W_PAGE_ALLOCATOR_H__
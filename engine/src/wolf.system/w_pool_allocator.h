@@ -0,0 +1,463 @@
+/*
+	Project			 : Wolf Engine. Copyright(c) Pooya Eimandar (http://PooyaEimandar.com) . All rights reserved.
+	Source			 : Please direct any bug to https://github.com/PooyaEimandar/Wolf.Engine/issues
+	Website			 : http://WolfSource.io
+	Name			 : w_pool_allocator.h
+	Description		 : A cross platform and thread safe fixed size object pool with per thread caches
+	Comment          : objects are allocated from segments which never move or shrink till the pool is released
+*/
+
+#if _MSC_VER > 1000
+#pragma once
+#endif
+
+#ifndef __W_POOL_ALLOCATOR_H__
+#define __W_POOL_ALLOCATOR_H__
+
+#include "w_system_export.h"
+#include "w_logger.h"
+#include "w_memory_tracker.h"
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <atomic>
+#include <mutex>
+#include <memory>
+#include <vector>
+#include <utility>
+#include <algorithm>
+
+#if defined(__ANDROID) || defined(__linux) || defined(__APPLE__)
+#include "w_std.h"
+#endif
+
+//default number of objects in each segment of pool
+#ifndef W_POOL_ALLOCATOR_OBJECTS_PER_SEGMENT
+#define W_POOL_ALLOCATOR_OBJECTS_PER_SEGMENT 256
+#endif
+
+//maximum number of free objects which each thread cache keeps before returning half of them to the pool
+#ifndef W_POOL_ALLOCATOR_CACHE_SIZE
+#define W_POOL_ALLOCATOR_CACHE_SIZE 64
+#endif
+
+//debug mode writes canaries around each object and reports leaks on release
+#ifndef W_POOL_ALLOCATOR_DEBUG_MODE
+#if defined(DEBUG) || defined(_DEBUG)
+#define W_POOL_ALLOCATOR_DEBUG_MODE true
+#else
+#define W_POOL_ALLOCATOR_DEBUG_MODE false
+#endif
+#endif
+
+namespace wolf
+{
+	namespace system
+	{
+        /*
+            Allocates objects of type T from segments of contiguous slots. Freed slots are kept in a shared free list and
+            each thread has its own cache of free slots, so most allocations and frees do not take any lock.
+            Caches are refilled from and flushed to the shared free list in batches. Objects can be freed from any thread
+        */
+        template<typename T>
+        class w_pool_allocator
+        {
+        public:
+            /*
+                @param pName, name of pool which is used in logs
+                @param pObjectsPerSegment, number of objects in each segment
+                @param pDebugMode, write canaries around each object, check them on free and report leaks on release
+                @param pCategory, memory category which segments are accounted to
+            */
+            w_pool_allocator(
+                _In_z_ const char* pName = "w_pool_allocator",
+                _In_ const size_t& pObjectsPerSegment = W_POOL_ALLOCATOR_OBJECTS_PER_SEGMENT,
+                _In_ const bool& pDebugMode = W_POOL_ALLOCATOR_DEBUG_MODE,
+                _In_ const w_memory_category& pCategory = w_memory_tracker::get_thread_category()) :
+                _name(pName),
+                _objects_per_segment(std::max<size_t>(pObjectsPerSegment, 1)),
+                _is_debug_mode(pDebugMode),
+                _category(pCategory),
+                _shared(std::make_shared<_shared_list>()),
+                _live_objects(0)
+            {
+                //slot layout: [header canary][object][footer canary], canaries only exist in debug mode
+                this->_alignment = std::max(alignof(T), alignof(_free_node));
+                this->_header_size = this->_is_debug_mode ? _round_up(sizeof(uint64_t), this->_alignment) : 0;
+                auto _body_size = std::max(sizeof(T), sizeof(_free_node));
+                this->_slot_size = _round_up(
+                    this->_header_size + _body_size + (this->_is_debug_mode ? sizeof(uint64_t) : 0),
+                    this->_alignment);
+                this->_footer_offset = this->_header_size + _body_size;
+            }
+
+            ~w_pool_allocator()
+            {
+                release();
+                this->_shared->is_alive.store(false, std::memory_order_release);
+            }
+
+            //allocate raw memory for one object, returns nullptr if out of memory
+            void* allocate()
+            {
+                auto& _cache = _get_thread_cache();
+                if (!_cache.head && !_refill(_cache)) return nullptr;
+
+                auto _node = _cache.head;
+                _cache.head = _node->next;
+                _cache.count--;
+
+                auto _slot = reinterpret_cast<uint8_t*>(_node) - this->_header_size;
+                if (this->_is_debug_mode)
+                {
+                    _write_canary(_slot, W_POOL_ALLOCATOR_LIVE_CANARY);
+                    _write_canary(_slot + this->_footer_offset, W_POOL_ALLOCATOR_LIVE_CANARY);
+                }
+                this->_live_objects.fetch_add(1, std::memory_order_relaxed);
+
+                return _node;
+            }
+
+            //free raw memory of one object which was allocated from this pool
+            void deallocate(_In_ void* pPtr)
+            {
+                if (!pPtr) return;
+
+                auto _slot = static_cast<uint8_t*>(pPtr) - this->_header_size;
+                if (this->_is_debug_mode)
+                {
+                    auto _header = _read_canary(_slot);
+                    if (_header == W_POOL_ALLOCATOR_FREE_CANARY)
+                    {
+                        V(W_FAILED, w_log_type::W_ERROR, "double free of object {} detected. trace info: {}", pPtr, this->_name);
+                        return;
+                    }
+                    if (_header != W_POOL_ALLOCATOR_LIVE_CANARY ||
+                        _read_canary(_slot + this->_footer_offset) != W_POOL_ALLOCATOR_LIVE_CANARY)
+                    {
+                        V(W_FAILED, w_log_type::W_ERROR, "memory corruption around object {} detected. trace info: {}", pPtr, this->_name);
+                    }
+                    _write_canary(_slot, W_POOL_ALLOCATOR_FREE_CANARY);
+                }
+                this->_live_objects.fetch_sub(1, std::memory_order_relaxed);
+
+                auto _node = static_cast<_free_node*>(pPtr);
+                auto& _cache = _get_thread_cache();
+                _node->next = _cache.head;
+                _cache.head = _node;
+                _cache.count++;
+                if (_cache.count > W_POOL_ALLOCATOR_CACHE_SIZE)
+                {
+                    _flush(_cache, W_POOL_ALLOCATOR_CACHE_SIZE / 2);
+                }
+            }
+
+            //allocate and construct one object, returns nullptr if out of memory
+            template<typename... ARGS>
+            T* allocate_new(ARGS&&... pArgs)
+            {
+                auto _ptr = allocate();
+                if (!_ptr) return nullptr;
+                return new (_ptr) T(std::forward<ARGS>(pArgs)...);
+            }
+
+            //destruct and free one object
+            void deallocate_delete(_In_ T* pObject)
+            {
+                if (!pObject) return;
+                pObject->~T();
+                deallocate(pObject);
+            }
+
+            /*
+                free all segments, objects which are still alive will not be destructed.
+                Thread caches of the pool are discarded the next time their thread uses the pool
+                @return number of objects which were not freed
+            */
+            size_t release()
+            {
+                std::lock_guard<std::mutex> _lock(this->_shared->mutex);
+                if (this->_segments.empty()) return 0;
+
+                auto _leaks = this->_live_objects.load(std::memory_order_relaxed);
+                if (_leaks)
+                {
+                    logger.warning("{} objects of pool {} were not freed", _leaks, this->_name);
+                    if (this->_is_debug_mode)
+                    {
+                        _report_leaks();
+                    }
+                }
+
+                for (auto& _segment : this->_segments)
+                {
+                    free(_segment.memory);
+                    w_memory_tracker::track_free(this->_category, _get_segment_size());
+                }
+                this->_segments.clear();
+
+                this->_shared->free_list = nullptr;
+                this->_shared->number_of_free = 0;
+                this->_shared->generation.fetch_add(1, std::memory_order_release);
+                this->_live_objects.store(0, std::memory_order_relaxed);
+
+                return _leaks;
+            }
+
+#pragma region Getters
+            //get number of objects which are allocated and not freed yet
+            size_t get_number_of_live_objects() const
+            {
+                return this->_live_objects.load(std::memory_order_relaxed);
+            }
+            size_t get_number_of_segments()
+            {
+                std::lock_guard<std::mutex> _lock(this->_shared->mutex);
+                return this->_segments.size();
+            }
+            //get number of objects which can be allocated without allocating new segments
+            size_t get_capacity()
+            {
+                std::lock_guard<std::mutex> _lock(this->_shared->mutex);
+                return this->_segments.size() * this->_objects_per_segment;
+            }
+            //get size of each slot in bytes, including canaries in debug mode
+            size_t get_slot_size() const
+            {
+                return this->_slot_size;
+            }
+            bool get_is_debug_mode() const
+            {
+                return this->_is_debug_mode;
+            }
+#pragma endregion
+
+        private:
+            //Prevent copying
+            w_pool_allocator(w_pool_allocator const&);
+            w_pool_allocator& operator= (w_pool_allocator const&);
+
+            static const uint64_t W_POOL_ALLOCATOR_LIVE_CANARY = 0xA110CA7EDC0FFEEull;
+            static const uint64_t W_POOL_ALLOCATOR_FREE_CANARY = 0xDEADBEEFFEEDF00Dull;
+
+            struct _free_node
+            {
+                _free_node*                         next;
+            };
+
+            struct _segment_info
+            {
+                void*                               memory;
+                uint8_t*                            first_slot;
+            };
+
+            //free list which is shared between threads, it outlives the pool till caches of all threads let it go
+            struct _shared_list
+            {
+                std::mutex                          mutex;
+                _free_node*                         free_list = nullptr;
+                size_t                              number_of_free = 0;
+                //incremented by release, cached slots of an older generation were freed with their segments
+                std::atomic<uint64_t>               generation{ 0 };
+                std::atomic<bool>                   is_alive{ true };
+            };
+
+            //free slots of one pool which are owned by one thread
+            struct _thread_cache
+            {
+                std::shared_ptr<_shared_list>       shared;
+                uint64_t                            generation = 0;
+                _free_node*                         head = nullptr;
+                size_t                              count = 0;
+            };
+
+            //caches of all pools of T which were used by one thread, they are returned to their pools when the thread exits
+            struct _thread_caches
+            {
+                std::vector<_thread_cache>          caches;
+
+                ~_thread_caches()
+                {
+                    for (auto& _cache : this->caches)
+                    {
+                        if (!_cache.head) continue;
+
+                        auto& _shared = *_cache.shared;
+                        std::lock_guard<std::mutex> _lock(_shared.mutex);
+                        if (!_shared.is_alive.load(std::memory_order_acquire) ||
+                            _cache.generation != _shared.generation.load(std::memory_order_acquire)) continue;
+
+                        while (_cache.head)
+                        {
+                            auto _node = _cache.head;
+                            _cache.head = _node->next;
+                            _node->next = _shared.free_list;
+                            _shared.free_list = _node;
+                            _shared.number_of_free++;
+                        }
+                    }
+                }
+            };
+
+            static size_t _round_up(_In_ const size_t& pValue, _In_ const size_t& pAlignment)
+            {
+                return (pValue + pAlignment - 1) / pAlignment * pAlignment;
+            }
+
+            static void _write_canary(_In_ uint8_t* pPtr, _In_ uint64_t pValue)
+            {
+                std::memcpy(pPtr, &pValue, sizeof(uint64_t));
+            }
+
+            static uint64_t _read_canary(_In_ const uint8_t* pPtr)
+            {
+                uint64_t _value;
+                std::memcpy(&_value, pPtr, sizeof(uint64_t));
+                return _value;
+            }
+
+            //get cache of calling thread for this pool, slots of a released generation are discarded
+            _thread_cache& _get_thread_cache()
+            {
+                static thread_local _thread_caches _thread_local_caches;
+                auto& _caches = _thread_local_caches.caches;
+
+                auto _generation = this->_shared->generation.load(std::memory_order_acquire);
+                for (auto& _cache : _caches)
+                {
+                    if (_cache.shared != this->_shared) continue;
+                    if (_cache.generation != _generation)
+                    {
+                        _cache.generation = _generation;
+                        _cache.head = nullptr;
+                        _cache.count = 0;
+                    }
+                    return _cache;
+                }
+
+                //first use of this pool by calling thread, forget caches of destroyed pools
+                _caches.erase(std::remove_if(_caches.begin(), _caches.end(), [](_In_ const _thread_cache& pCache)
+                {
+                    return !pCache.shared->is_alive.load(std::memory_order_acquire);
+                }), _caches.end());
+
+                _thread_cache _cache;
+                _cache.shared = this->_shared;
+                _cache.generation = _generation;
+                _caches.push_back(std::move(_cache));
+                return _caches.back();
+            }
+
+            //move a batch of free slots from the shared free list to the cache of calling thread
+            bool _refill(_Inout_ _thread_cache& pCache)
+            {
+                auto& _shared = *this->_shared;
+                std::lock_guard<std::mutex> _lock(_shared.mutex);
+                if (!_shared.free_list && !_add_segment()) return false;
+
+                size_t _count = 0;
+                while (_shared.free_list && _count < W_POOL_ALLOCATOR_CACHE_SIZE / 2)
+                {
+                    auto _node = _shared.free_list;
+                    _shared.free_list = _node->next;
+                    _node->next = pCache.head;
+                    pCache.head = _node;
+                    _count++;
+                }
+                pCache.count += _count;
+                _shared.number_of_free -= _count;
+                return true;
+            }
+
+            //move pCount free slots from the cache of calling thread to the shared free list
+            void _flush(_Inout_ _thread_cache& pCache, _In_ const size_t& pCount)
+            {
+                auto& _shared = *this->_shared;
+                std::lock_guard<std::mutex> _lock(_shared.mutex);
+                for (size_t i = 0; i < pCount && pCache.head; ++i)
+                {
+                    auto _node = pCache.head;
+                    pCache.head = _node->next;
+                    pCache.count--;
+
+                    _node->next = _shared.free_list;
+                    _shared.free_list = _node;
+                    _shared.number_of_free++;
+                }
+            }
+
+            size_t _get_segment_size() const
+            {
+                return this->_slot_size * this->_objects_per_segment + this->_alignment;
+            }
+
+            //allocate a new segment and push its slots to the shared free list, mutex of shared list must be held
+            bool _add_segment()
+            {
+                auto _size = _get_segment_size();
+                auto _memory = malloc(_size);
+                if (!_memory)
+                {
+                    V(W_FAILED, w_log_type::W_ERROR, "allocating segment with size {}. trace info: {}", _size, this->_name);
+                    return false;
+                }
+                w_memory_tracker::track_alloc(this->_category, _size);
+
+                _segment_info _segment;
+                _segment.memory = _memory;
+                _segment.first_slot = reinterpret_cast<uint8_t*>(_round_up(reinterpret_cast<uintptr_t>(_memory), this->_alignment));
+                this->_segments.push_back(_segment);
+
+                //push in reverse order, so objects will be allocated in order of their addresses
+                for (size_t i = this->_objects_per_segment; i > 0; --i)
+                {
+                    auto _slot = _segment.first_slot + (i - 1) * this->_slot_size;
+                    if (this->_is_debug_mode)
+                    {
+                        _write_canary(_slot, W_POOL_ALLOCATOR_FREE_CANARY);
+                    }
+
+                    auto _node = reinterpret_cast<_free_node*>(_slot + this->_header_size);
+                    _node->next = this->_shared->free_list;
+                    this->_shared->free_list = _node;
+                }
+                this->_shared->number_of_free += this->_objects_per_segment;
+
+                return true;
+            }
+
+            //log address of each object which is still alive, mutex of shared list must be held
+            void _report_leaks()
+            {
+                for (auto& _segment : this->_segments)
+                {
+                    for (size_t i = 0; i < this->_objects_per_segment; ++i)
+                    {
+                        auto _slot = _segment.first_slot + i * this->_slot_size;
+                        if (_read_canary(_slot) == W_POOL_ALLOCATOR_LIVE_CANARY)
+                        {
+                            logger.warning("leaked object {} of pool {}", static_cast<void*>(_slot + this->_header_size), this->_name);
+                        }
+                    }
+                }
+            }
+
+            const char*                             _name;
+            size_t                                  _objects_per_segment;
+            bool                                    _is_debug_mode;
+            w_memory_category                       _category;
+            size_t                                  _alignment;
+            size_t                                  _header_size;
+            size_t                                  _footer_offset;
+            size_t                                  _slot_size;
+
+            //shared free list, segments are guarded by its mutex
+            std::shared_ptr<_shared_list>           _shared;
+            std::vector<_segment_info>              _segments;
+            std::atomic<size_t>                     _live_objects;
+        };
+	}
+}
+
+#endif //__W_POOL_ALLOCATOR_H__
@@ -0,0 +1,328 @@
+/*
+	Project			 : Wolf Engine. Copyright(c) Pooya Eimandar (http://PooyaEimandar.com) . All rights reserved.
+	Source			 : Please direct any bug to https://github.com/PooyaEimandar/Wolf.Engine/issues
+	Website			 : http://WolfSource.io
+	Name			 : w_ring_buffer.h
+	Description		 : A lock-free single producer single consumer ring buffer of bytes on top of w_memory_pool
+	Comment          : reserved and peeked regions are always contiguous, so producer and consumer can work in place
+*/
+
+#if _MSC_VER > 1000
+#pragma once
+#endif
+
+#ifndef __W_RING_BUFFER_H__
+#define __W_RING_BUFFER_H__
+
+#include "w_memory_pool.h"
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+
+//size of cache line which is used for padding of shared atomics
+#ifndef W_CACHE_LINE_SIZE
+#define W_CACHE_LINE_SIZE 64
+#endif
+
+namespace wolf
+{
+	namespace system
+	{
+        /*
+            A contiguous ring buffer (bip buffer) for one producer thread and one consumer thread.
+            The producer calls reserve_write then commit, the consumer calls peek_read then release.
+            When a reservation does not fit at the end of memory, the producer continues from the start and
+            the consumer skips the unused tail, so every region handed out is contiguous
+        */
+        class w_ring_buffer
+        {
+        public:
+            w_ring_buffer() :
+                _capacity(0),
+                _write(0),
+                _watermark(0),
+                _reserved(0),
+                _reserved_wrapped(false),
+                _read(0)
+            {
+            }
+
+            ~w_ring_buffer()
+            {
+                release_memory();
+            }
+
+            /*
+                allocate memory of ring buffer, any content will be discarded
+                @param pCapacityInBytes, size of memory in bytes
+                @param pAlignment, alignment of memory
+                @param pPolicy, use huge pages or NUMA placement for large ring buffers
+                @return W_PASSED on success
+            */
+            W_RESULT initialize(
+                _In_ const size_t& pCapacityInBytes,
+                _In_ const size_t& pAlignment = 16,
+                _In_ const w_memory_policy& pPolicy = W_MEMORY_POLICY_DEFAULT)
+            {
+                if (!this->_memory.alloc(pCapacityInBytes, pAlignment, pPolicy)) return W_FAILED;
+
+                this->_capacity = pCapacityInBytes;
+                this->_reserved = 0;
+                this->_reserved_wrapped = false;
+                this->_watermark.store(0, std::memory_order_relaxed);
+                this->_read.store(0, std::memory_order_relaxed);
+                this->_write.store(0, std::memory_order_release);
+                return W_PASSED;
+            }
+
+            /*
+                grow or shrink the memory and keep the readable data in order.
+                Must not be called while producer or consumer are using the ring buffer
+                @return W_FAILED if readable data does not fit in the new capacity or allocation failed
+            */
+            W_RESULT resize(_In_ const size_t& pCapacityInBytes)
+            {
+                auto _readable = get_size();
+                if (pCapacityInBytes == 0 || _readable > pCapacityInBytes) return W_FAILED;
+
+                auto _ptr = static_cast<uint8_t*>(this->_memory.get_start_ptr());
+                if (!_ptr) return initialize(pCapacityInBytes);
+
+                //move readable data to the start of memory, so it stays in order after re-allocation
+                auto _read = this->_read.load(std::memory_order_relaxed);
+                auto _write = this->_write.load(std::memory_order_relaxed);
+                if (_write >= _read)
+                {
+                    if (_read) std::memmove(_ptr, _ptr + _read, _readable);
+                }
+                else
+                {
+                    //[read, watermark) is older than [0, write), rotate them in place
+                    std::rotate(_ptr, _ptr + _read, _ptr + this->_watermark.load(std::memory_order_relaxed));
+                }
+
+                auto _alignment = this->_memory.get_alignment();
+                if (!this->_memory.re_alloc(pCapacityInBytes, _alignment ? _alignment : 16)) return W_FAILED;
+
+                this->_capacity = pCapacityInBytes;
+                this->_reserved = 0;
+                this->_reserved_wrapped = false;
+                this->_watermark.store(0, std::memory_order_relaxed);
+                this->_read.store(0, std::memory_order_relaxed);
+                this->_write.store(_readable, std::memory_order_release);
+                return W_PASSED;
+            }
+
+            //free memory of ring buffer, must not be called while producer or consumer are using it
+            ULONG release_memory()
+            {
+                this->_capacity = 0;
+                this->_reserved = 0;
+                this->_watermark.store(0, std::memory_order_relaxed);
+                this->_read.store(0, std::memory_order_relaxed);
+                this->_write.store(0, std::memory_order_relaxed);
+                return this->_memory.release();
+            }
+
+#pragma region Producer
+            /*
+                reserve pSizeInBytes contiguous bytes for writing, only the producer thread may call it
+                @return pointer to reserved memory or nullptr if there is not enough contiguous free space
+            */
+            uint8_t* reserve_write(_In_ const size_t& pSizeInBytes)
+            {
+                auto _ptr = static_cast<uint8_t*>(this->_memory.get_start_ptr());
+                if (!_ptr || pSizeInBytes == 0) return nullptr;
+
+                auto _write = this->_write.load(std::memory_order_relaxed);
+                auto _read = this->_read.load(std::memory_order_acquire);
+
+                if (_write >= _read)
+                {
+                    //free regions are [write, capacity) and [0, read - 1)
+                    if (this->_capacity - _write >= pSizeInBytes)
+                    {
+                        this->_reserved = pSizeInBytes;
+                        this->_reserved_wrapped = false;
+                        return _ptr + _write;
+                    }
+                    //write must not reach read after wrapping, otherwise full and empty states are the same
+                    if (pSizeInBytes < _read)
+                    {
+                        this->_reserved = pSizeInBytes;
+                        this->_reserved_wrapped = true;
+                        return _ptr;
+                    }
+                }
+                else if (_read - _write > pSizeInBytes)
+                {
+                    //free region is [write, read - 1)
+                    this->_reserved = pSizeInBytes;
+                    this->_reserved_wrapped = false;
+                    return _ptr + _write;
+                }
+                return nullptr;
+            }
+
+            /*
+                publish pSizeInBytes bytes of last reservation to the consumer, only the producer thread may call it
+                @param pSizeInBytes, number of written bytes, must not be greater than reserved size
+            */
+            void commit(_In_ const size_t& pSizeInBytes)
+            {
+                auto _size = pSizeInBytes < this->_reserved ? pSizeInBytes : this->_reserved;
+                this->_reserved = 0;
+                if (_size == 0) return;
+
+                auto _write = this->_write.load(std::memory_order_relaxed);
+                if (this->_reserved_wrapped)
+                {
+                    //consumer will skip [watermark, capacity) and continue from the start
+                    this->_watermark.store(_write, std::memory_order_relaxed);
+                    this->_write.store(_size, std::memory_order_release);
+                }
+                else
+                {
+                    this->_write.store(_write + _size, std::memory_order_release);
+                }
+            }
+
+            //copy pSizeInBytes bytes to the ring buffer, returns false if there is not enough contiguous free space
+            bool write(_In_ const void* pData, _In_ const size_t& pSizeInBytes)
+            {
+                auto _ptr = reserve_write(pSizeInBytes);
+                if (!_ptr) return false;
+                std::memcpy(_ptr, pData, pSizeInBytes);
+                commit(pSizeInBytes);
+                return true;
+            }
+#pragma endregion
+
+#pragma region Consumer
+            /*
+                get the contiguous readable region, only the consumer thread may call it
+                @param pAvailableInBytes, number of readable bytes at returned pointer
+                @return pointer to readable memory or nullptr if ring buffer is empty
+            */
+            const uint8_t* peek_read(_Out_ size_t& pAvailableInBytes)
+            {
+                pAvailableInBytes = 0;
+
+                auto _ptr = static_cast<const uint8_t*>(this->_memory.get_start_ptr());
+                if (!_ptr) return nullptr;
+
+                auto _read = this->_read.load(std::memory_order_relaxed);
+                auto _write = this->_write.load(std::memory_order_acquire);
+                if (_read == _write) return nullptr;
+
+                if (_write < _read)
+                {
+                    //producer wrapped, read till watermark and then continue from the start
+                    auto _watermark = this->_watermark.load(std::memory_order_relaxed);
+                    if (_read == _watermark)
+                    {
+                        _read = 0;
+                        this->_read.store(0, std::memory_order_release);
+                        if (_write == 0) return nullptr;
+                        pAvailableInBytes = _write;
+                    }
+                    else
+                    {
+                        pAvailableInBytes = _watermark - _read;
+                    }
+                }
+                else
+                {
+                    pAvailableInBytes = _write - _read;
+                }
+                return _ptr + _read;
+            }
+
+            //free pSizeInBytes bytes from the region returned by peek_read, only the consumer thread may call it
+            void release(_In_ const size_t& pSizeInBytes)
+            {
+                if (pSizeInBytes == 0) return;
+                this->_read.store(this->_read.load(std::memory_order_relaxed) + pSizeInBytes, std::memory_order_release);
+            }
+
+            /*
+                copy up to pSizeInBytes bytes from the ring buffer, only the consumer thread may call it
+                @return number of copied bytes
+            */
+            size_t read(_Out_ void* pData, _In_ const size_t& pSizeInBytes)
+            {
+                size_t _copied = 0;
+                auto _dst = static_cast<uint8_t*>(pData);
+                while (_copied < pSizeInBytes)
+                {
+                    size_t _available = 0;
+                    auto _src = peek_read(_available);
+                    if (!_src) break;
+
+                    auto _size = pSizeInBytes - _copied < _available ? pSizeInBytes - _copied : _available;
+                    std::memcpy(_dst + _copied, _src, _size);
+                    release(_size);
+                    _copied += _size;
+                }
+                return _copied;
+            }
+#pragma endregion
+
+#pragma region Getters
+            //get total size of memory in bytes
+            size_t get_capacity() const
+            {
+                return this->_capacity;
+            }
+            //get number of readable bytes, it is exact only when called by producer or consumer while the other one is idle
+            size_t get_size() const
+            {
+                auto _read = this->_read.load(std::memory_order_acquire);
+                auto _write = this->_write.load(std::memory_order_acquire);
+                if (_write >= _read) return _write - _read;
+                return this->_watermark.load(std::memory_order_relaxed) - _read + _write;
+            }
+            //get the largest size which reserve_write can currently return
+            size_t get_max_write_size() const
+            {
+                if (!this->_capacity) return 0;
+
+                auto _read = this->_read.load(std::memory_order_acquire);
+                auto _write = this->_write.load(std::memory_order_acquire);
+                if (_write >= _read)
+                {
+                    auto _tail = this->_capacity - _write;
+                    auto _head = _read ? _read - 1 : 0;
+                    return _tail > _head ? _tail : _head;
+                }
+                return _read - _write - 1;
+            }
+            bool get_is_empty() const
+            {
+                return this->_read.load(std::memory_order_acquire) == this->_write.load(std::memory_order_acquire);
+            }
+#pragma endregion
+
+        private:
+            //Prevent copying
+            w_ring_buffer(w_ring_buffer const&);
+            w_ring_buffer& operator= (w_ring_buffer const&);
+
+            w_memory_pool                                           _memory;
+            size_t                                                  _capacity;
+
+            //owned by producer
+            alignas(W_CACHE_LINE_SIZE) std::atomic<size_t>          _write;
+            //end of valid data before producer wrapped to the start
+            std::atomic<size_t>                                     _watermark;
+            size_t                                                  _reserved;
+            bool                                                    _reserved_wrapped;
+
+            //owned by consumer
+            alignas(W_CACHE_LINE_SIZE) std::atomic<size_t>          _read;
+        };
+	}
+}
+
+#endif //__W_RING_BUFFER_H__
@@ -21,31 +21,556 @@
 #endif
 
 #include <future>
-#include <functional>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <stdexcept>
+#include <atomic>
+#include <thread>
+#include <system_error>
+#include <vector>
 #include "w_system_export.h"
 #include "w_std.h"
+#include "w_fiber_scheduler.h"
 
 namespace wolf
 {
 	namespace system
 	{
+        template<typename T>
+        class w_task_handle;
+
+        //shared state of a task, which is shared between the task and all copies of its handle
+        class w_task_state_base
+        {
+        public:
+            w_task_state_base() : _is_ready(false)
+            {
+            }
+
+            virtual ~w_task_state_base()
+            {
+            }
+
+            //block the caller till the task is done, fibers yield instead of blocking their worker thread
+            void wait()
+            {
+                run_deferred();
+                if (get_is_ready()) return;
+
+                if (w_fiber_scheduler::get_is_fiber())
+                {
+                    w_fiber_scheduler::yield_until([this]()
+                    {
+                        return get_is_ready();
+                    });
+                    return;
+                }
+
+                std::unique_lock<std::mutex> _lock(this->_mutex);
+                this->_condition_var.wait(_lock, [this]()
+                {
+                    return get_is_ready();
+                });
+            }
+
+            template<typename _REP, typename _PER>
+            std::future_status wait_for(_In_ const std::chrono::duration<_REP, _PER>& pTime)
+            {
+                if (get_is_ready()) return std::future_status::ready;
+                if (get_is_deferred()) return std::future_status::deferred;
+
+                if (w_fiber_scheduler::get_is_fiber())
+                {
+                    auto _deadline = std::chrono::steady_clock::now() + pTime;
+                    w_fiber_scheduler::yield_until([this, _deadline]()
+                    {
+                        return get_is_ready() || std::chrono::steady_clock::now() >= _deadline;
+                    });
+                }
+                else
+                {
+                    std::unique_lock<std::mutex> _lock(this->_mutex);
+                    this->_condition_var.wait_for(_lock, pTime, [this]()
+                    {
+                        return get_is_ready();
+                    });
+                }
+                return get_is_ready() ? std::future_status::ready : std::future_status::timeout;
+            }
+
+            //execute the deferred work on the calling thread, if it was not executed yet
+            void run_deferred()
+            {
+                std::function<void()> _work;
+                {
+                    std::lock_guard<std::mutex> _lock(this->_mutex);
+                    _work.swap(this->_deferred_work);
+                }
+                if (_work)
+                {
+                    _work();
+                }
+            }
+
+            //pFunc will be called once the task is done, it will be called immediately if task is already done
+            void add_continuation(_In_ const std::function<void()>& pFunc)
+            {
+                {
+                    std::lock_guard<std::mutex> _lock(this->_mutex);
+                    if (!get_is_ready())
+                    {
+                        this->_continuations.push_back(pFunc);
+                        return;
+                    }
+                }
+                pFunc();
+            }
+
+            void set_deferred(_In_ const std::function<void()>& pWork)
+            {
+                std::lock_guard<std::mutex> _lock(this->_mutex);
+                this->_deferred_work = pWork;
+            }
+
+            void set_exception(_In_ std::exception_ptr pException)
+            {
+                this->_exception = pException;
+                _mark_ready();
+            }
+
+            //rethrow the exception of task if it failed
+            void rethrow_if_failed() const
+            {
+                if (this->_exception)
+                {
+                    std::rethrow_exception(this->_exception);
+                }
+            }
+
+#pragma region Getters
+            bool get_is_ready() const
+            {
+                return this->_is_ready.load(std::memory_order_acquire);
+            }
+
+            bool get_is_deferred()
+            {
+                std::lock_guard<std::mutex> _lock(this->_mutex);
+                return this->_deferred_work != nullptr;
+            }
+
+            std::exception_ptr get_exception() const
+            {
+                return this->_exception;
+            }
+#pragma endregion
+
+        protected:
+            void _mark_ready()
+            {
+                std::vector<std::function<void()>> _continuations;
+                {
+                    std::lock_guard<std::mutex> _lock(this->_mutex);
+                    this->_is_ready.store(true, std::memory_order_release);
+                    _continuations.swap(this->_continuations);
+                    this->_condition_var.notify_all();
+                }
+                for (auto& _continuation : _continuations)
+                {
+                    _continuation();
+                }
+            }
+
+        private:
+            //Prevent copying
+            w_task_state_base(w_task_state_base const&);
+            w_task_state_base& operator= (w_task_state_base const&);
+
+            std::atomic<bool>                           _is_ready;
+            std::mutex                                  _mutex;
+            std::condition_variable                     _condition_var;
+            std::exception_ptr                          _exception;
+            std::function<void()>                       _deferred_work;
+            std::vector<std::function<void()>>          _continuations;
+        };
+
+        template<typename T>
+        class w_task_state : public w_task_state_base
+        {
+        public:
+            void set_value(_In_ T pValue)
+            {
+                this->_value.reset(new T(std::move(pValue)));
+                _mark_ready();
+            }
+
+            const T& get_value() const
+            {
+                //the task is done without a value or an exception
+                if (!this->_value) throw std::future_error(std::future_errc::broken_promise);
+                return *this->_value;
+            }
+
+            //execute pFunc and store its result or its exception
+            template<typename F, typename... ARGS>
+            void invoke(_In_ F& pFunc, _In_ ARGS&&... pArgs)
+            {
+                try
+                {
+                    set_value(pFunc(std::forward<ARGS>(pArgs)...));
+                }
+                catch (...)
+                {
+                    set_exception(std::current_exception());
+                }
+            }
+
+        private:
+            std::unique_ptr<T>                          _value;
+        };
+
+        template<>
+        class w_task_state<void> : public w_task_state_base
+        {
+        public:
+            void set_value()
+            {
+                _mark_ready();
+            }
+
+            void get_value() const
+            {
+            }
+
+            template<typename F, typename... ARGS>
+            void invoke(_In_ F& pFunc, _In_ ARGS&&... pArgs)
+            {
+                try
+                {
+                    pFunc(std::forward<ARGS>(pArgs)...);
+                    set_value();
+                }
+                catch (...)
+                {
+                    set_exception(std::current_exception());
+                }
+            }
+        };
+
+        //result type of a continuation which receives the result of previous task
+        template<typename T, typename F>
+        struct w_task_continuation_result
+        {
+            typedef decltype(std::declval<F&>()(std::declval<const T&>())) type;
+        };
+
+        template<typename F>
+        struct w_task_continuation_result<void, F>
+        {
+            typedef decltype(std::declval<F&>()()) type;
+        };
+
+        //a copyable handle to the result of a task
+        template<typename T>
+        class w_task_handle
+        {
+        public:
+            w_task_handle()
+            {
+            }
+
+            explicit w_task_handle(_In_ const std::shared_ptr<w_task_state<T>>& pState) : _state(pState)
+            {
+            }
+
+            //block till the task is done, deferred tasks will be executed on the calling thread
+            void wait() const
+            {
+                if (this->_state) this->_state->wait();
+            }
+
+            //wait for a while, returns std::future_status::deferred if the task is deferred and was not executed yet
+            template<typename _REP, typename _PER>
+            std::future_status wait_for(_In_ const std::chrono::duration<_REP, _PER>& pTime) const
+            {
+                if (!this->_state) return std::future_status::ready;
+                return this->_state->wait_for(pTime);
+            }
+
+            /*
+                wait for the task and return its result, rethrows the exception of task if it failed.
+                std::future_error with std::future_errc::no_state will be thrown if handle is not valid
+            */
+            auto get() const -> decltype(std::declval<w_task_state<T>>().get_value())
+            {
+                if (!this->_state) throw std::future_error(std::future_errc::no_state);
+                this->_state->wait();
+                this->_state->rethrow_if_failed();
+                return this->_state->get_value();
+            }
+
+            /*
+                schedule pFunc on the shared fiber scheduler once this task is done,
+                pFunc receives the result of this task, if this task fails the exception will be passed to the returned handle.
+                The returned handle fails with std::future_errc::no_state if this handle is not valid
+            */
+            template<typename F>
+            w_task_handle<typename w_task_continuation_result<T, F>::type> then(_In_ F pFunc) const
+            {
+                typedef typename w_task_continuation_result<T, F>::type _result_type;
+
+                auto _state = this->_state;
+                auto _next = std::make_shared<w_task_state<_result_type>>();
+                if (!_state)
+                {
+                    _next->set_exception(std::make_exception_ptr(std::future_error(std::future_errc::no_state)));
+                    return w_task_handle<_result_type>(_next);
+                }
+                if (_state->get_is_deferred())
+                {
+                    //waiting on the continuation runs the deferred task first
+                    _next->set_deferred([_state]()
+                    {
+                        _state->run_deferred();
+                    });
+                }
+
+                _state->add_continuation([_state, _next, pFunc]()
+                {
+                    auto _hr = w_fiber_scheduler::execute([_state, _next, pFunc]() mutable
+                    {
+                        if (_state->get_exception())
+                        {
+                            _next->set_exception(_state->get_exception());
+                            return;
+                        }
+                        _invoke_continuation(*_state, *_next, pFunc);
+                    });
+                    if (_hr == W_FAILED)
+                    {
+                        _next->set_exception(std::make_exception_ptr(std::runtime_error("fiber scheduler was released")));
+                    }
+                });
+                return w_task_handle<_result_type>(_next);
+            }
+
+#pragma region Getters
+            bool get_is_valid() const
+            {
+                return this->_state != nullptr;
+            }
+
+            bool get_is_ready() const
+            {
+                return this->_state && this->_state->get_is_ready();
+            }
+
+            const std::shared_ptr<w_task_state<T>>& get_state() const
+            {
+                return this->_state;
+            }
+#pragma endregion
+
+        private:
+            template<typename U, typename R, typename F>
+            static void _invoke_continuation(_In_ w_task_state<U>& pState, _In_ w_task_state<R>& pNext, _In_ F& pFunc)
+            {
+                pNext.invoke(pFunc, pState.get_value());
+            }
+
+            template<typename R, typename F>
+            static void _invoke_continuation(_In_ w_task_state<void>& pState, _In_ w_task_state<R>& pNext, _In_ F& pFunc)
+            {
+                pNext.invoke(pFunc);
+            }
+
+            std::shared_ptr<w_task_state<T>>            _state;
+        };
+
 		class w_task
 		{
 		public:
-			WSYS_EXP static void execute_async(_In_ const std::function<W_RESULT(void)>& pTaskWork, _In_ const std::function<void(W_RESULT)>& pCallBack = nullptr);
-			WSYS_EXP static void execute_deferred(_In_ const std::function<W_RESULT(void)>& pTaskWork);
-			//wait only work for deferred task
-			WSYS_EXP static std::future_status wait_for(_In_ const long long pMilliSeconds);
-			//wait only work for deferred task
-			template<typename _REP, typename _PER>
-			static std::future_status wait_for(_In_ const std::chrono::duration<_REP, _PER>& pTime);
-			//wait only work for deferred task
-			WSYS_EXP static void wait();
-			//get only work for deferred task
-			WSYS_EXP static void get();
-
-		private:
-			static std::future<W_RESULT> _deferred;
+            //execute pWork on the shared fiber scheduler and return a handle to its result
+            template<typename F>
+            static w_task_handle<decltype(std::declval<F&>()())> run(_In_ F pWork)
+            {
+                typedef decltype(std::declval<F&>()()) _result_type;
+
+                auto _state = std::make_shared<w_task_state<_result_type>>();
+                auto _hr = w_fiber_scheduler::execute([_state, pWork]() mutable
+                {
+                    _state->invoke(pWork);
+                });
+                if (_hr == W_FAILED)
+                {
+                    _state->set_exception(std::make_exception_ptr(std::runtime_error("fiber scheduler was released")));
+                }
+                return w_task_handle<_result_type>(_state);
+            }
+
+            /*
+                execute pWork on a new thread and return a handle to its result, use it for blocking or long running work
+                such as loops which wait on condition variables, sockets or decoders, which must not run as fibers
+            */
+            template<typename F>
+            static w_task_handle<decltype(std::declval<F&>()())> run_on_thread(_In_ F pWork)
+            {
+                typedef decltype(std::declval<F&>()()) _result_type;
+
+                auto _state = std::make_shared<w_task_state<_result_type>>();
+                try
+                {
+                    std::thread([_state, pWork]() mutable
+                    {
+                        _state->invoke(pWork);
+                    }).detach();
+                }
+                catch (const std::system_error&)
+                {
+                    //could not create the thread
+                    _state->set_exception(std::current_exception());
+                }
+                return w_task_handle<_result_type>(_state);
+            }
+
+            //create a task which will be executed on the first thread which waits for it
+            template<typename F>
+            static w_task_handle<decltype(std::declval<F&>()())> defer(_In_ F pWork)
+            {
+                typedef decltype(std::declval<F&>()()) _result_type;
+
+                auto _state = std::make_shared<w_task_state<_result_type>>();
+                std::weak_ptr<w_task_state<_result_type>> _weak_state = _state;
+                _state->set_deferred([_weak_state, pWork]() mutable
+                {
+                    //the state owns this function, so keep a weak reference to avoid a cycle
+                    auto _state = _weak_state.lock();
+                    if (_state)
+                    {
+                        _state->invoke(pWork);
+                    }
+                });
+                return w_task_handle<_result_type>(_state);
+            }
+
+            //returns a handle which will be ready once all of pTasks are done, it fails with the first exception of pTasks
+            template<typename T>
+            static w_task_handle<void> when_all(_In_ const std::vector<w_task_handle<T>>& pTasks)
+            {
+                auto _all = std::make_shared<w_task_state<void>>();
+                if (pTasks.empty())
+                {
+                    _all->set_value();
+                    return w_task_handle<void>(_all);
+                }
+                if (!_get_is_all_valid(*_all, pTasks)) return w_task_handle<void>(_all);
+
+                auto _tasks = pTasks;
+                auto _remaining = std::make_shared<std::atomic<size_t>>(_tasks.size());
+                _set_deferred_tasks(*_all, _tasks);
+                for (auto& _task : _tasks)
+                {
+                    _task.get_state()->add_continuation([_all, _remaining, _tasks]()
+                    {
+                        if (_remaining->fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+                        for (auto& _t : _tasks)
+                        {
+                            if (_t.get_state()->get_exception())
+                            {
+                                _all->set_exception(_t.get_state()->get_exception());
+                                return;
+                            }
+                        }
+                        _all->set_value();
+                    });
+                }
+                return w_task_handle<void>(_all);
+            }
+
+            //returns a handle to the index of the first task of pTasks which is done
+            template<typename T>
+            static w_task_handle<size_t> when_any(_In_ const std::vector<w_task_handle<T>>& pTasks)
+            {
+                auto _any = std::make_shared<w_task_state<size_t>>();
+                if (pTasks.empty())
+                {
+                    _any->set_exception(std::make_exception_ptr(std::invalid_argument("when_any requires at least one task")));
+                    return w_task_handle<size_t>(_any);
+                }
+                if (!_get_is_all_valid(*_any, pTasks)) return w_task_handle<size_t>(_any);
+
+                _set_deferred_tasks(*_any, pTasks);
+                auto _is_set = std::make_shared<std::atomic<bool>>(false);
+                for (size_t i = 0; i < pTasks.size(); ++i)
+                {
+                    pTasks[i].get_state()->add_continuation([_any, _is_set, i]()
+                    {
+                        if (!_is_set->exchange(true, std::memory_order_acq_rel))
+                        {
+                            _any->set_value(i);
+                        }
+                    });
+                }
+                return w_task_handle<size_t>(_any);
+            }
+
+            //execute pTaskWork on a new thread, so it may block, pCallBack will be called from the same thread
+			WSYS_EXP static w_task_handle<W_RESULT> execute_async(
+                _In_ const std::function<W_RESULT(void)>& pTaskWork,
+                _In_ const std::function<void(W_RESULT)>& pCallBack = nullptr);
+            //create a deferred task, it will be executed on the first thread which waits for the returned handle
+			WSYS_EXP static w_task_handle<W_RESULT> execute_deferred(_In_ const std::function<W_RESULT(void)>& pTaskWork);
+
+        private:
+            //a combined task fails with std::future_errc::no_state if one of pTasks is not valid
+            template<typename T>
+            static bool _get_is_all_valid(_In_ w_task_state_base& pCombined, _In_ const std::vector<w_task_handle<T>>& pTasks)
+            {
+                for (auto& _task : pTasks)
+                {
+                    if (!_task.get_is_valid())
+                    {
+                        pCombined.set_exception(std::make_exception_ptr(std::future_error(std::future_errc::no_state)));
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+            //waiting on a combined task runs deferred tasks which are not executed yet
+            template<typename T>
+            static void _set_deferred_tasks(_In_ w_task_state_base& pCombined, _In_ const std::vector<w_task_handle<T>>& pTasks)
+            {
+                bool _has_deferred = false;
+                for (auto& _task : pTasks)
+                {
+                    if (_task.get_state()->get_is_deferred())
+                    {
+                        _has_deferred = true;
+                        break;
+                    }
+                }
+                if (!_has_deferred) return;
+
+                std::vector<std::weak_ptr<w_task_state<T>>> _states;
+                for (auto& _task : pTasks)
+                {
+                    _states.push_back(_task.get_state());
+                }
+                pCombined.set_deferred([_states]()
+                {
+                    for (auto& _weak_state : _states)
+                    {
+                        auto _state = _weak_state.lock();
+                        if (_state)
+                        {
+                            _state->run_deferred();
+                        }
+                    }
+                });
+            }
 		};
 	}
 }
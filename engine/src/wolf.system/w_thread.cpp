@@ -1,237 +1,187 @@
 #include "w_system_pch.h"
 #include "w_thread.h"
-#include <queue>
-
-#ifdef __WIN32
-#include <process.h>
-#else
+#include "w_aligned_malloc.h"
 #include <mutex>
+#include <new>
 #include <condition_variable>
-#include <sstream>
+
+//maximum number of pending jobs of each thread, producers will yield while the queue is full
+#ifndef W_THREAD_JOB_QUEUE_CAPACITY
+#define W_THREAD_JOB_QUEUE_CAPACITY 4096
 #endif
 
 namespace wolf
 {
     namespace system
     {
-        
-#ifdef __WIN32
-        unsigned int __stdcall THREAD_WORK(_In_ void* pParameter);
-#endif
-        
+        struct w_thread_job
+        {
+            w_job                                   work;
+            w_job_counter*                          counter = nullptr;
+        };
+
         class w_thread_pimp
         {
         public:
-            w_thread_pimp() : _is_released(false)
+            w_thread_pimp() :
+                _job_queue(W_THREAD_JOB_QUEUE_CAPACITY),
+                _thread_id(0),
+                _is_released(false),
+                _epoch(0),
+                _is_sleeping(false),
+                _enqueued(0),
+                _completed(0),
+                _waiters(0)
             {
-#ifdef __WIN32
-                InitializeCriticalSection(&this->_critical_section);
-                InitializeConditionVariable(&this->_condition_var);
-                this->_thread_handle = (HANDLE)_beginthreadex(0, 0, THREAD_WORK, this, 0, 0);
-#else
                 this->_thread_handle = std::thread(&w_thread_pimp::action, this);
-#endif
             }
             ~w_thread_pimp()
             {
                 release();
             }
 
-            void add_job(_In_ const std::function<void()>& pJob)
+            //_job_queue is aligned to cache line, which is more than operator new of C++14 guarantees
+            static void* operator new(_In_ size_t pSizeInBytes)
             {
-#ifdef __WIN32
-                EnterCriticalSection(&this->_critical_section);
+#if defined(__WIN32) || defined(_MSC_VER) 
+                auto _ptr = _aligned_malloc(pSizeInBytes, alignof(w_thread_pimp));
 #else
-                std::lock_guard<std::mutex> _lock(this->_critical_section);
+                auto _ptr = aligned_malloc(pSizeInBytes, alignof(w_thread_pimp));
 #endif
-                
-                this->_job_queue.push(std::move(pJob));
-                
-                //signal for action function
-#ifdef __WIN32
-                WakeConditionVariable(&this->_condition_var);
-                LeaveCriticalSection(&this->_critical_section);
+                if (!_ptr) throw std::bad_alloc();
+                return _ptr;
+            }
+
+            static void operator delete(_In_ void* pPtr)
+            {
+#if defined(__WIN32) || defined(_MSC_VER) 
+                _aligned_free(pPtr);
 #else
-                this->_condition_var.notify_one();
+                aligned_free(pPtr);
 #endif
             }
 
-            void wait()
+            void add_job(_In_ w_job&& pJob, _In_opt_ w_job_counter* pCounter)
             {
-#ifdef __WIN32
-                EnterCriticalSection(&this->_critical_section);
-                while (!this->_job_queue.empty())
+                if (pCounter)
                 {
-                    SleepConditionVariableCS(&this->_condition_var, &this->_critical_section, INFINITE);
+                    pCounter->_increment();
                 }
-                LeaveCriticalSection(&this->_critical_section);
-#else
-                std::unique_lock<std::mutex> _lock(this->_critical_section);
-                this->_condition_var.wait(_lock, [this]()
+
+                w_thread_job _job;
+                _job.work = std::move(pJob);
+                _job.counter = pCounter;
+
+                this->_enqueued.fetch_add(1, std::memory_order_relaxed);
+                while (!this->_job_queue.try_enqueue(std::move(_job)))
+                {
+                    //queue is full, make sure consumer is awake and give it time to drain
+                    _wake();
+                    std::this_thread::yield();
+                }
+                _wake();
+            }
+
+            void wait()
+            {
+                //wait only for jobs which were added before calling this function
+                auto _target = this->_enqueued.load(std::memory_order_seq_cst);
+                if (this->_completed.load(std::memory_order_seq_cst) >= _target) return;
+
+                std::unique_lock<std::mutex> _lock(this->_done_mutex);
+                this->_waiters.fetch_add(1, std::memory_order_seq_cst);
+                this->_done_condition_var.wait(_lock, [this, _target]()
                 {
-                    return this->_job_queue.empty();
+                    return this->_completed.load(std::memory_order_seq_cst) >= _target;
                 });
-#endif
+                this->_waiters.fetch_sub(1, std::memory_order_seq_cst);
             }
 
             void action()
             {
-                //get thread id
-#ifdef __WIN32
-                this->_thread_id = w_thread::get_current_thread_id();
-#else
-                //convert std::thread::id to DWORD
-                auto __thread_id = w_thread::get_current_thread_id();
-                std::stringstream _ss;
-                _ss << __thread_id;
-                this->_thread_id = std::atoll(_ss.str().c_str());
-                _ss.clear();
-#endif
+                this->_thread_id = static_cast<DWORD>(w_thread::get_current_thread_id());
+
+                w_thread_job _job;
                 while (true)
                 {
-#ifdef __WIN32
-                    EnterCriticalSection(&this->_critical_section);
-                    if (!this->_job_queue.size())
-                    {
-                        SleepConditionVariableCS(&this->_condition_var, &this->_critical_section, INFINITE);
-                    }
-                    if (this->_is_released)
+                    auto _epoch = this->_epoch.load(std::memory_order_seq_cst);
+                    if (this->_job_queue.try_dequeue(_job))
                     {
-                        break;
-                    }
-                    std::function<void()> _job = this->_job_queue.front();
-                    LeaveCriticalSection(&this->_critical_section);
+                        //execute job
+                        _job.work();
+                        _job.work.reset();
+                        if (_job.counter)
+                        {
+                            _job.counter->_decrement();
+                            _job.counter = nullptr;
+                        }
 
-                    //execute job
-                    _job();
-                    
-                    EnterCriticalSection(&this->_critical_section);
-                    if (this->_is_released)
-                    {
-                        break;
-                    }
-                    if (this->_job_queue.size())
-                    {
-                        this->_job_queue.pop();
-                    }
-                    //signal for next action
-                    WakeConditionVariable(&this->_condition_var);
-                    LeaveCriticalSection(&this->_critical_section);
-#else
-                    std::function<void()> _job;
-                    
-                    //for auto releasing _lock
-                    {
-                        std::unique_lock<std::mutex> _lock(this->_critical_section);
-                        this->_condition_var.wait(_lock, [this]
+                        this->_completed.fetch_add(1, std::memory_order_seq_cst);
+                        if (this->_waiters.load(std::memory_order_seq_cst))
                         {
-                            return !this->_job_queue.empty() || this->_is_released;
-                        });
-                        
-                        if (this->_is_released) break;
-                        
-                        _job = this->_job_queue.front();
+                            std::lock_guard<std::mutex> _lock(this->_done_mutex);
+                            this->_done_condition_var.notify_all();
+                        }
+                        continue;
                     }
-                    
-                    //execute job
-                    _job();
-                    
-                     //for auto releasing _lock
+
+                    //sleep till a producer changes the epoch
+                    std::unique_lock<std::mutex> _lock(this->_sleep_mutex);
+                    if (this->_is_released) break;
+                    this->_is_sleeping.store(true, std::memory_order_seq_cst);
+                    this->_sleep_condition_var.wait(_lock, [this, _epoch]
                     {
-                        std::lock_guard<std::mutex> _lock(this->_critical_section);
-                        this->_job_queue.pop();
-                        this->_condition_var.notify_one();
-                    }
-#endif
+                        return this->_is_released || this->_epoch.load(std::memory_order_seq_cst) != _epoch;
+                    });
+                    this->_is_sleeping.store(false, std::memory_order_relaxed);
                 }
             }
 
             ULONG release()
             {
-                if (this->_is_released) return 1;
-
-#ifdef __WIN32
-                EnterCriticalSection(&this->_critical_section);
-                this->_is_released = true;
+                if (!this->_thread_handle.joinable()) return 1;
 
-                auto _jobs_count = this->_job_queue.size();
-                if (_jobs_count)
+                wait();
                 {
-                    while (_jobs_count)
-                    {
-                        this->_job_queue.pop();
-                        _jobs_count = this->_job_queue.size();
-                    }
-                }
-                else
-                {
-                    //Signal to action to wake up and break from loop
-                    WakeConditionVariable(&this->_condition_var);
-                }
-
-                LeaveCriticalSection(&this->_critical_section);
-#else
-                if (this->_thread_handle.joinable())
-                {
-                    wait();
-                    this->_critical_section.lock();
+                    std::lock_guard<std::mutex> _lock(this->_sleep_mutex);
                     this->_is_released = true;
-                    this->_condition_var.notify_one();
-                    this->_critical_section.unlock();
-                    this->_thread_handle.join();
-                    
-                    logger.write("thread with id: {}  destroyed", _thread_id);
+                    this->_sleep_condition_var.notify_one();
                 }
-#endif
-                return 0;
-            }
+                this->_thread_handle.join();
 
-#ifdef __WIN32
-            void destroy()
-            {
-                //close thread
-                CloseHandle(this->_thread_handle);
-                DeleteCriticalSection(&this->_critical_section);
-                delete this;
+                logger.write("thread with id: {}  destroyed", this->_thread_id);
+
+                return 0;
             }
-#endif
 
-            DWORD get_thread_id()
+        private:
+            void _wake()
             {
-                return this->_thread_id;
+                this->_epoch.fetch_add(1, std::memory_order_seq_cst);
+                //lock only if consumer is sleeping
+                if (this->_is_sleeping.load(std::memory_order_seq_cst))
+                {
+                    std::lock_guard<std::mutex> _lock(this->_sleep_mutex);
+                    this->_sleep_condition_var.notify_one();
+                }
             }
 
-        private:
-#if defined(__WIN32) || defined(__UWP)
-            HANDLE                                  _thread_handle;
-            CRITICAL_SECTION                        _critical_section;
-            CONDITION_VARIABLE                      _condition_var;
-#else
             std::thread                             _thread_handle;
-            std::mutex                              _critical_section;
-            std::condition_variable                 _condition_var;
-#endif
-            
+            w_mpsc_queue<w_thread_job>              _job_queue;
             DWORD                                   _thread_id;
-            std::queue<std::function<void()>>       _job_queue;
             bool                                    _is_released;
-        };
 
-#if defined(__WIN32) || defined(__UWP)
-        unsigned int __stdcall THREAD_WORK(_In_ void* pParameter)
-        {
-            auto _action_thread_ptr = (w_thread_pimp*)pParameter;
-            if (_action_thread_ptr)
-            {
-                _action_thread_ptr->action();
-                auto _thread_id = _action_thread_ptr->get_thread_id();
-                _action_thread_ptr->destroy();
-                logger.write("thread with id: {} destroyed", _thread_id);
-            }
-            return W_PASSED;
-        }
-#endif
+            std::mutex                              _sleep_mutex;
+            std::condition_variable                 _sleep_condition_var;
+            std::atomic<uint32_t>                   _epoch;
+            std::atomic<bool>                       _is_sleeping;
 
+            std::mutex                              _done_mutex;
+            std::condition_variable                 _done_condition_var;
+            std::atomic<uint64_t>                   _enqueued;
+            std::atomic<uint64_t>                   _completed;
+            std::atomic<uint32_t>                   _waiters;
+        };
     }
 }
 
@@ -246,10 +196,10 @@ w_thread::~w_thread()
     release();
 }
 
-void w_thread::add_job(_In_ const std::function<void()>& pJob)
+void w_thread::add_job(_In_ w_job&& pJob, _In_opt_ w_job_counter* pCounter)
 {
     if (!this->_pimp) return;
-    this->_pimp->add_job(pJob);
+    this->_pimp->add_job(std::move(pJob), pCounter);
 }
 
 void w_thread::wait()
@@ -262,4 +212,6 @@ void w_thread::release()
 {
     if (!this->_pimp) return;
     this->_pimp->release();
+    delete this->_pimp;
+    this->_pimp = nullptr;
 }
@@ -26,6 +26,8 @@
 
 #include "w_system_export.h"
 #include <functional>
+#include "w_mpsc_queue.h"
+#include "w_job_counter.h"
 
 #if defined(__ANDROID) || defined(__linux) || defined(__APPLE__)
 #include "w_std.h"
@@ -42,7 +44,19 @@ namespace wolf
             WSYS_EXP w_thread();
             WSYS_EXP ~w_thread();
 
-            WSYS_EXP void add_job(_In_ const std::function<void()>& pJob);
+            /*
+                add a job to the lock-free queue of this thread, the job will be moved into the queue
+                @param pJob, the job
+                @param pCounter, optional counter which will be decremented once the job is done
+            */
+            WSYS_EXP void add_job(_In_ w_job&& pJob, _In_opt_ w_job_counter* pCounter = nullptr);
+            //add a callable, captures up to w_job::inline_size bytes will not allocate
+            template<typename F>
+            void add_job(_In_ F&& pJob, _In_opt_ w_job_counter* pCounter = nullptr)
+            {
+                add_job(w_job(std::forward<F>(pJob)), pCounter);
+            }
+            //wait for jobs which were added before calling this function
             WSYS_EXP void wait();
             WSYS_EXP void release();
 
@@ -74,6 +88,10 @@ namespace wolf
 
 
         private:
+            //Prevent copying
+            w_thread(w_thread const&);
+            w_thread& operator= (w_thread const&);
+
             w_thread_pimp*                          _pimp;
         };
 	}
@@ -1,9 +1,644 @@
 #include "w_system_pch.h"
 #include "w_thread_pool.h"
+#include <deque>
+#include <random>
+#include <algorithm>
+
+//maximum time in microseconds which a waiting thread sleeps before looking for new jobs again
+#ifndef W_THREAD_POOL_HELPER_SLEEP_US
+#define W_THREAD_POOL_HELPER_SLEEP_US 100
+#endif
+
+namespace wolf
+{
+    namespace system
+    {
+        struct w_pool_job
+        {
+            std::function<void()>                   work;
+            w_job_counter*                          counter = nullptr;
+            //true if the job added for specific worker
+            bool                                    affinity = false;
+        };
+
+        /*
+            Chase-Lev work stealing deque, based on "Correct and Efficient Work-Stealing for Weak Memory Models"
+            only the owner worker pushes and pops from bottom, other workers steal from top
+        */
+        class w_work_stealing_deque
+        {
+            struct w_ring
+            {
+                w_ring(_In_ const int64_t& pCapacity) :
+                    capacity(pCapacity),
+                    mask(pCapacity - 1),
+                    items(new std::atomic<w_pool_job*>[pCapacity])
+                {
+                }
+                ~w_ring()
+                {
+                    delete[] this->items;
+                }
+
+                w_pool_job* get(_In_ const int64_t& pIndex) const
+                {
+                    return this->items[pIndex & this->mask].load(std::memory_order_relaxed);
+                }
+
+                void put(_In_ const int64_t& pIndex, _In_ w_pool_job* pJob)
+                {
+                    this->items[pIndex & this->mask].store(pJob, std::memory_order_relaxed);
+                }
+
+                w_ring* grow(_In_ const int64_t& pBottom, _In_ const int64_t& pTop) const
+                {
+                    auto _ring = new w_ring(this->capacity * 2);
+                    for (auto i = pTop; i != pBottom; ++i)
+                    {
+                        _ring->put(i, get(i));
+                    }
+                    return _ring;
+                }
+
+                int64_t                             capacity;
+                int64_t                             mask;
+                std::atomic<w_pool_job*>*           items;
+            };
+
+        public:
+            //capacity must be power of 2
+            w_work_stealing_deque(_In_ const int64_t& pCapacity = 1024) :
+                _top(0),
+                _bottom(0),
+                _ring(new w_ring(pCapacity))
+            {
+            }
+
+            ~w_work_stealing_deque()
+            {
+                delete this->_ring.load(std::memory_order_relaxed);
+                for (auto _r : this->_old_rings)
+                {
+                    delete _r;
+                }
+                this->_old_rings.clear();
+            }
+
+            //push a job, must be called only by owner
+            void push(_In_ w_pool_job* pJob)
+            {
+                auto _b = this->_bottom.load(std::memory_order_relaxed);
+                auto _t = this->_top.load(std::memory_order_acquire);
+                auto _r = this->_ring.load(std::memory_order_relaxed);
+
+                if (_b - _t > _r->capacity - 1)
+                {
+                    //thieves may still read from old ring, so keep it alive till destruction of deque
+                    this->_old_rings.push_back(_r);
+                    _r = _r->grow(_b, _t);
+                    this->_ring.store(_r, std::memory_order_release);
+                }
+                _r->put(_b, pJob);
+                //publish the job to thieves which load bottom with acquire
+                this->_bottom.store(_b + 1, std::memory_order_release);
+            }
+
+            //pop a job, must be called only by owner
+            w_pool_job* pop()
+            {
+                auto _b = this->_bottom.load(std::memory_order_relaxed) - 1;
+                auto _r = this->_ring.load(std::memory_order_relaxed);
+                this->_bottom.store(_b, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                auto _t = this->_top.load(std::memory_order_relaxed);
+
+                w_pool_job* _job = nullptr;
+                if (_t <= _b)
+                {
+                    _job = _r->get(_b);
+                    if (_t == _b)
+                    {
+                        //the last item, race with thieves
+                        if (!this->_top.compare_exchange_strong(
+                            _t,
+                            _t + 1,
+                            std::memory_order_seq_cst,
+                            std::memory_order_relaxed))
+                        {
+                            _job = nullptr;
+                        }
+                        this->_bottom.store(_b + 1, std::memory_order_relaxed);
+                    }
+                }
+                else
+                {
+                    //deque was empty
+                    this->_bottom.store(_b + 1, std::memory_order_relaxed);
+                }
+                return _job;
+            }
+
+            //steal a job, can be called by any thread
+            w_pool_job* steal()
+            {
+                auto _t = this->_top.load(std::memory_order_acquire);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                auto _b = this->_bottom.load(std::memory_order_acquire);
+
+                if (_t < _b)
+                {
+                    auto _r = this->_ring.load(std::memory_order_acquire);
+                    auto _job = _r->get(_t);
+                    if (!this->_top.compare_exchange_strong(
+                        _t,
+                        _t + 1,
+                        std::memory_order_seq_cst,
+                        std::memory_order_relaxed))
+                    {
+                        //lost the race with owner or other thieves
+                        return nullptr;
+                    }
+                    return _job;
+                }
+                return nullptr;
+            }
+
+        private:
+            //Prevent copying
+            w_work_stealing_deque(w_work_stealing_deque const&);
+            w_work_stealing_deque& operator= (w_work_stealing_deque const&);
+
+            std::atomic<int64_t>                    _top;
+            std::atomic<int64_t>                    _bottom;
+            std::atomic<w_ring*>                    _ring;
+            std::vector<w_ring*>                    _old_rings;
+        };
+
+        class w_thread_pool_pimp;
+
+        //worker of current thread, will be used for pushing jobs to the deque of owner worker
+        static thread_local w_thread_pool_pimp*     s_current_pool = nullptr;
+        static thread_local size_t                  s_current_worker_index = 0;
+        //pools of jobs which are running on current thread, a job may help other jobs, so they are nested
+        static thread_local std::vector<w_thread_pool_pimp*> s_running_jobs;
+
+        class w_thread_pool_pimp
+        {
+            struct w_worker
+            {
+                std::thread                         thread;
+                w_work_stealing_deque               deque;
+                //jobs which added with affinity, only this worker executes them
+                std::mutex                          affinity_mutex;
+                std::deque<w_pool_job*>             affinity_jobs;
+                std::atomic<size_t>                 affinity_pending;
+
+                w_worker() : affinity_pending(0) {}
+            };
+
+        public:
+            w_thread_pool_pimp(_In_ const size_t& pNumberOfThreads) :
+                _is_released(false),
+                _pending(0),
+                _blocked(0),
+                _epoch(0),
+                _sleepers(0)
+            {
+                auto _size = std::max<size_t>(pNumberOfThreads, 1);
+                for (size_t i = 0; i < _size; ++i)
+                {
+                    this->_workers.push_back(new w_worker());
+                }
+                //start workers after all deques were created, because workers are going to steal from each others
+                for (size_t i = 0; i < _size; ++i)
+                {
+                    this->_workers[i]->thread = std::thread(&w_thread_pool_pimp::action, this, i);
+                }
+            }
+
+            ~w_thread_pool_pimp()
+            {
+                release();
+            }
+
+            void submit(_In_ const std::function<void()>& pJob, _In_opt_ w_job_counter* pCounter)
+            {
+                auto _job = _create_job(pJob, pCounter);
+                if (s_current_pool == this)
+                {
+                    //called from one of our workers, so push it to the deque of this worker
+                    this->_workers[s_current_worker_index]->deque.push(_job);
+                }
+                else
+                {
+                    std::lock_guard<std::mutex> _lock(this->_global_mutex);
+                    this->_global_jobs.push_back(_job);
+                }
+                _notify(false);
+            }
+
+            void submit_after(
+                _In_ w_job_counter& pDependency,
+                _In_ const std::function<void()>& pJob,
+                _In_opt_ w_job_counter* pCounter)
+            {
+                //create the job right now, so wait_all and pCounter consider it as pending job
+                auto _job = _create_job(pJob, pCounter);
+                auto _submit = [this, _job]()
+                {
+                    {
+                        std::lock_guard<std::mutex> _lock(this->_global_mutex);
+                        this->_global_jobs.push_back(_job);
+                    }
+                    _notify(false);
+                };
+
+                {
+                    std::lock_guard<std::mutex> _lock(pDependency._mutex);
+                    if (pDependency._value.load(std::memory_order_acquire) != 0)
+                    {
+                        pDependency._continuations.push_back(_submit);
+                        return;
+                    }
+                }
+                _submit();
+            }
+
+            void add_job_for_thread(
+                _In_ const size_t& pThreadIndex,
+                _In_ const std::function<void()>& pJob,
+                _In_opt_ w_job_counter* pCounter)
+            {
+                if (pThreadIndex >= this->_workers.size()) return;
+
+                auto _job = _create_job(pJob, pCounter);
+                _job->affinity = true;
+                auto _worker = this->_workers[pThreadIndex];
+                _worker->affinity_pending.fetch_add(1, std::memory_order_relaxed);
+                {
+                    std::lock_guard<std::mutex> _lock(_worker->affinity_mutex);
+                    _worker->affinity_jobs.push_back(_job);
+                }
+                //we do not know which worker will be waked up, so wake up all of them
+                _notify(true);
+            }
+
+            void parallel_for(
+                _In_ const size_t& pBegin,
+                _In_ const size_t& pEnd,
+                _In_ const std::function<void(const size_t&, const size_t&)>& pFunc,
+                _In_ size_t pGrainSize)
+            {
+                if (pEnd <= pBegin) return;
+
+                auto _count = pEnd - pBegin;
+                if (pGrainSize == 0)
+                {
+                    //a few ranges per worker, so stealing can balance the uneven ranges
+                    pGrainSize = std::max<size_t>(1, _count / (this->_workers.size() * 4));
+                }
+                if (_count <= pGrainSize)
+                {
+                    pFunc(pBegin, pEnd);
+                    return;
+                }
+
+                w_job_counter _counter;
+                //the first range will be executed on the calling thread
+                for (auto _begin = pBegin + pGrainSize; _begin < pEnd; _begin += pGrainSize)
+                {
+                    auto _end = std::min(_begin + pGrainSize, pEnd);
+                    submit([&pFunc, _begin, _end]()
+                    {
+                        pFunc(_begin, _end);
+                    }, &_counter);
+                }
+                pFunc(pBegin, std::min(pBegin + pGrainSize, pEnd));
+
+                wait(_counter);
+            }
+
+            void wait(_In_ w_job_counter& pCounter)
+            {
+                _help_until([&pCounter]()
+                {
+                    return pCounter.get_is_done();
+                }, [&pCounter]()
+                {
+                    pCounter._wait_for(std::chrono::microseconds(W_THREAD_POOL_HELPER_SLEEP_US));
+                });
+            }
+
+            void wait_for(_In_ const size_t& pThreadIndex)
+            {
+                if (pThreadIndex >= this->_workers.size()) return;
+
+                auto _worker = this->_workers[pThreadIndex];
+                std::unique_lock<std::mutex> _lock(this->_done_mutex);
+                this->_done_condition_var.wait(_lock, [_worker]()
+                {
+                    return _worker->affinity_pending.load(std::memory_order_acquire) == 0;
+                });
+            }
+
+            void wait_all()
+            {
+                /*
+                    jobs of this pool which are running on the calling thread can not finish before we return,
+                    so they are excluded from pending jobs, as well as jobs of other threads which are waiting in wait_all
+                */
+                const auto _blocked = static_cast<size_t>(std::count(s_running_jobs.begin(), s_running_jobs.end(), this));
+                this->_blocked.fetch_add(_blocked, std::memory_order_acq_rel);
+
+                _help_until([this]()
+                {
+                    return _get_is_all_done();
+                }, [this]()
+                {
+                    std::unique_lock<std::mutex> _lock(this->_done_mutex);
+                    this->_done_condition_var.wait_for(_lock, std::chrono::microseconds(W_THREAD_POOL_HELPER_SLEEP_US), [this]()
+                    {
+                        return _get_is_all_done();
+                    });
+                });
+
+                if (_blocked && this->_blocked.fetch_sub(_blocked, std::memory_order_acq_rel) == _blocked)
+                {
+                    std::lock_guard<std::mutex> _lock(this->_done_mutex);
+                    this->_done_condition_var.notify_all();
+                }
+            }
+
+            void action(_In_ const size_t pIndex)
+            {
+                s_current_pool = this;
+                s_current_worker_index = pIndex;
+
+                logger.write("thread pool worker with id: {} started", w_thread::get_current_thread_id());
+
+                std::minstd_rand _random(static_cast<unsigned int>(pIndex + 1));
+                while (!this->_is_released.load(std::memory_order_acquire))
+                {
+                    //capture epoch before looking for jobs, so we will not miss any notification
+                    auto _epoch = this->_epoch.load(std::memory_order_seq_cst);
+
+                    auto _job = _find_job(pIndex, _random);
+                    if (_job)
+                    {
+                        _execute(pIndex, _job);
+                        continue;
+                    }
+
+                    std::unique_lock<std::mutex> _lock(this->_sleep_mutex);
+                    this->_sleepers.fetch_add(1, std::memory_order_seq_cst);
+                    this->_sleep_condition_var.wait(_lock, [this, _epoch]()
+                    {
+                        return this->_is_released.load(std::memory_order_acquire) ||
+                            this->_epoch.load(std::memory_order_seq_cst) != _epoch;
+                    });
+                    this->_sleepers.fetch_sub(1, std::memory_order_relaxed);
+                }
+
+                s_current_pool = nullptr;
+            }
+
+            void release()
+            {
+                if (this->_is_released.load()) return;
+
+                //let workers finish all pending jobs
+                wait_all();
+
+                {
+                    std::lock_guard<std::mutex> _lock(this->_sleep_mutex);
+                    this->_is_released.store(true, std::memory_order_release);
+                }
+                this->_sleep_condition_var.notify_all();
+
+                //join all workers before deleting them, other workers may still be stealing from their deques
+                for (auto _worker : this->_workers)
+                {
+                    if (_worker->thread.joinable())
+                    {
+                        _worker->thread.join();
+                    }
+                }
+                for (auto _worker : this->_workers)
+                {
+                    delete _worker;
+                }
+                this->_workers.clear();
+            }
+
+            size_t get_pool_size() const
+            {
+                return this->_workers.size();
+            }
+
+            bool get_is_worker_thread() const
+            {
+                return s_current_pool == this;
+            }
+
+        private:
+            //all jobs are done, except jobs which are blocked in wait_all
+            bool _get_is_all_done() const
+            {
+                auto _blocked = this->_blocked.load(std::memory_order_acquire);
+                return this->_pending.load(std::memory_order_acquire) <= _blocked;
+            }
+
+            /*
+                execute pending jobs on the calling thread till pIsDone returns true, pSleep will be called
+                when there is nothing to execute and it must return after a short time, so new jobs can be picked
+            */
+            template<typename D, typename S>
+            void _help_until(_In_ const D& pIsDone, _In_ const S& pSleep)
+            {
+                //workers of this pool look at their own jobs first, other threads only take shared jobs
+                const auto _is_worker = s_current_pool == this;
+                const auto _index = _is_worker ? s_current_worker_index : 0;
+
+                std::minstd_rand _random(static_cast<unsigned int>(_index + 1));
+                while (!pIsDone())
+                {
+                    auto _job = _is_worker ? _find_job(_index, _random) : _find_shared_job(_random);
+                    if (_job)
+                    {
+                        _execute(_index, _job);
+                    }
+                    else if (_is_worker)
+                    {
+                        //blocking a worker may cause dead lock if the rest of jobs are in its deque
+                        std::this_thread::yield();
+                    }
+                    else
+                    {
+                        pSleep();
+                    }
+                }
+            }
+
+            w_pool_job* _create_job(_In_ const std::function<void()>& pJob, _In_opt_ w_job_counter* pCounter)
+            {
+                auto _job = new w_pool_job();
+                _job->work = pJob;
+                _job->counter = pCounter;
+                if (pCounter)
+                {
+                    pCounter->_increment();
+                }
+                this->_pending.fetch_add(1, std::memory_order_relaxed);
+                return _job;
+            }
+
+            void _notify(_In_ const bool& pAll)
+            {
+                this->_epoch.fetch_add(1, std::memory_order_seq_cst);
+                if (this->_sleepers.load(std::memory_order_seq_cst) == 0) return;
+
+                std::lock_guard<std::mutex> _lock(this->_sleep_mutex);
+                if (pAll)
+                {
+                    this->_sleep_condition_var.notify_all();
+                }
+                else
+                {
+                    this->_sleep_condition_var.notify_one();
+                }
+            }
+
+            w_pool_job* _find_job(_In_ const size_t& pIndex, _In_ std::minstd_rand& pRandom)
+            {
+                auto _worker = this->_workers[pIndex];
+
+                //first of all the jobs which belong to this worker
+                {
+                    std::lock_guard<std::mutex> _lock(_worker->affinity_mutex);
+                    if (!_worker->affinity_jobs.empty())
+                    {
+                        auto _job = _worker->affinity_jobs.front();
+                        _worker->affinity_jobs.pop_front();
+                        return _job;
+                    }
+                }
+
+                //then local deque
+                auto _job = _worker->deque.pop();
+                if (_job) return _job;
+
+                //then jobs which submitted from outside of pool
+                {
+                    std::lock_guard<std::mutex> _lock(this->_global_mutex);
+                    if (!this->_global_jobs.empty())
+                    {
+                        _job = this->_global_jobs.front();
+                        this->_global_jobs.pop_front();
+                        return _job;
+                    }
+                }
+
+                //finally try to steal from other workers, start from a random victim
+                auto _size = this->_workers.size();
+                if (_size < 2) return nullptr;
+
+                auto _start = pRandom() % _size;
+                for (size_t i = 0; i < _size; ++i)
+                {
+                    auto _victim = (_start + i) % _size;
+                    if (_victim == pIndex) continue;
+
+                    _job = this->_workers[_victim]->deque.steal();
+                    if (_job) return _job;
+                }
+                return nullptr;
+            }
+
+            //find a job for threads outside of the pool, jobs which added for specific worker will not be returned
+            w_pool_job* _find_shared_job(_In_ std::minstd_rand& pRandom)
+            {
+                {
+                    std::lock_guard<std::mutex> _lock(this->_global_mutex);
+                    if (!this->_global_jobs.empty())
+                    {
+                        auto _job = this->_global_jobs.front();
+                        this->_global_jobs.pop_front();
+                        return _job;
+                    }
+                }
+
+                auto _size = this->_workers.size();
+                auto _start = pRandom() % _size;
+                for (size_t i = 0; i < _size; ++i)
+                {
+                    auto _job = this->_workers[(_start + i) % _size]->deque.steal();
+                    if (_job) return _job;
+                }
+                return nullptr;
+            }
+
+            //pIndex is the index of worker which executes the job, it is only used for jobs which added for specific worker
+            void _execute(_In_ const size_t& pIndex, _In_ w_pool_job* pJob)
+            {
+                auto _is_affinity_job = pJob->affinity;
+                if (pJob->work)
+                {
+                    s_running_jobs.push_back(this);
+                    pJob->work();
+                    s_running_jobs.pop_back();
+                }
+                if (pJob->counter)
+                {
+                    pJob->counter->_decrement();
+                }
+                delete pJob;
+
+                bool _signal = false;
+                if (_is_affinity_job &&
+                    this->_workers[pIndex]->affinity_pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                {
+                    _signal = true;
+                }
+                if (this->_pending.fetch_sub(1, std::memory_order_acq_rel) - 1 <= this->_blocked.load(std::memory_order_acquire))
+                {
+                    _signal = true;
+                }
+                if (_signal)
+                {
+                    std::lock_guard<std::mutex> _lock(this->_done_mutex);
+                    this->_done_condition_var.notify_all();
+                }
+            }
+
+            std::vector<w_worker*>                  _workers;
+            std::atomic<bool>                       _is_released;
+            //number of jobs which are not finished yet
+            std::atomic<size_t>                     _pending;
+            //number of running jobs which are waiting in wait_all
+            std::atomic<size_t>                     _blocked;
+
+            //jobs which submitted from threads outside of the pool
+            std::mutex                              _global_mutex;
+            std::deque<w_pool_job*>                 _global_jobs;
+
+            //sleeping and waking up workers
+            std::mutex                              _sleep_mutex;
+            std::condition_variable                 _sleep_condition_var;
+            std::atomic<uint64_t>                   _epoch;
+            std::atomic<uint32_t>                   _sleepers;
+
+            //signaling waiters of wait_for and wait_all
+            std::mutex                              _done_mutex;
+            std::condition_variable                 _done_condition_var;
+        };
+    }
+}
 
 using namespace wolf::system;
 
-w_thread_pool::w_thread_pool()
+#pragma region w_thread_pool
+
+w_thread_pool::w_thread_pool() : _pimp(nullptr)
 {
 }
 
@@ -15,62 +650,124 @@ w_thread_pool::~w_thread_pool()
 void w_thread_pool::allocate(_In_ const size_t& pSize)
 {
     release();
-    this->_threads.resize(pSize);
+    if (pSize == 0) return;
+    this->_pimp = new (std::nothrow) w_thread_pool_pimp(pSize);
+    if (!this->_pimp)
+    {
+        logger.error("could not allocate memory for w_thread_pool_pimp. trace info: w_thread_pool::allocate");
+    }
 }
 
 void w_thread_pool::wait_for(_In_ const size_t& pThreadIndex)
 {
-    if (pThreadIndex < this->_threads.size())
-    {
-        this->_threads[pThreadIndex].wait();
-    }
+    if (!this->_pimp) return;
+    this->_pimp->wait_for(pThreadIndex);
 }
 
 void w_thread_pool::wait_all()
 {
-    for (auto& _t : this->_threads)
+    if (!this->_pimp) return;
+    this->_pimp->wait_all();
+}
+
+void w_thread_pool::wait(_In_ w_job_counter& pCounter)
+{
+    if (!this->_pimp)
     {
-        _t.wait();
+        pCounter.wait();
+        return;
     }
+    this->_pimp->wait(pCounter);
 }
 
 void w_thread_pool::release()
 {
-    for (auto& _t : this->_threads)
+    if (!this->_pimp) return;
+    this->_pimp->release();
+    delete this->_pimp;
+    this->_pimp = nullptr;
+}
+
+void w_thread_pool::submit(_In_ const std::function<void()>& pJob, _In_opt_ w_job_counter* pCounter)
+{
+    if (!this->_pimp)
+    {
+        //no worker, so execute it on the calling thread
+        pJob();
+        return;
+    }
+    this->_pimp->submit(pJob, pCounter);
+}
+
+void w_thread_pool::submit_after(
+    _In_ w_job_counter& pDependency,
+    _In_ const std::function<void()>& pJob,
+    _In_opt_ w_job_counter* pCounter)
+{
+    if (!this->_pimp)
     {
-        _t.release();
+        pDependency.wait();
+        pJob();
+        return;
     }
-    this->_threads.clear();
+    this->_pimp->submit_after(pDependency, pJob, pCounter);
+}
+
+void w_thread_pool::parallel_for(
+    _In_ const size_t& pBegin,
+    _In_ const size_t& pEnd,
+    _In_ const std::function<void(const size_t& pRangeBegin, const size_t& pRangeEnd)>& pFunc,
+    _In_ size_t pGrainSize)
+{
+    if (!this->_pimp)
+    {
+        if (pBegin < pEnd)
+        {
+            pFunc(pBegin, pEnd);
+        }
+        return;
+    }
+    this->_pimp->parallel_for(pBegin, pEnd, pFunc, pGrainSize);
 }
 
 #pragma region Getters
 
 size_t w_thread_pool::get_pool_size() const
 {
-    return this->_threads.size();
+    if (!this->_pimp) return 0;
+    return this->_pimp->get_pool_size();
+}
+
+bool w_thread_pool::get_is_worker_thread() const
+{
+    return this->_pimp && this->_pimp->get_is_worker_thread();
 }
 
 #pragma endregion
 
 #pragma region Setters
 
-void w_thread_pool::add_jobs_for_thread(_In_ const size_t& pThreadIndex, _In_ const std::vector<std::function<void()>>& pJobs)
+void w_thread_pool::add_jobs_for_thread(
+    _In_ const size_t& pThreadIndex,
+    _In_ const std::vector<std::function<void()>>& pJobs,
+    _In_opt_ w_job_counter* pCounter)
 {
-    if (pThreadIndex < this->_threads.size())
+    if (!this->_pimp) return;
+    for (auto& _job : pJobs)
     {
-        for (auto& _job : pJobs)
-        {
-            this->_threads[pThreadIndex].add_job(_job);
-        }
+        this->_pimp->add_job_for_thread(pThreadIndex, _job, pCounter);
     }
 }
 
-void w_thread_pool::add_job_for_thread(_In_ const size_t& pThreadIndex, _In_ const std::function<void()>& pJob)
+void w_thread_pool::add_job_for_thread(
+    _In_ const size_t& pThreadIndex,
+    _In_ const std::function<void()>& pJob,
+    _In_opt_ w_job_counter* pCounter)
 {
-    if (pThreadIndex < this->_threads.size())
-    {
-        this->_threads[pThreadIndex].add_job(pJob);
-    }
+    if (!this->_pimp) return;
+    this->_pimp->add_job_for_thread(pThreadIndex, pJob, pCounter);
 }
 
-#pragma endregion
\ No newline at end of file
+#pragma endregion
+
+#pragma endregion
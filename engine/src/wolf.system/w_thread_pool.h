@@ -3,8 +3,8 @@
 	Source			 : Please direct any bug to https://github.com/PooyaEimandar/Wolf.Engine/issues
 	Website			 : http://WolfSource.io
 	Name			 : w_thread_pool.h
-	Description		 : A cross platform thread pool class 
-	Comment          :
+	Description		 : A cross platform work stealing thread pool class
+	Comment          : each worker owns a Chase-Lev deque, idle workers steal from others
 */
 
 #if _MSC_VER > 1000
@@ -21,6 +21,8 @@ namespace wolf
 {
 	namespace system
 	{
+        class w_thread_pool_pimp;
+
         class w_thread_pool
         {
         public:
@@ -31,26 +33,64 @@ namespace wolf
             WSYS_EXP void allocate(_In_ const size_t& pNumberOfThreads);
 			//wait for specific thread to be done
             WSYS_EXP void wait_for(_In_ const size_t& pThreadIndex);
-			//wait for all threads
+			//wait for all jobs of pool, the calling thread executes pending jobs while waiting. When it is called from a job, the jobs which are waiting in wait_all are not waited for
             WSYS_EXP void wait_all();
+            /*
+                wait for all jobs which signal pCounter, instead of sleeping the calling thread executes
+                pending jobs of pool (except jobs which were added for specific thread) till pCounter reached zero
+            */
+            WSYS_EXP void wait(_In_ w_job_counter& pCounter);
 			//release all resources
             WSYS_EXP void release();
 
+            //submit a job without thread affinity, one of the idle workers will pick or steal it
+            WSYS_EXP void submit(_In_ const std::function<void()>& pJob, _In_opt_ w_job_counter* pCounter = nullptr);
+            //submit a job which will be scheduled once all jobs of pDependency are done
+            WSYS_EXP void submit_after(
+                _In_ w_job_counter& pDependency,
+                _In_ const std::function<void()>& pJob,
+                _In_opt_ w_job_counter* pCounter = nullptr);
+            /*
+                split [pBegin, pEnd) into ranges and execute pFunc for each range on all workers,
+                the calling thread executes one of ranges and returns when all ranges are done
+                @param pBegin, the first index
+                @param pEnd, one past the last index
+                @param pFunc, the function which will be called with sub range of [begin, end)
+                @param pGrainSize, minimum size of each range, zero means calculate it based on number of workers
+            */
+            WSYS_EXP void parallel_for(
+                _In_ const size_t& pBegin,
+                _In_ const size_t& pEnd,
+                _In_ const std::function<void(const size_t& pRangeBegin, const size_t& pRangeEnd)>& pFunc,
+                _In_ size_t pGrainSize = 0);
+
 #pragma region Getters
             WSYS_EXP size_t get_pool_size() const;
+            //returns true if the calling thread is one of workers of this pool
+            WSYS_EXP bool get_is_worker_thread() const;
 #pragma endregion
 
 #pragma region Setters
 			//add jobs for specific thread
-            WSYS_EXP void add_jobs_for_thread(_In_ const size_t& pThreadIndex, _In_ const std::vector<std::function<void()>>& pJobs);
+            WSYS_EXP void add_jobs_for_thread(
+                _In_ const size_t& pThreadIndex,
+                _In_ const std::vector<std::function<void()>>& pJobs,
+                _In_opt_ w_job_counter* pCounter = nullptr);
 			//add a job for specific thread
-            WSYS_EXP void add_job_for_thread(_In_ const size_t& pThreadIndex, _In_ const std::function<void()>& pJob);
+            WSYS_EXP void add_job_for_thread(
+                _In_ const size_t& pThreadIndex,
+                _In_ const std::function<void()>& pJob,
+                _In_opt_ w_job_counter* pCounter = nullptr);
 #pragma endregion
 
         private:
-            std::vector<w_thread> _threads;
+            //Prevent copying
+            w_thread_pool(w_thread_pool const&);
+            w_thread_pool& operator= (w_thread_pool const&);
+
+            w_thread_pool_pimp*                     _pimp;
         };
 	}
 }
 
-#endif //__W_THREAD_H__
+#endif //__W_THREAD_POOL_H__
@@ -30,8 +30,8 @@ WOLF_MAIN()
     //log to output file
     logger.write("Wolf initialized");
 
-    //execute async task in standard c++
-    w_task::execute_async([]()-> W_RESULT
+    //execute async task on the shared fiber scheduler
+    auto _async_task = w_task::execute_async([]()-> W_RESULT
     {
         logger.write("async task 01 started");
         return W_PASSED;
@@ -41,8 +41,15 @@ WOLF_MAIN()
         logger.write("async task 01 completed");
     });
 
+    //continue with another task once the async task is done
+    auto _continuation = _async_task.then([](const W_RESULT& pHR)-> W_RESULT
+    {
+        logger.write("continuation of async task 01 started with result: {}", pHR);
+        return pHR;
+    });
+
     //define deferred task
-    w_task::execute_deferred([]()-> W_RESULT
+    auto _deferred_task_01 = w_task::execute_deferred([]()-> W_RESULT
     {
 
         logger.write("deferred task 01 started");
@@ -53,7 +60,7 @@ WOLF_MAIN()
 
     });
     //deferred wait for only 1 sec and then continue
-    auto _status = w_task::wait_for(std::chrono::seconds(1).count());
+    auto _status = _deferred_task_01.wait_for(std::chrono::seconds(1));
     //check status of deferred task
     switch (_status)
     {
@@ -66,12 +73,12 @@ WOLF_MAIN()
     case std::future_status::deferred:
         logger.write("deferred task deferred");
         //call it
-        wolf::system::w_task::get();
+        _deferred_task_01.get();
         break;
     }
 
-    //create another deferred task
-    w_task::execute_deferred([]()-> W_RESULT
+    //create another deferred task, each deferred task owns its handle
+    auto _deferred_task_02 = w_task::execute_deferred([]()-> W_RESULT
     {
         logger.write("deferred task 02 started");
         //wait for 1 sec
@@ -79,10 +86,15 @@ WOLF_MAIN()
         logger.write("deferred task 02 done");
         return W_PASSED;
     });
-    //deferred will block until deferred task done
-    w_task::wait();
+
+    //wait for all tasks, deferred tasks will be executed on this thread
+    std::vector<w_task_handle<W_RESULT>> _tasks = { _continuation, _deferred_task_02 };
+    w_task::when_all(_tasks).wait();
 
     logger.write("all done");
+
+    //release fiber scheduler of tasks
+    w_fiber_scheduler::release();
 	
     //release logger
     logger.release();
@@ -55,6 +55,28 @@ WOLF_MAIN()
     logger.write("main is waiting for others threads to execute their jobs");
     _thread_pool.wait_all();
 
+    //a job may wait for all jobs of its own pool, it does not wait for itself
+    std::atomic<size_t> _done_jobs(0);
+    w_job_counter _counter;
+    _thread_pool.submit([&_thread_pool, &_done_jobs]()
+    {
+        for (size_t i = 0; i < 64; ++i)
+        {
+            _thread_pool.submit([&_done_jobs]()
+            {
+                _done_jobs.fetch_add(1, std::memory_order_relaxed);
+            });
+        }
+        _thread_pool.wait_all();
+        logger.write("job with thread id: {} waited for {} jobs", w_thread::get_current_thread_id(), _done_jobs.load());
+    }, &_counter);
+    _thread_pool.wait(_counter);
+    if (_done_jobs.load() != 64)
+    {
+        logger.error("wait_all of job returned before other jobs were done");
+        return EXIT_FAILURE;
+    }
+
     logger.write("releasing thread pool");
     _thread_pool.release();
 	
@@ -28,6 +28,9 @@ WOLF_MAIN()
 
     size_t _length = 10;
 
+    //account memory of this pool to media category
+    w_memory_tag_scope _memory_tag(W_MEMORY_CATEGORY_MEDIA);
+
     w_memory_pool _memory;
     _memory.alloc(_length * sizeof(float));
 
@@ -68,6 +71,11 @@ WOLF_MAIN()
         logger.write("{}", _new_f[i].number);
         logger.write(_new_f[i].name);
     }
+
+    //output memory statistics of all categories
+    auto _media_stats = w_memory_tracker::get_stats(W_MEMORY_CATEGORY_MEDIA);
+    logger.write("media category uses {} bytes, peak {} bytes", _media_stats.current_bytes, _media_stats.peak_bytes);
+    logger.write(w_memory_tracker::to_json(true));
     
     logger.release();
 
@@ -16,5 +16,6 @@
 
 #include <wolf.h>
 #include <w_memory_pool.h>
+#include <w_memory_tracker.h>
 
 #endif
@@ -32,9 +32,14 @@ WOLF_MAIN()
     {
         logger.write("pusher launched with socket ID: {}", pSocketID);
         
-        const char* _msg = "Hello, I'm pusher!";
-        auto _len = strlen(_msg) + 1;//1 for "\0" end of message
-        if(w_network::send(pSocketID, _msg, _len) != _len)
+        //pack the message in place inside the buffer of nanomsg, it will be sent without copying
+        w_network_message _msg;
+        msgpack::packer<w_network_message> _packer(_msg);
+        const char* _text = "Hello, I'm pusher!";
+        _packer.pack(std::make_tuple(msgpack::type::raw_ref(_text, static_cast<uint32_t>(strlen(_text))), pSocketID));
+
+        auto _len = _msg.get_size();
+        if (w_network::send(pSocketID, _msg) != static_cast<int>(_len))
         {
             logger.error("count of sent bytes not equal to count of message bytes");
             return;
@@ -16,6 +16,7 @@
 
 #include <wolf.h>
 #include <w_network.h>
+#include <w_network_message.h>
 #include <w_thread.h>
 
 #endif
@@ -32,12 +32,22 @@ WOLF_MAIN()
     {
         logger.write("puller launched with socket ID: {}", pSocketID);
         
-        char* _buffer = nullptr;
+        //the message owns the buffer of nanomsg and it will be unpacked in place
+        w_network_message _msg;
         while (1)
         {
-            if(w_network::receive(pSocketID, &_buffer) >= 0)
+            if (w_network::receive(pSocketID, _msg) >= 0)
             {
-                logger.write("Roger that, puller received: {}", _buffer);
+                size_t _offset = 0;
+                msgpack::object_handle _handle;
+                if (_msg.unpack(_handle, _offset) == W_PASSED)
+                {
+                    //raw_ref points to the buffer of message
+                    std::tuple<msgpack::type::raw_ref, int> _content;
+                    _handle.get().convert(_content);
+                    auto& _text = std::get<0>(_content);
+                    logger.write("Roger that, puller received: {} from socket: {}", std::string(_text.ptr, _text.size), std::get<1>(_content));
+                }
                 break;
             }
         }
@@ -27,44 +27,27 @@ WOLF_MAIN()
 #endif
     logger.initialize(_log_config);
     
+    //one event loop serves all sockets, handlers run on workers of thread pool
+    w_network_reactor _reactor;
+    _reactor.initialize(nullptr, 2);
+
     w_signal<void(const int&)> on_bind_established;
-	on_bind_established += [](const int& pSocketID)
+	on_bind_established += [&_reactor](const int& pSocketID)
 	{
 		logger.write("node just attached to reply server on socket ID: {}", pSocketID);
 
-		while (true)
+		//messages of this socket are handled one by one and in order, so we can reply inside the handler
+		_reactor.add_receiver(pSocketID, [](const int& pID, const char* pBuffer, const size_t& pLength)
 		{
-			//receive
-			char* _rcv_buffer = nullptr;
-			auto _rcv_len = w_network::receive(pSocketID, &_rcv_buffer);
-			if (_rcv_len >= 0)
-			{
-				std::string _rcv_msg;
-				_rcv_msg.resize(_rcv_len);
-				memcpy(&_rcv_msg[0], _rcv_buffer, _rcv_len);
-
-				logger.write("message \'{}\' received", _rcv_msg);
-
-				_rcv_msg.clear();
-				w_network::free_buffer(_rcv_buffer);
+			logger.write("message \'{}\' received", std::string(pBuffer, pLength));
 
-				//send ack
-				std::string _msg = "server: " + w_time_span::now().to_string();
-				if (w_network::send(pSocketID, _msg.c_str(), _msg.size()) >= 0)
-				{
-					logger.write("message \'{}\' sent.", _msg);
-				}
-				_msg.clear();
-			}
-			else
+			//send ack
+			std::string _msg = "server: " + w_time_span::now().to_string();
+			if (w_network::send(pID, _msg.c_str(), _msg.size()) >= 0)
 			{
-				logger.write("could not receive");
+				logger.write("message \'{}\' sent.", _msg);
 			}
-
-
-			//wait for 1 second
-			w_thread::sleep_current_thread(1000);
-		}
+		});
 	};
     
     w_network _req_rep_server;
@@ -75,6 +58,7 @@ WOLF_MAIN()
     //sleep 5 sec
     w_thread::sleep_current_thread(5000);
     
+	_reactor.release();
 	_req_rep_server.release();
     logger.release();
 
@@ -16,6 +16,7 @@
 
 #include <wolf.h>
 #include <w_network.h>
+#include <w_network_reactor.h>
 #include <w_thread.h>
 #include <w_time_span.h>
 
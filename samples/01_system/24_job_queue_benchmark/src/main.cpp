@@ -0,0 +1,191 @@
+/*
+	Project			 : Wolf Engine. Copyright(c) Pooya Eimandar (http://PooyaEimandar.com) . All rights reserved.
+	Source			 : Please direct any bug to https://github.com/PooyaEimandar/Wolf.Engine/issues
+	Website			 : http://WolfSource.io
+	Name			 : main.cpp
+	Description		 : This sample measures throughput of job submission of w_thread
+	Comment          : compares lock-free queue of w_thread with the old mutex and std::queue<std::function> implementation
+*/
+
+#include "pch.h"
+#include <w_timer.h>
+#include <w_thread.h>
+#include <queue>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <vector>
+
+//namespaces
+using namespace wolf;
+using namespace wolf::system;
+
+static const size_t JOBS_COUNT = 1 << 20;
+
+//the old implementation of w_thread, each add_job locks a mutex and allocates a std::function
+class legacy_thread
+{
+public:
+    legacy_thread() : _is_released(false)
+    {
+        this->_thread = std::thread(&legacy_thread::action, this);
+    }
+
+    ~legacy_thread()
+    {
+        release();
+    }
+
+    void add_job(_In_ const std::function<void()>& pJob)
+    {
+        std::lock_guard<std::mutex> _lock(this->_mutex);
+        this->_job_queue.push(pJob);
+        this->_condition_var.notify_one();
+    }
+
+    void wait()
+    {
+        std::unique_lock<std::mutex> _lock(this->_mutex);
+        this->_condition_var.wait(_lock, [this]()
+        {
+            return this->_job_queue.empty();
+        });
+    }
+
+    void release()
+    {
+        if (!this->_thread.joinable()) return;
+        wait();
+        {
+            std::lock_guard<std::mutex> _lock(this->_mutex);
+            this->_is_released = true;
+            this->_condition_var.notify_all();
+        }
+        this->_thread.join();
+    }
+
+private:
+    void action()
+    {
+        while (true)
+        {
+            std::function<void()> _job;
+            {
+                std::unique_lock<std::mutex> _lock(this->_mutex);
+                this->_condition_var.wait(_lock, [this]
+                {
+                    return !this->_job_queue.empty() || this->_is_released;
+                });
+                if (this->_is_released) break;
+                _job = this->_job_queue.front();
+            }
+
+            _job();
+
+            {
+                std::lock_guard<std::mutex> _lock(this->_mutex);
+                this->_job_queue.pop();
+                this->_condition_var.notify_all();
+            }
+        }
+    }
+
+    std::thread                             _thread;
+    std::mutex                              _mutex;
+    std::condition_variable                 _condition_var;
+    std::queue<std::function<void()>>       _job_queue;
+    bool                                    _is_released;
+};
+
+//a typical job payload, the lambda below captures 48 bytes
+struct job_payload
+{
+    uint64_t    values[5];
+};
+
+//submit JOBS_COUNT jobs from pProducers threads and returns jobs per second
+template<typename T>
+static double run(_In_ T& pThread, _In_ const size_t& pProducers, _Inout_ std::atomic<uint64_t>& pSum)
+{
+    w_timer _timer;
+    _timer.start();
+
+    std::vector<std::thread> _producers;
+    const auto _jobs_per_producer = JOBS_COUNT / pProducers;
+    for (size_t i = 0; i < pProducers; ++i)
+    {
+        _producers.emplace_back([&pThread, &pSum, _jobs_per_producer, i]()
+        {
+            auto _sum = &pSum;
+            for (size_t j = 0; j < _jobs_per_producer; ++j)
+            {
+                job_payload _payload = { { i, j, 1, 2, 3 } };
+                pThread.add_job([_sum, _payload]()
+                {
+                    _sum->fetch_add(_payload.values[0] + _payload.values[1], std::memory_order_relaxed);
+                });
+            }
+        });
+    }
+    for (auto& _p : _producers)
+    {
+        _p.join();
+    }
+    pThread.wait();
+
+    auto _seconds = _timer.get_seconds();
+    return _seconds > 0 ? (_jobs_per_producer * pProducers) / _seconds : 0.0;
+}
+
+WOLF_MAIN()
+{
+    w_logger_config _log_config;
+    _log_config.app_name = L"24_job_queue_benchmark";
+    _log_config.log_path = wolf::system::io::get_current_directoryW();
+#ifdef __WIN32
+    _log_config.log_to_std_out = false;
+#else
+    _log_config.log_to_std_out = true;
+#endif
+    //initialize logger, and log in to the output debug window of visual studio(just for windows) and Log folder inside running directory
+    logger.initialize(_log_config);
+
+    //log to output file
+    logger.write("Wolf initialized");
+
+    const size_t _producers[] = { 1, 4, 16 };
+    for (auto _count : _producers)
+    {
+        std::atomic<uint64_t> _legacy_sum(0), _sum(0);
+
+        double _legacy_jobs_per_sec = 0;
+        {
+            legacy_thread _legacy;
+            _legacy_jobs_per_sec = run(_legacy, _count, _legacy_sum);
+        }
+
+        double _jobs_per_sec = 0;
+        {
+            w_thread _thread;
+            _jobs_per_sec = run(_thread, _count, _sum);
+            _thread.release();
+        }
+
+        if (_legacy_sum != _sum)
+        {
+            logger.error("results of legacy and lock-free queues are not equal");
+            return EXIT_FAILURE;
+        }
+
+        logger.write("producers: {} legacy: {:.0f} jobs/sec lock-free: {:.0f} jobs/sec speedup: {:.2f}x",
+            _count,
+            _legacy_jobs_per_sec,
+            _jobs_per_sec,
+            _legacy_jobs_per_sec > 0 ? _jobs_per_sec / _legacy_jobs_per_sec : 0.0);
+    }
+
+    //release logger
+    logger.release();
+
+    return EXIT_SUCCESS;
+}
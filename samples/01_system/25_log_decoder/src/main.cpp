@@ -0,0 +1,80 @@
+/*
+	Project			 : Wolf Engine. Copyright(c) Pooya Eimandar (http://PooyaEimandar.com) . All rights reserved.
+	Source			 : Please direct any bug to https://github.com/PooyaEimandar/Wolf.Engine/issues
+	Website			 : http://WolfSource.io
+	Name			 : main.cpp
+	Description		 : This sample decodes binary logs of w_logger to text or JSON lines
+	Comment          : binary logs (.wBinLog) are written when w_logger_config::binary_mode is true
+*/
+
+#include "pch.h"
+#include <fstream>
+
+//namespaces
+using namespace wolf;
+using namespace wolf::system;
+
+static void print_usage()
+{
+    std::cout << "usage: 25_log_decoder <path of .wBinLog file> [--json] [output path]" << std::endl;
+    std::cout << "    --json         write one JSON object per record instead of text lines" << std::endl;
+    std::cout << "    output path    write to this file instead of standard output" << std::endl;
+}
+
+//Entry point of program
+WOLF_MAIN()
+{
+#ifdef _WIN32
+    auto _argc = __argc;
+    auto _argv = __argv;
+#else
+    auto _argc = pArgc;
+    auto _argv = pArgv;
+#endif
+
+    if (_argc < 2)
+    {
+        print_usage();
+        return EXIT_FAILURE;
+    }
+
+    std::string _input_path = _argv[1];
+    std::string _output_path;
+    auto _format = W_LOG_DECODE_TEXT;
+    for (int i = 2; i < _argc; ++i)
+    {
+        std::string _arg = _argv[i];
+        if (_arg == "--json")
+        {
+            _format = W_LOG_DECODE_JSON_LINES;
+        }
+        else
+        {
+            _output_path = _arg;
+        }
+    }
+
+    W_RESULT _hr;
+    if (_output_path.empty())
+    {
+        _hr = w_log_binary::decode(_input_path, std::cout, _format);
+    }
+    else
+    {
+        std::ofstream _output(_output_path, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!_output.is_open())
+        {
+            std::cerr << "could not create " << _output_path << std::endl;
+            return EXIT_FAILURE;
+        }
+        _hr = w_log_binary::decode(_input_path, _output, _format);
+    }
+
+    if (_hr == W_FAILED)
+    {
+        std::cerr << "could not decode " << _input_path << ", it is not a binary log of wolf" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,192 @@
+/*
+	Project			 : Wolf Engine. Copyright(c) Pooya Eimandar (http://PooyaEimandar.com) . All rights reserved.
+	Source			 : Please direct any bug to https://github.com/PooyaEimandar/Wolf.Engine/issues
+	Website			 : http://WolfSource.io
+	Name			 : main.cpp
+	Description		 : This sample measures throughput of small messages over loopback with and without w_network_batcher
+	Comment          : each message is a state of an entity, same as messages which we push per frame
+*/
+
+#include "pch.h"
+#include <w_timer.h>
+#include <w_network.h>
+#include <w_network_message.h>
+#include <w_network_batcher.h>
+#include <thread>
+#include <atomic>
+
+//namespaces
+using namespace wolf;
+using namespace wolf::system;
+
+static const size_t MESSAGES_COUNT = 1 << 18;
+
+//state of an entity, consecutive states are similar, so batches are compressible
+struct entity_state
+{
+    uint32_t    id;
+    uint32_t    frame;
+    float       position[3];
+    float       rotation[4];
+    float       velocity[3];
+    uint32_t    flags;
+};
+
+enum bench_mode
+{
+    DIRECT = 0,
+    BATCHED,
+    BATCHED_LZ4
+};
+
+static const char* s_mode_names[] = { "direct", "batched", "batched+lz4" };
+
+struct bench_result
+{
+    double                      messages_per_sec = 0;
+    uint64_t                    received = 0;
+    w_network_batcher_stats     stats;
+};
+
+static entity_state make_state(_In_ const size_t& pIndex)
+{
+    entity_state _state;
+    _state.id = static_cast<uint32_t>(pIndex % 256);
+    _state.frame = static_cast<uint32_t>(pIndex / 256);
+    for (int i = 0; i < 3; ++i)
+    {
+        _state.position[i] = static_cast<float>(_state.id) + _state.frame * 0.1f;
+        _state.velocity[i] = 1.0f;
+    }
+    _state.rotation[0] = _state.rotation[1] = _state.rotation[2] = 0.0f;
+    _state.rotation[3] = 1.0f;
+    _state.flags = 0;
+    return _state;
+}
+
+static bench_result run(_In_ const std::string& pURL, _In_ const bench_mode& pMode)
+{
+    bench_result _result;
+
+    int _pull_socket = -1, _push_socket = -1;
+    w_signal<void(const int&)> _on_bind;
+    _on_bind += [&_pull_socket](const int& pSocketID) { _pull_socket = pSocketID; };
+    w_signal<void(const int&)> _on_connect;
+    _on_connect += [&_push_socket](const int& pSocketID) { _push_socket = pSocketID; };
+
+    //the puller stops when it does not receive anything for one second
+    w_network _puller, _pusher;
+    if (_puller.setup_one_way_puller(pURL.c_str(), _on_bind, 1000) == W_FAILED ||
+        _pusher.setup_one_way_pusher(pURL.c_str(), _on_connect) == W_FAILED)
+    {
+        logger.error("could not setup sockets on {}", pURL);
+        return _result;
+    }
+
+    w_network_batcher _batcher;
+    w_network_batcher_config _config;
+    _config.compress = pMode == BATCHED_LZ4;
+    _batcher.initialize(_config);
+
+    std::atomic<uint64_t> _received(0);
+    std::thread _receiver([&]()
+    {
+        auto _on_message = [&_received](const char* pMessage, const size_t& pSize)
+        {
+            if (pSize == sizeof(entity_state)) _received.fetch_add(1, std::memory_order_relaxed);
+        };
+        while (_received.load(std::memory_order_relaxed) < MESSAGES_COUNT)
+        {
+            if (pMode == DIRECT)
+            {
+                w_network_message _msg;
+                if (w_network::receive(_pull_socket, _msg) < 0) break;
+                _on_message(_msg.get_data(), _msg.get_size());
+            }
+            else if (_batcher.receive(_pull_socket, _on_message) < 0)
+            {
+                break;
+            }
+        }
+    });
+
+    w_timer _timer;
+    _timer.start();
+
+    for (size_t i = 0; i < MESSAGES_COUNT; ++i)
+    {
+        auto _state = make_state(i);
+        if (pMode == DIRECT)
+        {
+            w_network::send(_push_socket, reinterpret_cast<const char*>(&_state), sizeof(_state));
+        }
+        else
+        {
+            _batcher.send(_push_socket, reinterpret_cast<const char*>(&_state), sizeof(_state));
+        }
+    }
+    _batcher.flush_all();
+    _receiver.join();
+
+    auto _seconds = _timer.get_seconds();
+    _result.received = _received.load();
+    _result.messages_per_sec = _seconds > 0 ? _result.received / _seconds : 0.0;
+    _result.stats = _batcher.get_stats();
+
+    _batcher.release();
+    _pusher.release();
+    _puller.release();
+
+    return _result;
+}
+
+WOLF_MAIN()
+{
+    w_logger_config _log_config;
+    _log_config.app_name = L"26_networking_batch_benchmark";
+    _log_config.log_path = wolf::system::io::get_current_directoryW();
+#ifdef __WIN32
+    _log_config.log_to_std_out = false;
+#else
+    _log_config.log_to_std_out = true;
+#endif
+    logger.initialize(_log_config);
+
+    const char* _transports[] = { "inproc://w_batch_benchmark_", "ipc://w_batch_benchmark_" };
+    int _index = 0;
+    for (auto _transport : _transports)
+    {
+        double _direct_messages_per_sec = 0;
+        for (auto _mode : { DIRECT, BATCHED, BATCHED_LZ4 })
+        {
+            auto _url = _transport + std::to_string(_index++);
+            auto _result = run(_url, _mode);
+            if (_result.received != MESSAGES_COUNT)
+            {
+                logger.error("{} {}: received {} of {} messages", _transport, s_mode_names[_mode], _result.received, MESSAGES_COUNT);
+                continue;
+            }
+            if (_mode == DIRECT)
+            {
+                _direct_messages_per_sec = _result.messages_per_sec;
+                logger.write("{} {}: {:.0f} msgs/sec", _transport, s_mode_names[_mode], _result.messages_per_sec);
+                continue;
+            }
+
+            auto& _stats = _result.stats;
+            logger.write("{} {}: {:.0f} msgs/sec speedup: {:.2f}x batches: {} raw: {} bytes wire: {} bytes saved: {} bytes",
+                _transport,
+                s_mode_names[_mode],
+                _result.messages_per_sec,
+                _direct_messages_per_sec > 0 ? _result.messages_per_sec / _direct_messages_per_sec : 0.0,
+                _stats.batches_sent,
+                _stats.raw_bytes_sent,
+                _stats.wire_bytes_sent,
+                _stats.bytes_saved);
+        }
+    }
+
+    logger.release();
+
+    return EXIT_SUCCESS;
+}
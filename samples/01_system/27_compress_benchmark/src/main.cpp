@@ -0,0 +1,287 @@
+/*
+	Project			 : Wolf Engine. Copyright(c) Pooya Eimandar (http://PooyaEimandar.com) . All rights reserved.
+	Source			 : Please direct any bug to https://github.com/PooyaEimandar/Wolf.Engine/issues
+	Website			 : http://WolfSource.io
+	Name			 : main.cpp
+	Description		 : This sample measures ratio and throughput of each mode of w_compress on scene and network data
+	Comment          : pass path of a .wscene as the first argument, default is sponza of content/models
+*/
+
+#include "pch.h"
+#include <w_compress.hpp>
+#include <w_compress_blocks.h>
+#include <msgpack.hpp>
+#include <fstream>
+#include <chrono>
+
+//namespaces
+using namespace wolf;
+using namespace wolf::system;
+
+static const size_t NETWORK_MESSAGES_COUNT = 20000;
+static const size_t NETWORK_TRAINING_COUNT = 2000;
+
+//state of an entity, same as messages which we push per frame
+struct entity_state
+{
+    uint32_t            id;
+    uint32_t            frame;
+    std::string         name;
+    float               position[3];
+    float               rotation[4];
+    std::vector<int>    components;
+    MSGPACK_DEFINE(id, frame, name, position, rotation, components);
+};
+
+struct bench_result
+{
+    size_t  raw_size = 0;
+    size_t  compressed_size = 0;
+    double  compress_seconds = 0;
+    double  decompress_seconds = 0;
+    bool    passed = true;
+};
+
+static double get_seconds(_In_ const std::chrono::steady_clock::time_point& pStart)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - pStart).count();
+}
+
+static std::string make_message(_In_ const size_t& pIndex)
+{
+    entity_state _state;
+    _state.id = static_cast<uint32_t>(pIndex % 512);
+    _state.frame = static_cast<uint32_t>(pIndex / 512);
+    _state.name = "entity_" + std::to_string(_state.id % 64);
+    for (int i = 0; i < 3; ++i)
+    {
+        _state.position[i] = static_cast<float>(_state.id) + _state.frame * 0.25f;
+    }
+    _state.rotation[0] = _state.rotation[1] = _state.rotation[2] = 0.0f;
+    _state.rotation[3] = 1.0f;
+    _state.components = { 1, 4, static_cast<int>(_state.id % 8) };
+
+    msgpack::sbuffer _buffer;
+    msgpack::pack(_buffer, _state);
+    return std::string(_buffer.data(), _buffer.size());
+}
+
+static void print(_In_z_ const char* pData, _In_z_ const char* pMode, _In_ const bench_result& pResult)
+{
+    if (!pResult.passed)
+    {
+        logger.error("{} {}: failed", pData, pMode);
+        return;
+    }
+
+    const double _mb = pResult.raw_size / (1024.0 * 1024.0);
+    logger.write("{:<8} {:<16} ratio: {:6.3f} compress: {:8.1f} MB/s decompress: {:8.1f} MB/s",
+        pData,
+        pMode,
+        pResult.compressed_size ? static_cast<double>(pResult.raw_size) / pResult.compressed_size : 0.0,
+        pResult.compress_seconds > 0 ? _mb / pResult.compress_seconds : 0.0,
+        pResult.decompress_seconds > 0 ? _mb / pResult.decompress_seconds : 0.0);
+}
+
+//compress and decompress a buffer with frame api
+static bench_result run_frame(_In_ const std::string& pData, _In_ const w_compress_mode& pMode, _In_ const int& pAcceleration)
+{
+    bench_result _result;
+    _result.raw_size = pData.size();
+
+    w_compress_result _compressed = {};
+    _compressed.size_in = pData.size();
+    auto _start = std::chrono::steady_clock::now();
+    _result.passed = w_compress::compress_buffer(pData.data(), &_compressed, pMode, pAcceleration) == W_PASSED;
+    _result.compress_seconds = get_seconds(_start);
+    if (!_result.passed) return _result;
+    _result.compressed_size = _compressed.size_out;
+
+    w_compress_result _decompressed = {};
+    _decompressed.size_in = _compressed.size_out;
+    _start = std::chrono::steady_clock::now();
+    _result.passed = w_compress::decompress_buffer(_compressed.data, &_decompressed) == W_PASSED &&
+        _decompressed.size_out == pData.size() &&
+        std::memcmp(_decompressed.data, pData.data(), pData.size()) == 0;
+    _result.decompress_seconds = get_seconds(_start);
+
+    free(_compressed.data);
+    if (_decompressed.data) free(_decompressed.data);
+
+    return _result;
+}
+
+//compress and decompress a buffer as block container
+static bench_result run_blocks(
+    _In_ const std::string& pData,
+    _In_ const w_compress_blocks_config& pConfig,
+    _In_opt_ w_thread_pool* pThreadPool)
+{
+    bench_result _result;
+    _result.raw_size = pData.size();
+
+    w_compress_result _compressed = {};
+    _compressed.size_in = pData.size();
+    auto _start = std::chrono::steady_clock::now();
+    _result.passed = w_compress_blocks::compress(pData.data(), &_compressed, pConfig, pThreadPool) == W_PASSED;
+    _result.compress_seconds = get_seconds(_start);
+    if (!_result.passed) return _result;
+    _result.compressed_size = _compressed.size_out;
+
+    w_compress_result _decompressed = {};
+    _decompressed.size_in = _compressed.size_out;
+    _start = std::chrono::steady_clock::now();
+    _result.passed = w_compress_blocks::decompress(_compressed.data, &_decompressed, pThreadPool) == W_PASSED &&
+        _decompressed.size_out == pData.size() &&
+        std::memcmp(_decompressed.data, pData.data(), pData.size()) == 0;
+    _result.decompress_seconds = get_seconds(_start);
+
+    free(_compressed.data);
+    if (_decompressed.data) free(_decompressed.data);
+
+    return _result;
+}
+
+//compress and decompress each message alone, with or without dictionary
+static bench_result run_messages(
+    _In_ const std::vector<std::string>& pMessages,
+    _In_opt_ w_compress_dict pDict,
+    _In_ const w_compress_mode& pMode,
+    _In_ const int& pAcceleration)
+{
+    bench_result _result;
+    std::vector<w_compress_result> _compressed(pMessages.size());
+
+    auto _start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < pMessages.size() && _result.passed; ++i)
+    {
+        _compressed[i].size_in = pMessages[i].size();
+        _result.passed = (pDict ?
+            w_compress::compress_buffer(pMessages[i].data(), pDict, &_compressed[i], pMode, pAcceleration) :
+            w_compress::compress_buffer(pMessages[i].data(), &_compressed[i], pMode, pAcceleration)) == W_PASSED;
+    }
+    _result.compress_seconds = get_seconds(_start);
+
+    _start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < pMessages.size() && _result.passed; ++i)
+    {
+        w_compress_result _decompressed = {};
+        _decompressed.size_in = _compressed[i].size_out;
+        _result.passed = (pDict ?
+            w_compress::decompress_buffer(_compressed[i].data, pDict, &_decompressed) :
+            w_compress::decompress_buffer(_compressed[i].data, &_decompressed)) == W_PASSED &&
+            _decompressed.size_out == pMessages[i].size();
+        if (_decompressed.data) free(_decompressed.data);
+    }
+    _result.decompress_seconds = get_seconds(_start);
+
+    for (size_t i = 0; i < pMessages.size(); ++i)
+    {
+        _result.raw_size += pMessages[i].size();
+        _result.compressed_size += _compressed[i].size_out;
+        if (_compressed[i].data) free(_compressed[i].data);
+    }
+
+    return _result;
+}
+
+static std::string load_scene(_In_z_ const std::string& pPath)
+{
+    std::ifstream _file(pPath, std::ios::in | std::ios::binary);
+    if (!_file)
+    {
+        logger.error("could not open scene {}", pPath);
+        return std::string();
+    }
+    std::string _packed((std::istreambuf_iterator<char>(_file)), std::istreambuf_iterator<char>());
+
+    //.wscene is compressed msgpack, benchmark the raw msgpack of scene
+    w_compress_result _result = {};
+    _result.size_in = _packed.size();
+    if (w_compress::decompress_buffer(_packed.data(), &_result) != W_PASSED)
+    {
+        logger.error("could not decompress scene {}", pPath);
+        return std::string();
+    }
+    std::string _scene(_result.data, _result.size_out);
+    free(_result.data);
+    return _scene;
+}
+
+WOLF_MAIN()
+{
+    w_logger_config _log_config;
+    _log_config.app_name = L"27_compress_benchmark";
+    _log_config.log_path = wolf::system::io::get_current_directoryW();
+#ifdef __WIN32
+    _log_config.log_to_std_out = false;
+#else
+    _log_config.log_to_std_out = true;
+#endif
+    logger.initialize(_log_config);
+
+#ifdef __WIN32
+    std::string _scene_path = wolf::system::io::get_current_directory() + "/../../../../content/models/sponza/sponza.wscene";
+#else
+    std::string _scene_path = wolf::system::io::get_current_directory() + "/../../../../../content/models/sponza/sponza.wscene";
+#endif
+    if (pArgc > 1) _scene_path = pArgv[1];
+
+    w_thread_pool _thread_pool;
+    auto _workers = std::thread::hardware_concurrency();
+    _thread_pool.allocate(_workers > 1 ? _workers - 1 : 1);
+
+#pragma region scene
+    auto _scene = load_scene(_scene_path);
+    if (!_scene.empty())
+    {
+        logger.write("scene {} bytes", _scene.size());
+
+        print("scene", "default", run_frame(_scene, w_compress_mode::W_DEFAULT, 1));
+        print("scene", "fast x8", run_frame(_scene, w_compress_mode::W_FAST, 8));
+        for (auto _level : { 4, 9, 12 })
+        {
+            auto _name = "hc " + std::to_string(_level);
+            print("scene", _name.c_str(), run_frame(_scene, w_compress_mode::W_HC, _level));
+        }
+
+        w_compress_blocks_config _config;
+        print("scene", "blocks 1 thread", run_blocks(_scene, _config, nullptr));
+        print("scene", "blocks pool", run_blocks(_scene, _config, &_thread_pool));
+        _config.hc_level = 9;
+        print("scene", "blocks hc 9 pool", run_blocks(_scene, _config, &_thread_pool));
+    }
+#pragma endregion
+
+#pragma region network
+    std::vector<std::string> _training, _messages;
+    for (size_t i = 0; i < NETWORK_TRAINING_COUNT; ++i)
+    {
+        _training.push_back(make_message(i * 7));
+    }
+    for (size_t i = 0; i < NETWORK_MESSAGES_COUNT; ++i)
+    {
+        _messages.push_back(make_message(NETWORK_TRAINING_COUNT * 7 + i));
+    }
+
+    std::vector<char> _dictionary;
+    w_compress_dict _dict = nullptr;
+    if (w_compress::train_dict(_training, _dictionary) == W_PASSED &&
+        w_compress::create_dict(_dictionary.data(), _dictionary.size(), &_dict) == W_PASSED)
+    {
+        logger.write("network dictionary {} bytes from {} samples", _dictionary.size(), _training.size());
+
+        print("network", "default", run_messages(_messages, nullptr, w_compress_mode::W_DEFAULT, 1));
+        print("network", "dict", run_messages(_messages, _dict, w_compress_mode::W_DEFAULT, 1));
+        print("network", "dict fast x8", run_messages(_messages, _dict, w_compress_mode::W_FAST, 8));
+        print("network", "dict hc 9", run_messages(_messages, _dict, w_compress_mode::W_HC, 9));
+
+        w_compress::free_dict(_dict);
+    }
+#pragma endregion
+
+    _thread_pool.release();
+    logger.release();
+
+    return EXIT_SUCCESS;
+}
@@ -280,6 +280,9 @@ void scene::load()
 						_indices.push_back(_mesh->indices[i]);
 					}
 
+					//split and packed only meshes are interleaved on demand
+					_mesh->interleave_vertices();
+					_mesh->unpack_vertices();
 					for (auto& _v : _mesh->vertices)
 					{
 						//just store position
@@ -58,7 +58,11 @@ int main()
 			std::vector<w_cpipeline_scene> _scene_packs = { *_scene };
             
             auto _out_path = _parent_dir + _base_name + L".wscene";
-			if (w_content_manager::save_wolf_scenes_to_file(_scene_packs, _out_path) == W_PASSED)
+            //write .wscene v2, so the scene will be mapped and used in place on load. Positions are stored as a separate stream,
+            //so CPU passes such as culling read them in place
+            w_cpipeline_wscene_config _config;
+            _config.split_vertices = true;
+			if (w_content_manager::save_wolf_scenes_to_file(_scene_packs, _out_path, _config) == W_PASSED)
 			{
 				logger.write(L"scene {} converted", _file_name);
 			}
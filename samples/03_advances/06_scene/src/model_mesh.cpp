@@ -433,6 +433,10 @@ private:
 				_texture_uv_index = _find->second;
 			}
 
+			//split and packed only meshes are interleaved only at upload time
+			_mesh_data->interleave_vertices();
+			_mesh_data->unpack_vertices();
+
 			//set bounding boxes
 			pMergedBoundingBox.merge(_mesh_data->bounding_box);
 			pSubMeshBoundingBoxes.push_back(_mesh_data->bounding_box);
@@ -96,8 +96,8 @@ protected:
 	static W_RESULT _store_indices_vertices_to_batch(
 		_In_ const wolf::render::vulkan::w_vertex_binding_attributes& pVertexBindingAttributes,
 		_In_ const float& pTextureUVIndex,
-		_In_ const std::vector<wolf::content_pipeline::w_vertex_struct>& pVertices,
-		_In_ const std::vector<uint32_t>& pIndices,
+		_In_ const wolf::content_pipeline::w_cpipeline_vector<wolf::content_pipeline::w_vertex_struct>& pVertices,
+		_In_ const wolf::content_pipeline::w_cpipeline_vector<uint32_t>& pIndices,
 		_Inout_ std::vector<float>& pBatchVertices,
 		_Inout_ std::vector<uint32_t>& pBatchIndices,
 		_Inout_ uint32_t& pBaseVertexOffset);
@@ -496,13 +496,13 @@ W_RESULT model_mesh::draw(_In_ const w_command_buffer& pCommandBuffer, _In_ cons
 W_RESULT model_mesh::_store_indices_vertices_to_batch(
 	_In_ const wolf::render::vulkan::w_vertex_binding_attributes& pVertexBindingAttributes,
 	_In_ const float& pTextureUVIndex,
-	_In_ const std::vector<w_vertex_struct>& pVertices,
-	_In_ const std::vector<uint32_t>& pIndices,
+	_In_ const w_cpipeline_vector<w_vertex_struct>& pVertices,
+	_In_ const w_cpipeline_vector<uint32_t>& pIndices,
 	_Inout_ std::vector<float>& pBatchVertices,
 	_Inout_ std::vector<uint32_t>& pBatchIndices,
 	_Inout_ uint32_t& pBaseVertexOffset)
 {
-	if (!pVertices.size()) return W_FAILED;
+	if (pVertices.empty()) return W_FAILED;
 
 	uint32_t i = 0;
 
@@ -997,6 +997,10 @@ void model_mesh::_store_to_batch(
 			}
 		}
 
+		//split and packed only meshes are interleaved only at upload time
+		_mesh_data->interleave_vertices();
+		_mesh_data->unpack_vertices();
+
 		//set bounding boxes
 		if (pMergedBoundingBox)
 		{
@@ -184,6 +184,9 @@ void model::_add_to_mocs(_In_  w_cpipeline_model* pConvexHull)
 	{
 		moc_data _moc_data;
 
+		//split and packed only meshes are interleaved on demand
+		_iter->interleave_vertices();
+		_iter->unpack_vertices();
 		clipspace_vertex _cv;
 		auto _vert_size = _iter->vertices.size();
 		for (uint32_t i = 0; i < _vert_size; i++)
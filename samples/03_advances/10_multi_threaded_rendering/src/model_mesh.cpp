@@ -500,6 +500,10 @@ void model_mesh::_store_to_batch(
 			}
 		}
 
+		//split and packed only meshes are interleaved only at upload time
+		_mesh_data->interleave_vertices();
+		_mesh_data->unpack_vertices();
+
 		//set bounding boxes
 		if (pMergedBoundingBox)
 		{
@@ -0,0 +1,186 @@
+/*
+	Project			 : Wolf Engine. Copyright(c) Pooya Eimandar (http://PooyaEimandar.com) . All rights reserved.
+	Source			 : Please direct any bug to https://github.com/PooyaEimandar/Wolf.Engine/issues
+	Website			 : http://WolfSource.io
+	Name			 : main.cpp
+	Description		 : This sample measures time of each stage of importing a model with and without thread pool, build cache and loading a .wscene
+	Comment          : pass path of a source model as the first argument and a .wscene as the second, defaults are teapot of 02_model and sponza.wscene of content/models
+*/
+
+#include "pch.h"
+#include <w_content_manager.h>
+#include <sstream>
+#include <chrono>
+
+//namespaces
+using namespace wolf;
+using namespace wolf::system;
+using namespace wolf::content_pipeline;
+
+static double get_seconds(_In_ const std::chrono::steady_clock::time_point& pStart)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - pStart).count();
+}
+
+//import model and pack it, so results of serial and parallel import can be compared
+static bool import(
+    _In_z_ const std::wstring& pPath,
+    _In_z_ const char* pMode,
+    _In_opt_ w_thread_pool* pThreadPool,
+    _Inout_ std::string& pPacked)
+{
+    assimp::w_assimp_stats _stats;
+    auto _start = std::chrono::steady_clock::now();
+    auto _scene = assimp::w_assimp::load(
+        pPath,
+        false
+#ifdef __WIN32
+        , false
+#endif
+        , pThreadPool
+        , &_stats);
+    auto _total = get_seconds(_start);
+    if (!_scene)
+    {
+        logger.error(L"could not import {}", pPath);
+        return false;
+    }
+
+    logger.write("{:<8} read: {:8.3f} ms convert: {:8.3f} ms build: {:8.3f} ms total: {:8.3f} ms meshes: {} vertices: {} indices: {}",
+        pMode,
+        _stats.read_file * 1000.0,
+        _stats.convert_meshes * 1000.0,
+        _stats.build_scene * 1000.0,
+        _total * 1000.0,
+        _stats.meshes,
+        _stats.vertices,
+        _stats.indices);
+
+    std::vector<w_cpipeline_scene> _scenes = { *_scene };
+    std::stringstream _buffer;
+    msgpack::pack(_buffer, _scenes);
+    pPacked = _buffer.str();
+
+    _scenes.clear();
+    _scene->release();
+    delete _scene;
+
+    return true;
+}
+
+WOLF_MAIN()
+{
+    w_logger_config _log_config;
+    _log_config.app_name = L"15_import_benchmark";
+    _log_config.log_path = wolf::system::io::get_current_directoryW();
+#ifdef __WIN32
+    _log_config.log_to_std_out = false;
+#else
+    _log_config.log_to_std_out = true;
+#endif
+    logger.initialize(_log_config);
+
+#ifdef __WIN32
+    std::wstring _root_path = wolf::system::io::get_current_directoryW() + L"/../../../../";
+#else
+    std::wstring _root_path = wolf::system::io::get_current_directoryW() + L"/../../../../../";
+#endif
+    //content/models only ships the converted sponza, so the source model is the teapot of 02_model
+    std::wstring _model_path = _root_path + L"samples/03_advances/02_model/src/content/models/teapot.DAE";
+    std::wstring _wscene_path = _root_path + L"content/models/sponza/sponza.wscene";
+    if (pArgc > 1) _model_path = wolf::system::convert::string_to_wstring(pArgv[1]);
+    if (pArgc > 2) _wscene_path = wolf::system::convert::string_to_wstring(pArgv[2]);
+
+    for (auto& _path : { _model_path, _wscene_path })
+    {
+        if (wolf::system::io::get_is_file(wolf::system::convert::wstring_to_string(_path).c_str()) == W_FAILED)
+        {
+            logger.error(L"could not find {}", _path);
+            logger.error("usage: 15_import_benchmark [path of source model] [path of .wscene]");
+            logger.release();
+            return EXIT_FAILURE;
+        }
+    }
+
+    w_thread_pool _thread_pool;
+    auto _workers = std::thread::hardware_concurrency();
+    _thread_pool.allocate(_workers > 1 ? _workers - 1 : 1);
+
+#pragma region import
+    std::string _serial, _parallel;
+    if (import(_model_path, "serial", nullptr, _serial) &&
+        import(_model_path, "pool", &_thread_pool, _parallel))
+    {
+        if (_serial == _parallel)
+        {
+            logger.write("serial and parallel imports are identical, {} bytes", _serial.size());
+        }
+        else
+        {
+            logger.error("serial and parallel imports are different");
+        }
+    }
+#pragma endregion
+
+#pragma region build cache
+    //the first load imports the model and stores it, the second one maps the cached .wscene
+    w_cpipeline_build_cache _build_cache;
+    w_cpipeline_build_cache_config _cache_config;
+    _cache_config.path = wolf::system::io::get_current_directory() + "/build_cache";
+    //cached meshes keep positions as a separate stream, so CPU passes read them from the mapped file
+    _cache_config.wscene.split_vertices = true;
+    if (_build_cache.initialize(_cache_config) == W_PASSED)
+    {
+        _build_cache.clear();
+        w_content_manager::set_build_cache(&_build_cache);
+
+        for (auto _pass : { "cold", "warm" })
+        {
+            auto _start = std::chrono::steady_clock::now();
+            auto _scene = w_content_manager::load<w_cpipeline_scene>(_model_path, false
+#ifdef __WIN32
+                , false
+#endif
+                , &_thread_pool);
+            auto _seconds = get_seconds(_start);
+            if (_scene)
+            {
+                logger.write("cache {} load: {:8.3f} ms", _pass, _seconds * 1000.0);
+                _scene->release();
+                delete _scene;
+            }
+        }
+
+        auto _stats = _build_cache.get_stats();
+        logger.write("cache hits: {} misses: {} stores: {} evictions: {} hash: {:8.3f} ms",
+            _stats.hits,
+            _stats.misses,
+            _stats.stores,
+            _stats.evictions,
+            _stats.hash_seconds * 1000.0);
+
+        w_content_manager::set_build_cache(nullptr);
+    }
+    _build_cache.release();
+#pragma endregion
+
+#pragma region wscene
+    std::vector<w_cpipeline_scene> _scenes;
+    auto _start = std::chrono::steady_clock::now();
+    if (w_content_manager::load_wolf_scenes_from_file(_scenes, _wscene_path) == W_PASSED)
+    {
+        logger.write("wscene   load: {:8.3f} ms scenes: {}", get_seconds(_start) * 1000.0, _scenes.size());
+    }
+    else
+    {
+        logger.error(L"could not load {}", _wscene_path);
+    }
+    _scenes.clear();
+#pragma endregion
+
+    w_content_manager::release();
+    _thread_pool.release();
+    logger.release();
+
+    return EXIT_SUCCESS;
+}
@@ -65,14 +65,19 @@ void scene::load()
 	this->_media_time.set_fixed_time_step(true);
 	this->_media_time.set_target_elapsed_seconds(1.0f / this->_media_core.get_video_frame_rate());
 
-	//allocate memory for buffering, we need 3 frames
+	//allocate ring buffer for buffering, we need 3 frames and one more because ring buffer never fills completely
 	auto _size = 
-		this->_max_buffering_frames * /*3 frames*/
+		(this->_max_buffering_frames + 1) * /*3 frames*/
 		4 * /*RGBA*/
 		this->_media_core.get_video_frame_width() * /*frame width*/
 		this->_media_core.get_video_frame_height() * /*frame height*/
 		sizeof(uint8_t);
-	if (this->_media_memory.alloc(_size) == nullptr)
+	//frames are large, so back them by huge pages on the NUMA node of rendering thread when possible
+	w_memory_tag_scope _memory_tag(W_MEMORY_CATEGORY_MEDIA);
+	if (this->_media_memory.initialize(
+		_size,
+		16,
+		W_MEMORY_POLICY_HUGE_PAGES | W_MEMORY_POLICY_NUMA_LOCAL) == W_FAILED)
 	{
 		release();
 		V(W_FAILED,
@@ -332,7 +337,8 @@ void scene::_buffer_video(_In_ const size_t& pNumberOfFrames)
 	{
 		if (this->_media_core.write_video_frame_to_buffer(this->_media_memory, 1, false) == W_FAILED)
 		{
-			logger.write("Error on media buffering");
+			//ring buffer is full or media core failed and logged it
+			break;
 		}
 	}
 }
@@ -387,20 +393,20 @@ void scene::update(_In_ const wolf::system::w_game_time& pGameTime)
 	this->_media_time.tick([&]()
 	{
 		const size_t _size_in_bytes = 4 /*RGBA*/ * sizeof(uint8_t) * this->_texture.get_width() * this->_texture.get_height();
-		auto _frames = (uint8_t*)this->_media_memory.get_start_ptr();
+		//this thread is the consumer of ring buffer and media thread is the producer
+		size_t _available_in_bytes = 0;
+		auto _frame = this->_media_memory.peek_read(_available_in_bytes);
 		auto _pixels = (uint8_t*)this->_texture.read_data_of_texture();
-		if (_frames && _pixels)
+		if (_frame && _pixels && _available_in_bytes >= _size_in_bytes)
 		{
-			std::memcpy(&_pixels[0], &_frames[this->_media_memory.read_index], _size_in_bytes);
+			std::memcpy(&_pixels[0], _frame, _size_in_bytes);
 			this->_texture.flush_staging_data();
-
-			auto _delta = std::abs((int)this->_media_memory.write_index - (int)_size_in_bytes);
-			if (this->_media_memory.read_index == _delta)
-			{
-				//notify for buffering
-				this->_media_signal_slot.notify_one();
-			}
-			this->_media_memory.read_index = (this->_media_memory.read_index + _size_in_bytes) % this->_media_memory.get_size_in_bytes();
+			this->_media_memory.release(_size_in_bytes);
+		}
+		if (this->_media_memory.get_max_write_size() >= _size_in_bytes)
+		{
+			//notify for buffering
+			this->_media_signal_slot.notify_one();
 		}
 	});
 	//++++++++++++++++++++++++++++++++++++++++++++++++++++
@@ -488,7 +494,7 @@ ULONG scene::release()
 		this->_media_thread_exited.wait(_lk);
 		//realease all media resources
 		this->_media_core.release();
-		this->_media_memory.release();
+		this->_media_memory.release_memory();
 		w_media_core::shut_down();
 	}
 	//++++++++++++++++++++++++++++++++++++++++++++++++++++
@@ -27,7 +27,7 @@
 //The following codes have been added for this project
 //++++++++++++++++++++++++++++++++++++++++++++++++++++
 #include <w_media_core.h>
-#include <w_memory_pool.h>
+#include <w_ring_buffer.h>
 #include <tbb/atomic.h>
 #include <tbb/critical_section.h>
 #include <tbb/compat/condition_variable>
@@ -92,7 +92,7 @@ private:
 
 	wolf::framework::w_media_core									_media_core;
 	wolf::system::w_game_time										_media_time;
-	wolf::system::w_memory_pool										_media_memory;
+	wolf::system::w_ring_buffer										_media_memory;
 	tbb::mutex														_media_buffer_mutex;
 	tbb::interface5::condition_variable								_media_signal_slot;
 
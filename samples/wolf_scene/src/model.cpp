@@ -1,6 +1,6 @@
 #include "pch.h"
 #include "model.h"
-#include <tbb/parallel_for.h>
+#include <atomic>
 
 using namespace wolf::system;
 using namespace wolf::graphics;
@@ -186,11 +186,13 @@ void model::_add_to_mocs(_In_  w_cpipeline_model* pConvexHull)
 	{
 		moc_data _moc_data;
 
+		//read tightly packed positions instead of walking w_vertex_struct
 		clipspace_vertex _cv;
-		auto _vert_size = _iter->vertices.size();
+		auto _positions = _iter->get_positions();
+		auto _vert_size = _positions ? _iter->get_vertices_count() : 0;
 		for (uint32_t i = 0; i < _vert_size; i++)
 		{
-			auto _vertex_pos = _iter->vertices[i].position;
+			auto _vertex_pos = &_positions[i * 3];
 			_cv.x = _vertex_pos[0];
 			_cv.y = _vertex_pos[1];
 			_cv.z = 0;
@@ -222,7 +224,9 @@ void model::_add_to_mocs(_In_  w_cpipeline_model* pConvexHull)
 	}
 }
 
-bool model::check_is_in_sight(_In_ wolf::framework::w_first_person_camera* pCamera)
+bool model::check_is_in_sight(
+	_In_ wolf::framework::w_first_person_camera* pCamera,
+	_In_ w_thread_pool& pThreadPool)
 {
 	const std::string _trace_info = this->_name + "::check_is_in_sight";
 
@@ -242,15 +246,16 @@ bool model::check_is_in_sight(_In_ wolf::framework::w_first_person_camera* pCame
 	}
 
 	
-	tbb::atomic<bool> _found = false;
+	std::atomic<bool> _found(false);
 	auto _camera_pos = pCamera->get_position();
 	auto _camera_frustum = pCamera->get_frustum();
 
-	tbb::parallel_for(
-		tbb::blocked_range<size_t>(0, this->sub_meshes_bounding_box.size()),
-		[&](const tbb::blocked_range<size_t>& pRange)
+	pThreadPool.parallel_for(
+		0,
+		this->sub_meshes_bounding_box.size(),
+		[&](_In_ const size_t& pBegin, _In_ const size_t& pEnd)
 	{
-		for (size_t i = pRange.begin(); i < pRange.end(); ++i)
+		for (size_t i = pBegin; i < pEnd; ++i)
 		{
 			if (_found) break;
 			
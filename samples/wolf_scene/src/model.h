@@ -16,6 +16,7 @@
 
 #include "model_mesh.h"
 #include <w_framework/w_masked_occlusion_culling.h>
+#include <w_thread_pool.h>
 
 class model : public model_mesh
 {
@@ -28,7 +29,9 @@ public:
 
 	W_RESULT initialize();
 
-	bool	 check_is_in_sight(_In_ wolf::framework::w_first_person_camera* pCamera);
+	bool	 check_is_in_sight(
+		_In_ wolf::framework::w_first_person_camera* pCamera,
+		_In_ wolf::system::w_thread_pool& pThreadPool);
 	W_RESULT pre_update(
 		_In_ const glm::mat4& pProjectionView, 
 		_Inout_ wolf::framework::w_masked_occlusion_culling& pMaskedOcclusionCulling);
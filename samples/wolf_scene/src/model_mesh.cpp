@@ -550,6 +550,10 @@ void model_mesh::_store_to_batch(
 #pragma endregion
 
 #pragma region store vertex buffer
+		//split and packed only meshes are interleaved only at upload time
+		_mesh_data->interleave_vertices();
+		_mesh_data->unpack_vertices();
+
 		i = 0;
 		auto _vertex_dec = pVertexBindingAttributes.binding_attributes.find(0);
 		switch (pVertexBindingAttributes.declaration)
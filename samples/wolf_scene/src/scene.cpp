@@ -4,7 +4,6 @@
 #include <glm_extension.h>
 #include <w_thread.h>
 #include <w_task.h>
-#include <tbb/parallel_for.h>
 
 using namespace std;
 using namespace wolf;
@@ -70,6 +69,8 @@ scene::scene(_In_z_ const std::wstring& pContentPath, _In_ const wolf::system::w
 	//++++++++++++++++++++++++++++++++++++++++++++++++++++
 	//The following codes have been added for this project
 	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	this->_thread_pool.allocate(w_thread::get_number_of_hardware_thread_contexts());
+
 	auto _number_of_threads = 1;// w_thread::get_number_of_hardware_thread_contexts();
 	if (this->_masked_occlusion_culling.initialize(_number_of_threads, true) == W_FAILED)
 	{
@@ -610,18 +611,27 @@ void scene::update(_In_ const wolf::system::w_game_time& pGameTime)
 		this->_drawable_models.clear();
 
 		//test all bounding boxes of models with camera frustom
-		tbb::parallel_for(
-			tbb::blocked_range<size_t>(0, this->_scene_models.size()),
-			[&](const tbb::blocked_range<size_t>& pRange)
+		this->_models_in_sight.assign(this->_scene_models.size(), 0);
+		this->_thread_pool.parallel_for(
+			0,
+			this->_scene_models.size(),
+			[&](_In_ const size_t& pBegin, _In_ const size_t& pEnd)
 		{
-			for (size_t i = pRange.begin(); i < pRange.end(); ++i)
+			for (size_t i = pBegin; i < pEnd; ++i)
 			{
-				if (this->_scene_models[i] && this->_scene_models[i]->check_is_in_sight(&this->_first_camera))
+				if (this->_scene_models[i] && this->_scene_models[i]->check_is_in_sight(&this->_first_camera, this->_thread_pool))
 				{
-					this->_visible_models.push_back(this->_scene_models[i]);
+					this->_models_in_sight[i] = 1;
 				}
 			}
 		});
+		for (size_t i = 0; i < this->_models_in_sight.size(); ++i)
+		{
+			if (this->_models_in_sight[i])
+			{
+				this->_visible_models.push_back(this->_scene_models[i]);
+			}
+		}
 
 		//now check for masked occlusion culling
 		bool _need_post_check = false;
@@ -826,6 +836,8 @@ ULONG scene::release()
 	this->_masked_occlusion_culling.release();
 	SAFE_DELETE(_masked_occlusion_culling_debug_frame);
 
+	this->_thread_pool.release();
+
 	SAFE_RELEASE(this->_shape_coordinate_axis);
 
 	//release gui's resources
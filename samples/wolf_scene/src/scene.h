@@ -28,7 +28,7 @@
 //The following codes have been added for this project
 //++++++++++++++++++++++++++++++++++++++++++++++++++++
 #include <w_framework/w_masked_occlusion_culling.h>
-#include <tbb/concurrent_vector.h>
+#include <w_thread_pool.h>
 //++++++++++++++++++++++++++++++++++++++++++++++++++++
 //++++++++++++++++++++++++++++++++++++++++++++++++++++
 
@@ -111,7 +111,10 @@ private:
 	wolf::framework::w_masked_occlusion_culling						_masked_occlusion_culling;
 	wolf::graphics::w_texture*										_masked_occlusion_culling_debug_frame;
 	long															_visible_meshes;
-	tbb::concurrent_vector<model*>									_visible_models;
+	wolf::system::w_thread_pool										_thread_pool;
+	std::vector<model*>												_visible_models;
+	//flags of models which passed frustum culling, filled in parallel
+	std::vector<uint8_t>											_models_in_sight;
 	std::vector<model*>												_drawable_models;
 	std::vector<model*>												_searched_models;
 